@@ -2,8 +2,11 @@
 
 #include <algorithm>
 #include <array>
+#include <iterator>
 
 #include "hecl/Blender/Connection.hpp"
+#include "hecl/CookMetrics.hpp"
+#include "hecl/ParallelFor.hpp"
 #include "PATH.hpp"
 
 namespace DataSpec {
@@ -14,6 +17,8 @@ constexpr s32 AROT_MIN_MODELS = 8;
 constexpr s32 COLLISION_MIN_NODE_TRIANGLES = 8;
 constexpr s32 PATH_MIN_NODE_REGIONS = 16;
 constexpr float AROT_MIN_SUBDIV = 8.f;
+/* Nodes at least this large classify their children and build their subtrees on the helper pool */
+constexpr size_t AROT_PARALLEL_MIN_INDICES = 1024;
 
 static zeus::CAABox SplitAABB(const zeus::CAABox& aabb, int i) {
   zeus::CAABox pos, neg;
@@ -52,8 +57,12 @@ static zeus::CAABox SplitAABB(const zeus::CAABox& aabb, int i) {
 }
 
 void AROTBuilder::Node::mergeSets(int a, int b) {
-  childNodes[a].childIndices.insert(childNodes[b].childIndices.cbegin(), childNodes[b].childIndices.cend());
-  childNodes[b].childIndices = childNodes[a].childIndices;
+  std::vector<int> merged;
+  merged.reserve(childNodes[a].childIndices.size() + childNodes[b].childIndices.size());
+  std::set_union(childNodes[a].childIndices.cbegin(), childNodes[a].childIndices.cend(),
+                 childNodes[b].childIndices.cbegin(), childNodes[b].childIndices.cend(), std::back_inserter(merged));
+  childNodes[a].childIndices = merged;
+  childNodes[b].childIndices = std::move(merged);
 }
 
 bool AROTBuilder::Node::compareSets(int a, int b) const {
@@ -65,8 +74,13 @@ void AROTBuilder::Node::addChild(int level, int minChildren, const std::vector<z
   /* Gather intersecting faces */
   for (size_t i = 0; i < triBoxes.size(); ++i)
     if (triBoxes[i].intersects(curAABB))
-      childIndices.insert(i);
+      childIndices.push_back(i);
 
+  subdivide(level, minChildren, triBoxes, curAABB, typeOut);
+}
+
+void AROTBuilder::Node::subdivide(int level, int minChildren, const std::vector<zeus::CAABox>& triBoxes,
+                                  const zeus::CAABox& curAABB, BspNodeType& typeOut) {
   zeus::CVector3f extents = curAABB.extents();
 
   /* Return early if empty, triangle intersection below performance threshold, or at max level */
@@ -79,14 +93,36 @@ void AROTBuilder::Node::addChild(int level, int minChildren, const std::vector<z
     return;
   }
 
-  /* Subdivide */
+  /* Subdivide; a face can only touch a child box if it touches this one, so only this node's faces are
+   * classified. Indices are visited in order, keeping each child's list sorted. */
   typeOut = BspNodeType::Branch;
   childNodes.resize(8);
-  for (int i = 0; i < 8; ++i) {
-    BspNodeType chType;
-    childNodes[i].addChild(level + 1, minChildren, triBoxes, SplitAABB(curAABB, i), chType);
-    flags |= int(chType) << (i * 2);
+  std::array<zeus::CAABox, 8> childAABBs;
+  for (int i = 0; i < 8; ++i)
+    childAABBs[i] = SplitAABB(curAABB, i);
+
+  /* Children are independent, so large nodes classify and build each child on the helper pool */
+  std::array<BspNodeType, 8> chTypes;
+  if (childIndices.size() >= AROT_PARALLEL_MIN_INDICES) {
+    hecl::ParallelFor(8, [&](size_t i) {
+      Node& child = childNodes[i];
+      for (int idx : childIndices)
+        if (triBoxes[idx].intersects(childAABBs[i]))
+          child.childIndices.push_back(idx);
+      child.subdivide(level + 1, minChildren, triBoxes, childAABBs[i], chTypes[i]);
+    });
+  } else {
+    for (int idx : childIndices) {
+      const zeus::CAABox& triBox = triBoxes[idx];
+      for (int i = 0; i < 8; ++i)
+        if (triBox.intersects(childAABBs[i]))
+          childNodes[i].childIndices.push_back(idx);
+    }
+    for (int i = 0; i < 8; ++i)
+      childNodes[i].subdivide(level + 1, minChildren, triBoxes, childAABBs[i], chTypes[i]);
   }
+  for (int i = 0; i < 8; ++i)
+    flags |= int(chTypes[i]) << (i * 2);
 
   /* Unsubdivide minimum axis dimensions */
   if (extents.x() < AROT_MIN_SUBDIV) {
@@ -124,12 +160,11 @@ void AROTBuilder::Node::addChild(int level, int minChildren, const std::vector<z
   }
 }
 
-size_t AROTBuilder::BitmapPool::addIndices(const std::set<int>& indices) {
-  for (size_t i = 0; i < m_pool.size(); ++i)
-    if (m_pool[i] == indices)
-      return i;
-  m_pool.push_back(indices);
-  return m_pool.size() - 1;
+size_t AROTBuilder::BitmapPool::addIndices(const std::vector<int>& indices) {
+  const auto [it, inserted] = m_lookup.try_emplace(indices, m_pool.size());
+  if (inserted)
+    m_pool.push_back(indices);
+  return it->second;
 }
 
 constexpr std::array<uint32_t, 8> AROTChildCounts{
@@ -316,6 +351,8 @@ template void AROTBuilder::Node::pathWrite(DNAPATH::PATH<DNAMP3::PAKBridge>& pat
 
 void AROTBuilder::build(std::vector<std::vector<uint8_t>>& secs, const zeus::CAABox& fullAabb,
                         const std::vector<zeus::CAABox>& meshAabbs, const std::vector<DNACMDL::Mesh>& meshes) {
+  hecl::CookMetricTimer timer("AROT octree ms");
+
   /* Recursively split */
   BspNodeType rootType;
   rootNode.addChild(0, AROT_MIN_MODELS, meshAabbs, fullAabb, rootType);
@@ -343,29 +380,11 @@ void AROTBuilder::build(std::vector<std::vector<uint8_t>>& secs, const zeus::CAA
   /* Write bitmap */
   std::vector<uint32_t> bmpWords;
   bmpWords.reserve(bmpWordCount);
-  for (const std::set<int>& bmp : bmpPool.m_pool) {
+  for (const std::vector<int>& bmp : bmpPool.m_pool) {
     bmpWords.clear();
     bmpWords.resize(bmpWordCount);
-
-    auto bmpIt = bmp.cbegin();
-    if (bmpIt != bmp.cend()) {
-      int curIdx = 0;
-      for (size_t word = 0; word < bmpWordCount; ++word) {
-        for (u32 b = 0; b < 32; ++b) {
-          if (*bmpIt == curIdx) {
-            bmpWords[word] |= 1U << b;
-            ++bmpIt;
-            if (bmpIt == bmp.cend()) {
-              break;
-            }
-          }
-          ++curIdx;
-        }
-        if (bmpIt == bmp.cend()) {
-          break;
-        }
-      }
-    }
+    for (int idx : bmp)
+      bmpWords[idx / 32] |= 1U << (idx % 32);
 
     for (uint32_t word : bmpWords)
       w.writeUint32Big(word);
@@ -377,6 +396,8 @@ void AROTBuilder::build(std::vector<std::vector<uint8_t>>& secs, const zeus::CAA
 }
 
 std::pair<std::unique_ptr<uint8_t[]>, uint32_t> AROTBuilder::buildCol(const ColMesh& mesh, BspNodeType& rootOut) {
+  hecl::CookMetricTimer timer("Collision octree ms");
+
   /* Accumulate total AABB */
   zeus::CAABox fullAABB;
   for (const auto& vert : mesh.verts)
@@ -411,6 +432,8 @@ std::pair<std::unique_ptr<uint8_t[]>, uint32_t> AROTBuilder::buildCol(const ColM
 
 template <class PAKBridge>
 void AROTBuilder::buildPath(DNAPATH::PATH<PAKBridge>& path) {
+  hecl::CookMetricTimer timer("PATH octree ms");
+
   /* Accumulate total AABB and gather region boxes */
   std::vector<zeus::CAABox> regionBoxes;
   regionBoxes.reserve(path.regions.size());
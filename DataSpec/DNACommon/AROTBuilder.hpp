@@ -4,7 +4,8 @@
 #include "DeafBabe.hpp"
 #include "zeus/CAABox.hpp"
 #include "CMDL.hpp"
-#include <set>
+#include <map>
+#include <vector>
 
 namespace DataSpec {
 namespace DNAPATH {
@@ -16,13 +17,15 @@ struct AROTBuilder {
   using ColMesh = hecl::blender::ColMesh;
 
   struct BitmapPool {
-    std::vector<std::set<int>> m_pool;
-    size_t addIndices(const std::set<int>& indices);
+    std::vector<std::vector<int>> m_pool;
+    std::map<std::vector<int>, size_t> m_lookup;
+    size_t addIndices(const std::vector<int>& indices);
   } bmpPool;
 
   struct Node {
     std::vector<Node> childNodes;
-    std::set<int> childIndices;
+    /* Sorted, unique */
+    std::vector<int> childIndices;
     size_t poolIdx = 0;
     uint16_t flags = 0;
     uint16_t compSubdivs = 0;
@@ -32,6 +35,8 @@ struct AROTBuilder {
 
     void addChild(int level, int minChildren, const std::vector<zeus::CAABox>& triBoxes, const zeus::CAABox& curAABB,
                   BspNodeType& typeOut);
+    void subdivide(int level, int minChildren, const std::vector<zeus::CAABox>& triBoxes, const zeus::CAABox& curAABB,
+                   BspNodeType& typeOut);
     void mergeSets(int a, int b);
     bool compareSets(int a, int b) const;
     void nodeCount(size_t& sz, size_t& idxRefs, BitmapPool& bmpPool, size_t& curOff);
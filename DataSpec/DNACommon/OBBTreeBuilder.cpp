@@ -1,116 +1,225 @@
 #include "DataSpec/DNACommon/OBBTreeBuilder.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
 #include <cstddef>
-#include <unordered_set>
 #include <vector>
 
 #include "DataSpec/DNAMP1/DCLN.hpp"
 
 #include <athena/Types.hpp>
-#include <gmm/gmm.h>
 #include <hecl/Blender/Connection.hpp>
+#include <hecl/CookMetrics.hpp>
+#include <hecl/ParallelFor.hpp>
+#include <logvisor/logvisor.hpp>
 #include <zeus/CTransform.hpp>
 
 namespace DataSpec {
+static logvisor::Module Log("DataSpec::OBBTreeBuilder");
 
 using ColMesh = hecl::blender::ColMesh;
 
+/* Nodes with at least this many triangles build their children on the helper pool */
+constexpr size_t OBB_PARALLEL_MIN_TRIANGLES = 512;
+constexpr int OBB_SAH_BINS = 16;
+/* Cost of testing a node's box relative to testing one triangle */
+constexpr float OBB_TRAVERSAL_COST = 1.f;
+
 struct FittedOBB {
   zeus::CTransform xf;
   zeus::CVector3f he;
 };
 
-static std::vector<int> MakeRootTriangleIndex(const ColMesh& mesh) {
-  std::vector<int> ret;
+struct Triangle {
+  std::array<zeus::CVector3f, 3> verts;
+};
+
+/* Resolves each triangle's corners once so fitting and splitting work from a flat array */
+static std::vector<Triangle> MakeTriangles(const ColMesh& mesh) {
+  std::vector<Triangle> ret;
   ret.reserve(mesh.trianges.size());
-  for (size_t i = 0; i < mesh.trianges.size(); ++i)
+  for (const ColMesh::Triangle& T : mesh.trianges) {
+    std::array<uint32_t, 3> verts{};
+    size_t vertCount = 0;
+    for (const uint32_t edgeIdx : T.edges) {
+      for (const uint32_t vertIdx : mesh.edges[edgeIdx].verts) {
+        if (vertCount < 3 && std::find(verts.begin(), verts.begin() + vertCount, vertIdx) == verts.begin() + vertCount)
+          verts[vertCount++] = vertIdx;
+      }
+    }
+    /* Degenerate triangles repeat their last corner */
+    for (size_t i = vertCount; i < 3; ++i)
+      verts[i] = verts[vertCount ? vertCount - 1 : 0];
+
+    Triangle& tri = ret.emplace_back();
+    for (size_t i = 0; i < 3; ++i)
+      tri.verts[i] = mesh.verts[verts[i]].val;
+  }
+  return ret;
+}
+
+static std::vector<int> MakeRootTriangleIndex(const std::vector<Triangle>& tris) {
+  std::vector<int> ret;
+  ret.reserve(tris.size());
+  for (size_t i = 0; i < tris.size(); ++i)
     ret.push_back(i);
   return ret;
 }
 
-static std::unordered_set<uint32_t> GetTriangleVerts(const ColMesh& mesh, int triIdx) {
-  const ColMesh::Triangle& T = mesh.trianges[triIdx];
-  std::unordered_set<uint32_t> verts;
-  verts.insert(mesh.edges[T.edges[0]].verts[0]);
-  verts.insert(mesh.edges[T.edges[0]].verts[1]);
-  verts.insert(mesh.edges[T.edges[1]].verts[0]);
-  verts.insert(mesh.edges[T.edges[1]].verts[1]);
-  verts.insert(mesh.edges[T.edges[2]].verts[0]);
-  verts.insert(mesh.edges[T.edges[2]].verts[1]);
-  return verts;
+using Vec3d = std::array<double, 3>;
+
+static double Dot(const Vec3d& a, const Vec3d& b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+static Vec3d Cross(const Vec3d& a, const Vec3d& b) {
+  return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
 }
 
-// method to set the OBB parameters which produce a box oriented according to
-// the covariance matrix C, which just containts the points pnts
-static FittedOBB BuildFromCovarianceMatrix(gmm::dense_matrix<float>& C, const ColMesh& mesh,
-                                           const std::vector<int>& index) {
-  FittedOBB ret;
+static Vec3d Normalized(const Vec3d& v) {
+  const double len = std::sqrt(Dot(v, v));
+  return {v[0] / len, v[1] / len, v[2] / len};
+}
 
-  // extract the eigenvalues and eigenvectors from C
-  gmm::dense_matrix<float> eigvec(3, 3);
-  std::vector<float> eigval(3);
-  using namespace gmm;
-  using MAT1 = gmm::dense_matrix<float>;
-  gmm::symmetric_qr_algorithm(C, eigval, eigvec, default_tol_for_qr);
-
-  // find the right, up and forward vectors from the eigenvectors
-  zeus::CVector3f r(eigvec(0, 0), eigvec(1, 0), eigvec(2, 0));
-  zeus::CVector3f f(eigvec(0, 1), eigvec(1, 1), eigvec(2, 1));
-  zeus::CVector3f u(eigvec(0, 2), eigvec(1, 2), eigvec(2, 2));
-  r.normalize();
-  f.normalize();
-  u.normalize();
-
-  // set the rotation matrix using the eigvenvectors
-  ret.xf.basis[0] = r;
-  ret.xf.basis[1] = f;
-  ret.xf.basis[2] = u;
-  ret.xf.orthonormalize();
+/* Symmetric matrix stored as a00, a01, a02, a11, a12, a22 */
+using Sym3d = std::array<double, 6>;
 
-  // now build the bounding box extents in the rotated frame
-  zeus::CVector3f minim(1e10f, 1e10f, 1e10f), maxim(-1e10f, -1e10f, -1e10f);
-  for (int triIdx : index) {
-    std::unordered_set<uint32_t> verts = GetTriangleVerts(mesh, triIdx);
-    for (uint32_t v : verts) {
-      const zeus::CVector3f& p = mesh.verts[v].val;
-      zeus::CVector3f p_prime(ret.xf.basis[0].dot(p), ret.xf.basis[1].dot(p), ret.xf.basis[2].dot(p));
-      minim = zeus::min(minim, p_prime);
-      maxim = zeus::max(maxim, p_prime);
+static Vec3d Multiply(const Sym3d& A, const Vec3d& v) {
+  return {A[0] * v[0] + A[1] * v[1] + A[2] * v[2], A[1] * v[0] + A[3] * v[1] + A[4] * v[2],
+          A[2] * v[0] + A[4] * v[1] + A[5] * v[2]};
+}
+
+/* Eigenvector for an eigenvalue of multiplicity one: the longest cross product of rows of A - λI */
+static Vec3d EigenvectorForSingle(const Sym3d& A, double eigval) {
+  const Vec3d row0{A[0] - eigval, A[1], A[2]};
+  const Vec3d row1{A[1], A[3] - eigval, A[4]};
+  const Vec3d row2{A[2], A[4], A[5] - eigval};
+  const std::array<Vec3d, 3> crosses{Cross(row0, row1), Cross(row0, row2), Cross(row1, row2)};
+  const auto best = std::max_element(crosses.cbegin(), crosses.cend(),
+                                     [](const Vec3d& a, const Vec3d& b) { return Dot(a, a) < Dot(b, b); });
+  if (Dot(*best, *best) == 0.0)
+    return {1.0, 0.0, 0.0};
+  return Normalized(*best);
+}
+
+/* Eigenvector for the middle eigenvalue, solved as a 2x2 problem orthogonal to the first one found */
+static Vec3d EigenvectorForMiddle(const Sym3d& A, const Vec3d& w, double eigval) {
+  Vec3d u;
+  if (std::abs(w[0]) > std::abs(w[1])) {
+    const double invLength = 1.0 / std::sqrt(w[0] * w[0] + w[2] * w[2]);
+    u = {-w[2] * invLength, 0.0, w[0] * invLength};
+  } else {
+    const double invLength = 1.0 / std::sqrt(w[1] * w[1] + w[2] * w[2]);
+    u = {0.0, w[2] * invLength, -w[1] * invLength};
+  }
+  const Vec3d v = Cross(w, u);
+
+  const Vec3d Au = Multiply(A, u);
+  const Vec3d Av = Multiply(A, v);
+  double m00 = Dot(u, Au) - eigval;
+  double m01 = Dot(u, Av);
+  double m11 = Dot(v, Av) - eigval;
+  const double absM00 = std::abs(m00);
+  const double absM01 = std::abs(m01);
+  const double absM11 = std::abs(m11);
+
+  if (absM00 >= absM11) {
+    if (std::max(absM00, absM01) == 0.0)
+      return u;
+    if (absM00 >= absM01) {
+      m01 /= m00;
+      m00 = 1.0 / std::sqrt(1.0 + m01 * m01);
+      m01 *= m00;
+    } else {
+      m00 /= m01;
+      m01 = 1.0 / std::sqrt(1.0 + m00 * m00);
+      m00 *= m01;
     }
+    return {m01 * u[0] - m00 * v[0], m01 * u[1] - m00 * v[1], m01 * u[2] - m00 * v[2]};
   }
 
-  // set the center of the OBB to be the average of the
-  // minimum and maximum, and the extents be half of the
-  // difference between the minimum and maximum
-  zeus::CVector3f center = (maxim + minim) * 0.5f;
-  ret.xf.origin = ret.xf.basis * center;
-  ret.he = (maxim - minim) * 0.5f;
+  if (std::max(absM11, absM01) == 0.0)
+    return u;
+  if (absM11 >= absM01) {
+    m01 /= m11;
+    m11 = 1.0 / std::sqrt(1.0 + m01 * m01);
+    m01 *= m11;
+  } else {
+    m11 /= m01;
+    m01 = 1.0 / std::sqrt(1.0 + m11 * m11);
+    m11 *= m01;
+  }
+  return {m11 * u[0] - m01 * v[0], m11 * u[1] - m01 * v[1], m11 * u[2] - m01 * v[2]};
+}
+
+/* Closed-form eigenvectors of a symmetric 3x3 matrix (Eberly, "A Robust Eigensolver for 3x3 Symmetric
+ * Matrices"), returned as right-handed orthonormal columns */
+static zeus::CMatrix3f SymmetricEigenvectors(Sym3d A) {
+  const double maxAbs = std::abs(*std::max_element(A.cbegin(), A.cend(), [](double a, double b) {
+    return std::abs(a) < std::abs(b);
+  }));
+  if (maxAbs == 0.0)
+    return zeus::CMatrix3f();
+  for (double& a : A)
+    a /= maxAbs;
+
+  const double q = (A[0] + A[3] + A[5]) / 3.0;
+  const double b00 = A[0] - q;
+  const double b11 = A[3] - q;
+  const double b22 = A[5] - q;
+  const double p =
+      std::sqrt((b00 * b00 + b11 * b11 + b22 * b22 + 2.0 * (A[1] * A[1] + A[2] * A[2] + A[4] * A[4])) / 6.0);
+  /* Isotropic; any basis fits equally well */
+  if (p < 1e-12)
+    return zeus::CMatrix3f();
+
+  const double c00 = b11 * b22 - A[4] * A[4];
+  const double c01 = A[1] * b22 - A[4] * A[2];
+  const double c02 = A[1] * A[4] - b11 * A[2];
+  const double halfDet = std::clamp((b00 * c00 - A[1] * c01 + A[2] * c02) / (p * p * p) * 0.5, -1.0, 1.0);
+  const double angle = std::acos(halfDet) / 3.0;
+  constexpr double TwoThirdsPi = 2.09439510239319549;
+  const double eigMax = q + p * 2.0 * std::cos(angle);
+  const double eigMin = q + p * 2.0 * std::cos(angle + TwoThirdsPi);
+  const double eigMid = 3.0 * q - eigMax - eigMin;
+
+  /* Start from whichever extreme eigenvalue is further from the middle one */
+  Vec3d v0, v1, v2;
+  if (halfDet >= 0.0) {
+    v2 = EigenvectorForSingle(A, eigMax);
+    v1 = Normalized(EigenvectorForMiddle(A, v2, eigMid));
+    v0 = Cross(v1, v2);
+  } else {
+    v0 = EigenvectorForSingle(A, eigMin);
+    v1 = Normalized(EigenvectorForMiddle(A, v0, eigMid));
+    v2 = Cross(v0, v1);
+  }
 
+  zeus::CMatrix3f ret;
+  ret[0] = zeus::CVector3f(float(v0[0]), float(v0[1]), float(v0[2])).normalized();
+  ret[1] = zeus::CVector3f(float(v1[0]), float(v1[1]), float(v1[2])).normalized();
+  ret[2] = zeus::CVector3f(float(v2[0]), float(v2[1]), float(v2[2])).normalized();
   return ret;
 }
 
 // builds an OBB from triangles specified as an array of
 // points with integer indices into the point array. Forms
 // the covariance matrix for the triangles, then uses the
-// method build_from_covariance_matrix() method to fit
-// the box.  ALL points will be fit in the box, regardless
-// of whether they are indexed by a triangle or not.
-static FittedOBB FitOBB(const ColMesh& mesh, const std::vector<int>& index) {
-  float Ai, Am = 0.0;
-  zeus::CVector3f mu, mui;
-  gmm::dense_matrix<float> C(3, 3);
-  float cxx = 0.0, cxy = 0.0, cxz = 0.0, cyy = 0.0, cyz = 0.0, czz = 0.0;
+// closed-form eigen solve to orient the box. ALL corners
+// of the indexed triangles will be fit in the box.
+static FittedOBB FitOBB(const std::vector<Triangle>& tris, const std::vector<int>& index) {
+  double Am = 0.0;
+  zeus::CVector3f mu;
+  double cxx = 0.0, cxy = 0.0, cxz = 0.0, cyy = 0.0, cyz = 0.0, czz = 0.0;
 
   // loop over the triangles this time to find the
   // mean location
   for (int i : index) {
-    std::unordered_set<uint32_t> verts = GetTriangleVerts(mesh, i);
-    auto it = verts.begin();
-    zeus::CVector3f p = mesh.verts[*it++].val;
-    zeus::CVector3f q = mesh.verts[*it++].val;
-    zeus::CVector3f r = mesh.verts[*it++].val;
-    mui = (p + q + r) / 3.f;
-    Ai = (q - p).cross(r - p).magnitude() / 2.f;
+    const zeus::CVector3f& p = tris[i].verts[0];
+    const zeus::CVector3f& q = tris[i].verts[1];
+    const zeus::CVector3f& r = tris[i].verts[2];
+    const zeus::CVector3f mui = (p + q + r) / 3.f;
+    const float Ai = (q - p).cross(r - p).magnitude() / 2.f;
     mu += mui * Ai;
     Am += Ai;
 
@@ -120,46 +229,127 @@ static FittedOBB FitOBB(const ColMesh& mesh, const std::vector<int>& index) {
     cxz += (9.0 * mui.x() * mui.z() + p.x() * p.z() + q.x() * q.z() + r.x() * r.z()) * (Ai / 12.0);
     cyy += (9.0 * mui.y() * mui.y() + p.y() * p.y() + q.y() * q.y() + r.y() * r.y()) * (Ai / 12.0);
     cyz += (9.0 * mui.y() * mui.z() + p.y() * p.z() + q.y() * q.z() + r.y() * r.z()) * (Ai / 12.0);
+    czz += (9.0 * mui.z() * mui.z() + p.z() * p.z() + q.z() * q.z() + r.z() * r.z()) * (Ai / 12.0);
   }
 
-  if (zeus::close_enough(Am, 0.f))
+  if (zeus::close_enough(float(Am), 0.f))
     return {};
 
   // divide out the Am fraction from the average position and
-  // covariance terms
-  mu = mu / Am;
-  cxx /= Am;
-  cxy /= Am;
-  cxz /= Am;
-  cyy /= Am;
-  cyz /= Am;
-  czz /= Am;
-
-  // now subtract off the E[x]*E[x], E[x]*E[y], ... terms
-  cxx -= mu.x() * mu.x();
-  cxy -= mu.x() * mu.y();
-  cxz -= mu.x() * mu.z();
-  cyy -= mu.y() * mu.y();
-  cyz -= mu.y() * mu.z();
-  czz -= mu.z() * mu.z();
-
-  // now build the covariance matrix
-  C(0, 0) = cxx;
-  C(0, 1) = cxy;
-  C(0, 2) = cxz;
-  C(1, 0) = cxy;
-  C(1, 1) = cyy;
-  C(1, 2) = cyz;
-  C(2, 0) = cxz;
-  C(2, 1) = cyz;
-  C(2, 2) = czz;
-
-  // set the obb parameters from the covariance matrix
-  return BuildFromCovarianceMatrix(C, mesh, index);
+  // covariance terms, then subtract off the E[x]*E[x], E[x]*E[y], ... terms
+  mu = mu / float(Am);
+  const Sym3d C{cxx / Am - mu.x() * mu.x(), cxy / Am - mu.x() * mu.y(), cxz / Am - mu.x() * mu.z(),
+                cyy / Am - mu.y() * mu.y(), cyz / Am - mu.y() * mu.z(), czz / Am - mu.z() * mu.z()};
+
+  FittedOBB ret;
+  ret.xf.basis = SymmetricEigenvectors(C);
+
+  // now build the bounding box extents in the rotated frame
+  zeus::CVector3f minim(1e10f, 1e10f, 1e10f), maxim(-1e10f, -1e10f, -1e10f);
+  for (int triIdx : index) {
+    for (const zeus::CVector3f& p : tris[triIdx].verts) {
+      zeus::CVector3f p_prime(ret.xf.basis[0].dot(p), ret.xf.basis[1].dot(p), ret.xf.basis[2].dot(p));
+      minim = zeus::min(minim, p_prime);
+      maxim = zeus::max(maxim, p_prime);
+    }
+  }
+
+  // set the center of the OBB to be the average of the
+  // minimum and maximum, and the extents be half of the
+  // difference between the minimum and maximum
+  zeus::CVector3f center = (maxim + minim) * 0.5f;
+  ret.xf.origin = ret.xf.basis * center;
+  ret.he = (maxim - minim) * 0.5f;
+
+  return ret;
+}
+
+static float HalfSurfaceArea(const zeus::CVector3f& extent) {
+  return extent.x() * extent.y() + extent.y() * extent.z() + extent.z() * extent.x();
+}
+
+struct LocalBounds {
+  zeus::CVector3f min{1e10f, 1e10f, 1e10f};
+  zeus::CVector3f max{-1e10f, -1e10f, -1e10f};
+  void accumulate(const LocalBounds& other) {
+    min = zeus::min(min, other.min);
+    max = zeus::max(max, other.max);
+  }
+  float area() const { return min.x() > max.x() ? 0.f : HalfSurfaceArea(max - min); }
+};
+
+struct SplitChoice {
+  int axis = -1;
+  int bin = 0;
+  float binMin = 0.f;
+  float binScale = 0.f;
+  float cost = 0.f;
+  int binOf(const zeus::CVector3f& centroid) const {
+    return std::min(int((centroid[axis] - binMin) * binScale), OBB_SAH_BINS - 1);
+  }
+};
+
+/* Binned surface area heuristic over triangle centroids along each axis of the node's box */
+static SplitChoice ChooseSplit(const std::vector<LocalBounds>& bounds, const std::vector<zeus::CVector3f>& centroids,
+                               float parentArea) {
+  SplitChoice best;
+  best.cost = float(bounds.size());
+  if (parentArea <= 0.f)
+    return best;
+
+  for (int c = 0; c < 3; ++c) {
+    float cMin = 1e10f, cMax = -1e10f;
+    for (const zeus::CVector3f& centroid : centroids) {
+      cMin = std::min(cMin, centroid[c]);
+      cMax = std::max(cMax, centroid[c]);
+    }
+    if (!(cMax > cMin))
+      continue;
+
+    SplitChoice cand;
+    cand.axis = c;
+    cand.binMin = cMin;
+    cand.binScale = OBB_SAH_BINS / (cMax - cMin);
+    std::array<LocalBounds, OBB_SAH_BINS> binBounds;
+    std::array<size_t, OBB_SAH_BINS> binCounts{};
+    for (size_t i = 0; i < centroids.size(); ++i) {
+      const int bin = cand.binOf(centroids[i]);
+      binBounds[bin].accumulate(bounds[i]);
+      ++binCounts[bin];
+    }
+
+    /* Right-to-left sweep, then evaluate each plane while sweeping left-to-right */
+    std::array<float, OBB_SAH_BINS> rightArea{};
+    std::array<size_t, OBB_SAH_BINS> rightCount{};
+    LocalBounds acc;
+    size_t count = 0;
+    for (int b = OBB_SAH_BINS - 1; b > 0; --b) {
+      acc.accumulate(binBounds[b]);
+      count += binCounts[b];
+      rightArea[b] = acc.area();
+      rightCount[b] = count;
+    }
+    acc = {};
+    count = 0;
+    for (int b = 1; b < OBB_SAH_BINS; ++b) {
+      acc.accumulate(binBounds[b - 1]);
+      count += binCounts[b - 1];
+      if (count == 0 || rightCount[b] == 0)
+        continue;
+      const float cost =
+          OBB_TRAVERSAL_COST + (acc.area() * float(count) + rightArea[b] * float(rightCount[b])) / parentArea;
+      if (cost < best.cost) {
+        best = cand;
+        best.bin = b;
+        best.cost = cost;
+      }
+    }
+  }
+  return best;
 }
 
 template <typename Node>
-static void MakeLeaf(const ColMesh& mesh, const std::vector<int>& index, Node& n) {
+static void MakeLeaf(const std::vector<int>& index, Node& n) {
   n.left.reset();
   n.right.reset();
   n.isLeaf = true;
@@ -171,9 +361,10 @@ static void MakeLeaf(const ColMesh& mesh, const std::vector<int>& index, Node& n
 }
 
 template <typename Node>
-static std::unique_ptr<Node> RecursiveMakeNode(const ColMesh& mesh, const std::vector<int>& index) {
+static std::unique_ptr<Node> RecursiveMakeNode(const std::vector<Triangle>& tris, const std::vector<int>& index,
+                                               int depth) {
   // calculate root OBB
-  FittedOBB obb = FitOBB(mesh, index);
+  FittedOBB obb = FitOBB(tris, index);
 
   // make results row-major and also invert the rotation basis
   obb.xf.basis.transpose();
@@ -185,71 +376,189 @@ static std::unique_ptr<Node> RecursiveMakeNode(const ColMesh& mesh, const std::v
   }
   n->halfExtent = obb.he;
 
-  // terminate branch when volume < 1.0
-  if (obb.he[0] * obb.he[1] * obb.he[2] < 1.f) {
-    MakeLeaf(mesh, index, *n);
+  if (index.size() <= 1) {
+    MakeLeaf(index, *n);
+    return n;
+  }
+
+  /* Triangle bounds and centroids in the box's frame */
+  std::vector<LocalBounds> bounds(index.size());
+  std::vector<zeus::CVector3f> centroids(index.size());
+  for (size_t i = 0; i < index.size(); ++i) {
+    zeus::CVector3f sum;
+    for (const zeus::CVector3f& vert : tris[index[i]].verts) {
+      const zeus::CVector3f v = obb.xf.basis * (vert - obb.xf.origin);
+      bounds[i].min = zeus::min(bounds[i].min, v);
+      bounds[i].max = zeus::max(bounds[i].max, v);
+      sum += v;
+    }
+    centroids[i] = sum / 3.f;
+  }
+
+  // split only when the heuristic expects fewer triangle tests than keeping this node a leaf
+  const SplitChoice split = ChooseSplit(bounds, centroids, HalfSurfaceArea(obb.he * 2.f));
+  if (split.axis == -1) {
+    MakeLeaf(index, *n);
     return n;
   }
 
   n->isLeaf = false;
 
-  std::vector<int> indexNeg[3];
-  std::vector<int> indexPos[3];
-  for (int c = 0; c < 3; ++c) {
-    // subdivide negative side
-    indexNeg[c].reserve(index.size());
-    for (int i : index) {
-      std::unordered_set<uint32_t> verts = GetTriangleVerts(mesh, i);
-      for (uint32_t vtx : verts) {
-        zeus::CVector3f v = mesh.verts[vtx].val;
-        v = obb.xf.basis * (v - obb.xf.origin);
-        if (v[c] < 0.f) {
-          indexNeg[c].push_back(i);
-          break;
-        }
-      }
-    }
+  std::vector<int> indexNeg;
+  std::vector<int> indexPos;
+  indexNeg.reserve(index.size());
+  indexPos.reserve(index.size());
+  for (size_t i = 0; i < index.size(); ++i)
+    (split.binOf(centroids[i]) < split.bin ? indexNeg : indexPos).push_back(index[i]);
+
+  const auto buildChild = [&](size_t i) {
+    if (i == 0)
+      n->left = RecursiveMakeNode<Node>(tris, indexNeg, depth + 1);
+    else
+      n->right = RecursiveMakeNode<Node>(tris, indexPos, depth + 1);
+  };
+  if (index.size() >= OBB_PARALLEL_MIN_TRIANGLES) {
+    hecl::ParallelFor(2, buildChild);
+  } else {
+    buildChild(0);
+    buildChild(1);
+  }
 
-    // subdivide positive side
-    indexPos[c].reserve(index.size());
-    for (int i : index) {
-      std::unordered_set<uint32_t> verts = GetTriangleVerts(mesh, i);
-      for (uint32_t vtx : verts) {
-        zeus::CVector3f v = mesh.verts[vtx].val;
-        v = obb.xf.basis * (v - obb.xf.origin);
-        if (v[c] >= 0.f) {
-          indexPos[c].push_back(i);
-          break;
-        }
-      }
-    }
+  return n;
+}
+
+struct TreeStats {
+  size_t nodes = 0;
+  size_t leaves = 0;
+  size_t leafTriangles = 0;
+  int maxDepth = 0;
+  size_t queries = 0;
+  size_t nodeVisits = 0;
+  size_t triangleTests = 0;
+};
+
+template <typename Node>
+static void GatherStats(const Node& n, int depth, TreeStats& stats) {
+  ++stats.nodes;
+  stats.maxDepth = std::max(stats.maxDepth, depth);
+  if (n.isLeaf) {
+    ++stats.leaves;
+    stats.leafTriangles += n.leafData->triangleIndices.size();
+    return;
   }
+  GatherStats(*n.left, depth + 1, stats);
+  GatherStats(*n.right, depth + 1, stats);
+}
 
-  size_t idxMin = index.size();
-  int minComp = -1;
-  for (int c = 0; c < 3; ++c) {
-    size_t test = std::max(indexNeg[c].size(), indexPos[c].size());
-    if (test < idxMin && test < index.size() * 3 / 4) {
-      minComp = c;
-      idxMin = test;
+/* Separating axis test between a world-space box and a node's stored OBB (rows of the box-to-world
+ * transform, as COBBox::ReadBig loads them) */
+template <typename Node>
+static bool NodeIntersectsBox(const Node& n, const zeus::CVector3f& center, const zeus::CVector3f& he) {
+  constexpr float Epsilon = 1e-6f;
+  float R[3][3];
+  float absR[3][3];
+  float t[3];
+  float e[3];
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      R[i][j] = n.xf[i].simd[j];
+      absR[i][j] = std::abs(R[i][j]) + Epsilon;
     }
+    t[i] = n.xf[i].simd[3] - center[i];
+    e[i] = n.halfExtent.simd[i];
   }
-
-  if (minComp == -1) {
-    MakeLeaf(mesh, index, *n);
-    return n;
+  const float a[3] = {he.x(), he.y(), he.z()};
+
+  for (int i = 0; i < 3; ++i)
+    if (std::abs(t[i]) > a[i] + e[0] * absR[i][0] + e[1] * absR[i][1] + e[2] * absR[i][2])
+      return false;
+  for (int j = 0; j < 3; ++j) {
+    const float tj = t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j];
+    if (std::abs(tj) > a[0] * absR[0][j] + a[1] * absR[1][j] + a[2] * absR[2][j] + e[j])
+      return false;
   }
+  for (int i = 0; i < 3; ++i) {
+    const int i1 = (i + 1) % 3;
+    const int i2 = (i + 2) % 3;
+    for (int j = 0; j < 3; ++j) {
+      const int j1 = (j + 1) % 3;
+      const int j2 = (j + 2) % 3;
+      const float ra = a[i1] * absR[i2][j] + a[i2] * absR[i1][j];
+      const float rb = e[j1] * absR[i][j2] + e[j2] * absR[i][j1];
+      if (std::abs(t[i2] * R[i1][j] - t[i1] * R[i2][j]) > ra + rb)
+        return false;
+    }
+  }
+  return true;
+}
 
-  n->left = RecursiveMakeNode<Node>(mesh, indexNeg[minComp]);
-  n->right = RecursiveMakeNode<Node>(mesh, indexPos[minComp]);
+/* Mirrors CCollidableOBBTree's box queries: every tested node counts as a visit, children are only
+ * visited when their parent's OBB overlaps the query, and leaves test all their triangles */
+template <typename Node>
+static void QueryBox(const Node& n, const zeus::CVector3f& center, const zeus::CVector3f& he, TreeStats& stats) {
+  ++stats.nodeVisits;
+  if (!NodeIntersectsBox(n, center, he))
+    return;
+  if (n.isLeaf) {
+    stats.triangleTests += n.leafData->triangleIndices.size();
+    return;
+  }
+  QueryBox(*n.left, center, he, stats);
+  QueryBox(*n.right, center, he, stats);
+}
 
-  return n;
+/* Runs player-sized box queries on a lattice spanning the mesh bounds */
+template <typename Node>
+static void MeasureQueries(const Node& root, const std::vector<Triangle>& tris, TreeStats& stats) {
+  constexpr int Lattice = 8;
+  const zeus::CVector3f queryHe{0.7f, 0.7f, 1.35f};
+  zeus::CVector3f min{FLT_MAX, FLT_MAX, FLT_MAX};
+  zeus::CVector3f max{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+  for (const Triangle& tri : tris) {
+    for (const zeus::CVector3f& v : tri.verts) {
+      min = zeus::CVector3f{std::min(min.x(), v.x()), std::min(min.y(), v.y()), std::min(min.z(), v.z())};
+      max = zeus::CVector3f{std::max(max.x(), v.x()), std::max(max.y(), v.y()), std::max(max.z(), v.z())};
+    }
+  }
+  const zeus::CVector3f step = (max - min) / float(Lattice);
+  for (int x = 0; x < Lattice; ++x) {
+    for (int y = 0; y < Lattice; ++y) {
+      for (int z = 0; z < Lattice; ++z) {
+        const zeus::CVector3f center = min + step * zeus::CVector3f{x + 0.5f, y + 0.5f, z + 0.5f};
+        QueryBox(root, center, queryHe, stats);
+        ++stats.queries;
+      }
+    }
+  }
 }
 
 template <typename Node>
 std::unique_ptr<Node> OBBTreeBuilder::buildCol(const ColMesh& mesh) {
-  std::vector<int> root = MakeRootTriangleIndex(mesh);
-  return RecursiveMakeNode<Node>(mesh, root);
+  std::unique_ptr<Node> ret;
+  const std::vector<Triangle> tris = MakeTriangles(mesh);
+  {
+    hecl::CookMetricTimer timer("OBB tree ms");
+    std::vector<int> root = MakeRootTriangleIndex(tris);
+    ret = RecursiveMakeNode<Node>(tris, root, 0);
+  }
+
+  if (hecl::VerbosityLevel >= 2 || hecl::CookMetricsEnabled()) {
+    TreeStats stats;
+    GatherStats(*ret, 0, stats);
+    MeasureQueries(*ret, tris, stats);
+    const double visitsPerQuery = double(stats.nodeVisits) / double(stats.queries);
+    const double testsPerQuery = double(stats.triangleTests) / double(stats.queries);
+    hecl::AddCookMetric("OBB node visits per query", visitsPerQuery);
+    hecl::AddCookMetric("OBB triangle tests per query", testsPerQuery);
+    if (hecl::VerbosityLevel >= 2)
+      Log.report(logvisor::Info,
+                 FMT_STRING("OBB tree: {} triangles, {} nodes, depth {}, {:.1f} triangles per leaf, "
+                            "{:.1f} node visits and {:.1f} triangle tests per query over {} box queries"),
+                 tris.size(), stats.nodes, stats.maxDepth,
+                 stats.leaves ? double(stats.leafTriangles) / double(stats.leaves) : 0.0, visitsPerQuery,
+                 testsPerQuery, stats.queries);
+  }
+  return ret;
 }
 
 template std::unique_ptr<DNAMP1::DCLN::Collision::Node>
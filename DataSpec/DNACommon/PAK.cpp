@@ -1,9 +1,17 @@
 #include "DataSpec/DNACommon/PAK.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <vector>
+
 #include "DataSpec/DNAMP1/DNAMP1.hpp"
 #include "DataSpec/DNAMP2/DNAMP2.hpp"
 #include "DataSpec/DNAMP3/DNAMP3.hpp"
 
+#include <hecl/ParallelFor.hpp>
+
 namespace DataSpec {
 
 template <class PAKBRIDGE>
@@ -435,54 +443,96 @@ template <class BRIDGETYPE>
 bool PAKRouter<BRIDGETYPE>::extractResources(const BRIDGETYPE& pakBridge, bool force, hecl::blender::Token& btok,
                                              std::function<void(const char*, float)> progress) {
   enterPAKBridge(pakBridge);
-  size_t count = 0;
-  size_t sz = m_pak->m_entries.size();
-  float fsz = sz;
-  for (unsigned w = 0; count < sz; ++w) {
-    for (const auto& item : m_pak->m_firstEntries) {
-      const auto* entryPtr = m_pak->lookupEntry(item);
-      ResExtractor<BRIDGETYPE> extractor = BRIDGETYPE::LookupExtractor(*m_node.get(), *m_pak.get(), *entryPtr);
-      if (extractor.weight != w)
-        continue;
-
-      std::string bestName = getBestEntryName(*entryPtr, false);
-      float thisFac = ++count / fsz;
-      progress(bestName.c_str(), thisFac);
-
-      const nod::Node* node = m_node.get();
-
-      hecl::ProjectPath working = getWorking(entryPtr, extractor);
-      working.makeDirChain(false);
-      hecl::ResourceLock resLk(working);
-      if (!resLk)
-        continue;
-
-      /* Extract to unmodified directory */
-      hecl::ProjectPath cooked = working.getCookedPath(m_dataSpec.getUnmodifiedSpec());
-      if (force || cooked.isNone()) {
-        cooked.makeDirChain(false);
-        PAKEntryReadStream s = entryPtr->beginReadStream(*node);
-        const auto fout = hecl::FopenUnique(cooked.getAbsolutePath().data(), "wb");
-        std::fwrite(s.data(), 1, s.length(), fout.get());
-      }
+  const auto startTime = std::chrono::steady_clock::now();
+  const nod::Node* node = m_node.get();
+  SpecBase* curSpec = g_curSpec.get();
+
+  /* Entries of one weight may depend on the output of lower weights, but not on each other */
+  using ExtractJob = std::pair<const EntryType*, ResExtractor<BRIDGETYPE>>;
+  std::map<unsigned, std::vector<ExtractJob>> jobsByWeight;
+  for (const auto& item : m_pak->m_firstEntries) {
+    const auto* entryPtr = m_pak->lookupEntry(item);
+    ResExtractor<BRIDGETYPE> extractor = BRIDGETYPE::LookupExtractor(*node, *m_pak.get(), *entryPtr);
+    const unsigned weight = extractor.weight;
+    jobsByWeight[weight].emplace_back(entryPtr, std::move(extractor));
+  }
 
-      if (extractor.func_a) /* Doesn't need PAKRouter access */
-      {
-        if (force || !extractor.IsFullyExtracted(working)) {
-          PAKEntryReadStream s = entryPtr->beginReadStream(*node);
-          extractor.func_a(s, working);
-        }
-      } else if (extractor.func_b) /* Needs PAKRouter access */
-      {
-        if (force || !extractor.IsFullyExtracted(working)) {
-          PAKEntryReadStream s = entryPtr->beginReadStream(*node);
-          extractor.func_b(m_dataSpec, s, working, *this, *entryPtr, force, btok,
-                           [&progress, thisFac](const char* update) { progress(update, thisFac); });
-        }
+  const float fsz = m_pak->m_entries.size();
+  std::atomic_size_t completed{0};
+  std::atomic_size_t extractedCount{0};
+  std::atomic<atUint64> readBytes{0};
+
+  const auto extractEntry = [&](const ExtractJob& job) {
+    const auto& [entryPtr, extractor] = job;
+    std::string bestName = getBestEntryName(*entryPtr, false);
+    const float thisFac = completed.load() / fsz;
+    progress(bestName.c_str(), thisFac);
+
+    hecl::ProjectPath working = getWorking(entryPtr, extractor);
+    working.makeDirChain(false);
+    hecl::ResourceLock resLk(working);
+    if (!resLk) {
+      ++completed;
+      return;
+    }
+
+    /* Extract to unmodified directory; the decompressed stream is reused by the extractor */
+    PAKEntryReadStream s;
+    hecl::ProjectPath cooked = working.getCookedPath(m_dataSpec.getUnmodifiedSpec());
+    if (force || cooked.isNone()) {
+      cooked.makeDirChain(false);
+      s = entryPtr->beginReadStream(*node);
+      readBytes += s.length();
+      const auto fout = hecl::FopenUnique(cooked.getAbsolutePath().data(), "wb");
+      std::fwrite(s.data(), 1, s.length(), fout.get());
+    }
+
+    if ((extractor.func_a || extractor.func_b) && (force || !extractor.IsFullyExtracted(working))) {
+      if (s) {
+        s.seek(0, athena::SeekOrigin::Begin);
+      } else {
+        s = entryPtr->beginReadStream(*node);
+        readBytes += s.length();
       }
+      if (extractor.func_a) /* Doesn't need PAKRouter access */
+        extractor.func_a(s, working);
+      else /* Needs PAKRouter access */
+        extractor.func_b(m_dataSpec, s, working, *this, *entryPtr, force, btok,
+                         [&progress, thisFac](const char* update) { progress(update, thisFac); });
+      ++extractedCount;
     }
+    ++completed;
+  };
+
+  for (const auto& [weight, jobs] : jobsByWeight) {
+    /* Extractors needing PAKRouter access may drive Blender, so they stay on this thread while the
+     * shared helper pool works through the self-contained ones. The pool is bounded process-wide, so
+     * concurrent PAK jobs on ClientProcess workers don't each spawn their own helpers. */
+    std::vector<const ExtractJob*> routerJobs;
+    std::vector<const ExtractJob*> freeJobs;
+    for (const ExtractJob& job : jobs)
+      (job.second.func_b ? routerJobs : freeJobs).push_back(&job);
+
+    hecl::ParallelForAlongside(
+        [&]() {
+          for (const ExtractJob* job : routerJobs)
+            extractEntry(*job);
+        },
+        freeJobs.size(),
+        [&](size_t i) {
+          /* Pool threads are shared with other PAK jobs; bind this router's thread state per entry */
+          enterPAKBridge(pakBridge);
+          g_curSpec.reset(curSpec);
+          extractEntry(*freeJobs[i]);
+        });
   }
 
+  const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+  const double mib = readBytes.load() / 1048576.0;
+  LogDNACommon.report(logvisor::Info,
+                      FMT_STRING("Extracted {} of {} entries from {}: {:.1f} MiB read in {:.2f} s ({:.1f} MiB/s)"),
+                      extractedCount.load(), completed.load(), pakBridge.getName(), mib, secs,
+                      secs > 0.0 ? mib / secs : 0.0);
   return true;
 }
 
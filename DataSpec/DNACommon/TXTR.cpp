@@ -1,16 +1,24 @@
 #include "DataSpec/DNACommon/TXTR.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 #include "DataSpec/DNACommon/PAK.hpp"
 
 #include <athena/FileWriter.hpp>
+#include <hecl/ParallelFor.hpp>
 #include <hecl/hecl.hpp>
 #include <logvisor/logvisor.hpp>
 #include <png.h>
 #include <squish.h>
 
+#if __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace DataSpec {
 
 static logvisor::Module Log("libpng");
@@ -25,6 +33,49 @@ static int CountBits(uint32_t n) {
   return ret;
 }
 
+/* Averages 2x2 texel quads from two input lines into one mip line */
+static void BoxFilterRow(const uint8_t* in1, const uint8_t* in2, unsigned chanCount, unsigned mipWidth, uint8_t* out,
+                         bool dxt1) {
+  unsigned x = 0;
+#if __SSE2__
+  if (chanCount == 4) {
+    /* Four RGBA output texels per step; 16-bit sums of four 8-bit texels cannot overflow */
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(int(0xff000000));
+    const auto sumPairs = [&](const uint8_t* line1, const uint8_t* line2) {
+      const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line1));
+      const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line2));
+      const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+      const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+      return _mm_unpacklo_epi64(_mm_add_epi16(lo, _mm_srli_si128(lo, 8)), _mm_add_epi16(hi, _mm_srli_si128(hi, 8)));
+    };
+    for (; x + 4 <= mipWidth; x += 4) {
+      const __m128i sum01 = sumPairs(in1 + x * 8, in2 + x * 8);
+      const __m128i sum23 = sumPairs(in1 + x * 8 + 16, in2 + x * 8 + 16);
+      __m128i texels = _mm_packus_epi16(_mm_srli_epi16(sum01, 2), _mm_srli_epi16(sum23, 2));
+      if (dxt1) {
+        const __m128i opaque = _mm_andnot_si128(_mm_cmpeq_epi8(texels, zero), alphaMask);
+        texels = _mm_or_si128(_mm_andnot_si128(alphaMask, texels), opaque);
+      }
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4), texels);
+    }
+  }
+#endif
+  for (; x < mipWidth; ++x) {
+    for (unsigned c = 0; c < chanCount; ++c) {
+      uint32_t tmp = 0;
+      tmp += in1[(x * 2) * chanCount + c];
+      tmp += in1[(x * 2 + 1) * chanCount + c];
+      tmp += in2[(x * 2) * chanCount + c];
+      tmp += in2[(x * 2 + 1) * chanCount + c];
+      out[x * chanCount + c] = uint8_t(tmp / 4);
+      if (c == 3 && dxt1) {
+        out[x * chanCount + c] = uint8_t(out[x * chanCount + c] ? 0xff : 0x0);
+      }
+    }
+  }
+}
+
 /* Box filter algorithm (for mipmapping) */
 static void BoxFilter(const uint8_t* input, unsigned chanCount, unsigned inWidth, unsigned inHeight, uint8_t* output,
                       bool dxt1) {
@@ -37,25 +88,15 @@ static void BoxFilter(const uint8_t* input, unsigned chanCount, unsigned inWidth
     mipHeight = inHeight / 2;
   }
 
-  for (unsigned y = 0; y < mipHeight; ++y) {
-    const unsigned miplineBase = mipWidth * y;
-    const unsigned in1LineBase = inWidth * (y * 2);
-    const unsigned in2LineBase = inWidth * (y * 2 + 1);
-    for (unsigned x = 0; x < mipWidth; ++x) {
-      uint8_t* out = &output[(miplineBase + x) * chanCount];
-      for (unsigned c = 0; c < chanCount; ++c) {
-        uint32_t tmp = 0;
-        tmp += input[(in1LineBase + (x * 2)) * chanCount + c];
-        tmp += input[(in1LineBase + (x * 2 + 1)) * chanCount + c];
-        tmp += input[(in2LineBase + (x * 2)) * chanCount + c];
-        tmp += input[(in2LineBase + (x * 2 + 1)) * chanCount + c];
-        out[c] = uint8_t(tmp / 4);
-        if (c == 3 && dxt1) {
-          out[c] = uint8_t(out[c] ? 0xff : 0x0);
-        }
-      }
+  constexpr unsigned BandHeight = 32;
+  const unsigned bandCount = (mipHeight + BandHeight - 1) / BandHeight;
+  hecl::ParallelFor(bandCount, [&](size_t i) {
+    const unsigned yEnd = std::min(mipHeight, unsigned(i + 1) * BandHeight);
+    for (unsigned y = unsigned(i) * BandHeight; y < yEnd; ++y) {
+      BoxFilterRow(&input[inWidth * (y * 2) * chanCount], &input[inWidth * (y * 2 + 1) * chanCount], chanCount,
+                   mipWidth, &output[mipWidth * y * chanCount], dxt1);
     }
-  }
+  });
 }
 
 static size_t ComputeMippedTexelCount(unsigned inWidth, unsigned inHeight) {
@@ -97,103 +138,92 @@ static constexpr uint8_t Convert6To8(uint8_t v) {
 
 static constexpr uint8_t Convert8To6(uint8_t v) { return v >> 2; }
 
-static uint8_t Lookup4BPP(const uint8_t* texels, int width, int x, int y) {
+/* GX textures are stored as rows of 32-byte tiles. These helpers locate the tile row once per texel row
+ * and walk across it, rather than recomputing the tile address for every texel. */
+static void Read4BPPRow(const uint8_t* texels, int width, int y, uint8_t* out) {
   const int bwidth = (width + 7) / 8;
-  const int bx = x / 8;
-  const int by = y / 8;
-  const int rx = x % 8;
-  const int ry = y % 8;
-  const int bidx = by * bwidth + bx;
-  const uint8_t* btexels = &texels[32 * bidx];
-  return btexels[ry * 4 + rx / 2] >> ((rx & 1) ? 0 : 4) & 0xf;
+  const uint8_t* tileRow = &texels[32 * bwidth * (y / 8) + (y % 8) * 4];
+  for (int x = 0; x < width; x += 8, tileRow += 32) {
+    const int count = std::min(8, width - x);
+    for (int rx = 0; rx < count; ++rx) {
+      out[x + rx] = tileRow[rx / 2] >> ((rx & 1) ? 0 : 4) & 0xf;
+    }
+  }
 }
 
-static void Set4BPP(uint8_t* texels, int width, int x, int y, uint8_t val) {
+static void Write4BPPRow(uint8_t* texels, int width, int y, const uint8_t* in) {
   const int bwidth = (width + 7) / 8;
-  const int bx = x / 8;
-  const int by = y / 8;
-  const int rx = x % 8;
-  const int ry = y % 8;
-  const int bidx = by * bwidth + bx;
-  uint8_t* btexels = &texels[32 * bidx];
-  btexels[ry * 4 + rx / 2] |= (val & 0xf) << ((rx & 1) ? 0 : 4);
+  uint8_t* tileRow = &texels[32 * bwidth * (y / 8) + (y % 8) * 4];
+  for (int x = 0; x < width; x += 8, tileRow += 32) {
+    const int count = std::min(8, width - x);
+    for (int rx = 0; rx < count; ++rx) {
+      tileRow[rx / 2] |= (in[x + rx] & 0xf) << ((rx & 1) ? 0 : 4);
+    }
+  }
 }
 
-static uint8_t Lookup8BPP(const uint8_t* texels, int width, int x, int y) {
-  int bwidth = (width + 7) / 8;
-  int bx = x / 8;
-  int by = y / 4;
-  int rx = x % 8;
-  int ry = y % 4;
-  int bidx = by * bwidth + bx;
-  const uint8_t* btexels = &texels[32 * bidx];
-  return btexels[ry * 8 + rx];
+static void Read8BPPRow(const uint8_t* texels, int width, int y, uint8_t* out) {
+  const int bwidth = (width + 7) / 8;
+  const uint8_t* tileRow = &texels[32 * bwidth * (y / 4) + (y % 4) * 8];
+  for (int x = 0; x < width; x += 8, tileRow += 32) {
+    std::memcpy(&out[x], tileRow, std::min(8, width - x));
+  }
 }
 
-static void Set8BPP(uint8_t* texels, int width, int x, int y, uint8_t val) {
+static void Write8BPPRow(uint8_t* texels, int width, int y, const uint8_t* in) {
   const int bwidth = (width + 7) / 8;
-  const int bx = x / 8;
-  const int by = y / 4;
-  const int rx = x % 8;
-  const int ry = y % 4;
-  const int bidx = by * bwidth + bx;
-  uint8_t* btexels = &texels[32 * bidx];
-  btexels[ry * 8 + rx] = val;
+  uint8_t* tileRow = &texels[32 * bwidth * (y / 4) + (y % 4) * 8];
+  for (int x = 0; x < width; x += 8, tileRow += 32) {
+    std::memcpy(tileRow, &in[x], std::min(8, width - x));
+  }
 }
 
-static uint16_t Lookup16BPP(const uint8_t* texels, int width, int x, int y) {
+/* 16-bit texels are copied as stored (big-endian) */
+static void Read16BPPRow(const uint8_t* texels, int width, int y, uint16_t* out) {
   const int bwidth = (width + 3) / 4;
-  const int bx = x / 4;
-  const int by = y / 4;
-  const int rx = x % 4;
-  const int ry = y % 4;
-  int bidx = by * bwidth + bx;
-  const uint16_t* btexels = reinterpret_cast<const uint16_t*>(&texels[32 * bidx]);
-  return btexels[ry * 4 + rx];
+  const uint8_t* tileRow = &texels[32 * bwidth * (y / 4) + (y % 4) * 8];
+  for (int x = 0; x < width; x += 4, tileRow += 32) {
+    std::memcpy(&out[x], tileRow, std::min(4, width - x) * 2);
+  }
 }
 
-static void Set16BPP(uint8_t* texels, int width, int x, int y, uint16_t val) {
+static void Write16BPPRow(uint8_t* texels, int width, int y, const uint16_t* in) {
   const int bwidth = (width + 3) / 4;
-  const int bx = x / 4;
-  const int by = y / 4;
-  const int rx = x % 4;
-  const int ry = y % 4;
-  const int bidx = by * bwidth + bx;
-  auto* btexels = reinterpret_cast<uint16_t*>(&texels[32 * bidx]);
-  btexels[ry * 4 + rx] = val;
+  uint8_t* tileRow = &texels[32 * bwidth * (y / 4) + (y % 4) * 8];
+  for (int x = 0; x < width; x += 4, tileRow += 32) {
+    std::memcpy(tileRow, &in[x], std::min(4, width - x) * 2);
+  }
 }
 
-static void LookupRGBA8(const uint8_t* texels, int width, int x, int y, uint8_t* r, uint8_t* g, uint8_t* b,
-                        uint8_t* a) {
+/* RGBA8 tiles come in pairs: 16 big-endian AR texels followed by 16 GB texels */
+static void ReadRGBA8Row(const uint8_t* texels, int width, int y, uint8_t* out) {
   const int bwidth = (width + 3) / 4;
-  const int bx = x / 4;
-  const int by = y / 4;
-  const int rx = x % 4;
-  const int ry = y % 4;
-  const int bidx = (by * bwidth + bx) * 2;
-  const auto* artexels = reinterpret_cast<const uint16_t*>(&texels[32 * bidx]);
-  const auto* gbtexels = reinterpret_cast<const uint16_t*>(&texels[32 * (bidx + 1)]);
-  const uint16_t ar = hecl::SBig(artexels[ry * 4 + rx]);
-  *a = ar >> 8 & 0xff;
-  *r = ar & 0xff;
-  const uint16_t gb = hecl::SBig(gbtexels[ry * 4 + rx]);
-  *g = gb >> 8 & 0xff;
-  *b = gb & 0xff;
+  const uint8_t* tileRow = &texels[64 * bwidth * (y / 4) + (y % 4) * 8];
+  for (int x = 0; x < width; x += 4, tileRow += 64) {
+    const int count = std::min(4, width - x);
+    uint8_t* px = &out[x * 4];
+    for (int rx = 0; rx < count; ++rx, px += 4) {
+      px[0] = tileRow[rx * 2 + 1];
+      px[1] = tileRow[32 + rx * 2];
+      px[2] = tileRow[32 + rx * 2 + 1];
+      px[3] = tileRow[rx * 2];
+    }
+  }
 }
 
-static void SetRGBA8(uint8_t* texels, int width, int x, int y, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+static void WriteRGBA8Row(uint8_t* texels, int width, int y, const uint8_t* in) {
   const int bwidth = (width + 3) / 4;
-  const int bx = x / 4;
-  const int by = y / 4;
-  const int rx = x % 4;
-  const int ry = y % 4;
-  const int bidx = (by * bwidth + bx) * 2;
-  uint16_t* artexels = reinterpret_cast<uint16_t*>(&texels[32 * bidx]);
-  uint16_t* gbtexels = reinterpret_cast<uint16_t*>(&texels[32 * (bidx + 1)]);
-  const uint16_t ar = (a << 8) | r;
-  artexels[ry * 4 + rx] = hecl::SBig(ar);
-  const uint16_t gb = (g << 8) | b;
-  gbtexels[ry * 4 + rx] = hecl::SBig(gb);
+  uint8_t* tileRow = &texels[64 * bwidth * (y / 4) + (y % 4) * 8];
+  for (int x = 0; x < width; x += 4, tileRow += 64) {
+    const int count = std::min(4, width - x);
+    const uint8_t* px = &in[x * 4];
+    for (int rx = 0; rx < count; ++rx, px += 4) {
+      tileRow[rx * 2] = px[3];
+      tileRow[rx * 2 + 1] = px[0];
+      tileRow[32 + rx * 2] = px[1];
+      tileRow[32 + rx * 2 + 1] = px[2];
+    }
+  }
 }
 
 static void DecodeI4(png_structp png, png_infop info, const uint8_t* texels, int width, int height) {
@@ -203,8 +233,9 @@ static void DecodeI4(png_structp png, png_infop info, const uint8_t* texels, int
   std::unique_ptr<uint8_t[]> buf(new uint8_t[width]);
   // memset(buf.get(), 0, width);
   for (int y = height - 1; y >= 0; --y) {
+    Read4BPPRow(texels, width, y, buf.get());
     for (int x = 0; x < width; ++x) {
-      buf[x] = Convert4To8(Lookup4BPP(texels, width, x, y));
+      buf[x] = Convert4To8(buf[x]);
     }
     png_write_row(png, buf.get());
   }
@@ -228,18 +259,14 @@ static void DecodeI8(png_structp png, png_infop info, const uint8_t* texels, int
   png_write_info(png, info);
   std::unique_ptr<uint8_t[]> buf(new uint8_t[width]);
   for (int y = height - 1; y >= 0; --y) {
-    for (int x = 0; x < width; ++x) {
-      buf[x] = Lookup8BPP(texels, width, x, y);
-    }
+    Read8BPPRow(texels, width, y, buf.get());
     png_write_row(png, buf.get());
   }
 }
 
 static void EncodeI8(const uint8_t* rgbaIn, uint8_t* texels, int width, int height) {
   for (int y = height - 1; y >= 0; --y) {
-    for (int x = 0; x < width; ++x) {
-      Set8BPP(texels, width, x, y, rgbaIn[x]);
-    }
+    Write8BPPRow(texels, width, y, rgbaIn);
     rgbaIn += width;
   }
 }
@@ -248,10 +275,12 @@ static void DecodeIA4(png_structp png, png_infop info, const uint8_t* texels, in
   png_set_IHDR(png, info, width, height, 8, PNG_COLOR_TYPE_GRAY_ALPHA, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
                PNG_FILTER_TYPE_DEFAULT);
   png_write_info(png, info);
+  std::unique_ptr<uint8_t[]> row(new uint8_t[width]);
   std::unique_ptr<uint8_t[]> buf(new uint8_t[width * 2]);
   for (int y = height - 1; y >= 0; --y) {
+    Read8BPPRow(texels, width, y, row.get());
     for (int x = 0; x < width; ++x) {
-      const uint8_t texel = Lookup8BPP(texels, width, x, y);
+      const uint8_t texel = row[x];
       buf[x * 2] = Convert4To8(texel & 0xf);
       buf[x * 2 + 1] = Convert4To8(texel >> 4 & 0xf);
     }
@@ -281,18 +310,21 @@ static void DecodeIA8(png_structp png, png_infop info, const uint8_t* texels, in
   png_write_info(png, info);
   std::unique_ptr<uint16_t[]> buf(new uint16_t[width]);
   for (int y = height - 1; y >= 0; --y) {
+    Read16BPPRow(texels, width, y, buf.get());
     for (int x = 0; x < width; ++x) {
-      buf[x] = hecl::SBig(Lookup16BPP(texels, width, x, y));
+      buf[x] = hecl::SBig(buf[x]);
     }
     png_write_row(png, reinterpret_cast<png_bytep>(buf.get()));
   }
 }
 
 static void EncodeIA8(const uint8_t* rgbaIn, uint8_t* texels, int width, int height) {
+  std::unique_ptr<uint16_t[]> buf(new uint16_t[width]);
   for (int y = height - 1; y >= 0; --y) {
     for (int x = 0; x < width; ++x) {
-      Set16BPP(texels, width, x, y, hecl::SBig(reinterpret_cast<const uint16_t*>(rgbaIn)[x]));
+      buf[x] = hecl::SBig(reinterpret_cast<const uint16_t*>(rgbaIn)[x]);
     }
+    Write16BPPRow(texels, width, y, buf.get());
     rgbaIn += width * 2;
   }
 }
@@ -612,9 +644,7 @@ static void DecodeC4(png_structp png, png_infop info, const uint8_t* data, int w
   png_write_info(png, info);
   std::unique_ptr<uint8_t[]> buf(new uint8_t[width]);
   for (int y = 0; y < height; ++y) {
-    for (int x = 0; x < width; ++x) {
-      buf[x] = Lookup4BPP(texels, width, x, y);
-    }
+    Read4BPPRow(texels, width, y, buf.get());
     png_write_row(png, buf.get());
   }
 }
@@ -622,9 +652,7 @@ static void DecodeC4(png_structp png, png_infop info, const uint8_t* data, int w
 static void EncodeC4(png_structp png, png_infop info, const uint8_t* rgbaIn, uint8_t* data, int width, int height) {
   uint8_t* texels = EncodePaletteSPLT(png, info, 16, data);
   for (int y = 0; y < height; ++y) {
-    for (int x = 0; x < width; ++x) {
-      Set4BPP(texels, width, x, y, rgbaIn[x]);
-    }
+    Write4BPPRow(texels, width, y, rgbaIn);
     rgbaIn += width;
   }
 }
@@ -636,9 +664,7 @@ static void DecodeC8(png_structp png, png_infop info, const uint8_t* data, int w
   png_write_info(png, info);
   std::unique_ptr<uint8_t[]> buf(new uint8_t[width]);
   for (int y = 0; y < height; ++y) {
-    for (int x = 0; x < width; ++x) {
-      buf[x] = Lookup8BPP(texels, width, x, y);
-    }
+    Read8BPPRow(texels, width, y, buf.get());
     png_write_row(png, buf.get());
   }
 }
@@ -646,9 +672,7 @@ static void DecodeC8(png_structp png, png_infop info, const uint8_t* data, int w
 static void EncodeC8(png_structp png, png_infop info, const uint8_t* rgbaIn, uint8_t* data, int width, int height) {
   uint8_t* texels = EncodePalette(png, info, 256, data);
   for (int y = 0; y < height; ++y) {
-    for (int x = 0; x < width; ++x) {
-      Set8BPP(texels, width, x, y, rgbaIn[x]);
-    }
+    Write8BPPRow(texels, width, y, rgbaIn);
     rgbaIn += width;
   }
 }
@@ -657,10 +681,12 @@ static void DecodeRGB565(png_structp png, png_infop info, const uint8_t* texels,
   png_set_IHDR(png, info, width, height, 8, PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
                PNG_FILTER_TYPE_DEFAULT);
   png_write_info(png, info);
+  std::unique_ptr<uint16_t[]> row(new uint16_t[width]);
   std::unique_ptr<uint8_t[]> buf(new uint8_t[width * 3]);
   for (int y = height - 1; y >= 0; --y) {
+    Read16BPPRow(texels, width, y, row.get());
     for (int x = 0; x < width; ++x) {
-      const uint16_t texel = hecl::SBig(Lookup16BPP(texels, width, x, y));
+      const uint16_t texel = hecl::SBig(row[x]);
       buf[x * 3] = Convert5To8(texel >> 11 & 0x1f);
       buf[x * 3 + 1] = Convert6To8(texel >> 5 & 0x3f);
       buf[x * 3 + 2] = Convert5To8(texel & 0x1f);
@@ -690,10 +716,12 @@ static void DecodeRGB5A3(png_structp png, png_infop info, const uint8_t* texels,
   png_set_IHDR(png, info, width, height, 8, PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
                PNG_FILTER_TYPE_DEFAULT);
   png_write_info(png, info);
+  std::unique_ptr<uint16_t[]> row(new uint16_t[width]);
   std::unique_ptr<uint8_t[]> buf(new uint8_t[width * 4]);
   for (int y = height - 1; y >= 0; --y) {
+    Read16BPPRow(texels, width, y, row.get());
     for (int x = 0; x < width; ++x) {
-      const uint16_t texel = hecl::SBig(Lookup16BPP(texels, width, x, y));
+      const uint16_t texel = hecl::SBig(row[x]);
       if (texel & 0x8000) {
         buf[x * 4] = Convert5To8(texel >> 10 & 0x1f);
         buf[x * 4 + 1] = Convert5To8(texel >> 5 & 0x1f);
@@ -745,18 +773,14 @@ static void DecodeRGBA8(png_structp png, png_infop info, const uint8_t* texels,
   png_write_info(png, info);
   std::unique_ptr<uint8_t[]> buf(new uint8_t[width * 4]);
   for (int y = height - 1; y >= 0; --y) {
-    for (int x = 0; x < width; ++x) {
-      LookupRGBA8(texels, width, x, y, &buf[x * 4], &buf[x * 4 + 1], &buf[x * 4 + 2], &buf[x * 4 + 3]);
-    }
+    ReadRGBA8Row(texels, width, y, buf.get());
     png_write_row(png, buf.get());
   }
 }
 
 static void EncodeRGBA8(const uint8_t* rgbaIn, uint8_t* texels, int width, int height) {
   for (int y = height - 1; y >= 0; --y) {
-    for (int x = 0; x < width; ++x) {
-      SetRGBA8(texels, width, x, y, rgbaIn[x * 4], rgbaIn[x * 4 + 1], rgbaIn[x * 4 + 2], rgbaIn[x * 4 + 3]);
-    }
+    WriteRGBA8Row(texels, width, y, rgbaIn);
     rgbaIn += width * 4;
   }
 }
@@ -798,34 +822,67 @@ static void DecodeCMPR(png_structp png, png_infop info, const uint8_t* texels, i
   }
 }
 
-static void EncodeCMPR(const uint8_t* rgbaIn, uint8_t* texels, int width, int height) {
-  /* Encode 8 rows at a time */
-  const int bwidth = (width + 7) / 8;
-  const int bpwidth = bwidth * 8;
-  std::unique_ptr<uint32_t[]> buf(new uint32_t[bpwidth * 8]);
-  uint32_t* bTargets[4] = {buf.get(), buf.get() + 4, buf.get() + 4 * width, buf.get() + 4 * width + 4};
-  for (int y = height / 8 - 1; y >= 0; --y) {
-    for (int r = 7; r >= 0; --r) {
-      std::memcpy(bTargets[0] + width * r, rgbaIn, width * 4);
-      rgbaIn += width * 4;
-    }
-    auto* blks = reinterpret_cast<DXTBlock*>(texels + 32 * bwidth * y);
-    for (int x = 0; x < width; x += 8) {
-      uint32_t blkIn[4][4][4];
-      for (int bt = 0; bt < 4; ++bt) {
-        for (int by = 0; by < 4; ++by) {
-          std::memcpy(blkIn[bt][by], bTargets[bt] + x + width * by, 16);
-        }
+/* Encodes one 8-row strip of bottom-up RGBA rows into a row of CMPR tiles */
+static void EncodeCMPRStrip(const uint8_t* stripIn, DXTBlock* blks, int width) {
+  const auto* rows = reinterpret_cast<const uint32_t*>(stripIn);
+  for (int x = 0; x < width; x += 8) {
+    uint32_t blkIn[4][4][4];
+    for (int bt = 0; bt < 4; ++bt) {
+      for (int by = 0; by < 4; ++by) {
+        const int row = (bt / 2) * 4 + by;
+        std::memcpy(blkIn[bt][by], rows + width * (7 - row) + x + (bt % 2) * 4, 16);
       }
-
-      squish::Compress(reinterpret_cast<uint8_t*>(blkIn[0][0]), blks++, squish::kDxt1GCN);
-      squish::Compress(reinterpret_cast<uint8_t*>(blkIn[1][0]), blks++, squish::kDxt1GCN);
-      squish::Compress(reinterpret_cast<uint8_t*>(blkIn[2][0]), blks++, squish::kDxt1GCN);
-      squish::Compress(reinterpret_cast<uint8_t*>(blkIn[3][0]), blks++, squish::kDxt1GCN);
     }
+
+    squish::Compress(reinterpret_cast<uint8_t*>(blkIn[0][0]), blks++, squish::kDxt1GCN);
+    squish::Compress(reinterpret_cast<uint8_t*>(blkIn[1][0]), blks++, squish::kDxt1GCN);
+    squish::Compress(reinterpret_cast<uint8_t*>(blkIn[2][0]), blks++, squish::kDxt1GCN);
+    squish::Compress(reinterpret_cast<uint8_t*>(blkIn[3][0]), blks++, squish::kDxt1GCN);
   }
 }
 
+/* Independent slice of one mip level; all levels are queued before compressing so small mips
+ * share the helper pool with the large ones instead of each forking on their own */
+struct TexelBand {
+  const uint8_t* rgbaIn;
+  uint8_t* blocksOut;
+  int width;
+  int height;
+};
+
+static void AppendCMPRStrips(std::vector<TexelBand>& strips, const uint8_t* rgbaIn, uint8_t* texels, int width,
+                             int height) {
+  /* Input rows are bottom-up, so the first input strip is the last tile row */
+  const int bwidth = (width + 7) / 8;
+  const int stripCount = height / 8;
+  for (int i = 0; i < stripCount; ++i) {
+    const int y = stripCount - 1 - i;
+    strips.push_back({rgbaIn + size_t(i) * 8 * width * 4, texels + 32 * bwidth * y, width, 8});
+  }
+}
+
+static void EncodeCMPRStrips(const std::vector<TexelBand>& strips) {
+  hecl::ParallelFor(strips.size(), [&](size_t i) {
+    EncodeCMPRStrip(strips[i].rgbaIn, reinterpret_cast<DXTBlock*>(strips[i].blocksOut), strips[i].width);
+  });
+}
+
+/* DXT blocks are stored row-major, so 16-row bands compress into contiguous ranges of the output */
+static void AppendDXTBands(std::vector<TexelBand>& bands, const uint8_t* rgbaIn, uint8_t* blocksOut, int width,
+                           int height, int flags) {
+  constexpr int BandHeight = 16;
+  const size_t bandLen = squish::GetStorageRequirements(width, BandHeight, flags);
+  for (int y = 0; y < height; y += BandHeight, blocksOut += bandLen) {
+    bands.push_back({rgbaIn + size_t(y) * width * 4, blocksOut, width, std::min(BandHeight, height - y)});
+  }
+}
+
+static void CompressDXTBands(const std::vector<TexelBand>& bands, int flags) {
+  hecl::ParallelFor(bands.size(), [&](size_t i) {
+    squish::CompressImage(bands[i].rgbaIn, bands[i].width, bands[i].height, bands[i].blocksOut, flags);
+  });
+}
+
 static void PNGErr(png_structp png, png_const_charp msg) { Log.report(logvisor::Error, FMT_STRING("{}"), msg); }
 
 static void PNGWarn(png_structp png, png_const_charp msg) { Log.report(logvisor::Warning, FMT_STRING("{}"), msg); }
@@ -1283,14 +1340,16 @@ bool TXTR::Cook(const hecl::ProjectPath& inPath, const hecl::ProjectPath& outPat
     const uint8_t* rgbaIn = bufOut.get();
     uint8_t* blocksOut = compOut.get();
     std::memset(blocksOut, 0, compLen);
+    std::vector<TexelBand> strips;
     for (size_t i = 0; i < numMips; ++i) {
       const int thisLen = squish::GetStorageRequirements(filterWidth, filterHeight, squish::kDxt1);
-      EncodeCMPR(rgbaIn, blocksOut, filterWidth, filterHeight);
+      AppendCMPRStrips(strips, rgbaIn, blocksOut, filterWidth, filterHeight);
       rgbaIn += filterWidth * filterHeight * nComps;
       blocksOut += thisLen;
       filterWidth /= 2;
       filterHeight /= 2;
     }
+    EncodeCMPRStrips(strips);
 
     format = 10;
   } else {
@@ -1582,14 +1641,16 @@ bool TXTR::CookPC(const hecl::ProjectPath& inPath, const hecl::ProjectPath& outP
     filterHeight = height;
     const uint8_t* rgbaIn = bufOut.get();
     uint8_t* blocksOut = compOut.get();
+    std::vector<TexelBand> bands;
     for (i = 0; i < numMips; ++i) {
       const int thisLen = squish::GetStorageRequirements(filterWidth, filterHeight, compFlags);
-      squish::CompressImage(rgbaIn, filterWidth, filterHeight, blocksOut, compFlags);
+      AppendDXTBands(bands, rgbaIn, blocksOut, filterWidth, filterHeight, compFlags);
       rgbaIn += filterWidth * filterHeight * nComps;
       blocksOut += thisLen;
       filterWidth /= 2;
       filterHeight /= 2;
     }
+    CompressDXTBands(bands, compFlags);
   }
 
   /* Do write out */
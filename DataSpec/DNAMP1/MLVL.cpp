@@ -8,6 +8,7 @@
 #include "Runtime/RetroTypes.hpp"
 #include "Runtime/World/ScriptObjectSupport.hpp"
 #include "hecl/Blender/Connection.hpp"
+#include "hecl/CookDatabase.hpp"
 
 namespace DataSpec {
 extern hecl::Database::DataSpecEntry SpecEntMP1;
@@ -109,6 +110,8 @@ bool MLVL::Cook(const hecl::ProjectPath& outPath, const hecl::ProjectPath& inPat
 
   const hecl::ProjectPath parentPath = inPath.getParentPath();
   const hecl::DirectoryEnumerator dEnum(parentPath.getAbsolutePath());
+  /* Area directories and the !name/!savw/!mapw files are discovered by listing */
+  hecl::Database::CookDatabase::RecordDirectoryListing(parentPath);
 
   mlvl.magic = 0xDEAFBABE;
   mlvl.version = 0x11;
@@ -133,6 +136,7 @@ bool MLVL::Cook(const hecl::ProjectPath& outPath, const hecl::ProjectPath& inPat
       continue;
 
     const hecl::DirectoryEnumerator areaDEnum(area.path.getAbsolutePath());
+    hecl::Database::CookDatabase::RecordDirectoryListing(area.path);
     const hecl::ProjectPath areaPath = GetPathBeginsWith(areaDEnum, area.path, "!area");
     if (!areaPath.isFile())
       continue;
@@ -144,6 +148,7 @@ bool MLVL::Cook(const hecl::ProjectPath& outPath, const hecl::ProjectPath& inPat
     std::vector<atUint32> memRelays;
 
     if (memRelayPath.isFile()) {
+      hecl::Database::CookDatabase::RecordDependency(memRelayPath);
       athena::io::FileReader fr(memRelayPath.getAbsolutePath());
       athena::io::YAMLDocReader r;
       if (r.parse(&fr))
@@ -167,12 +172,14 @@ bool MLVL::Cook(const hecl::ProjectPath& outPath, const hecl::ProjectPath& inPat
       else
         layerName = hecl::StringUtils::TrimWhitespace(std::string(endCh));
 
+      hecl::Database::CookDatabase::RecordDirectoryListing(hecl::ProjectPath(area.path, e.m_name));
       hecl::ProjectPath objectsPath(area.path, e.m_name + "/!objects.yaml");
       if (objectsPath.isNone())
         continue;
 
       SCLY::ScriptLayer layer;
       {
+        hecl::Database::CookDatabase::RecordDependency(objectsPath);
         athena::io::FileReader freader(objectsPath.getAbsolutePath());
         if (!freader.isOpen())
           continue;
@@ -431,6 +438,7 @@ bool MLVL::CookSAVW(const hecl::ProjectPath& outPath, const World& wld) {
     if (area.path.getPathType() != hecl::ProjectPath::Type::Directory)
       continue;
 
+    hecl::Database::CookDatabase::RecordDirectoryListing(area.path);
     hecl::ProjectPath areaPath = GetPathBeginsWith(area.path, "!area");
     if (!areaPath.isFile())
       continue;
@@ -438,6 +446,7 @@ bool MLVL::CookSAVW(const hecl::ProjectPath& outPath, const World& wld) {
     hecl::ProjectPath memRelayPath(area.path, "/!memoryrelays.yaml");
     std::vector<atUint32> memRelays;
     if (memRelayPath.isFile()) {
+      hecl::Database::CookDatabase::RecordDependency(memRelayPath);
       athena::io::FileReader fr(memRelayPath.getAbsolutePath());
       athena::io::YAMLDocReader r;
       if (r.parse(&fr))
@@ -447,12 +456,14 @@ bool MLVL::CookSAVW(const hecl::ProjectPath& outPath, const World& wld) {
 
     for (const hecl::DirectoryEnumerator::Entry& e :
          hecl::DirectoryEnumerator(area.path.getAbsolutePath(), hecl::DirectoryEnumerator::Mode::DirsSorted)) {
+      hecl::Database::CookDatabase::RecordDirectoryListing(hecl::ProjectPath(area.path, e.m_name));
       hecl::ProjectPath objectsPath(area.path, e.m_name + "/!objects.yaml");
       if (objectsPath.isNone())
         continue;
 
       SCLY::ScriptLayer layer;
       {
+        hecl::Database::CookDatabase::RecordDependency(objectsPath);
         athena::io::FileReader freader(objectsPath.getAbsolutePath());
         if (!freader.isOpen())
           continue;
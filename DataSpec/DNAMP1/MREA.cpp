@@ -1,4 +1,5 @@
 #include "hecl/ClientProcess.hpp"
+#include "hecl/CookDatabase.hpp"
 #include "athena/MemoryReader.hpp"
 #include "MREA.hpp"
 #include "SCLY.hpp"
@@ -383,9 +384,12 @@ bool MREA::Cook(const hecl::ProjectPath& outPath, const hecl::ProjectPath& inPat
   hecl::ProjectPath areaDirPath = inPath.getParentPath();
   std::vector<hecl::ProjectPath> layerScriptPaths;
   {
+    /* Adding, removing or renaming a layer directory changes the layer set */
+    hecl::Database::CookDatabase::RecordDirectoryListing(areaDirPath);
     hecl::DirectoryEnumerator dEnum(inPath.getParentPath().getAbsolutePath(),
                                     hecl::DirectoryEnumerator::Mode::DirsSorted, false, false, true);
     for (const hecl::DirectoryEnumerator::Entry& ent : dEnum) {
+      hecl::Database::CookDatabase::RecordDirectoryListing(hecl::ProjectPath(areaDirPath, ent.m_name));
       hecl::ProjectPath layerScriptPath(areaDirPath, ent.m_name + "/!objects.yaml");
       if (layerScriptPath.isFile())
         layerScriptPaths.push_back(std::move(layerScriptPath));
@@ -502,6 +506,7 @@ bool MREA::Cook(const hecl::ProjectPath& outPath, const hecl::ProjectPath& inPat
     sclyData.fourCC = FOURCC('SCLY');
     sclyData.version = 1;
     for (const hecl::ProjectPath& layer : layerScriptPaths) {
+      hecl::Database::CookDatabase::RecordDependency(layer);
       athena::io::FileReader freader(layer.getAbsolutePath());
       if (!freader.isOpen())
         continue;
@@ -606,6 +611,7 @@ bool MREA::Cook(const hecl::ProjectPath& outPath, const hecl::ProjectPath& inPat
   hecl::ProjectPath visiMetadataPath(areaDirPath, "!visi.yaml");
   bool visiGood = false;
   if (visiMetadataPath.isFile()) {
+    hecl::Database::CookDatabase::RecordDependency(visiMetadataPath);
     athena::io::FileReader visiReader(visiMetadataPath.getAbsolutePath());
     athena::io::YAMLDocReader r;
     if (r.parse(&visiReader)) {
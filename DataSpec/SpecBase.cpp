@@ -6,6 +6,7 @@
 #include "DataSpec/SpecBase.hpp"
 #include "DataSpec/Blender/BlenderSupport.hpp"
 #include "DataSpec/DNACommon/DNACommon.hpp"
+#include "DataSpec/DNACommon/PAK.hpp"
 #include "DataSpec/DNACommon/TXTR.hpp"
 #include "DataSpec/AssetNameMap.hpp"
 #include "DataSpec/DNACommon/MetaforceVersionInfo.hpp"
@@ -18,6 +19,11 @@
 
 #include <png.h>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+
 #define DUMP_CACHE_FILL 1
 
 namespace DataSpec {
@@ -206,7 +212,7 @@ const hecl::Database::DataSpecEntry* SpecBase::overrideDataSpec(const hecl::Proj
   return &getOriginalSpec();
 }
 
-void SpecBase::doCook(const hecl::ProjectPath& path, const hecl::ProjectPath& cookedPath, bool fast,
+bool SpecBase::doCook(const hecl::ProjectPath& path, const hecl::ProjectPath& cookedPath, bool fast,
                       hecl::blender::Token& btok, FCookProgress progress) {
   cookedPath.makeDirChain(false);
   DataSpec::g_curSpec.reset(this);
@@ -220,7 +226,7 @@ void SpecBase::doCook(const hecl::ProjectPath& path, const hecl::ProjectPath& co
   if (hecl::IsPathBlend(asBlend)) {
     hecl::blender::Connection& conn = btok.getBlenderConnection();
     if (!conn.openBlend(asBlend))
-      return;
+      return false;
     switch (conn.getBlendType()) {
     case hecl::blender::BlendType::Mesh: {
       hecl::blender::DataStream ds = conn.beginData();
@@ -273,13 +279,12 @@ void SpecBase::doCook(const hecl::ProjectPath& path, const hecl::ProjectPath& co
       break;
     }
     default:
-      break;
+      return false;
     }
   } else if (hecl::IsPathPNG(path)) {
     if (m_pc)
-      TXTR::CookPC(path, cookedPath);
-    else
-      TXTR::Cook(path, cookedPath);
+      return TXTR::CookPC(path, cookedPath);
+    return TXTR::Cook(path, cookedPath);
   } else if (hecl::IsPathYAML(path)) {
     athena::io::FileReader reader(path.getAbsolutePath());
     cookYAML(cookedPath, path, reader, btok, progress);
@@ -287,7 +292,10 @@ void SpecBase::doCook(const hecl::ProjectPath& path, const hecl::ProjectPath& co
     cookAudioGroup(cookedPath, path, progress);
   } else if (IsPathSong(path)) {
     cookSong(cookedPath, path, progress);
+  } else {
+    return false;
   }
+  return true;
 }
 
 void SpecBase::flattenDependenciesBlend(const hecl::ProjectPath& in, std::vector<hecl::ProjectPath>& pathsOut,
@@ -668,6 +676,88 @@ void SpecBase::doPackage(const hecl::ProjectPath& path, const hecl::Database::Da
 
 void SpecBase::interruptCook() { cancelBackgroundIndex(); }
 
+static std::string_view GXTexFmtName(uint32_t format) {
+  static constexpr std::array<std::string_view, 11> Names{"I4",     "I8",     "IA4",   "IA8",   "C4",  "C8",
+                                                          "C14X2",  "RGB565", "RGB5A3", "RGBA8", "CMPR"};
+  return format < Names.size() ? Names[format] : std::string_view{"unknown"};
+}
+
+static void GatherWorkingTextures(const hecl::ProjectPath& dir, std::vector<hecl::ProjectPath>& out) {
+  for (const hecl::DirectoryEnumerator::Entry& ent :
+       hecl::DirectoryEnumerator(dir.getAbsolutePath(), hecl::DirectoryEnumerator::Mode::DirsThenFilesSorted)) {
+    /* Hidden directories hold the project database and cooked output */
+    if (ent.m_name.empty() || ent.m_name[0] == '.')
+      continue;
+    hecl::ProjectPath path(dir, ent.m_name);
+    if (ent.m_isDir)
+      GatherWorkingTextures(path, out);
+    else if (hecl::IsPathPNG(path))
+      out.push_back(std::move(path));
+  }
+}
+
+bool SpecBase::benchmarkTextures(const hecl::ProjectPath& root, int iterations, std::vector<TextureBenchmark>& out) {
+  std::vector<hecl::ProjectPath> textures;
+  if (root.getPathType() == hecl::ProjectPath::Type::Directory)
+    GatherWorkingTextures(root, textures);
+  else if (hecl::IsPathPNG(root))
+    textures.push_back(root);
+
+  iterations = std::max(1, iterations);
+  for (const hecl::ProjectPath& texture : textures) {
+    if (!checkPathPrefix(texture))
+      continue;
+
+    /* Always the GX encoder; PC formats have no decoder to round-trip through */
+    const hecl::ProjectPath cooked = texture.getCookedPath(*getDataSpecEntry()).getWithExtension(".bench", true);
+    const hecl::ProjectPath decoded = cooked.getWithExtension(".bench.png", true);
+    cooked.makeDirChain(false);
+
+    double encodeMs = 0.0;
+    bool encoded = true;
+    for (int i = 0; i < iterations && encoded; ++i) {
+      const auto start = std::chrono::steady_clock::now();
+      encoded = TXTR::Cook(texture, cooked);
+      encodeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    if (!encoded) {
+      Log.report(logvisor::Warning, FMT_STRING("unable to encode '{}'"), texture.getRelativePath());
+      hecl::Unlink(cooked.getAbsolutePath().data());
+      continue;
+    }
+
+    athena::io::FileReader reader(cooked.getAbsolutePath());
+    const atUint64 size = reader.length();
+    std::unique_ptr<atUint8[]> data = reader.readUBytes(size);
+    reader.close();
+    hecl::Unlink(cooked.getAbsolutePath().data());
+    if (size < 12)
+      continue;
+    const uint32_t format = hecl::SBig(*reinterpret_cast<const uint32_t*>(data.get()));
+
+    double decodeMs = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+      std::unique_ptr<atUint8[]> copy(new atUint8[size]);
+      std::memcpy(copy.get(), data.get(), size);
+      PAKEntryReadStream rs(std::move(copy), size, 0);
+      const auto start = std::chrono::steady_clock::now();
+      TXTR::Extract(rs, decoded);
+      decodeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    hecl::Unlink(decoded.getAbsolutePath().data());
+
+    const std::string_view name = GXTexFmtName(format);
+    auto it = std::find_if(out.begin(), out.end(), [&](const TextureBenchmark& b) { return b.format == name; });
+    if (it == out.end())
+      it = out.insert(out.end(), TextureBenchmark{std::string(name)});
+    ++it->textures;
+    it->nativeBytes += size;
+    it->encodeMs += encodeMs / iterations;
+    it->decodeMs += decodeMs / iterations;
+  }
+  return true;
+}
+
 std::optional<hecl::blender::World> SpecBase::compileWorldFromDir(const hecl::ProjectPath& dir,
                                                                   hecl::blender::Token& btok) const {
   hecl::ProjectPath asBlend;
@@ -37,7 +37,7 @@ struct SpecBase : hecl::Database::IDataSpec {
   bool canCook(const hecl::ProjectPath& path, hecl::blender::Token& btok) override;
   const hecl::Database::DataSpecEntry* overrideDataSpec(const hecl::ProjectPath& path,
                                                         const hecl::Database::DataSpecEntry* oldEntry) const override;
-  void doCook(const hecl::ProjectPath& path, const hecl::ProjectPath& cookedPath, bool fast, hecl::blender::Token& btok,
+  bool doCook(const hecl::ProjectPath& path, const hecl::ProjectPath& cookedPath, bool fast, hecl::blender::Token& btok,
               FCookProgress progress) override;
 
   bool canPackage(const hecl::ProjectPath& path) override;
@@ -47,6 +47,8 @@ struct SpecBase : hecl::Database::IDataSpec {
 
   void interruptCook() override;
 
+  bool benchmarkTextures(const hecl::ProjectPath& root, int iterations, std::vector<TextureBenchmark>& out) override;
+
   /* Extract handlers */
   virtual bool checkStandaloneID(const char* id) const = 0;
   virtual bool checkFromStandaloneDisc(nod::DiscBase& disc, const std::string& regstr,
@@ -48,6 +48,7 @@
 #include "DNAMP1/MazeSeeds.hpp"
 #include "DNAMP1/SnowForces.hpp"
 #include "hecl/ClientProcess.hpp"
+#include "hecl/CookDatabase.hpp"
 #include "hecl/MultiProgressPrinter.hpp"
 #include "hecl/Blender/Connection.hpp"
 #include "hecl/Blender/SDNARead.hpp"
@@ -139,6 +140,7 @@ struct SpecMP1 : SpecBase {
   std::unique_ptr<uint8_t[]> m_dolBuf;
 
   std::unordered_map<hecl::Hash, hecl::blender::Matrix4f> m_mreaPathToXF;
+  std::unordered_map<hecl::Hash, hecl::ProjectPath> m_mreaPathToWorld;
 
   SpecMP1(const hecl::Database::DataSpecEntry* specEntry, hecl::Database::Project& project, bool pc)
   : SpecBase(specEntry, project, pc)
@@ -713,8 +715,10 @@ struct SpecMP1 : SpecBase {
                     continue;
                   hecl::blender::DataStream ds = conn.beginData();
                   hecl::blender::World world = ds.compileWorld();
-                  for (const auto& area : world.areas)
+                  for (const auto& area : world.areas) {
                     m_mreaPathToXF[area.path.hash()] = area.transform;
+                    m_mreaPathToWorld[area.path.hash()] = wldPath;
+                  }
                 }
                 break;
               }
@@ -756,8 +760,11 @@ struct SpecMP1 : SpecBase {
 
     const hecl::blender::Matrix4f* xf = nullptr;
     auto xfSearch = m_mreaPathToXF.find(in.getParentPath().hash());
-    if (xfSearch != m_mreaPathToXF.cend())
+    if (xfSearch != m_mreaPathToXF.cend()) {
       xf = &xfSearch->second;
+      /* The transform is cached across areas; attribute it to its world for incremental cooks */
+      hecl::Database::CookDatabase::RecordDependency(m_mreaPathToWorld[xfSearch->first]);
+    }
     DNAMP1::MREA::Cook(out, in, meshCompiles, *colMesh, lights, btok, xf, m_pc);
   }
 
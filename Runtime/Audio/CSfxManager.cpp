@@ -2,7 +2,33 @@
 
 #include "Runtime/CSimplePool.hpp"
 
+#include <algorithm>
+
+#include <fmt/format.h>
+
 namespace metaforce {
+namespace {
+/* Voices kept by the ranked stealing pass; lower ranked voices are stopped or never started */
+constexpr size_t MaxActiveVoices = 48;
+
+/* Bits of CBaseSfxWrapper::m_queuedCommands */
+constexpr u8 VoiceCmdVectors = 0x1;
+constexpr u8 VoiceCmdPitch = 0x2;
+constexpr u8 VoiceCmdVolume = 0x4;
+constexpr u8 VoiceCmdSpan = 0x8;
+
+struct SSfxStats {
+  u64 m_submitted = 0;
+  u64 m_culled = 0;
+  u64 m_stolen = 0;
+  u64 m_played = 0;
+  u64 m_commands = 0;
+  u64 m_coalesced = 0;
+  u64 m_flushes = 0;
+};
+SSfxStats s_SfxStats;
+} // Anonymous namespace
+
 static TLockedToken<std::vector<u16>> mpSfxTranslationTableTok;
 std::vector<u16>* CSfxManager::mpSfxTranslationTable = nullptr;
 
@@ -36,6 +62,7 @@ float CSfxManager::m_reverbAmount = 1.f;
 CSfxManager::EAuxEffect CSfxManager::m_activeEffect = CSfxManager::EAuxEffect::None;
 CSfxManager::EAuxEffect CSfxManager::m_nextEffect = CSfxManager::EAuxEffect::None;
 amuse::ObjToken<amuse::Listener> CSfxManager::m_listener;
+std::vector<CSfxHandle> CSfxManager::m_queuedVoices;
 
 u16 CSfxManager::kMaxPriority;
 u16 CSfxManager::kMedPriority;
@@ -289,6 +316,52 @@ s16 CSfxManager::GetRank(CBaseSfxWrapper* sfx) {
   return rank;
 }
 
+void CSfxManager::QueueVoiceCommand(const CSfxHandle& handle, u8 command) {
+  ++s_SfxStats.m_commands;
+  if (handle->m_queuedCommands == 0)
+    m_queuedVoices.push_back(handle);
+  else if ((handle->m_queuedCommands & command) != 0)
+    ++s_SfxStats.m_coalesced;
+  handle->m_queuedCommands |= command;
+}
+
+void CSfxManager::FlushVoiceCommands() {
+  if (m_queuedVoices.empty())
+    return;
+  ++s_SfxStats.m_flushes;
+  for (const CSfxHandle& handle : m_queuedVoices) {
+    const u8 commands = handle->m_queuedCommands;
+    handle->m_queuedCommands = 0;
+    if (!handle->IsPlaying())
+      continue;
+
+    if (handle->IsEmitter()) {
+      CSfxEmitterWrapper& emitter = static_cast<CSfxEmitterWrapper&>(*handle);
+      const amuse::ObjToken<amuse::Emitter> h = emitter.GetHandle();
+      if (!h)
+        continue;
+      if ((commands & VoiceCmdVectors) != 0) {
+        const CAudioSys::C3DEmitterParmData& data = emitter.GetEmitterData();
+        zeus::simd_floats p(data.x0_pos.mSimd);
+        zeus::simd_floats d(data.xc_dir.mSimd);
+        h->setVectors(p.data(), d.data());
+        h->setMaxVol(data.x26_maxVol);
+      }
+    }
+
+    const amuse::ObjToken<amuse::Voice> voice = handle->GetVoice();
+    if (!voice)
+      continue;
+    if ((commands & VoiceCmdPitch) != 0)
+      voice->setPitchWheel(handle->m_queuedPitch);
+    if ((commands & VoiceCmdVolume) != 0)
+      voice->setVolume(handle->m_queuedVolume);
+    if ((commands & VoiceCmdSpan) != 0)
+      voice->setSurroundPan(handle->m_queuedSpan);
+  }
+  m_queuedVoices.clear();
+}
+
 void CSfxManager::ApplyReverb() {
   const CSfxChannel& chanObj = m_channels[size_t(m_currentChannel)];
   for (const CSfxHandle& handle : chanObj.x48_handles) {
@@ -305,7 +378,8 @@ void CSfxManager::PitchBend(const CSfxHandle& handle, float pitch) {
     CSfxManager::Update(0.f);
   if (handle->IsPlaying()) {
     m_doUpdate = true;
-    handle->GetVoice()->setPitchWheel(pitch);
+    handle->m_queuedPitch = pitch;
+    QueueVoiceCommand(handle, VoiceCmdPitch);
   }
 }
 
@@ -316,15 +390,19 @@ void CSfxManager::SfxVolume(const CSfxHandle& handle, float vol) {
     CSfxWrapper& wrapper = static_cast<CSfxWrapper&>(*handle);
     wrapper.SetVolume(vol);
   }
-  if (handle->IsPlaying())
-    handle->GetVoice()->setVolume(vol);
+  if (handle->IsPlaying()) {
+    handle->m_queuedVolume = vol;
+    QueueVoiceCommand(handle, VoiceCmdVolume);
+  }
 }
 
 void CSfxManager::SfxSpan(const CSfxHandle& handle, float span) {
   if (!handle)
     return;
-  if (handle->IsPlaying())
-    handle->GetVoice()->setSurroundPan(span);
+  if (handle->IsPlaying()) {
+    handle->m_queuedSpan = span;
+    QueueVoiceCommand(handle, VoiceCmdSpan);
+  }
 }
 
 u16 CSfxManager::TranslateSFXID(u16 id) {
@@ -361,6 +439,7 @@ CSfxHandle CSfxManager::SfxStart(u16 id, float vol, float pan, bool useAcoustics
     return {};
 
   m_doUpdate = true;
+  ++s_SfxStats.m_submitted;
   CSfxHandle wrapper = std::make_shared<CSfxWrapper>(looped, prio, id, vol, pan, useAcoustics, areaId);
   CSfxChannel& chanObj = m_channels[size_t(m_currentChannel)];
   chanObj.x48_handles.insert(wrapper);
@@ -384,11 +463,7 @@ void CSfxManager::UpdateEmitter(const CSfxHandle& handle, const zeus::CVector3f&
   emitter.GetEmitterData().x0_pos = pos;
   emitter.GetEmitterData().xc_dir = dir;
   emitter.GetEmitterData().x26_maxVol = maxVol;
-  amuse::Emitter& h = *emitter.GetHandle();
-  zeus::simd_floats p(pos.mSimd);
-  zeus::simd_floats d(dir.mSimd);
-  h.setVectors(p.data(), d.data());
-  h.setMaxVol(maxVol);
+  QueueVoiceCommand(handle, VoiceCmdVectors);
 }
 
 CSfxHandle CSfxManager::AddEmitter(u16 id, const zeus::CVector3f& pos, const zeus::CVector3f& dir, bool useAcoustics,
@@ -434,6 +509,7 @@ CSfxHandle CSfxManager::AddEmitter(const CAudioSys::C3DEmitterParmData& parmData
   if (looped)
     data.x20_flags |= 0x6; // Pausable/restartable when inaudible
   m_doUpdate = true;
+  ++s_SfxStats.m_submitted;
   CSfxHandle wrapper = std::make_shared<CSfxEmitterWrapper>(looped, prio, data, useAcoustics, areaId);
   CSfxChannel& chanObj = m_channels[size_t(m_currentChannel)];
   chanObj.x48_handles.insert(wrapper);
@@ -592,37 +668,52 @@ void CSfxManager::Update(float dt) {
     }
 
     std::sort(rankedSfx.begin(), rankedSfx.end(),
-              [](const CSfxHandle& a, const CSfxHandle& b) -> bool { return a->GetRank() < b->GetRank(); });
-
-    for (size_t i = 48; i < rankedSfx.size(); ++i) {
-      const CSfxHandle& handle = rankedSfx[i];
-      if (handle->IsPlaying()) {
-        handle->Stop();
-        handle->Close();
-        chanObj.x48_handles.erase(handle);
-      }
-    }
+              [](const CSfxHandle& a, const CSfxHandle& b) -> bool { return a->GetRank() > b->GetRank(); });
 
+    /* Highest ranked first: voices past the budget are stolen, and one-shot emitters out of earshot never start.
+     * Looped emitters are left to amuse, which pauses them while inaudible. */
+    size_t activeVoices = 0;
     for (const CSfxHandle& handle : rankedSfx) {
-      if (handle->IsPlaying() && !handle->IsInArea()) {
-        handle->Stop();
-        handle->Close();
-        chanObj.x48_handles.erase(handle);
+      if (!handle->IsInArea()) {
+        if (handle->IsPlaying()) {
+          handle->Stop();
+          handle->Close();
+          chanObj.x48_handles.erase(handle);
+        }
+        continue;
+      }
+      if (activeVoices >= MaxActiveVoices) {
+        if (handle->IsPlaying()) {
+          ++s_SfxStats.m_stolen;
+          handle->Stop();
+          handle->Close();
+          chanObj.x48_handles.erase(handle);
+        }
+        continue;
+      }
+      if (handle->IsPlaying()) {
+        ++activeVoices;
+        continue;
       }
-    }
-
 #ifndef URDE_MSAN
-    for (const CSfxHandle& handle : chanObj.x48_handles) {
-      if (handle->IsPlaying())
+      if (!handle->Ready())
         continue;
-      if (handle->Ready() && handle->IsInArea())
-        handle->Play();
-    }
+      if (handle->IsEmitter() && !handle->IsLooped() && chanObj.x44_listenerActive &&
+          handle->GetAudible(chanObj.x0_pos) == ESfxAudibility::Aud0) {
+        ++s_SfxStats.m_culled;
+        continue;
+      }
+      handle->Play();
+      ++s_SfxStats.m_played;
+      ++activeVoices;
 #endif
+    }
 
     m_doUpdate = false;
   }
 
+  FlushVoiceCommands();
+
   for (auto it = chanObj.x48_handles.begin(); it != chanObj.x48_handles.end();) {
     const CSfxHandle& handle = *it;
     if (!handle->IsPlaying() && !handle->IsLooped()) {
@@ -656,7 +747,18 @@ void CSfxManager::Shutdown() {
   mpSfxTranslationTable = nullptr;
   mpSfxTranslationTableTok = TLockedToken<std::vector<u16>>{};
   StopAndRemoveAllEmitters();
+  m_queuedVoices.clear();
   DisableAuxCallback();
 }
 
+std::string CSfxManager::Summarize() {
+  const CSfxChannel& chanObj = m_channels[size_t(m_currentChannel)];
+  return fmt::format(FMT_STRING("{} sounds submitted, {} played, {} culled as inaudible, {} stolen, {} in channel\n"
+                                "Voice commands: {} queued, {} coalesced, {} flushes"),
+                     s_SfxStats.m_submitted, s_SfxStats.m_played, s_SfxStats.m_culled, s_SfxStats.m_stolen,
+                     chanObj.x48_handles.size(), s_SfxStats.m_commands, s_SfxStats.m_coalesced, s_SfxStats.m_flushes);
+}
+
+void CSfxManager::ResetStats() { s_SfxStats = {}; }
+
 } // namespace metaforce
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <memory>
+#include <string>
 #include <unordered_set>
 #include <vector>
 
@@ -55,6 +56,7 @@ public:
   };
 
   class CBaseSfxWrapper : public std::enable_shared_from_this<CBaseSfxWrapper> {
+    friend class CSfxManager;
     float x4_timeRemaining = 15.f;
     s16 x8_rank = 0;
     s16 xa_prio;
@@ -71,6 +73,13 @@ public:
     bool m_isEmitter : 1 = false;
     bool m_isClosed : 1 = false;
 
+  private:
+    /* Voice parameters set this frame, applied by FlushVoiceCommands; later calls replace earlier ones */
+    u8 m_queuedCommands = 0;
+    float m_queuedPitch = 0.f;
+    float m_queuedVolume = 0.f;
+    float m_queuedSpan = 0.f;
+
   public:
     virtual ~CBaseSfxWrapper() = default;
     virtual void SetActive(bool v) { x14_24_isActive = v; }
@@ -179,6 +188,7 @@ public:
   static EAuxEffect m_activeEffect;
   static EAuxEffect m_nextEffect;
   static amuse::ObjToken<amuse::Listener> m_listener;
+  static std::vector<CSfxHandle> m_queuedVoices;
 
   static u16 kMaxPriority;
   static u16 kMedPriority;
@@ -201,6 +211,8 @@ public:
   static bool PlaySound(const CSfxHandle& handle);
   static void StopSound(const CSfxHandle& handle);
   static s16 GetRank(CBaseSfxWrapper* sfx);
+  static void QueueVoiceCommand(const CSfxHandle& handle, u8 command);
+  static void FlushVoiceCommands();
   static void ApplyReverb();
   static float GetReverbAmount();
   static void PitchBend(const CSfxHandle& handle, float pitch);
@@ -232,6 +244,10 @@ public:
 
   static void Update(float dt);
   static void Shutdown();
+
+  /* Emitters submitted, culled as inaudible, stolen and played, and voice commands batched since the last reset */
+  static std::string Summarize();
+  static void ResetStats();
 };
 
 using CSfxHandle = CSfxManager::CSfxHandle;
@@ -3,15 +3,24 @@
 #include "Runtime/Audio/CAudioSys.hpp"
 #include "Runtime/CDvdFile.hpp"
 #include "Runtime/CDvdRequest.hpp"
+#include "Runtime/CProfiler.hpp"
 #include "Runtime/CStringExtras.hpp"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include <amuse/DSPCodec.hpp>
+#include <fmt/format.h>
+#include <logvisor/logvisor.hpp>
+#include <optick.h>
 
 namespace metaforce {
 class CDSPStreamManager;
@@ -19,6 +28,40 @@ class CDSPStreamManager;
 static u32 s_HandleCounter = 0;
 static u32 s_HandleCounter2 = 0;
 
+namespace {
+/* Decoded PCM kept ahead of each voice, as a multiple of the largest request its callback has made */
+constexpr u32 PCMRingSamples = 0x4000;
+constexpr u32 MinReadAheadSamples = 2048;
+constexpr u32 ReadAheadCallbacks = 4;
+constexpr auto DecodeInterval = std::chrono::milliseconds(2);
+
+/* Callback durations in power-of-two microsecond buckets starting below 16us */
+constexpr size_t CallbackBuckets = 10;
+
+struct SStreamStats {
+  std::atomic<u64> m_callbacks{0};
+  std::atomic<u64> m_xruns{0};
+  std::atomic<u64> m_maxCallbackUs{0};
+  std::array<std::atomic<u64>, CallbackBuckets> m_callbackHist{};
+  std::atomic<u64> m_decodedSamples{0};
+  std::atomic<u64> m_decodeUs{0};
+
+  void AddCallback(std::chrono::steady_clock::duration dur) {
+    const u64 us = u64(std::chrono::duration_cast<std::chrono::microseconds>(dur).count());
+    size_t bucket = 0;
+    while (bucket + 1 < CallbackBuckets && us >= (u64(16) << bucket)) {
+      ++bucket;
+    }
+    m_callbackHist[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_callbacks.fetch_add(1, std::memory_order_relaxed);
+    u64 prevMax = m_maxCallbackUs.load(std::memory_order_relaxed);
+    while (us > prevMax && !m_maxCallbackUs.compare_exchange_weak(prevMax, us, std::memory_order_relaxed)) {
+    }
+  }
+};
+SStreamStats s_StreamStats;
+} // Anonymous namespace
+
 /* Standard DSPADPCM header */
 struct dspadpcm_header {
   u32 x0_num_samples;
@@ -54,8 +97,12 @@ struct SDSPStreamInfo {
   explicit SDSPStreamInfo(const CDSPStreamManager& stream);
 };
 
+/* File reads and ADPCM decoding run on a shared decode thread that keeps each stream's PCM ring topped up;
+ * the voice callback only copies out of the ring. State touched by both the game and decode threads is
+ * guarded by m_decodeLock, while the ring itself is single-producer single-consumer. Every allocation or
+ * stop bumps m_requestGen so the callback never plays samples left over from a previous stream. */
 struct SDSPStream : boo::IAudioVoiceCallback {
-  bool x0_active;
+  std::atomic_bool x0_active{false};
   bool x1_oneshot;
   s32 x4_ownerId;
   SDSPStream* x8_stereoLeft;
@@ -71,12 +118,31 @@ struct SDSPStream : boo::IAudioVoiceCallback {
   u32 xd8_ringBytes = 0x11DC0;   // 73152 4sec in ADPCM bytes
   u32 xdc_ringSamples = 0x1f410; // 128016 4sec in samples
   s8 xe0_curBuffer = -1;
-  bool xe8_silent = true;
+  std::atomic_bool xe8_silent{true};
   u8 xec_readState = 0; // 0: NoRead 1: Read 2: ReadWrap
 
   std::optional<CDvdFile> m_file;
   std::array<std::shared_ptr<IDvdRequest>, 2> m_readReqs;
 
+  std::mutex m_decodeLock;
+  u32 m_decodeGen = 0;
+  u32 m_publishedGen = 0;
+  std::atomic<u32> m_requestGen{0};
+  /* Generation in the high word, ring index of its first sample in the low word */
+  std::atomic<u64> m_pcmEpoch{0};
+  std::atomic<u32> m_pcmWrite{0};
+  std::atomic<u32> m_pcmRead{0};
+  std::atomic_bool m_pcmEnded{false};
+  std::atomic<u32> m_maxRequest{0};
+  u32 m_consumedGen = 0;
+  bool m_pcmStarted = false;
+  std::array<s16, PCMRingSamples> m_pcmRing{};
+
+  static std::thread g_DecodeThread;
+  static std::mutex g_DecodeMutex;
+  static std::condition_variable g_DecodeCV;
+  static std::atomic_bool g_DecodeRun;
+
   void ReadBuffer(int buf) {
     u32 halfSize = xd8_ringBytes / 2;
     u8* data = xd4_ringBuffer.get() + (buf ? halfSize : 0);
@@ -180,61 +246,185 @@ struct SDSPStream : boo::IAudioVoiceCallback {
     return m_curSample - startSamp;
   }
 
-  size_t supplyAudio(boo::IAudioVoice&, size_t frames, int16_t* data) override {
-    if (!x0_active) {
-      memset(data, 0, frames * 2);
-      return frames;
+  /* Decodes up to frames samples, stopping early while the next ADPCM half is still being read */
+  size_t decodeSamples(int16_t* data, size_t frames) {
+    const unsigned halfRingSamples = xdc_ringSamples / 2;
+    if (!x10_info.x10_loopFlag) {
+      const size_t fileSamples = size_t(x10_info.xc_adpcmBytes) * 14 / 8;
+      frames = std::min(frames, fileSamples - std::min(size_t(m_totalSamples), fileSamples));
     }
 
-    if (xe8_silent) {
-      StopStream();
-      memset(data, 0, frames * 2);
-      return frames;
+    size_t decoded = 0;
+    while (decoded < frames) {
+      if (m_curSample >= xdc_ringSamples) {
+        if (!BufferStream()) {
+          break;
+        }
+        m_curSample = 0;
+      } else if (xec_readState != 2 || (xe0_curBuffer == 0 && m_curSample >= halfRingSamples)) {
+        if (!BufferStream()) {
+          break;
+        }
+      }
+
+      const unsigned readToSample = std::min(m_curSample + unsigned(frames - decoded),
+                                             (m_curSample / halfRingSamples + 1) * halfRingSamples);
+      int16_t* out = data + decoded;
+      decoded += decompressChunk(readToSample, out);
     }
 
-    unsigned halfRingSamples = xdc_ringSamples / 2;
+    m_totalSamples += decoded;
+    return decoded;
+  }
 
-    size_t remFrames = frames;
-    while (remFrames) {
-      if (xec_readState != 2 || (xe0_curBuffer == 0 && m_curSample >= halfRingSamples)) {
-        if (!BufferStream()) {
-          memset(data, 0, remFrames * 2);
-          return frames;
-        }
+  void ReleaseFile() {
+    for (auto& request : m_readReqs) {
+      if (request) {
+        request->PostCancelRequest();
+        request.reset();
       }
+    }
+    m_file = std::nullopt;
+  }
 
-      unsigned readToSample =
-          std::min(m_curSample + unsigned(remFrames), (m_curSample / halfRingSamples + 1) * halfRingSamples);
-
-      if (!x10_info.x10_loopFlag) {
-        m_totalSamples += remFrames;
-        size_t fileSamples = x10_info.xc_adpcmBytes * 14 / 8;
-        if (m_totalSamples >= fileSamples) {
-          size_t leftover = m_totalSamples - fileSamples;
-          readToSample -= leftover;
-          remFrames -= leftover;
-          memset(data + remFrames, 0, leftover * 2);
-          StopStream();
-        }
+  /* Decode thread: top up the PCM ring to the read-ahead target */
+  void DecodeAhead() {
+    std::unique_lock lk{m_decodeLock};
+    if (!x0_active || xe8_silent || m_decodeGen != m_requestGen.load()) {
+      if (m_file) {
+        ReleaseFile();
       }
+      return;
+    }
+    if (!m_file) {
+      return;
+    }
 
-      unsigned leftoverSamples = 0;
-      if (readToSample > xdc_ringSamples) {
-        leftoverSamples = readToSample - xdc_ringSamples;
-        readToSample = xdc_ringSamples;
+    u32 write = m_pcmWrite.load(std::memory_order_relaxed);
+    if (m_publishedGen != m_decodeGen) {
+      m_publishedGen = m_decodeGen;
+      m_pcmEnded.store(false, std::memory_order_relaxed);
+      m_pcmEpoch.store(u64(m_decodeGen) << 32 | write, std::memory_order_release);
+    }
+    if (m_pcmEnded.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    /* Until the callback picks up the new generation its read index still points into the old one */
+    const u32 epochStart = u32(m_pcmEpoch.load(std::memory_order_relaxed));
+    u32 read = m_pcmRead.load(std::memory_order_acquire);
+    if (s32(read - epochStart) < 0) {
+      read = epochStart;
+    }
+    const u32 target =
+        std::clamp(m_maxRequest.load(std::memory_order_relaxed) * ReadAheadCallbacks, MinReadAheadSamples, PCMRingSamples);
+    const u32 queued = write - read;
+    if (queued >= target) {
+      return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    u32 want = target - queued;
+    u32 produced = 0;
+    while (want) {
+      const u32 pos = write & (PCMRingSamples - 1);
+      const u32 chunk = std::min(want, PCMRingSamples - pos);
+      const u32 got = u32(decodeSamples(m_pcmRing.data() + pos, chunk));
+      write += got;
+      want -= got;
+      produced += got;
+      m_pcmWrite.store(write, std::memory_order_release);
+      if (got < chunk) {
+        break;
       }
+    }
+
+    if (!x10_info.x10_loopFlag && m_totalSamples >= size_t(x10_info.xc_adpcmBytes) * 14 / 8) {
+      m_pcmEnded.store(true, std::memory_order_release);
+    }
+    s_StreamStats.m_decodedSamples.fetch_add(produced, std::memory_order_relaxed);
+    s_StreamStats.m_decodeUs.fetch_add(
+        u64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()),
+        std::memory_order_relaxed);
+  }
 
-      remFrames -= decompressChunk(readToSample, data);
+  /* Voice callback: copy whatever the decode thread has ready */
+  size_t consumeSamples(int16_t* data, size_t frames) {
+    if (frames > m_maxRequest.load(std::memory_order_relaxed)) {
+      m_maxRequest.store(u32(std::min(frames, size_t(PCMRingSamples))), std::memory_order_relaxed);
+    }
 
-      if (leftoverSamples) {
-        BufferStream();
-        m_curSample = 0;
-        remFrames -= decompressChunk(leftoverSamples, data);
+    const u32 gen = m_requestGen.load(std::memory_order_acquire);
+    const u64 epoch = m_pcmEpoch.load(std::memory_order_acquire);
+    if (u32(epoch >> 32) != gen) {
+      return 0;
+    }
+    if (m_consumedGen != gen) {
+      m_consumedGen = gen;
+      m_pcmRead.store(u32(epoch), std::memory_order_relaxed);
+      m_pcmStarted = false;
+    }
+
+    const bool ended = m_pcmEnded.load(std::memory_order_acquire);
+    const u32 read = m_pcmRead.load(std::memory_order_relaxed);
+    const u32 count = std::min(u32(frames), m_pcmWrite.load(std::memory_order_acquire) - read);
+    const u32 pos = read & (PCMRingSamples - 1);
+    const u32 first = std::min(count, PCMRingSamples - pos);
+    memcpy(data, m_pcmRing.data() + pos, first * 2);
+    memcpy(data + first, m_pcmRing.data(), (count - first) * 2);
+    m_pcmRead.store(read + count, std::memory_order_release);
+
+    if (count) {
+      m_pcmStarted = true;
+    }
+    if (count < frames) {
+      if (ended) {
+        StopStream();
+      } else if (m_pcmStarted) {
+        s_StreamStats.m_xruns.fetch_add(1, std::memory_order_relaxed);
       }
     }
+    return count;
+  }
 
+  size_t supplyAudio(boo::IAudioVoice&, size_t frames, int16_t* data) override {
+    CProfiler::CZone zone("SDSPStream::supplyAudio");
+    const auto start = std::chrono::steady_clock::now();
+    size_t copied = 0;
+    if (x0_active) {
+      if (xe8_silent) {
+        StopStream();
+      } else {
+        copied = consumeSamples(data, frames);
+      }
+    }
+    memset(data + copied, 0, (frames - copied) * 2);
+    s_StreamStats.AddCallback(std::chrono::steady_clock::now() - start);
     return frames;
   }
+
+  static void DecodeProc() {
+    logvisor::RegisterThreadName("AudioDecode");
+    OPTICK_THREAD("AudioDecode");
+    CProfiler::SetThreadName("AudioDecode");
+
+    std::unique_lock lk{g_DecodeMutex};
+    while (g_DecodeRun.load()) {
+      lk.unlock();
+      {
+        CProfiler::CZone zone("SDSPStream::DecodeAhead");
+        for (auto& stream : g_Streams) {
+          stream.DecodeAhead();
+        }
+      }
+      lk.lock();
+      if (!g_DecodeRun.load()) {
+        break;
+      }
+      g_DecodeCV.wait_for(lk, DecodeInterval);
+    }
+  }
+
   boo::ObjToken<boo::IAudioVoice> m_booVoice;
 
   void DoAllocateStream() {
@@ -256,20 +446,30 @@ struct SDSPStream : boo::IAudioVoiceCallback {
         stream.x1_oneshot = true;
       }
     }
+
+    if (!g_DecodeRun.load()) {
+      g_DecodeRun.store(true);
+      g_DecodeThread = std::thread(DecodeProc);
+    }
   }
 
   static void FreeAllStreams() {
+    if (g_DecodeRun.load()) {
+      std::unique_lock lk{g_DecodeMutex};
+      g_DecodeRun.store(false);
+      lk.unlock();
+      g_DecodeCV.notify_one();
+      if (g_DecodeThread.joinable()) {
+        g_DecodeThread.join();
+      }
+    }
+
     for (auto& stream : g_Streams) {
       stream.m_booVoice.reset();
       stream.x0_active = false;
-      for (auto& request : stream.m_readReqs) {
-        if (request) {
-          request->PostCancelRequest();
-          request.reset();
-        }
-      }
+      stream.m_requestGen.fetch_add(1);
+      stream.ReleaseFile();
       stream.xd4_ringBuffer.reset();
-      stream.m_file = std::nullopt;
     }
   }
 
@@ -278,6 +478,7 @@ struct SDSPStream : boo::IAudioVoiceCallback {
       if (stream.x0_active || stream.x1_oneshot != oneshot) {
         continue;
       }
+      stream.m_requestGen.fetch_add(1);
       stream.x0_active = true;
       stream.x4_ownerId = ++s_HandleCounter2;
       if (stream.x4_ownerId == -1) {
@@ -333,6 +534,7 @@ struct SDSPStream : boo::IAudioVoiceCallback {
     m_booVoice->setMonoChannelLevels(nullptr, coefs.data(), true);
     xe8_silent = true;
     x0_active = false;
+    m_requestGen.fetch_add(1);
   }
 
   static void Silence(s32 id) {
@@ -348,10 +550,11 @@ struct SDSPStream : boo::IAudioVoiceCallback {
       right->SilenceStream();
   }
 
+  /* Called from the voice callback; the decode thread closes the file once it sees the stream inactive */
   void StopStream() {
     x0_active = false;
+    m_requestGen.fetch_add(1);
     m_booVoice->stop();
-    m_file = std::nullopt;
   }
 
   static bool IsStreamActive(s32 id) {
@@ -402,17 +605,13 @@ struct SDSPStream : boo::IAudioVoiceCallback {
   }
 
   void AllocateStream(const SDSPStreamInfo& info, float vol, float left, float right) {
+    std::unique_lock lk{m_decodeLock};
+    ReleaseFile();
     x10_info = info;
     m_file.emplace(x10_info.x0_fileName);
     if (!xd4_ringBuffer) {
       DoAllocateStream();
     }
-    for (auto& request : m_readReqs) {
-      if (request) {
-        request->PostCancelRequest();
-        request.reset();
-      }
-    }
     x4c_vol = vol;
     m_leftgain = left;
     m_rightgain = right;
@@ -427,6 +626,10 @@ struct SDSPStream : boo::IAudioVoiceCallback {
     m_prev1 = 0;
     m_prev2 = 0;
     memset(xd4_ringBuffer.get(), 0, 0x11DC0);
+    m_decodeGen = m_requestGen.fetch_add(1) + 1;
+    lk.unlock();
+    g_DecodeCV.notify_one();
+
     m_booVoice->resetSampleRate(info.x4_sampleRate);
     m_booVoice->start();
     UpdateStreamVolume(vol);
@@ -436,6 +639,10 @@ struct SDSPStream : boo::IAudioVoiceCallback {
 };
 
 std::array<SDSPStream, 4> SDSPStream::g_Streams{};
+std::thread SDSPStream::g_DecodeThread;
+std::mutex SDSPStream::g_DecodeMutex;
+std::condition_variable SDSPStream::g_DecodeCV;
+std::atomic_bool SDSPStream::g_DecodeRun{false};
 
 class CDSPStreamManager {
   friend struct SDSPStreamInfo;
@@ -1037,6 +1244,38 @@ void CStreamAudioManager::StopOneShot() {
 
 void CStreamAudioManager::Shutdown() { CDSPStreamManager::Shutdown(); }
 
+std::string CStreamAudioManager::Summarize() {
+  const u64 callbacks = s_StreamStats.m_callbacks.load();
+  const u64 decodedSamples = s_StreamStats.m_decodedSamples.load();
+  const u64 decodeUs = s_StreamStats.m_decodeUs.load();
+  std::string ret = fmt::format(FMT_STRING("{} stream callbacks, {} underruns, longest {} us\n"
+                                           "Decode thread: {} samples in {:.1f} ms ({:.2f} us per 1000 samples)\n"
+                                           "Callback durations:"),
+                                callbacks, s_StreamStats.m_xruns.load(), s_StreamStats.m_maxCallbackUs.load(),
+                                decodedSamples, double(decodeUs) / 1000.0,
+                                decodedSamples ? double(decodeUs) * 1000.0 / double(decodedSamples) : 0.0);
+  for (size_t i = 0; i < CallbackBuckets; ++i) {
+    const u64 count = s_StreamStats.m_callbackHist[i].load();
+    if (i + 1 < CallbackBuckets) {
+      ret += fmt::format(FMT_STRING("\n  < {:5} us: {}"), u64(16) << i, count);
+    } else {
+      ret += fmt::format(FMT_STRING("\n  >= {:4} us: {}"), u64(16) << (i - 1), count);
+    }
+  }
+  return ret;
+}
+
+void CStreamAudioManager::ResetStats() {
+  s_StreamStats.m_callbacks.store(0);
+  s_StreamStats.m_xruns.store(0);
+  s_StreamStats.m_maxCallbackUs.store(0);
+  for (auto& bucket : s_StreamStats.m_callbackHist) {
+    bucket.store(0);
+  }
+  s_StreamStats.m_decodedSamples.store(0);
+  s_StreamStats.m_decodeUs.store(0);
+}
+
 u8 CStreamAudioManager::g_MusicVolume = 0x7f;
 u8 CStreamAudioManager::g_SfxVolume = 0x7f;
 bool CStreamAudioManager::g_MusicUnmute = true;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <string_view>
 
 #include "Runtime/GCNTypes.hpp"
@@ -32,6 +33,10 @@ public:
   static void Initialize();
   static void StopOneShot();
   static void Shutdown();
+
+  /* Voice callback durations, underruns and decode thread load since the last reset */
+  static std::string Summarize();
+  static void ResetStats();
 };
 
 } // namespace metaforce
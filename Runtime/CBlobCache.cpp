@@ -0,0 +1,219 @@
+#include "Runtime/CBlobCache.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define METAFORCE_HAS_MMAP 1
+#endif
+
+#include "Runtime/CResLoader.hpp"
+#include "Runtime/GameGlobalObjects.hpp"
+#include "Runtime/IFactory.hpp"
+
+#include <fmt/format.h>
+#include <hecl/hecl.hpp>
+#include <logvisor/logvisor.hpp>
+#include <xxhash/xxhash.h>
+
+namespace metaforce {
+namespace {
+logvisor::Module Log("metaforce::CBlobCache");
+
+/* Written in native byte order; a blob from a host of the other endianness fails the magic check */
+struct SBlobHeader {
+  u32 m_magic;
+  u32 m_version;
+  u32 m_pakOffset;
+  u32 m_pakSize;
+  u64 m_size;
+  u64 m_pakNameHash;
+  u64 m_sourceHash;
+  u64 m_payloadHash;
+  u64 m_reserved[2];
+};
+static_assert(sizeof(SBlobHeader) == 64, "Blob payloads must stay 32-byte aligned");
+
+constexpr u32 BlobMagic = 0x424C4F42; // 'BLOB'
+
+u64 HashPakName(std::string_view name) { return XXH64(name.data(), name.size(), 0); }
+
+/* Pak file name reduced to characters that are safe in a blob file name */
+std::string PakFileTag(std::string_view path) {
+  if (const size_t slash = path.find_last_of("/\\"); slash != std::string_view::npos) {
+    path.remove_prefix(slash + 1);
+  }
+  std::string ret(path);
+  std::replace_if(
+      ret.begin(), ret.end(), [](char c) { return !std::isalnum(static_cast<unsigned char>(c)) && c != '.'; }, '_');
+  return ret;
+}
+} // Anonymous namespace
+
+std::string CBlobCache::m_dir;
+CBlobCache::SStats CBlobCache::m_stats;
+
+CBlobCache::CBlob::~CBlob() {
+#if METAFORCE_HAS_MMAP
+  if (m_mapping != nullptr) {
+    munmap(m_mapping, m_mappingSize);
+  }
+#endif
+}
+
+void CBlobCache::Enable(std::string_view rootDir) {
+  m_dir = fmt::format(FMT_STRING("{}/v{}"), rootDir, kVersion);
+  hecl::RecursiveMakeDir(m_dir.c_str());
+  Log.report(logvisor::Info, FMT_STRING("Using blob cache at '{}'"), m_dir);
+}
+
+std::string CBlobCache::GetBlobPath(const SKey& key) {
+  return fmt::format(FMT_STRING("{}/{}_{}_{}_{:016x}.bin"), m_dir, PakFileTag(key.m_pakName), key.m_kind.toString(),
+                     key.m_id, key.m_sourceHash);
+}
+
+CBlobCache::SKindStats& CBlobCache::GetKindStats(FourCC kind) {
+  auto it = std::find_if(m_stats.m_kinds.begin(), m_stats.m_kinds.end(),
+                         [kind](const SKindStats& stats) { return stats.m_kind == kind; });
+  if (it != m_stats.m_kinds.end()) {
+    return *it;
+  }
+  return m_stats.m_kinds.emplace_back(SKindStats{kind});
+}
+
+std::optional<CBlobCache::SKey> CBlobCache::MakeKey(FourCC kind, CAssetId id, const void* source,
+                                                    size_t sourceSize) {
+  if (!IsEnabled() || g_ResFactory == nullptr) {
+    return std::nullopt;
+  }
+  const CResLoader* loader = g_ResFactory->GetResLoader();
+  std::string_view pakName;
+  SKey key{kind, id};
+  if (loader == nullptr || !loader->GetResourceLocation(id, pakName, key.m_pakOffset, key.m_pakSize)) {
+    return std::nullopt;
+  }
+  key.m_pakName = pakName;
+  key.m_sourceHash = XXH64(source, sourceSize, 0);
+  return key;
+}
+
+std::unique_ptr<CBlobCache::CBlob> CBlobCache::Map(const SKey& key, size_t expectedSize) {
+  if (!IsEnabled()) {
+    return nullptr;
+  }
+  SKindStats& kindStats = GetKindStats(key.m_kind);
+  const std::string path = GetBlobPath(key);
+  const size_t fileSize = sizeof(SBlobHeader) + expectedSize;
+  auto blob = std::make_unique<CBlob>();
+  const u8* base = nullptr;
+
+#if METAFORCE_HAS_MMAP
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    struct stat st {};
+    if (fstat(fd, &st) == 0 && size_t(st.st_size) == fileSize) {
+      /* Private and writable so the blob behaves like a freshly loaded buffer */
+      void* mapping = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      if (mapping != MAP_FAILED) {
+        blob->m_mapping = mapping;
+        blob->m_mappingSize = fileSize;
+        base = static_cast<const u8*>(mapping);
+      }
+    }
+    close(fd);
+  }
+#else
+  if (const auto fp = hecl::FopenUnique(path.c_str(), "rb")) {
+    blob->m_heap.reset(new u8[fileSize]);
+    if (std::fread(blob->m_heap.get(), 1, fileSize, fp.get()) == fileSize && std::fgetc(fp.get()) == EOF) {
+      base = blob->m_heap.get();
+    }
+  }
+#endif
+
+  if (base == nullptr) {
+    ++kindStats.m_misses;
+    return nullptr;
+  }
+  const auto* header = reinterpret_cast<const SBlobHeader*>(base);
+  const u8* payload = base + sizeof(SBlobHeader);
+  if (header->m_magic != BlobMagic || header->m_version != kVersion || header->m_pakOffset != key.m_pakOffset ||
+      header->m_pakSize != key.m_pakSize || header->m_size != expectedSize ||
+      header->m_pakNameHash != HashPakName(key.m_pakName) || header->m_sourceHash != key.m_sourceHash) {
+    ++kindStats.m_misses;
+    return nullptr;
+  }
+  /* Callers trust the payload's internal offsets, so a truncated or damaged blob must never get through */
+  if (header->m_payloadHash != XXH64(payload, expectedSize, 0)) {
+    Log.report(logvisor::Warning, FMT_STRING("Discarding corrupt blob '{}'"), path);
+    ++kindStats.m_misses;
+    return nullptr;
+  }
+  blob->m_data = const_cast<u8*>(payload);
+  blob->m_size = expectedSize;
+  ++kindStats.m_hits;
+  m_stats.m_bytesMapped += expectedSize;
+  return blob;
+}
+
+void CBlobCache::Store(const SKey& key, const void* data, size_t size) {
+  if (!IsEnabled()) {
+    return;
+  }
+  const std::string path = GetBlobPath(key);
+  const std::string tmpPath = path + ".tmp";
+  {
+    const auto fp = hecl::FopenUnique(tmpPath.c_str(), "wb");
+    if (fp == nullptr) {
+      Log.report(logvisor::Warning, FMT_STRING("Unable to open '{}' for writing"), tmpPath);
+      return;
+    }
+    const SBlobHeader header{BlobMagic,
+                             kVersion,
+                             key.m_pakOffset,
+                             key.m_pakSize,
+                             u64(size),
+                             HashPakName(key.m_pakName),
+                             key.m_sourceHash,
+                             XXH64(data, size, 0),
+                             {}};
+    if (std::fwrite(&header, sizeof(header), 1, fp.get()) != 1 || std::fwrite(data, 1, size, fp.get()) != size) {
+      Log.report(logvisor::Warning, FMT_STRING("Unable to write '{}'"), tmpPath);
+      return;
+    }
+  }
+  /* Readers only ever see complete blobs */
+  if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+    std::remove(tmpPath.c_str());
+    return;
+  }
+  ++m_stats.m_stores;
+}
+
+void CBlobCache::AddBuildTime(FourCC kind, bool hit, std::chrono::steady_clock::duration dur) {
+  SKindStats& kindStats = GetKindStats(kind);
+  (hit ? kindStats.m_hitMs : kindStats.m_missMs) += std::chrono::duration<double, std::milli>(dur).count();
+}
+
+std::string CBlobCache::Summarize() {
+  if (!IsEnabled()) {
+    return "Blob cache disabled; start with --blob-cache to enable it";
+  }
+  std::string ret = fmt::format(FMT_STRING("Blob cache '{}': {} stored, {:.1f} MiB mapped"), m_dir, m_stats.m_stores,
+                                double(m_stats.m_bytesMapped) / 1048576.0);
+  /* Average time per load from a cached blob against the same work from source data */
+  const auto average = [](double ms, u32 count) { return count != 0 ? ms / count : 0.0; };
+  for (const SKindStats& kindStats : m_stats.m_kinds) {
+    ret += fmt::format(FMT_STRING("\n{}: {} hits at {:.2f} ms, {} misses at {:.2f} ms"), kindStats.m_kind.toString(),
+                       kindStats.m_hits, average(kindStats.m_hitMs, kindStats.m_hits), kindStats.m_misses,
+                       average(kindStats.m_missMs, kindStats.m_misses));
+  }
+  return ret;
+}
+
+} // namespace metaforce
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Runtime/RetroTypes.hpp"
+
+namespace metaforce {
+
+/* Optional on-disk cache of resource data that has already been transformed for the runtime
+ * (inflated, byte-swapped to native endianness, offsets relative to the blob start). Blobs are keyed by
+ * kind, asset ID, the pak the resource came from and an XXH64 of its source bytes, so a modified or
+ * relocated resource never picks up a stale blob. The payload carries its own hash and is rejected if it
+ * does not match. Blobs are stored under a versioned directory and mapped copy-on-write on later runs.
+ * Disabled unless Enable is called. */
+class CBlobCache {
+public:
+  static constexpr u32 kVersion = 3;
+
+  class CBlob {
+    friend class CBlobCache;
+    u8* m_data = nullptr;
+    size_t m_size = 0;
+    void* m_mapping = nullptr;
+    size_t m_mappingSize = 0;
+    std::unique_ptr<u8[]> m_heap;
+
+  public:
+    CBlob() = default;
+    ~CBlob();
+    CBlob(const CBlob&) = delete;
+    CBlob& operator=(const CBlob&) = delete;
+
+    u8* GetData() const { return m_data; }
+    size_t GetSize() const { return m_size; }
+  };
+
+  struct SKey {
+    FourCC m_kind;
+    CAssetId m_id;
+    std::string m_pakName;
+    u32 m_pakOffset = 0;
+    u32 m_pakSize = 0;
+    u64 m_sourceHash = 0;
+  };
+
+  struct SKindStats {
+    FourCC m_kind;
+    u32 m_hits = 0;
+    u32 m_misses = 0;
+    /* Time spent producing objects whose data came from the cache, and from source data */
+    double m_hitMs = 0.0;
+    double m_missMs = 0.0;
+  };
+
+  struct SStats {
+    u32 m_stores = 0;
+    u64 m_bytesMapped = 0;
+    std::vector<SKindStats> m_kinds;
+  };
+
+private:
+  static std::string m_dir;
+  static SStats m_stats;
+
+  static std::string GetBlobPath(const SKey& key);
+  static SKindStats& GetKindStats(FourCC kind);
+
+public:
+  static void Enable(std::string_view rootDir);
+  static bool IsEnabled() { return !m_dir.empty(); }
+
+  /* Locates id in the loaded paks and hashes source, the bytes the blob is derived from (compressed bytes
+   * for compressed resources). Empty when the cache is disabled or the resource is not in a pak. */
+  static std::optional<SKey> MakeKey(FourCC kind, CAssetId id, const void* source, size_t sourceSize);
+  /* Returns nullptr unless a blob of exactly expectedSize exists for this key */
+  static std::unique_ptr<CBlob> Map(const SKey& key, size_t expectedSize);
+  static void Store(const SKey& key, const void* data, size_t size);
+
+  static void AddBuildTime(FourCC kind, bool hit, std::chrono::steady_clock::duration dur);
+  static const SStats& GetStats() { return m_stats; }
+  static std::string Summarize();
+};
+
+} // namespace metaforce
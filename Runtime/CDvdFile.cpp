@@ -3,6 +3,7 @@
 #include <optick.h>
 
 #include "Runtime/CDvdRequest.hpp"
+#include "Runtime/CProfiler.hpp"
 #include "Runtime/CStopwatch.hpp"
 
 namespace metaforce {
@@ -19,6 +20,9 @@ class CFileDvdRequest : public IDvdRequest {
   std::atomic_bool m_cancel = {false};
   std::atomic_bool m_complete = {false};
   std::function<void(u32)> m_callback;
+  std::chrono::steady_clock::time_point m_queueTime = std::chrono::steady_clock::now();
+  std::chrono::steady_clock::time_point m_startTime;
+  std::chrono::steady_clock::time_point m_endTime;
 
 public:
   ~CFileDvdRequest() override { CFileDvdRequest::PostCancelRequest(); }
@@ -38,6 +42,10 @@ public:
   }
 
   [[nodiscard]] EMediaType GetMediaType() const override { return EMediaType::File; }
+  [[nodiscard]] std::chrono::steady_clock::duration GetQueueWait() const override {
+    return m_startTime - m_queueTime;
+  }
+  [[nodiscard]] std::chrono::steady_clock::duration GetReadTime() const override { return m_endTime - m_startTime; }
 
   CFileDvdRequest(CDvdFile& file, void* buf, u32 len, ESeekOrigin whence, int off, std::function<void(u32)>&& cb)
   : m_reader(file.m_reader), m_buf(buf), m_len(len), m_whence(whence), m_offset(off), m_callback(std::move(cb)) {}
@@ -46,6 +54,7 @@ public:
     if (m_cancel.load()) {
       return;
     }
+    m_startTime = std::chrono::steady_clock::now();
     u32 readLen;
     if (m_whence == ESeekOrigin::Cur && m_offset == 0) {
       readLen = m_reader->readBytesToBuf(m_buf, m_len);
@@ -53,6 +62,7 @@ public:
       m_reader->seek(m_offset, athena::SeekOrigin(m_whence));
       readLen = m_reader->readBytesToBuf(m_buf, m_len);
     }
+    m_endTime = std::chrono::steady_clock::now();
     if (m_callback) {
       m_callback(readLen);
     }
@@ -70,6 +80,7 @@ std::vector<std::shared_ptr<IDvdRequest>> CDvdFile::m_RequestQueue;
 void CDvdFile::WorkerProc() {
   logvisor::RegisterThreadName("CDvdFile");
   OPTICK_THREAD("CDvdFile");
+  CProfiler::SetThreadName("CDvdFile");
 
   while (m_WorkerRun.load()) {
     std::unique_lock lk{m_WorkerMutex};
@@ -80,6 +91,7 @@ void CDvdFile::WorkerProc() {
       std::unique_lock waitlk{m_WaitMutex};
       for (std::shared_ptr<IDvdRequest>& req : swapQueue) {
         auto& concreteReq = static_cast<CFileDvdRequest&>(*req);
+        CProfiler::CZone zone("CDvdFile::DoRequest");
         concreteReq.DoRequest();
       }
       waitlk.unlock();
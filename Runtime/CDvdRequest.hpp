@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 namespace metaforce {
 
 class IDvdRequest {
@@ -12,6 +14,10 @@ public:
 
   enum class EMediaType { ARAM = 0, Real = 1, File = 2, NOD = 3 };
   virtual EMediaType GetMediaType() const = 0;
+
+  /* Time spent queued and reading; valid once IsComplete() */
+  virtual std::chrono::steady_clock::duration GetQueueWait() const { return {}; }
+  virtual std::chrono::steady_clock::duration GetReadTime() const { return {}; }
 };
 
 } // namespace metaforce
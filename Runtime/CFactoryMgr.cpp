@@ -3,9 +3,12 @@
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <cstring>
 #include <iterator>
 #include "optick.h"
 
+#include "Runtime/CBlobCache.hpp"
+#include "Runtime/CResLoadStats.hpp"
 #include "Runtime/CStopwatch.hpp"
 #include "Runtime/IObj.hpp"
 
@@ -19,13 +22,49 @@ constexpr std::array TypeTable{
     FOURCC('HINT'), FOURCC('MAPU'), FOURCC('DUMB'), FOURCC('OIDS'),
 };
 
+namespace {
+/* Resources whose inflated payload is kept in the blob cache, so later loads skip zlib */
+constexpr std::array BlobCachedTypes{FOURCC('CMDL'), FOURCC('PATH'), FOURCC('PART')};
+
+bool IsBlobCached(FourCC type) {
+  return CBlobCache::IsEnabled() &&
+         std::find(BlobCachedTypes.cbegin(), BlobCachedTypes.cend(), type) != BlobCachedTypes.cend();
+}
+
+/* Inflates a compressed pak entry, copying the result from a cached blob when one exists */
+std::unique_ptr<u8[]> InflateBlobCached(const SObjectTag& tag, const u8* buf, int size, u32& decompLenOut) {
+  const auto start = std::chrono::steady_clock::now();
+  std::unique_ptr<CInputStream> compRead = std::make_unique<athena::io::MemoryReader>(buf, size);
+  decompLenOut = compRead->readUint32Big();
+  const std::optional<CBlobCache::SKey> key = CBlobCache::MakeKey(tag.type, tag.id, buf, size_t(size));
+  if (key) {
+    if (const std::unique_ptr<CBlobCache::CBlob> blob = CBlobCache::Map(*key, decompLenOut)) {
+      std::unique_ptr<u8[]> ret(new u8[decompLenOut]);
+      std::memcpy(ret.get(), blob->GetData(), decompLenOut);
+      CBlobCache::AddBuildTime(tag.type, true, std::chrono::steady_clock::now() - start);
+      return ret;
+    }
+  }
+  CZipInputStream r(std::move(compRead));
+  std::unique_ptr<u8[]> ret = r.readUBytes(decompLenOut);
+  if (key) {
+    CBlobCache::Store(*key, ret.get(), decompLenOut);
+    CBlobCache::AddBuildTime(tag.type, false, std::chrono::steady_clock::now() - start);
+  }
+  return ret;
+}
+} // Anonymous namespace
+
 CFactoryFnReturn CFactoryMgr::MakeObject(const SObjectTag& tag, metaforce::CInputStream& in,
                                          const CVParamTransfer& paramXfer, CObjectReference* selfRef) {
   auto search = m_factories.find(tag.type);
   if (search == m_factories.end())
     return {};
 
-  return search->second(tag, in, paramXfer, selfRef);
+  const auto buildStart = std::chrono::steady_clock::now();
+  CFactoryFnReturn ret = search->second(tag, in, paramXfer, selfRef);
+  CResLoadStats::AddDuration(tag.type, CResLoadStats::EMetric::Build, std::chrono::steady_clock::now() - buildStart);
+  return ret;
 }
 
 bool CFactoryMgr::CanMakeMemory(const metaforce::SObjectTag& tag) const {
@@ -42,13 +81,33 @@ CFactoryFnReturn CFactoryMgr::MakeObjectFromMemory(const SObjectTag& tag, std::u
   const auto memFactoryIter = m_memFactories.find(tag.type);
   if (memFactoryIter != m_memFactories.cend()) {
     if (compressed) {
-      std::unique_ptr<CInputStream> compRead = std::make_unique<athena::io::MemoryReader>(localBuf.get(), size);
-      const u32 decompLen = compRead->readUint32Big();
-      CZipInputStream r(std::move(compRead));
-      std::unique_ptr<u8[]> decompBuf = r.readUBytes(decompLen);
-      return memFactoryIter->second(tag, std::move(decompBuf), decompLen, paramXfer, selfRef);
+      const auto decompStart = std::chrono::steady_clock::now();
+      u32 decompLen = 0;
+      std::unique_ptr<u8[]> decompBuf;
+      if (IsBlobCached(tag.type)) {
+        decompBuf = InflateBlobCached(tag, localBuf.get(), size, decompLen);
+      } else {
+        std::unique_ptr<CInputStream> compRead = std::make_unique<athena::io::MemoryReader>(localBuf.get(), size);
+        decompLen = compRead->readUint32Big();
+        CZipInputStream r(std::move(compRead));
+        decompBuf = r.readUBytes(decompLen);
+      }
+      CResLoadStats::AddDuration(tag.type, CResLoadStats::EMetric::Decompress,
+                                 std::chrono::steady_clock::now() - decompStart);
+      CResLoadStats::AddSample(tag.type, CResLoadStats::EMetric::CompressedSize, size);
+      CResLoadStats::AddSample(tag.type, CResLoadStats::EMetric::Size, decompLen);
+      const auto buildStart = std::chrono::steady_clock::now();
+      CFactoryFnReturn ret = memFactoryIter->second(tag, std::move(decompBuf), decompLen, paramXfer, selfRef);
+      CResLoadStats::AddDuration(tag.type, CResLoadStats::EMetric::Build,
+                                 std::chrono::steady_clock::now() - buildStart);
+      return ret;
     } else {
-      return memFactoryIter->second(tag, std::move(localBuf), size, paramXfer, selfRef);
+      CResLoadStats::AddSample(tag.type, CResLoadStats::EMetric::Size, size);
+      const auto buildStart = std::chrono::steady_clock::now();
+      CFactoryFnReturn ret = memFactoryIter->second(tag, std::move(localBuf), size, paramXfer, selfRef);
+      CResLoadStats::AddDuration(tag.type, CResLoadStats::EMetric::Build,
+                                 std::chrono::steady_clock::now() - buildStart);
+      return ret;
     }
   } else {
     const auto factoryIter = m_factories.find(tag.type);
@@ -56,15 +115,30 @@ CFactoryFnReturn CFactoryMgr::MakeObjectFromMemory(const SObjectTag& tag, std::u
       return {};
     }
 
-    if (compressed) {
+    // Stream factories inflate as they read, so decompression is counted as build time
+    const auto buildStart = std::chrono::steady_clock::now();
+    CFactoryFnReturn ret;
+    if (compressed && IsBlobCached(tag.type)) {
+      u32 decompLen = 0;
+      std::unique_ptr<u8[]> decompBuf = InflateBlobCached(tag, localBuf.get(), size, decompLen);
+      CResLoadStats::AddSample(tag.type, CResLoadStats::EMetric::CompressedSize, size);
+      CResLoadStats::AddSample(tag.type, CResLoadStats::EMetric::Size, decompLen);
+      CMemoryInStream r(decompBuf.get(), decompLen);
+      ret = factoryIter->second(tag, r, paramXfer, selfRef);
+    } else if (compressed) {
       std::unique_ptr<CInputStream> compRead = std::make_unique<athena::io::MemoryReader>(localBuf.get(), size);
-      compRead->readUint32Big();
+      const u32 decompLen = compRead->readUint32Big();
+      CResLoadStats::AddSample(tag.type, CResLoadStats::EMetric::CompressedSize, size);
+      CResLoadStats::AddSample(tag.type, CResLoadStats::EMetric::Size, decompLen);
       CZipInputStream r(std::move(compRead));
-      return factoryIter->second(tag, r, paramXfer, selfRef);
+      ret = factoryIter->second(tag, r, paramXfer, selfRef);
     } else {
+      CResLoadStats::AddSample(tag.type, CResLoadStats::EMetric::Size, size);
       CMemoryInStream r(localBuf.get(), size);
-      return factoryIter->second(tag, r, paramXfer, selfRef);
+      ret = factoryIter->second(tag, r, paramXfer, selfRef);
     }
+    CResLoadStats::AddDuration(tag.type, CResLoadStats::EMetric::Build, std::chrono::steady_clock::now() - buildStart);
+    return ret;
   }
 }
 
@@ -0,0 +1,211 @@
+#include "Runtime/CFrameBenchmark.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+
+#include "Runtime/CObjectList.hpp"
+#include "Runtime/World/CAi.hpp"
+
+#include <fmt/format.h>
+#include <hecl/hecl.hpp>
+#include <logvisor/logvisor.hpp>
+
+#include "TCastTo.hpp" // Generated file, do not modify include path
+
+namespace metaforce {
+namespace {
+logvisor::Module Log("metaforce::CFrameBenchmark");
+
+/* Set between BeginFrame and EndFrame on the thread running the frame */
+thread_local bool t_inFrame = false;
+thread_local CFrameBenchmark::CPhaseTimer* t_currentTimer = nullptr;
+
+constexpr std::array<std::string_view, CFrameBenchmark::kNumPhases + 1> PhaseNames{
+    "PreThink", "MoveActors", "Collision", "Particles", "Think", "Camera", "World", "Total",
+};
+
+constexpr std::array<const char*, CFrameBenchmark::kNumPhases> PhaseZoneNames{
+    "CStateManager::PreThink", "CStateManager::MoveActors", "CStateManager::Collision",
+    "CStateManager::Particles", "CStateManager::Think",      "CStateManager::Camera",
+    "CStateManager::World",
+};
+
+class CBenchmarkEntity final : public CEntity {
+public:
+  explicit CBenchmarkEntity(TUniqueId uid)
+  : CEntity(uid, CEntityInfo(kInvalidAreaId, CEntity::NullConnectionList), true, "Benchmark entity") {}
+  void Accept(IVisitor&) override {}
+};
+} // Anonymous namespace
+
+u32 CFrameBenchmark::x0_framesRemaining = 0;
+bool CFrameBenchmark::x4_finished = false;
+std::string CFrameBenchmark::x8_outPath;
+CFrameBenchmark::FrameTimes CFrameBenchmark::x28_curFrame{};
+std::chrono::steady_clock::time_point CFrameBenchmark::x30_frameStart;
+std::vector<CFrameBenchmark::FrameTimes> CFrameBenchmark::x38_frames;
+
+std::string_view CFrameBenchmark::GetPhaseName(EPhase phase) { return PhaseNames[size_t(phase)]; }
+
+const char* CFrameBenchmark::GetPhaseZoneName(EPhase phase) { return PhaseZoneNames[size_t(phase)]; }
+
+void CFrameBenchmark::Start(u32 frameCount, std::string_view outPath) {
+  x0_framesRemaining = frameCount;
+  x4_finished = frameCount == 0;
+  x8_outPath = outPath;
+  x38_frames.clear();
+  x38_frames.reserve(frameCount);
+  Log.report(logvisor::Info, FMT_STRING("Capturing {} simulation frames to '{}'"), frameCount, x8_outPath);
+}
+
+void CFrameBenchmark::AddPhaseTime(EPhase phase, std::chrono::steady_clock::duration dur) {
+  x28_curFrame[size_t(phase)] += std::chrono::duration<double, std::micro>(dur).count();
+}
+
+void CFrameBenchmark::CPhaseTimer::Begin() {
+  if (!t_inFrame) {
+    x4_active = false;
+    return;
+  }
+  const auto now = std::chrono::steady_clock::now();
+  x8_parent = t_currentTimer;
+  if (x8_parent != nullptr) {
+    AddPhaseTime(x8_parent->x0_phase, now - x8_parent->x10_start);
+  }
+  x10_start = now;
+  t_currentTimer = this;
+}
+
+void CFrameBenchmark::CPhaseTimer::End() {
+  const auto now = std::chrono::steady_clock::now();
+  AddPhaseTime(x0_phase, now - x10_start);
+  t_currentTimer = x8_parent;
+  if (x8_parent != nullptr) {
+    x8_parent->x10_start = now;
+  }
+}
+
+void CFrameBenchmark::BeginFrame() {
+  if (!IsCapturing()) {
+    return;
+  }
+  x28_curFrame.fill(0.0);
+  x30_frameStart = std::chrono::steady_clock::now();
+  t_inFrame = true;
+}
+
+void CFrameBenchmark::EndFrame() {
+  if (!IsCapturing()) {
+    return;
+  }
+  t_inFrame = false;
+  x28_curFrame[kNumPhases] =
+      std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - x30_frameStart).count();
+  x38_frames.push_back(x28_curFrame);
+  if (--x0_framesRemaining == 0) {
+    WriteReport();
+    x4_finished = true;
+  }
+}
+
+void CFrameBenchmark::Finish() {
+  if (!IsCapturing()) {
+    return;
+  }
+  t_inFrame = false;
+  x0_framesRemaining = 0;
+  x4_finished = true;
+  if (x38_frames.empty()) {
+    Log.report(logvisor::Warning, FMT_STRING("Benchmark ended before any simulation frame ran"));
+    return;
+  }
+  WriteReport();
+}
+
+void CFrameBenchmark::WriteReport() {
+  std::string out = fmt::format(FMT_STRING("{{\n  \"frames\": {},\n  \"phases\": {{\n"), x38_frames.size());
+  std::vector<double> samples;
+  samples.reserve(x38_frames.size());
+  for (size_t p = 0; p < PhaseNames.size(); ++p) {
+    samples.clear();
+    for (const auto& frame : x38_frames) {
+      samples.push_back(frame[p]);
+    }
+    std::sort(samples.begin(), samples.end());
+    const auto percentile = [&](double pct) {
+      return samples[std::min(samples.size() - 1, size_t(pct * double(samples.size() - 1) + 0.5))];
+    };
+    const double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / double(samples.size());
+    out += fmt::format(FMT_STRING("    \"{}\": {{\"mean_us\": {:.2f}, \"min_us\": {:.2f}, \"p50_us\": {:.2f}, "
+                                  "\"p95_us\": {:.2f}, \"max_us\": {:.2f}}}{}\n"),
+                       PhaseNames[p], mean, samples.front(), percentile(0.5), percentile(0.95), samples.back(),
+                       p + 1 < PhaseNames.size() ? "," : "");
+  }
+  out += "  }\n}\n";
+
+  if (x8_outPath.empty()) {
+    Log.report(logvisor::Info, FMT_STRING("Benchmark results:\n{}"), out);
+    return;
+  }
+  const auto fp = hecl::FopenUnique(x8_outPath.c_str(), "w");
+  if (fp == nullptr) {
+    Log.report(logvisor::Error, FMT_STRING("Unable to open '{}' for writing"), x8_outPath);
+    return;
+  }
+  std::fwrite(out.data(), 1, out.size(), fp.get());
+  Log.report(logvisor::Info, FMT_STRING("Wrote {} frames of results to '{}'"), x38_frames.size(), x8_outPath);
+}
+
+void CFrameBenchmark::RunObjectListBenchmark(u32 passes) {
+  if (passes == 0) {
+    return;
+  }
+
+  // Allocate in one order and link in another so list order does not follow heap order
+  std::vector<std::unique_ptr<CBenchmarkEntity>> entities;
+  entities.reserve(kMaxEntities);
+  for (size_t i = 0; i < kMaxEntities; ++i) {
+    entities.push_back(std::make_unique<CBenchmarkEntity>(TUniqueId(kUniqueIdType(i), 0)));
+    entities.back()->SetActive(i % 4 != 0);
+  }
+  std::vector<size_t> order(kMaxEntities);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), std::mt19937(0));
+  CObjectList list(EGameObjectList::All);
+  for (const size_t idx : order) {
+    list.AddObject(*entities[idx]);
+  }
+  std::array<bool, kMaxEntities> isAi{};
+
+  u64 visited = 0;
+  const auto timePasses = [&](const auto& pass) {
+    const auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < passes; ++i) {
+      pass();
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / passes;
+  };
+  const double linkedUs = timePasses([&] {
+    for (CEntity* ent : list) {
+      if (!TCastToConstPtr<CAi>(ent) && ent->GetActive()) {
+        ++visited;
+      }
+    }
+  });
+  const double packedUs = timePasses([&] {
+    for (const auto& entry : list.GetPackedEntries()) {
+      if (!isAi[entry.id] && entry.entity->GetActive()) {
+        ++visited;
+      }
+    }
+  });
+
+  Log.report(logvisor::Info,
+             FMT_STRING("Object list iteration over {} entities: linked {:.2f}us, packed {:.2f}us per pass "
+                        "({} passes, {} visits)"),
+             list.size(), linkedUs, packedUs, passes, visited);
+}
+
+} // namespace metaforce
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Runtime/CProfiler.hpp"
+#include "Runtime/GCNTypes.hpp"
+
+namespace metaforce {
+
+/* Times the phases of CStateManager::Update for a fixed number of frames and writes the result as JSON.
+ * Driven from the command line (--benchmark-frames N [--benchmark-out path]) together with --warp.
+ * metaforce-benchmark runs the same capture headless over a recorded input stream. */
+class CFrameBenchmark {
+public:
+  enum class EPhase {
+    PreThink,
+    MoveActors,
+    Collision,
+    Particles,
+    Think,
+    Camera,
+    World,
+    MAX
+  };
+  static constexpr size_t kNumPhases = size_t(EPhase::MAX);
+
+  /* Charges the enclosed time to a phase. Timers nest: an inner timer pauses the enclosing one, so
+   * particle updates inside Think count as Particles only. Only the thread running the frame is timed. */
+  class CPhaseTimer {
+    EPhase x0_phase;
+    bool x4_active;
+    CPhaseTimer* x8_parent = nullptr;
+    std::chrono::steady_clock::time_point x10_start;
+
+    void Begin();
+    void End();
+
+  public:
+    explicit CPhaseTimer(EPhase phase) : x0_phase(phase), x4_active(IsCapturing()) {
+      if (x4_active) {
+        Begin();
+      }
+    }
+    ~CPhaseTimer() {
+      if (x4_active) {
+        End();
+      }
+    }
+    CPhaseTimer(const CPhaseTimer&) = delete;
+    CPhaseTimer& operator=(const CPhaseTimer&) = delete;
+  };
+
+  /* A phase timer plus a profiler zone, for the top-level phases of CStateManager::Update */
+  class CPhaseScope {
+    CProfiler::CZone x0_zone;
+    CPhaseTimer x10_timer;
+
+  public:
+    explicit CPhaseScope(EPhase phase) : x0_zone(GetPhaseZoneName(phase)), x10_timer(phase) {}
+  };
+
+private:
+  /* Per-frame phase times in microseconds, followed by the whole update */
+  using FrameTimes = std::array<double, kNumPhases + 1>;
+
+  static u32 x0_framesRemaining;
+  static bool x4_finished;
+  static std::string x8_outPath;
+  static FrameTimes x28_curFrame;
+  static std::chrono::steady_clock::time_point x30_frameStart;
+  static std::vector<FrameTimes> x38_frames;
+
+  static void AddPhaseTime(EPhase phase, std::chrono::steady_clock::duration dur);
+  static void WriteReport();
+
+public:
+  static void Start(u32 frameCount, std::string_view outPath);
+  static bool IsCapturing() { return x0_framesRemaining != 0; }
+  static bool IsFinished() { return x4_finished; }
+  /* Ends a capture early, reporting the frames captured so far */
+  static void Finish();
+
+  static void BeginFrame();
+  static void EndFrame();
+
+  static std::string_view GetPhaseName(EPhase phase);
+  static const char* GetPhaseZoneName(EPhase phase);
+
+  /* Compares a linked CObjectList walk with per-entity type tests against the packed walk the update
+   * phases use, over a full kMaxEntities load (--benchmark-object-lists N) */
+  static void RunObjectListBenchmark(u32 passes);
+};
+
+} // namespace metaforce
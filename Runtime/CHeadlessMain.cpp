@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "boo/boo.hpp"
+#include "hecl/Database.hpp"
+#include "logvisor/logvisor.hpp"
+
+#include "Runtime/CFrameBenchmark.hpp"
+#include "Runtime/Graphics/CGraphics.hpp"
+#include "Runtime/Input/CInputRecorder.hpp"
+#include "Runtime/MP1/MP1.hpp"
+#include "amuse/BooBackend.hpp"
+
+/* Static reference to dataspec additions
+ * (used by MSVC to definitively link DataSpecs) */
+#include "DataSpecRegistry.hpp"
+
+/* metaforce-benchmark: runs MP1 without a window or graphics device and steps it at a fixed 60Hz
+ * from a recorded input stream (--replay-input, CInputRecorder format), capturing CFrameBenchmark
+ * timings. Nothing is drawn: g_BooFactory stays null, so resource commits are skipped and g_Renderer
+ * is a CNullRenderer. Audio goes to a WAV voice engine that is never pumped.
+ *
+ * metaforce-benchmark <project> --replay-input file [--warp world area] [--benchmark-frames N]
+ *                     [--benchmark-out file.json]
+ *
+ * Without --benchmark-frames every in-game frame of the replay is captured. */
+
+namespace metaforce {
+namespace {
+logvisor::Module Log("metaforce::CHeadlessMain");
+
+void AthenaExc(athena::error::Level level, const char* file, const char*, int line, fmt::string_view fmt,
+               fmt::format_args args) {
+  Log.vreport(logvisor::Level(level), fmt, args);
+}
+
+int RunHeadless(const std::vector<std::string>& args) {
+  hecl::Runtime::FileStoreManager fileMgr{"metaforce"};
+  hecl::CVarManager cvarMgr{fileMgr};
+  cvarMgr.parseCommandLine(args);
+
+  std::string projectArg;
+  for (const auto& arg : args) {
+    if (hecl::SearchForProject(arg)) {
+      projectArg = arg;
+      break;
+    }
+  }
+  if (projectArg.empty()) {
+    Log.report(logvisor::Error, FMT_STRING("Project directory not specified"));
+    return 1;
+  }
+  if (std::find(args.begin(), args.end(), "--replay-input") == args.end()) {
+    Log.report(logvisor::Error, FMT_STRING("--replay-input is required"));
+    return 1;
+  }
+
+  std::string subPath;
+  const hecl::ProjectRootPath projPath = hecl::SearchForProject(projectArg, subPath);
+  hecl::Database::Project proj(projPath);
+  CDvdFile::Initialize(hecl::ProjectPath{proj.getProjectWorkingPath(), "out/files/MP1"});
+
+  const std::string wavPath = fmt::format(FMT_STRING("{}/benchmark.wav"), fileMgr.getStoreRoot());
+  std::unique_ptr<boo::IAudioVoiceEngine> voiceEngine = boo::NewWAVAudioVoiceEngine(wavPath.c_str(), 32000.0, 2);
+  voiceEngine->setVolume(0.f);
+  amuse::BooBackendVoiceAllocator backend(*voiceEngine);
+
+  auto game = std::make_unique<MP1::CMain>(nullptr, nullptr, nullptr, nullptr, boo::ObjToken<boo::ITextureR>{});
+  game->SetHeadlessArgs(args);
+  game->Init(fileMgr, &cvarMgr, nullptr, voiceEngine.get(), backend);
+
+  if (!CInputRecorder::IsReplaying()) {
+    game->Shutdown();
+    CDvdFile::Shutdown();
+    return 1;
+  }
+  if (!CFrameBenchmark::IsCapturing()) {
+    std::string_view outPath;
+    const auto outIt = std::find(args.begin(), args.end(), "--benchmark-out");
+    if (args.end() - outIt >= 2) {
+      outPath = *(outIt + 1);
+    }
+    CFrameBenchmark::Start(CInputRecorder::GetReplayEndFrame(), outPath);
+  }
+
+  /* Loading gets the idle budget of a 60Hz frame, as the windowed loop gives it on a fast machine */
+  constexpr float dt = 1.f / 60.f;
+  constexpr auto loadBudget = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::seconds{1}) / 60;
+  while (true) {
+    g_ResFactory->AsyncIdle(loadBudget);
+    if (game->Proc(dt)) {
+      break;
+    }
+    CGraphics::TickRenderTimings();
+    ++logvisor::FrameIndex;
+    if (!CInputRecorder::IsReplaying()) {
+      CFrameBenchmark::Finish();
+      break;
+    }
+  }
+
+  game->Shutdown();
+  game.reset();
+  voiceEngine.reset();
+  CDvdFile::Shutdown();
+  return 0;
+}
+} // Anonymous namespace
+} // namespace metaforce
+
+int main(int argc, char** argv) {
+  logvisor::RegisterStandardExceptions();
+  logvisor::RegisterConsoleLogger();
+  atSetExceptionHandler(metaforce::AthenaExc);
+  zeus::detectCPU();
+
+  /* Handle -j argument */
+  hecl::SetCpuCountOverride(argc, argv);
+
+  std::vector<std::string> args;
+  for (int i = 1; i < argc; ++i)
+    args.emplace_back(argv[i]);
+  return metaforce::RunHeadless(args);
+}
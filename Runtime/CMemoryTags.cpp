@@ -0,0 +1,111 @@
+#include "Runtime/CMemoryTags.hpp"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+#include <logvisor/logvisor.hpp>
+
+namespace metaforce {
+namespace {
+logvisor::Module Log("metaforce::CMemoryTags");
+
+constexpr std::array<std::string_view, CMemoryTags::kNumTags> TagNames{
+    "Resources",
+    "World",
+    "Particles",
+    "Models",
+};
+
+thread_local EMemoryTag CurrentTag = EMemoryTag::Resources;
+
+double ToKiB(s64 bytes) { return double(bytes) / 1024.0; }
+} // Anonymous namespace
+
+std::array<std::atomic<s64>, CMemoryTags::kNumTags> CMemoryTags::m_live{};
+std::array<std::atomic<s64>, CMemoryTags::kNumTags> CMemoryTags::m_peak{};
+std::vector<CMemoryTags::SAreaPeak> CMemoryTags::m_areaPeaks;
+size_t CMemoryTags::m_curArea = SIZE_MAX;
+u32 CMemoryTags::m_logInterval = 0;
+u32 CMemoryTags::m_framesUntilLog = 0;
+
+CMemoryTags::CScope::CScope(EMemoryTag tag) : m_prevTag(CurrentTag) { CurrentTag = tag; }
+
+CMemoryTags::CScope::~CScope() { CurrentTag = m_prevTag; }
+
+EMemoryTag CMemoryTags::GetCurrentTag() { return CurrentTag; }
+
+void CMemoryTags::Add(EMemoryTag tag, s64 bytes) {
+  const size_t idx = size_t(tag);
+  const s64 live = m_live[idx].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  s64 peak = m_peak[idx].load(std::memory_order_relaxed);
+  while (live > peak && !m_peak[idx].compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+
+std::string_view CMemoryTags::GetTagName(EMemoryTag tag) { return TagNames[size_t(tag)]; }
+
+void CMemoryTags::SetCurrentArea(CAssetId mrea) {
+  const auto search =
+      std::find_if(m_areaPeaks.begin(), m_areaPeaks.end(), [&](const SAreaPeak& p) { return p.m_mrea == mrea; });
+  if (search != m_areaPeaks.end()) {
+    m_curArea = size_t(search - m_areaPeaks.begin());
+  } else {
+    m_curArea = m_areaPeaks.size();
+    m_areaPeaks.push_back({mrea});
+  }
+}
+
+void CMemoryTags::NewFrame() {
+  if (m_curArea < m_areaPeaks.size()) {
+    TagCounts& peak = m_areaPeaks[m_curArea].m_peak;
+    for (size_t i = 0; i < kNumTags; ++i) {
+      peak[i] = std::max(peak[i], m_live[i].load(std::memory_order_relaxed));
+    }
+  }
+
+  if (m_logInterval != 0 && --m_framesUntilLog == 0) {
+    m_framesUntilLog = m_logInterval;
+    std::string line;
+    for (size_t i = 0; i < kNumTags; ++i) {
+      line += fmt::format(FMT_STRING("{}{} {:.0f} KiB (peak {:.0f})"), i == 0 ? "" : ", ", TagNames[i],
+                          ToKiB(m_live[i].load(std::memory_order_relaxed)),
+                          ToKiB(m_peak[i].load(std::memory_order_relaxed)));
+    }
+    Log.report(logvisor::Info, FMT_STRING("{}"), line);
+  }
+}
+
+void CMemoryTags::SetLogInterval(u32 frameCount) {
+  m_logInterval = frameCount;
+  m_framesUntilLog = frameCount;
+}
+
+void CMemoryTags::ResetPeaks() {
+  for (size_t i = 0; i < kNumTags; ++i) {
+    m_peak[i].store(m_live[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  const CAssetId curMrea = m_curArea < m_areaPeaks.size() ? m_areaPeaks[m_curArea].m_mrea : CAssetId{};
+  m_areaPeaks.clear();
+  m_curArea = SIZE_MAX;
+  if (curMrea.IsValid()) {
+    SetCurrentArea(curMrea);
+  }
+}
+
+std::string CMemoryTags::Summarize() {
+  std::string ret;
+  for (size_t i = 0; i < kNumTags; ++i) {
+    ret += fmt::format(FMT_STRING("{}: {:.0f} KiB live, {:.0f} KiB peak\n"), TagNames[i],
+                       ToKiB(m_live[i].load(std::memory_order_relaxed)),
+                       ToKiB(m_peak[i].load(std::memory_order_relaxed)));
+  }
+  for (const SAreaPeak& area : m_areaPeaks) {
+    ret += fmt::format(FMT_STRING("Area 0x{} peak:"), area.m_mrea);
+    for (size_t i = 0; i < kNumTags; ++i) {
+      ret += fmt::format(FMT_STRING(" {} {:.0f} KiB"), TagNames[i], ToKiB(area.m_peak[i]));
+    }
+    ret += '\n';
+  }
+  return ret;
+}
+
+} // namespace metaforce
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Runtime/RetroTypes.hpp"
+
+namespace metaforce {
+
+enum class EMemoryTag : u8 {
+  Resources, // CSimplePool objects requested outside of any other scope
+  World,     // CGameArea section buffers and resources requested while streaming areas
+  Particles, // CElementGen particle buffers and resources requested by particle systems
+  Models,    // CBooModel instances and their uniform buffers
+  MAX
+};
+
+/* Live and peak byte counters per subsystem tag. Counting is a relaxed atomic add so it stays on in
+ * release builds. CSimplePool charges each referenced resource's packed size to the innermost CScope
+ * on the requesting thread. */
+class CMemoryTags {
+public:
+  static constexpr size_t kNumTags = size_t(EMemoryTag::MAX);
+  using TagCounts = std::array<s64, kNumTags>;
+
+  class CScope {
+    EMemoryTag m_prevTag;
+
+  public:
+    explicit CScope(EMemoryTag tag);
+    ~CScope();
+    CScope(const CScope&) = delete;
+    CScope& operator=(const CScope&) = delete;
+  };
+
+  struct SAreaPeak {
+    CAssetId m_mrea;
+    TagCounts m_peak{};
+  };
+
+private:
+  static std::array<std::atomic<s64>, kNumTags> m_live;
+  static std::array<std::atomic<s64>, kNumTags> m_peak;
+  static std::vector<SAreaPeak> m_areaPeaks;
+  static size_t m_curArea;
+  static u32 m_logInterval;
+  static u32 m_framesUntilLog;
+
+public:
+  static EMemoryTag GetCurrentTag();
+  static void Add(EMemoryTag tag, s64 bytes);
+  static void Sub(EMemoryTag tag, s64 bytes) { Add(tag, -bytes); }
+
+  static s64 GetLive(EMemoryTag tag) { return m_live[size_t(tag)].load(std::memory_order_relaxed); }
+  static s64 GetPeak(EMemoryTag tag) { return m_peak[size_t(tag)].load(std::memory_order_relaxed); }
+  static const std::vector<SAreaPeak>& GetAreaPeaks() { return m_areaPeaks; }
+  static const SAreaPeak* GetCurrentAreaPeak() {
+    return m_curArea < m_areaPeaks.size() ? &m_areaPeaks[m_curArea] : nullptr;
+  }
+  static std::string_view GetTagName(EMemoryTag tag);
+
+  /* Starts attributing per-area peaks to the given MREA; called from the main thread */
+  static void SetCurrentArea(CAssetId mrea);
+  /* Samples live counts into the current area's peaks and writes the periodic log */
+  static void NewFrame();
+  /* Logs a summary every frameCount frames; 0 disables */
+  static void SetLogInterval(u32 frameCount);
+  static void ResetPeaks();
+
+  static std::string Summarize();
+};
+
+} // namespace metaforce
@@ -1,12 +1,14 @@
 #include "Runtime/CObjectList.hpp"
 
+#include <algorithm>
+
 #include <logvisor/logvisor.hpp>
 namespace metaforce {
 namespace {
 logvisor::Module Log("metaforce::CObjectList");
 }
 
-CObjectList::CObjectList(EGameObjectList listEnum) : x2004_listEnum(listEnum) {}
+CObjectList::CObjectList(EGameObjectList listEnum) : x2004_listEnum(listEnum) { m_packedSlot.fill(-1); }
 
 void CObjectList::AddObject(CEntity& entity) {
   if (IsQualified(entity)) {
@@ -28,6 +30,10 @@ void CObjectList::AddObject(CEntity& entity) {
     newEnt.next = prevFirst;
     newEnt.prev = -1;
     ++x200a_count;
+
+    const s16 slot = s16(kMaxEntities - x200a_count);
+    m_packed[slot] = {&entity, x2008_firstId};
+    m_packedSlot[x2008_firstId] = slot;
   }
 }
 
@@ -47,6 +53,16 @@ void CObjectList::RemoveObject(TUniqueId uid) {
   ent.entity = nullptr;
   ent.next = -1;
   ent.prev = -1;
+
+  // Close the gap by shifting the newer entries up one slot, keeping list order
+  const s16 first = s16(kMaxEntities - x200a_count);
+  const s16 slot = m_packedSlot[uid.Value()];
+  std::copy_backward(m_packed.begin() + first, m_packed.begin() + slot, m_packed.begin() + slot + 1);
+  for (s16 i = first + 1; i <= slot; ++i) {
+    m_packedSlot[m_packed[i].id] = i;
+  }
+  m_packed[first] = {};
+  m_packedSlot[uid.Value()] = -1;
   --x200a_count;
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <span>
 
 #include "Runtime/RetroTypes.hpp"
 #include "Runtime/World/CEntity.hpp"
@@ -32,6 +33,17 @@ class CObjectList {
   s16 x2008_firstId = -1;
   u16 x200a_count = 0;
 
+public:
+  struct SPackedEntry {
+    CEntity* entity = nullptr;
+    s16 id = -1;
+  };
+
+private:
+  /* Dense copy of the list, filled from the back so [kMaxEntities - count, kMaxEntities) is in list order */
+  std::array<SPackedEntry, kMaxEntities> m_packed;
+  std::array<s16, kMaxEntities> m_packedSlot;
+
 public:
   class iterator {
     friend class CObjectList;
@@ -87,6 +99,12 @@ public:
   CEntity* GetValidObjectById(TUniqueId uid);
   s16 GetFirstObjectIndex() const { return x2008_firstId; }
   s16 GetNextObjectIndex(s16 prev) const { return x0_list[prev].next; }
+  /* Same entities and order as begin()/end() without chasing list links. Objects added while iterating are
+   * not visited; RemoveObject invalidates the span. Besides ClearGraveyard, UpdateObjectInLists removes from
+   * the listening AI list and SetActorAreaId from area lists, so neither of those may be walked this way. */
+  std::span<const SPackedEntry> GetPackedEntries() const {
+    return {m_packed.data() + (kMaxEntities - x200a_count), x200a_count};
+  }
   virtual bool IsQualified(const CEntity&) const;
   u16 size() const { return x200a_count; }
 };
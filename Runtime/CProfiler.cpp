@@ -0,0 +1,284 @@
+#include "Runtime/CProfiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <fmt/format.h>
+#include <hecl/hecl.hpp>
+#include <logvisor/logvisor.hpp>
+
+namespace metaforce {
+namespace {
+logvisor::Module Log("metaforce::CProfiler");
+
+const CProfiler::Clock::time_point Epoch = CProfiler::Clock::now();
+
+u64 ToNs(CProfiler::Clock::time_point time) {
+  return u64(std::chrono::duration_cast<std::chrono::nanoseconds>(time - Epoch).count());
+}
+
+struct SThreadBuffer {
+  std::string m_name;
+  u32 m_index = 0;
+  std::array<CProfiler::SZone, CProfiler::kRingSize> m_zones{};
+  std::atomic<u64> m_written = 0;
+  /* Set while a zone is being written; readers wait for it after disabling recording */
+  std::atomic_bool m_writing = false;
+
+  /* While capturing the ring is a queue: zones are moved out every frame, and the writer drops new zones
+   * rather than overwrite ones not yet drained */
+  std::vector<CProfiler::SZone> m_captured;
+  std::atomic<u64> m_drained = 0;
+  std::atomic<u64> m_dropped = 0;
+};
+
+std::atomic_bool Enabled = false;
+std::atomic_bool Draining = false;
+bool LiveView = false;
+u32 CaptureFramesRemaining = 0;
+std::string CapturePath;
+u64 FrameBeginNs = 0;
+u64 LastFrameBeginNs = 0;
+u64 LastFrameEndNs = 0;
+
+std::mutex ThreadsMutex;
+std::vector<std::unique_ptr<SThreadBuffer>> Threads;
+thread_local SThreadBuffer* ThreadBuffer = nullptr;
+thread_local u32 ThreadDepth = 0;
+
+/* Recording is skipped on unregistered threads so callbacks on threads we do not own, like the audio
+ * mixer's, never allocate a ring or take ThreadsMutex */
+bool IsRecording() { return ThreadBuffer != nullptr && Enabled.load(std::memory_order_relaxed); }
+
+void Record(const char* name, u64 beginNs, u64 endNs, u32 depth) {
+  SThreadBuffer& buf = *ThreadBuffer;
+  buf.m_writing.store(true);
+  if (Enabled.load()) {
+    const u64 idx = buf.m_written.load(std::memory_order_relaxed);
+    if (Draining.load() && idx - buf.m_drained.load(std::memory_order_acquire) >= CProfiler::kRingSize) {
+      buf.m_dropped.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      buf.m_zones[idx % CProfiler::kRingSize] = {name, beginNs, endNs, depth};
+      buf.m_written.store(idx + 1, std::memory_order_release);
+    }
+  }
+  buf.m_writing.store(false, std::memory_order_release);
+}
+
+/* Stops recording and waits for in-flight writes so every ring buffer can be read safely.
+ * Must be called with ThreadsMutex held. */
+bool PauseRecording() {
+  const bool wasEnabled = Enabled.exchange(false);
+  for (const auto& buf : Threads) {
+    while (buf->m_writing.load()) {
+      std::this_thread::yield();
+    }
+  }
+  return wasEnabled;
+}
+
+void UpdateEnabled() {
+  Draining.store(CaptureFramesRemaining != 0);
+  Enabled.store(LiveView || CaptureFramesRemaining != 0);
+}
+
+/* Forgets drained zones; must be called with ThreadsMutex held */
+void ResetCaptures() {
+  for (const auto& buf : Threads) {
+    buf->m_captured = {};
+    buf->m_drained.store(0);
+    buf->m_dropped.store(0);
+  }
+}
+
+/* Moves zones completed since the last drain out of each ring, so a capture is bounded by memory rather than
+ * by kRingSize */
+void DrainCaptures() {
+  std::lock_guard lk{ThreadsMutex};
+  for (const auto& buf : Threads) {
+    const u64 written = buf->m_written.load(std::memory_order_acquire);
+    for (u64 i = buf->m_drained.load(std::memory_order_relaxed); i < written; ++i) {
+      buf->m_captured.push_back(buf->m_zones[i % CProfiler::kRingSize]);
+    }
+    buf->m_drained.store(written, std::memory_order_release);
+  }
+}
+
+void AppendJsonString(std::string& out, std::string_view str) {
+  out += '"';
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+    }
+    out += c;
+  }
+  out += '"';
+}
+} // Anonymous namespace
+
+CProfiler::CZone::CZone(const char* name) : m_name(name), m_active(IsRecording()) {
+  if (m_active) {
+    ++ThreadDepth;
+    m_begin = Clock::now();
+  }
+}
+
+CProfiler::CZone::~CZone() {
+  if (m_active) {
+    const auto end = Clock::now();
+    --ThreadDepth;
+    Record(m_name, ToNs(m_begin), ToNs(end), ThreadDepth);
+  }
+}
+
+bool CProfiler::IsEnabled() { return Enabled.load(std::memory_order_relaxed); }
+
+void CProfiler::AddZone(const char* name, Clock::time_point begin, Clock::time_point end) {
+  if (IsRecording()) {
+    Record(name, ToNs(begin), ToNs(end), ThreadDepth);
+  }
+}
+
+void CProfiler::SetThreadName(std::string_view name) {
+  std::lock_guard lk{ThreadsMutex};
+  if (ThreadBuffer == nullptr) {
+    auto& buf = Threads.emplace_back(std::make_unique<SThreadBuffer>());
+    buf->m_index = u32(Threads.size());
+    ThreadBuffer = buf.get();
+  }
+  ThreadBuffer->m_name = name;
+}
+
+void CProfiler::StartCapture(u32 frameCount, std::string_view outPath) {
+  if (frameCount == 0) {
+    return;
+  }
+  {
+    std::lock_guard lk{ThreadsMutex};
+    PauseRecording();
+    for (const auto& buf : Threads) {
+      buf->m_written.store(0);
+    }
+    ResetCaptures();
+  }
+  CaptureFramesRemaining = frameCount;
+  CapturePath = outPath;
+  UpdateEnabled();
+  Log.report(logvisor::Info, FMT_STRING("Capturing {} frames of profiler zones to '{}'"), frameCount, CapturePath);
+}
+
+bool CProfiler::IsCapturing() { return CaptureFramesRemaining != 0; }
+
+void CProfiler::SetLiveView(bool live) {
+  if (LiveView == live) {
+    return;
+  }
+  LiveView = live;
+  UpdateEnabled();
+}
+
+void CProfiler::NewFrame() {
+  const u64 now = ToNs(Clock::now());
+  LastFrameBeginNs = FrameBeginNs;
+  LastFrameEndNs = now;
+  FrameBeginNs = now;
+
+  if (CaptureFramesRemaining != 0) {
+    DrainCaptures();
+    if (--CaptureFramesRemaining == 0) {
+      WriteChromeTrace(CapturePath);
+      UpdateEnabled();
+      std::lock_guard lk{ThreadsMutex};
+      ResetCaptures();
+    }
+  }
+}
+
+void CProfiler::GetLastFrameZones(std::vector<SZone>& out) {
+  out.clear();
+  if (ThreadBuffer == nullptr) {
+    return;
+  }
+  const SThreadBuffer& buf = *ThreadBuffer;
+  const u64 written = buf.m_written.load(std::memory_order_relaxed);
+  const u64 oldest = written > kRingSize ? written - kRingSize : 0;
+  // Zones are stored in the order they end
+  for (u64 i = written; i > oldest; --i) {
+    const SZone& zone = buf.m_zones[(i - 1) % kRingSize];
+    if (zone.m_endNs < LastFrameBeginNs) {
+      break;
+    }
+    if (zone.m_beginNs >= LastFrameBeginNs && zone.m_endNs <= LastFrameEndNs) {
+      out.push_back(zone);
+    }
+  }
+  std::sort(out.begin(), out.end(), [](const SZone& a, const SZone& b) {
+    return a.m_beginNs != b.m_beginNs ? a.m_beginNs < b.m_beginNs : a.m_depth < b.m_depth;
+  });
+}
+
+bool CProfiler::WriteChromeTrace(std::string_view path) {
+  std::string out = "{\"traceEvents\":[\n";
+  size_t zoneCount = 0;
+  u64 dropped = 0;
+  {
+    std::lock_guard lk{ThreadsMutex};
+    const bool wasEnabled = PauseRecording();
+    bool first = true;
+    for (const auto& buf : Threads) {
+      if (!first) {
+        out += ",\n";
+      }
+      first = false;
+      out += fmt::format(FMT_STRING("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":"),
+                         buf->m_index);
+      AppendJsonString(out, buf->m_name);
+      out += "}}";
+
+      const auto writeZone = [&](const SZone& zone) {
+        out += ",\n{\"name\":";
+        AppendJsonString(out, zone.m_name);
+        out += fmt::format(FMT_STRING(",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}"), buf->m_index,
+                           double(zone.m_beginNs) / 1000.0, double(zone.m_endNs - zone.m_beginNs) / 1000.0);
+        ++zoneCount;
+      };
+      for (const SZone& zone : buf->m_captured) {
+        writeZone(zone);
+      }
+      const u64 written = buf->m_written.load();
+      const u64 drained = buf->m_drained.load();
+      const u64 oldest = std::max(drained, written > kRingSize ? written - kRingSize : 0);
+      dropped += buf->m_dropped.load() + (oldest - drained);
+      for (u64 i = oldest; i < written; ++i) {
+        writeZone(buf->m_zones[i % kRingSize]);
+      }
+    }
+    if (wasEnabled) {
+      Enabled.store(true);
+    }
+  }
+  out += "\n]}\n";
+
+  if (dropped != 0) {
+    Log.report(logvisor::Warning,
+               FMT_STRING("{} profiler zones were dropped after filling a thread's ring within one frame"), dropped);
+  }
+  if (path.empty()) {
+    path = "profile.json";
+  }
+  const std::string pathStr(path);
+  const auto fp = hecl::FopenUnique(pathStr.c_str(), "w");
+  if (fp == nullptr) {
+    Log.report(logvisor::Error, FMT_STRING("Unable to open '{}' for writing"), pathStr);
+    return false;
+  }
+  std::fwrite(out.data(), 1, out.size(), fp.get());
+  Log.report(logvisor::Info, FMT_STRING("Wrote {} profiler zones to '{}'"), zoneCount, pathStr);
+  return true;
+}
+
+} // namespace metaforce
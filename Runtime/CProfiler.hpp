@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Runtime/GCNTypes.hpp"
+
+namespace metaforce {
+
+/* Hierarchical zone profiler. Each thread records completed zones into its own ring buffer, so recording
+ * takes no locks. Captures drain the rings every frame and export as Chrome trace JSON (chrome://tracing or
+ * Perfetto); the previous frame of the main thread can be inspected live from the ImGui console.
+ * Only threads registered with SetThreadName record zones. Zone names are stored by pointer and must be
+ * string literals. */
+class CProfiler {
+public:
+  using Clock = std::chrono::steady_clock;
+  /* Zones a thread may record within one frame before a capture loses them */
+  static constexpr size_t kRingSize = 1 << 14;
+
+  struct SZone {
+    const char* m_name = nullptr;
+    u64 m_beginNs = 0;
+    u64 m_endNs = 0;
+    u32 m_depth = 0;
+  };
+
+  class CZone {
+    const char* m_name;
+    bool m_active;
+    Clock::time_point m_begin;
+
+  public:
+    explicit CZone(const char* name);
+    ~CZone();
+    CZone(const CZone&) = delete;
+    CZone& operator=(const CZone&) = delete;
+  };
+
+  static bool IsEnabled();
+  /* Records a zone measured elsewhere, e.g. by CStopwatch */
+  static void AddZone(const char* name, Clock::time_point begin, Clock::time_point end);
+  /* Registers the calling thread for recording; call once when the thread starts, not from a hot path */
+  static void SetThreadName(std::string_view name);
+
+  /* Starts recording on all threads for frameCount frames, then writes a Chrome trace to outPath */
+  static void StartCapture(u32 frameCount, std::string_view outPath);
+  static bool IsCapturing();
+  /* Keeps recording enabled while the ImGui profiler view is open */
+  static void SetLiveView(bool live);
+  /* Marks a frame boundary; called from the main thread */
+  static void NewFrame();
+
+  /* Zones the calling thread recorded during the previous frame, ordered by start time */
+  static void GetLastFrameZones(std::vector<SZone>& out);
+  static bool WriteChromeTrace(std::string_view path);
+};
+
+} // namespace metaforce
@@ -1,5 +1,7 @@
 #include "Runtime/CResFactory.hpp"
 
+#include "Runtime/CProfiler.hpp"
+#include "Runtime/CResLoadStats.hpp"
 #include "Runtime/CSimplePool.hpp"
 #include "Runtime/CStopwatch.hpp"
 #include "optick.h"
@@ -13,18 +15,25 @@ void CResFactory::AddToLoadList(SLoadingData&& data) {
 }
 
 CFactoryFnReturn CResFactory::BuildSync(const SObjectTag& tag, const CVParamTransfer& xfer, CObjectReference* selfRef) {
+  CProfiler::CZone zone("CResFactory::BuildSync");
+  CResLoadStats::AddSyncBuild(tag);
   CFactoryFnReturn ret;
   if (x5c_factoryMgr.CanMakeMemory(tag)) {
     std::unique_ptr<uint8_t[]> data;
     int size = 0;
+    const auto readStart = std::chrono::steady_clock::now();
     x4_loader.LoadMemResourceSync(tag, data, &size);
+    CResLoadStats::AddDuration(tag.type, CResLoadStats::EMetric::Read, std::chrono::steady_clock::now() - readStart);
     if (size)
       ret = x5c_factoryMgr.MakeObjectFromMemory(tag, std::move(data), size, x4_loader.GetResourceCompression(tag), xfer,
                                                 selfRef);
     else
       ret = std::make_unique<TObjOwnerDerivedFromIObjUntyped>(nullptr);
   } else {
-    if (auto rp = x4_loader.LoadNewResourceSync(tag, nullptr))
+    const auto readStart = std::chrono::steady_clock::now();
+    auto rp = x4_loader.LoadNewResourceSync(tag, nullptr);
+    CResLoadStats::AddDuration(tag.type, CResLoadStats::EMetric::Read, std::chrono::steady_clock::now() - readStart);
+    if (rp)
       ret = x5c_factoryMgr.MakeObject(tag, *rp, xfer, selfRef);
     else
       ret = std::make_unique<TObjOwnerDerivedFromIObjUntyped>(nullptr);
@@ -36,11 +45,14 @@ CFactoryFnReturn CResFactory::BuildSync(const SObjectTag& tag, const CVParamTran
 bool CResFactory::PumpResource(SLoadingData& data) {
   OPTICK_EVENT();
   if (data.x8_dvdReq && data.x8_dvdReq->IsComplete()) {
+    CProfiler::CZone zone("CResFactory::PumpResource");
+    CResLoadStats::AddAsyncBuild(data.x0_tag.type);
+    CResLoadStats::AddDuration(data.x0_tag.type, CResLoadStats::EMetric::QueueWait, data.x8_dvdReq->GetQueueWait());
+    CResLoadStats::AddDuration(data.x0_tag.type, CResLoadStats::EMetric::Read, data.x8_dvdReq->GetReadTime());
     data.x8_dvdReq.reset();
     *data.xc_targetPtr =
         x5c_factoryMgr.MakeObjectFromMemory(data.x0_tag, std::move(data.x10_loadBuffer), data.x14_resSize,
                                             data.m_compressed, data.x18_cvXfer, data.m_selfRef);
-    Log.report(logvisor::Info, FMT_STRING("async-built {}"), data.x0_tag);
     return true;
   }
   return false;
@@ -77,6 +89,7 @@ void CResFactory::BuildAsync(const SObjectTag& tag, const CVParamTransfer& xfer,
 
 bool CResFactory::AsyncIdle(std::chrono::nanoseconds target) {
   OPTICK_EVENT();
+  CProfiler::CZone zone("CResFactory::AsyncIdle");
   if (m_loadList.empty()) {
     return false;
   }
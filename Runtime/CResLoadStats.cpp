@@ -0,0 +1,172 @@
+#include "Runtime/CResLoadStats.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#define METAFORCE_HAS_EXECINFO 1
+#endif
+
+#include <fmt/format.h>
+#include <hecl/hecl.hpp>
+#include <logvisor/logvisor.hpp>
+
+namespace metaforce {
+namespace {
+logvisor::Module Log("metaforce::CResLoadStats");
+
+constexpr size_t MaxSyncBuilds = 256;
+
+constexpr std::array<std::string_view, CResLoadStats::kNumMetrics> MetricNames{
+    "QueueWait", "Read", "Decompress", "Build", "Size", "CompressedSize",
+};
+constexpr std::array<std::string_view, CResLoadStats::kNumMetrics> MetricUnits{
+    "us", "us", "us", "us", "bytes", "bytes",
+};
+
+std::string CaptureCallStack() {
+#if METAFORCE_HAS_EXECINFO
+  std::array<void*, 32> frames{};
+  const int count = backtrace(frames.data(), int(frames.size()));
+  char** symbols = backtrace_symbols(frames.data(), count);
+  if (symbols == nullptr) {
+    return {};
+  }
+  std::string ret;
+  // Skip this function and AddSyncBuild
+  for (int i = 2; i < count; ++i) {
+    ret += symbols[i];
+    ret += '\n';
+  }
+  std::free(symbols);
+  return ret;
+#else
+  return "(call stacks unavailable on this platform)\n";
+#endif
+}
+
+std::string FormatTypeStats(FourCC type, const CResLoadStats::STypeStats& stats) {
+  std::string ret = fmt::format(FMT_STRING("{}: {} async, {} sync"), type.toString(), stats.m_asyncBuilds,
+                                stats.m_syncBuilds);
+  for (size_t m = 0; m < CResLoadStats::kNumMetrics; ++m) {
+    const CResLoadStats::SHistogram& hist = stats.m_metrics[m];
+    if (hist.m_count == 0) {
+      continue;
+    }
+    ret += fmt::format(FMT_STRING(", {} mean {:.0f} p95 {:.0f} max {:.0f}{}"), MetricNames[m],
+                       hist.m_total / hist.m_count, hist.Percentile(0.95), hist.m_max, MetricUnits[m]);
+  }
+  return ret;
+}
+} // Anonymous namespace
+
+std::unordered_map<FourCC, CResLoadStats::STypeStats> CResLoadStats::m_types;
+std::vector<CResLoadStats::SSyncBuild> CResLoadStats::m_syncBuilds;
+
+void CResLoadStats::SHistogram::Add(double value) {
+  const u64 intVal = value < 1.0 ? 0 : u64(value);
+  const size_t bucket = intVal == 0 ? 0 : std::min(size_t(std::bit_width(intVal) - 1), kNumBuckets - 1);
+  ++m_buckets[bucket];
+  ++m_count;
+  m_total += value;
+  m_max = std::max(m_max, value);
+}
+
+double CResLoadStats::SHistogram::Percentile(double pct) const {
+  const u32 target = std::max(u32(1), u32(pct * m_count + 0.5));
+  u32 seen = 0;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    seen += m_buckets[i];
+    if (seen >= target) {
+      return std::min(double(u64(1) << (i + 1)), m_max);
+    }
+  }
+  return m_max;
+}
+
+void CResLoadStats::AddSample(FourCC type, EMetric metric, double value) {
+  m_types[type].m_metrics[size_t(metric)].Add(value);
+}
+
+void CResLoadStats::AddSyncBuild(const SObjectTag& tag) {
+  ++m_types[tag.type].m_syncBuilds;
+  const auto search =
+      std::find_if(m_syncBuilds.begin(), m_syncBuilds.end(), [&](const SSyncBuild& b) { return b.m_tag == tag; });
+  if (search != m_syncBuilds.end()) {
+    ++search->m_count;
+  } else if (m_syncBuilds.size() < MaxSyncBuilds) {
+    m_syncBuilds.push_back({tag, 1, CaptureCallStack()});
+  }
+}
+
+u32 CResLoadStats::GetTotalSyncBuilds() {
+  u32 ret = 0;
+  for (const auto& [type, stats] : m_types) {
+    ret += stats.m_syncBuilds;
+  }
+  return ret;
+}
+
+void CResLoadStats::Reset() {
+  m_types.clear();
+  m_syncBuilds.clear();
+}
+
+std::string_view CResLoadStats::GetMetricName(EMetric metric) { return MetricNames[size_t(metric)]; }
+
+std::string CResLoadStats::Summarize() {
+  std::vector<FourCC> types;
+  types.reserve(m_types.size());
+  for (const auto& [type, stats] : m_types) {
+    types.push_back(type);
+  }
+  std::sort(types.begin(), types.end(), [](FourCC a, FourCC b) { return a.toString() < b.toString(); });
+
+  std::string ret;
+  for (const FourCC type : types) {
+    ret += FormatTypeStats(type, m_types[type]);
+    ret += '\n';
+  }
+  for (const SSyncBuild& build : m_syncBuilds) {
+    ret += fmt::format(FMT_STRING("sync-built {} x{}\n{}"), build.m_tag, build.m_count, build.m_callStack);
+  }
+  return ret;
+}
+
+bool CResLoadStats::WriteCsv(std::string_view path) {
+  const std::string pathStr(path);
+  const auto fp = hecl::FopenUnique(pathStr.c_str(), "w");
+  if (fp == nullptr) {
+    Log.report(logvisor::Error, FMT_STRING("Unable to open '{}' for writing"), pathStr);
+    return false;
+  }
+
+  std::string out = "type,metric,unit,async_builds,sync_builds,count,total,mean,p50,p95,max";
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    out += fmt::format(FMT_STRING(",b{}"), i);
+  }
+  out += '\n';
+  for (const auto& [type, stats] : m_types) {
+    for (size_t m = 0; m < kNumMetrics; ++m) {
+      const SHistogram& hist = stats.m_metrics[m];
+      if (hist.m_count == 0) {
+        continue;
+      }
+      out += fmt::format(FMT_STRING("{},{},{},{},{},{},{:.1f},{:.1f},{:.1f},{:.1f},{:.1f}"), type.toString(),
+                         MetricNames[m], MetricUnits[m], stats.m_asyncBuilds, stats.m_syncBuilds, hist.m_count,
+                         hist.m_total, hist.m_total / hist.m_count, hist.Percentile(0.5), hist.Percentile(0.95),
+                         hist.m_max);
+      for (const u32 bucket : hist.m_buckets) {
+        out += fmt::format(FMT_STRING(",{}"), bucket);
+      }
+      out += '\n';
+    }
+  }
+  std::fwrite(out.data(), 1, out.size(), fp.get());
+  Log.report(logvisor::Info, FMT_STRING("Wrote resource load stats for {} types to '{}'"), m_types.size(), pathStr);
+  return true;
+}
+
+} // namespace metaforce
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Runtime/RetroTypes.hpp"
+
+namespace metaforce {
+
+/* Per-asset-type resource load counters and log2 histograms, recorded by CResFactory and CFactoryMgr
+ * on the main thread. Dumped with the ResourceStats console command. */
+class CResLoadStats {
+public:
+  enum class EMetric {
+    QueueWait,      // us between queueing a DVD read and the worker starting it
+    Read,           // us spent in the DVD read
+    Decompress,     // us inflating a compressed resource before its memory factory runs
+    Build,          // us in the factory; includes inflating for stream factories
+    Size,           // bytes handed to the factory
+    CompressedSize, // bytes read for compressed resources
+    MAX
+  };
+  static constexpr size_t kNumMetrics = size_t(EMetric::MAX);
+  static constexpr size_t kNumBuckets = 32;
+
+  struct SHistogram {
+    /* Bucket i counts values in [2^i, 2^(i+1)); bucket 0 also holds 0 */
+    std::array<u32, kNumBuckets> m_buckets{};
+    u32 m_count = 0;
+    double m_total = 0.0;
+    double m_max = 0.0;
+
+    void Add(double value);
+    /* Upper bound of the bucket containing the given fraction of samples */
+    double Percentile(double pct) const;
+  };
+
+  struct STypeStats {
+    u32 m_asyncBuilds = 0;
+    u32 m_syncBuilds = 0;
+    std::array<SHistogram, kNumMetrics> m_metrics;
+  };
+
+  struct SSyncBuild {
+    SObjectTag m_tag;
+    u32 m_count = 0;
+    std::string m_callStack;
+  };
+
+private:
+  static std::unordered_map<FourCC, STypeStats> m_types;
+  static std::vector<SSyncBuild> m_syncBuilds;
+
+public:
+  static void AddSample(FourCC type, EMetric metric, double value);
+  static void AddDuration(FourCC type, EMetric metric, std::chrono::steady_clock::duration dur) {
+    AddSample(type, metric, std::chrono::duration<double, std::micro>(dur).count());
+  }
+  static void AddAsyncBuild(FourCC type) { ++m_types[type].m_asyncBuilds; }
+  /* Counts a blocking build and keeps the call stack of the first one seen per resource */
+  static void AddSyncBuild(const SObjectTag& tag);
+
+  static const std::unordered_map<FourCC, STypeStats>& GetTypeStats() { return m_types; }
+  static const std::vector<SSyncBuild>& GetSyncBuilds() { return m_syncBuilds; }
+  static u32 GetTotalSyncBuilds();
+  static void Reset();
+
+  static std::string_view GetMetricName(EMetric metric);
+  static std::string Summarize();
+  static bool WriteCsv(std::string_view path);
+};
+
+} // namespace metaforce
@@ -155,6 +155,34 @@ u32 CResLoader::ResourceSize(const SObjectTag& tag) const {
   return 0;
 }
 
+bool CResLoader::GetResourceLocation(CAssetId id, std::string_view& pakOut, u32& offsetOut, u32& sizeOut) const {
+  /* Same search order as FindResource, remembering which pak answered */
+  const auto locate = [&](const CPakFile& file) {
+    if (!CacheFromPak(file, id))
+      return false;
+    pakOut = file.GetPath();
+    offsetOut = x50_cachedResInfo->GetOffset();
+    sizeOut = x50_cachedResInfo->GetSize();
+    return true;
+  };
+
+  for (const std::unique_ptr<CPakFile>& file : m_overridePakList)
+    if (locate(*file))
+      return true;
+
+  if (x48_curPak != x18_pakLoadedList.end())
+    if (locate(**x48_curPak))
+      return true;
+
+  for (auto it = x18_pakLoadedList.begin(); it != x18_pakLoadedList.end(); ++it) {
+    if (it == x48_curPak)
+      continue;
+    if (locate(**it))
+      return true;
+  }
+  return false;
+}
+
 bool CResLoader::ResourceExists(const SObjectTag& tag) const { return FindResource(tag.id); }
 
 FourCC CResLoader::GetResourceTypeById(CAssetId id) const {
@@ -4,6 +4,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "Runtime/CPakFile.hpp"
@@ -47,6 +48,7 @@ public:
   void GetTagListForFile(const char* pakName, std::vector<SObjectTag>& out) const;
   bool GetResourceCompression(const SObjectTag& tag) const;
   u32 ResourceSize(const SObjectTag& tag) const;
+  bool GetResourceLocation(CAssetId id, std::string_view& pakOut, u32& offsetOut, u32& sizeOut) const;
   bool ResourceExists(const SObjectTag& tag) const;
   FourCC GetResourceTypeById(CAssetId id) const;
   const SObjectTag* GetResourceIdByName(std::string_view name) const;
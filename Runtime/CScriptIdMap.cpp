@@ -0,0 +1,149 @@
+#include "Runtime/CScriptIdMap.hpp"
+
+#include <algorithm>
+
+namespace metaforce {
+
+const CScriptIdMap::SBucket* CScriptIdMap::FindBucket(u32 key) const {
+  for (size_t i = HashKey(key);; i = (i + 1) & (kNumBuckets - 1)) {
+    const SBucket& bucket = m_buckets[i];
+    if (bucket.m_key == key) {
+      return &bucket;
+    }
+    if (bucket.m_key == kEmptyKey) {
+      return nullptr;
+    }
+  }
+}
+
+CScriptIdMap::SBucket& CScriptIdMap::FindOrAddBucket(u32 key) {
+  if ((m_numKeys + m_numTombstones + 1) * 4 > kNumBuckets * 3) {
+    Rehash();
+  }
+
+  SBucket* reuse = nullptr;
+  for (size_t i = HashKey(key);; i = (i + 1) & (kNumBuckets - 1)) {
+    SBucket& bucket = m_buckets[i];
+    if (bucket.m_key == key) {
+      return bucket;
+    }
+    if (bucket.m_key == kTombstoneKey) {
+      if (reuse == nullptr) {
+        reuse = &bucket;
+      }
+    } else if (bucket.m_key == kEmptyKey) {
+      if (reuse != nullptr) {
+        --m_numTombstones;
+      } else {
+        reuse = &bucket;
+      }
+      break;
+    }
+  }
+
+  ++m_numKeys;
+  *reuse = SBucket{key, 0, kInvalidNode, kInvalidNode};
+  return *reuse;
+}
+
+void CScriptIdMap::Rehash() {
+  const std::array<SBucket, kNumBuckets> old = m_buckets;
+  m_buckets.fill(SBucket{});
+  m_numTombstones = 0;
+  for (const SBucket& bucket : old) {
+    if (bucket.m_key == kEmptyKey || bucket.m_key == kTombstoneKey) {
+      continue;
+    }
+    size_t i = HashKey(bucket.m_key);
+    while (m_buckets[i].m_key != kEmptyKey) {
+      i = (i + 1) & (kNumBuckets - 1);
+    }
+    m_buckets[i] = bucket;
+  }
+}
+
+void CScriptIdMap::Insert(TEditorId editorId, TUniqueId uid) {
+  const s16 idx = s16(uid.Value());
+  if (m_nodes[idx].m_inUse) {
+    Erase(m_nodes[idx].m_value.second);
+  }
+
+  SBucket& bucket = FindOrAddBucket(MaskKey(editorId));
+  SNode& node = m_nodes[idx];
+  node.m_value = {editorId, uid};
+  node.m_seq = m_nextSeq++;
+  node.m_prev = bucket.m_tail;
+  node.m_next = kInvalidNode;
+  node.m_inUse = true;
+  if (bucket.m_tail != kInvalidNode) {
+    m_nodes[bucket.m_tail].m_next = idx;
+  } else {
+    bucket.m_head = idx;
+  }
+  bucket.m_tail = idx;
+
+  ++m_size;
+  bucket.m_stamp = ++m_generation;
+}
+
+bool CScriptIdMap::Erase(TUniqueId uid) {
+  const s16 idx = s16(uid.Value());
+  SNode& node = m_nodes[idx];
+  if (!node.m_inUse || node.m_value.second != uid) {
+    return false;
+  }
+
+  SBucket& bucket = *FindBucket(MaskKey(node.m_value.first));
+  if (node.m_prev != kInvalidNode) {
+    m_nodes[node.m_prev].m_next = node.m_next;
+  } else {
+    bucket.m_head = node.m_next;
+  }
+  if (node.m_next != kInvalidNode) {
+    m_nodes[node.m_next].m_prev = node.m_prev;
+  } else {
+    bucket.m_tail = node.m_prev;
+  }
+  if (bucket.m_head == kInvalidNode) {
+    bucket.m_key = kTombstoneKey;
+    --m_numKeys;
+    ++m_numTombstones;
+  }
+
+  // m_next is left intact so an iterator parked on this node can still advance
+  node.m_inUse = false;
+  --m_size;
+  bucket.m_stamp = ++m_generation;
+  return true;
+}
+
+CScriptIdMap::const_iterator CScriptIdMap::Find(TEditorId editorId) const {
+  const SBucket* bucket = FindBucket(MaskKey(editorId));
+  return {this, bucket != nullptr ? bucket->m_head : kInvalidNode};
+}
+
+CScriptIdMap::const_iterator CScriptIdMap::Locate(TUniqueId uid) const {
+  const s16 idx = s16(uid.Value());
+  const SNode& node = m_nodes[idx];
+  return {this, node.m_inUse && node.m_value.second == uid ? idx : kInvalidNode};
+}
+
+void CScriptIdMap::GetAreaEntries(TAreaId area, std::vector<value_type>& out) const {
+  std::vector<const SNode*> nodes;
+  for (const SNode& node : m_nodes) {
+    if (node.m_inUse && node.m_value.first.AreaNum() == area) {
+      nodes.push_back(&node);
+    }
+  }
+  std::sort(nodes.begin(), nodes.end(), [](const SNode* a, const SNode* b) {
+    const u32 keyA = MaskKey(a->m_value.first);
+    const u32 keyB = MaskKey(b->m_value.first);
+    return keyA != keyB ? keyA < keyB : a->m_seq < b->m_seq;
+  });
+  out.reserve(out.size() + nodes.size());
+  for (const SNode* node : nodes) {
+    out.push_back(node->m_value);
+  }
+}
+
+} // namespace metaforce
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "Runtime/RetroTypes.hpp"
+
+namespace metaforce {
+
+/* Editor ID -> unique ID index used for script message routing.
+ * Keys live in a flat open-addressing table; the targets of each key form a chain through a node array
+ * indexed by unique ID. Like the std::multimap it replaces, targets sharing an editor ID are visited
+ * in insertion order and iterators stay valid while objects are added or removed elsewhere. */
+class CScriptIdMap {
+public:
+  using value_type = std::pair<TEditorId, TUniqueId>;
+
+private:
+  static constexpr s16 kInvalidNode = -1;
+  static constexpr u32 kEmptyKey = UINT32_MAX;
+  static constexpr u32 kTombstoneKey = UINT32_MAX - 1;
+  static constexpr size_t kNumBuckets = kMaxEntities * 2;
+
+  struct SNode {
+    value_type m_value;
+    u32 m_seq = 0;
+    s16 m_prev = kInvalidNode;
+    s16 m_next = kInvalidNode;
+    bool m_inUse = false;
+  };
+
+  struct SBucket {
+    u32 m_key = kEmptyKey;
+    u32 m_stamp = 0;
+    s16 m_head = kInvalidNode;
+    s16 m_tail = kInvalidNode;
+  };
+
+  std::array<SNode, kMaxEntities> m_nodes{};
+  std::array<SBucket, kNumBuckets> m_buckets{};
+  u32 m_size = 0;
+  u32 m_numKeys = 0;
+  u32 m_numTombstones = 0;
+  u32 m_nextSeq = 0;
+  u32 m_generation = 0;
+
+  static constexpr u32 MaskKey(TEditorId id) { return id.id & 0x3ffffff; }
+  static constexpr size_t HashKey(u32 key) { return size_t((key * 0x9E3779B1u) >> 21) & (kNumBuckets - 1); }
+  const SBucket* FindBucket(u32 key) const;
+  SBucket* FindBucket(u32 key) { return const_cast<SBucket*>(std::as_const(*this).FindBucket(key)); }
+  SBucket& FindOrAddBucket(u32 key);
+  void Rehash();
+
+public:
+  class const_iterator {
+    friend class CScriptIdMap;
+    const CScriptIdMap* m_map = nullptr;
+    s16 m_node = kInvalidNode;
+
+    const_iterator(const CScriptIdMap* map, s16 node) : m_map(map), m_node(node) {}
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = CScriptIdMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    const_iterator() = default;
+    reference operator*() const { return m_map->m_nodes[m_node].m_value; }
+    pointer operator->() const { return &m_map->m_nodes[m_node].m_value; }
+    const_iterator& operator++() {
+      m_node = m_map->m_nodes[m_node].m_next;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator ret = *this;
+      ++*this;
+      return ret;
+    }
+    bool operator==(const const_iterator& other) const { return m_node == other.m_node; }
+    bool operator!=(const const_iterator& other) const { return m_node != other.m_node; }
+  };
+
+  void Insert(TEditorId editorId, TUniqueId uid);
+  bool Erase(TUniqueId uid);
+
+  /* First target of editorId, or end() */
+  const_iterator Find(TEditorId editorId) const;
+  std::pair<const_iterator, const_iterator> EqualRange(TEditorId editorId) const { return {Find(editorId), end()}; }
+  /* Position of uid within its editor ID's targets, or end() */
+  const_iterator Locate(TUniqueId uid) const;
+  const_iterator end() const { return {this, kInvalidNode}; }
+
+  /* All entries belonging to area, in multimap order */
+  void GetAreaEntries(TAreaId area, std::vector<value_type>& out) const;
+
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+  /* Bumped on every insertion and removal */
+  u32 GetGeneration() const { return m_generation; }
+  /* Generation of the last change to editorId's targets, or 0 if it has none */
+  u32 GetKeyStamp(TEditorId editorId) const {
+    const SBucket* bucket = FindBucket(MaskKey(editorId));
+    return bucket != nullptr ? bucket->m_stamp : 0;
+  }
+};
+
+} // namespace metaforce
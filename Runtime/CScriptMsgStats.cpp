@@ -0,0 +1,47 @@
+#include "Runtime/CScriptMsgStats.hpp"
+
+#include <algorithm>
+
+namespace metaforce {
+
+CScriptMsgStats::SFrameStats CScriptMsgStats::m_curStats;
+CScriptMsgStats::SFrameStats CScriptMsgStats::m_lastStats;
+u32 CScriptMsgStats::m_depth = 0;
+bool CScriptMsgStats::m_timingEnabled = false;
+
+CScriptMsgStats::CDispatchScope::CDispatchScope(EScriptObjectMessage msg) : m_msg(msg), m_timed(m_timingEnabled) {
+  ++m_depth;
+  m_curStats.m_maxDepth = std::max(m_curStats.m_maxDepth, m_depth);
+  ++m_curStats.m_total;
+  if (SMessageStats* stats = GetMessageStats(msg)) {
+    ++stats->m_count;
+  }
+  if (m_timed) {
+    m_start = std::chrono::steady_clock::now();
+  }
+}
+
+CScriptMsgStats::CDispatchScope::~CDispatchScope() {
+  --m_depth;
+  if (!m_timed) {
+    return;
+  }
+  if (SMessageStats* stats = GetMessageStats(m_msg)) {
+    stats->m_inclusiveUs +=
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_start).count();
+  }
+}
+
+void CScriptMsgStats::AddDeferred(EScriptObjectMessage msg) {
+  ++m_curStats.m_deferred;
+  if (SMessageStats* stats = GetMessageStats(msg)) {
+    ++stats->m_deferred;
+  }
+}
+
+void CScriptMsgStats::NewFrame() {
+  m_lastStats = m_curStats;
+  m_curStats = {};
+}
+
+} // namespace metaforce
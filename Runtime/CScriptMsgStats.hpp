@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+
+#include "Runtime/GCNTypes.hpp"
+#include "Runtime/World/ScriptObjectSupport.hpp"
+
+namespace metaforce {
+
+/* Per-frame counts and costs of script message dispatch, broken down by message type.
+ * Cost is inclusive of any messages sent while handling the message. */
+class CScriptMsgStats {
+public:
+  static constexpr size_t kNumMessages = size_t(EScriptObjectMessage::SuspendedMove) + 1;
+
+  struct SMessageStats {
+    u32 m_count = 0;
+    u32 m_deferred = 0;
+    double m_inclusiveUs = 0.0;
+  };
+
+  struct SFrameStats {
+    std::array<SMessageStats, kNumMessages> m_messages{};
+    u32 m_total = 0;
+    u32 m_deferred = 0;
+    u32 m_maxDepth = 0;
+  };
+
+  class CDispatchScope {
+    EScriptObjectMessage m_msg;
+    bool m_timed;
+    std::chrono::steady_clock::time_point m_start;
+
+  public:
+    explicit CDispatchScope(EScriptObjectMessage msg);
+    ~CDispatchScope();
+    CDispatchScope(const CDispatchScope&) = delete;
+    CDispatchScope& operator=(const CDispatchScope&) = delete;
+  };
+
+private:
+  static SFrameStats m_curStats;
+  static SFrameStats m_lastStats;
+  static u32 m_depth;
+  static bool m_timingEnabled;
+
+  static SMessageStats* GetMessageStats(EScriptObjectMessage msg) {
+    return size_t(msg) < kNumMessages ? &m_curStats.m_messages[size_t(msg)] : nullptr;
+  }
+
+public:
+  static void AddDeferred(EScriptObjectMessage msg);
+
+  /* Latches the previous frame's statistics */
+  static void NewFrame();
+  static const SFrameStats& GetLastFrameStats() { return m_lastStats; }
+
+  static void SetTimingEnabled(bool enabled) { m_timingEnabled = enabled; }
+};
+
+} // namespace metaforce
@@ -1,5 +1,6 @@
 #include "Runtime/CSimplePool.hpp"
 
+#include "Runtime/CMemoryTags.hpp"
 #include "Runtime/CToken.hpp"
 #include "Runtime/IVParamObj.hpp"
 
@@ -10,7 +11,10 @@ namespace metaforce {
 CSimplePool::CSimplePool(IFactory& factory)
 : x18_factory(factory), x1c_paramXfer(new TObjOwnerParam<IObjectStore*>(this)) {}
 
-CSimplePool::~CSimplePool() { assert(x8_resources.empty() && "Dangling CSimplePool resources detected"); }
+CSimplePool::~CSimplePool() {
+  SetResidencyBudget(0);
+  assert(x8_resources.empty() && "Dangling CSimplePool resources detected");
+}
 
 CToken CSimplePool::GetObj(const SObjectTag& tag, const CVParamTransfer& paramXfer) {
   if (!tag) {
@@ -23,6 +27,9 @@ CToken CSimplePool::GetObj(const SObjectTag& tag, const CVParamTransfer& paramXf
   }
 
   auto* const ret = new CObjectReference(*this, nullptr, tag, paramXfer);
+  ret->m_memoryTag = CMemoryTags::GetCurrentTag();
+  ret->m_memorySize = x18_factory.ResourceSize(tag);
+  CMemoryTags::Add(ret->m_memoryTag, ret->m_memorySize);
   x8_resources.emplace(tag, ret);
   return CToken(ret);
 }
@@ -52,12 +59,63 @@ bool CSimplePool::ObjectIsLive(const SObjectTag& tag) const {
   return iter->second->IsLoaded();
 }
 
-void CSimplePool::Flush() {}
+void CSimplePool::Flush() { TrimResident(); }
 
 void CSimplePool::ObjectUnreferenced(const SObjectTag& tag) {
   auto iter = x8_resources.find(tag);
-  if (iter != x8_resources.end())
+  if (iter != x8_resources.end()) {
+    CMemoryTags::Sub(iter->second->m_memoryTag, iter->second->m_memorySize);
     x8_resources.erase(iter);
+  }
+}
+
+bool CSimplePool::RetainUnloadedObject(const SObjectTag& tag, std::unique_ptr<IObj>& obj) {
+  const u32 size = x18_factory.ResourceSize(tag);
+  if (m_residencyBudget == 0 || size > m_residencyBudget || m_resident.contains(tag)) {
+    return false;
+  }
+  m_residentLru.push_front(tag);
+  m_resident.emplace(tag, SResidentObject{std::move(obj), size, m_residentLru.begin()});
+  m_residentBytes += size;
+  TrimResident();
+  return true;
+}
+
+bool CSimplePool::TakeRetainedObject(const SObjectTag& tag, std::unique_ptr<IObj>& out) {
+  const auto search = m_resident.find(tag);
+  if (search == m_resident.end()) {
+    ++m_residencyStats.m_misses;
+    return false;
+  }
+  ++m_residencyStats.m_hits;
+  out = std::move(search->second.m_obj);
+  m_residentBytes -= search->second.m_size;
+  m_residentLru.erase(search->second.m_lruIt);
+  m_resident.erase(search);
+  return true;
+}
+
+void CSimplePool::TrimResident() {
+  /* Destroying an object may unload its dependencies back into the LRU; the outer loop handles them */
+  if (m_trimming) {
+    return;
+  }
+  m_trimming = true;
+  while ((m_residentBytes > m_residencyBudget || m_residencyBudget == 0) && !m_residentLru.empty()) {
+    const auto search = m_resident.find(m_residentLru.back());
+    std::unique_ptr<IObj> evicted = std::move(search->second.m_obj);
+    m_residentBytes -= search->second.m_size;
+    m_residentLru.pop_back();
+    m_resident.erase(search);
+    ++m_residencyStats.m_evictions;
+    evicted.reset();
+  }
+  m_trimming = false;
+}
+
+void CSimplePool::SetResidencyBudget(size_t bytes) {
+  m_residencyBudget = bytes;
+  TrimResident();
 }
 
 std::vector<SObjectTag> CSimplePool::GetReferencedTags() const {
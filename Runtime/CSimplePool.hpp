@@ -1,5 +1,7 @@
 #pragma once
 
+#include <list>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -12,6 +14,15 @@ class CObjectReference;
 class IFactory;
 
 class CSimplePool : public IObjectStore {
+public:
+  static constexpr size_t kDefaultResidencyBudget = 64 * 1024 * 1024;
+
+  struct SResidencyStats {
+    u32 m_hits = 0;
+    u32 m_misses = 0;
+    u32 m_evictions = 0;
+  };
+
 protected:
   u8 x4_;
   u8 x5_;
@@ -19,6 +30,22 @@ protected:
   IFactory& x18_factory;
   CVParamTransfer x1c_paramXfer;
 
+  /* metaforce addition: unlocked objects stay resident in an LRU until the byte budget is exceeded,
+   * so revisiting an area does not rebuild them. Sizes are packed resource sizes. */
+  struct SResidentObject {
+    std::unique_ptr<IObj> m_obj;
+    u32 m_size = 0;
+    std::list<SObjectTag>::iterator m_lruIt;
+  };
+  std::unordered_map<SObjectTag, SResidentObject> m_resident;
+  std::list<SObjectTag> m_residentLru; /* Most recently unloaded first */
+  size_t m_residentBytes = 0;
+  size_t m_residencyBudget = kDefaultResidencyBudget;
+  SResidencyStats m_residencyStats;
+  bool m_trimming = false;
+
+  void TrimResident();
+
 public:
   CSimplePool(IFactory& factory);
   ~CSimplePool() override;
@@ -31,8 +58,18 @@ public:
   IFactory& GetFactory() const override { return x18_factory; }
   void Flush() override;
   void ObjectUnreferenced(const SObjectTag&) override;
+  bool RetainUnloadedObject(const SObjectTag& tag, std::unique_ptr<IObj>& obj) override;
+  bool TakeRetainedObject(const SObjectTag& tag, std::unique_ptr<IObj>& out) override;
   std::vector<SObjectTag> GetReferencedTags() const;
   size_t GetLiveObjects() const { return x8_resources.size(); }
+
+  /* Evicts least recently used objects until resident bytes fit; 0 disables residency */
+  void SetResidencyBudget(size_t bytes);
+  size_t GetResidencyBudget() const { return m_residencyBudget; }
+  size_t GetResidentBytes() const { return m_residentBytes; }
+  size_t GetResidentObjects() const { return m_resident.size(); }
+  const SResidencyStats& GetResidencyStats() const { return m_residencyStats; }
+  void ResetResidencyStats() { m_residencyStats = {}; }
 };
 
 } // namespace metaforce
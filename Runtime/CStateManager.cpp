@@ -6,20 +6,25 @@
 #include "Runtime/Camera/CBallCamera.hpp"
 #include "Runtime/Camera/CCameraShakeData.hpp"
 #include "Runtime/Camera/CGameCamera.hpp"
+#include "Runtime/CFrameBenchmark.hpp"
 #include "Runtime/CGameState.hpp"
 #include "Runtime/CMemoryCardSys.hpp"
+#include "Runtime/CMemoryTags.hpp"
 #include "Runtime/Collision/CCollisionActor.hpp"
 #include "Runtime/Collision/CCollidableSphere.hpp"
 #include "Runtime/Collision/CGameCollision.hpp"
 #include "Runtime/Collision/CMaterialFilter.hpp"
 #include "Runtime/Collision/CollisionUtil.hpp"
 #include "Runtime/CPlayerState.hpp"
+#include "Runtime/CProfiler.hpp"
+#include "Runtime/CScriptMsgStats.hpp"
 #include "Runtime/CSortedLists.hpp"
 #include "Runtime/CTimeProvider.hpp"
 #include "Runtime/GameGlobalObjects.hpp"
 #include "Runtime/Graphics/CBooRenderer.hpp"
 #include "Runtime/Graphics/CLight.hpp"
 #include "Runtime/Input/ControlMapper.hpp"
+#include "Runtime/Input/CInputRecorder.hpp"
 #include "Runtime/Input/CRumbleManager.hpp"
 #include "Runtime/MP1/CSamusHud.hpp"
 #include "Runtime/MP1/MP1.hpp"
@@ -51,6 +56,7 @@
 
 #include <hecl/CVarManager.hpp>
 #include <zeus/CMRay.hpp>
+#include <xxhash/xxhash.h>
 
 namespace metaforce {
 namespace {
@@ -218,7 +224,7 @@ CStateManager::CStateManager(const std::weak_ptr<CScriptMailbox>& mailbox, const
 
   if (sm_logScripting == nullptr) {
     sm_logScripting = hecl::CVarManager::instance()->findOrMakeCVar(
-        "stateManager.logScripting"sv, "Prints object communication to the console", false,
+        "stateManager.logScripting"sv, "Prints object creation and removal to the console", false,
         hecl::CVar::EFlags::ReadOnly | hecl::CVar::EFlags::Archive | hecl::CVar::EFlags::Game);
   }
   m_logScriptingReference.emplace(&m_logScripting, sm_logScripting);
@@ -1329,17 +1335,7 @@ void CStateManager::SendScriptMsg(CEntity* dest, TUniqueId src, EScriptObjectMes
     return;
   }
 
-  if (m_logScripting) {
-    auto srcObj = GetObjectById(src);
-    if (srcObj != nullptr) {
-      LogModule.report(logvisor::Info, FMT_STRING("{} is sending '{}' to '{}' id= {} -> {}"), srcObj->GetName(),
-                       ScriptObjectMessageToStr(msg), dest->GetName(), dest->GetUniqueId(), src, dest->GetUniqueId());
-    } else {
-      LogModule.report(logvisor::Info, FMT_STRING("Sending '{}' to '{}' id= {}"), ScriptObjectMessageToStr(msg),
-                       dest->GetName(), dest->GetUniqueId());
-    }
-  }
-
+  CScriptMsgStats::CDispatchScope stats(msg);
   dest->AcceptScriptMsg(msg, src, *this);
 }
 
@@ -1354,24 +1350,34 @@ void CStateManager::SendScriptMsgAlways(TUniqueId dest, TUniqueId src, EScriptOb
     return;
   }
 
-  if (m_logScripting) {
-    auto srcObj = GetObjectById(src);
-    if (srcObj != nullptr) {
-      LogModule.report(logvisor::Info, FMT_STRING("{} is sending '{}' to '{}' id= {} -> {}"), srcObj->GetName(),
-                       ScriptObjectMessageToStr(msg), dst->GetName(), dst->GetUniqueId(), src, dst->GetUniqueId());
-    } else {
-      LogModule.report(logvisor::Info, FMT_STRING("Sending '{}' to '{}' id= {}"), ScriptObjectMessageToStr(msg),
-                       dst->GetName(), dst->GetUniqueId());
-    }
+  CScriptMsgStats::CDispatchScope stats(msg);
+  dst->AcceptScriptMsg(msg, src, *this);
+}
+
+void CStateManager::DeferScriptMsg(TUniqueId dest, TUniqueId src, EScriptObjectMessage msg) {
+  if (m_deferredScriptMsgCount == kMaxDeferredScriptMsgs) {
+    DeliverDeferredScriptMsgs();
   }
+  const size_t idx = (m_deferredScriptMsgHead + m_deferredScriptMsgCount) % kMaxDeferredScriptMsgs;
+  m_deferredScriptMsgs[idx] = {dest, src, msg};
+  ++m_deferredScriptMsgCount;
+  CScriptMsgStats::AddDeferred(msg);
+}
 
-  dst->AcceptScriptMsg(msg, src, *this);
+void CStateManager::DeliverDeferredScriptMsgs() {
+  // Receivers may defer further messages; those are delivered in the same pass
+  while (m_deferredScriptMsgCount != 0) {
+    const SDeferredScriptMsg deferred = m_deferredScriptMsgs[m_deferredScriptMsgHead];
+    m_deferredScriptMsgHead = (m_deferredScriptMsgHead + 1) % kMaxDeferredScriptMsgs;
+    --m_deferredScriptMsgCount;
+    SendScriptMsg(ObjectById(deferred.m_dest), deferred.m_src, deferred.m_msg);
+  }
 }
 
 void CStateManager::SendScriptMsg(TUniqueId src, TEditorId dest, EScriptObjectMessage msg, EScriptObjectState state) {
   // CEntity* ent = GetObjectById(src);
   const auto search = GetIdListForScript(dest);
-  if (search.first == x890_scriptIdMap.cend()) {
+  if (search.first == x890_scriptIdMap.end()) {
     return;
   }
 
@@ -1383,10 +1389,10 @@ void CStateManager::SendScriptMsg(TUniqueId src, TEditorId dest, EScriptObjectMe
 }
 
 void CStateManager::FreeScriptObjects(TAreaId aid) {
-  for (const auto& p : x890_scriptIdMap) {
-    if (p.first.AreaNum() == aid) {
-      FreeScriptObject(p.second);
-    }
+  std::vector<CScriptIdMap::value_type> areaIds;
+  x890_scriptIdMap.GetAreaEntries(aid, areaIds);
+  for (const auto& p : areaIds) {
+    FreeScriptObject(p.second);
   }
 
   std::set<TEditorId> freedObjects;
@@ -1452,21 +1458,16 @@ TEditorId CStateManager::GetEditorIdForUniqueId(TUniqueId id) const {
 }
 
 TUniqueId CStateManager::GetIdForScript(TEditorId id) const {
-  const auto search = x890_scriptIdMap.find(id);
-  if (search == x890_scriptIdMap.cend()) {
+  const auto search = x890_scriptIdMap.Find(id);
+  if (search == x890_scriptIdMap.end()) {
     return kInvalidUniqueId;
   }
   return search->second;
 }
 
-std::pair<std::multimap<TEditorId, TUniqueId>::const_iterator, std::multimap<TEditorId, TUniqueId>::const_iterator>
+std::pair<CScriptIdMap::const_iterator, CScriptIdMap::const_iterator>
 CStateManager::GetIdListForScript(TEditorId id) const {
-  auto ret = x890_scriptIdMap.equal_range(id);
-  if (ret.first != x890_scriptIdMap.cend() && ret.first->first != id) {
-    ret.first = x890_scriptIdMap.cend();
-    ret.second = x890_scriptIdMap.cend();
-  }
-  return ret;
+  return x890_scriptIdMap.EqualRange(id);
 }
 
 void CStateManager::LoadScriptObjects(TAreaId aid, CInputStream& in, std::vector<TEditorId>& idsOut) {
@@ -2159,6 +2160,8 @@ void CStateManager::UpdateGraphicsTiming(float dt) {
 }
 
 void CStateManager::Update(float dt) {
+  CProfiler::CZone zone("CStateManager::Update");
+  CFrameBenchmark::BeginFrame();
   MP1::CMain::UpdateDiscordPresence(GetWorld()->IGetStringTableAssetId());
 
   CElementGen::SetGlobalSeed(x8d8_updateFrameIdx);
@@ -2187,54 +2190,73 @@ void CStateManager::Update(float dt) {
   }
 
   if (x904_gameState != EGameState::Paused) {
+    CFrameBenchmark::CPhaseScope phase(CFrameBenchmark::EPhase::PreThink);
     PreThinkObjects(dt);
     x87c_fluidPlaneManager->Update(dt);
   }
+  DeliverDeferredScriptMsgs();
 
   if (x904_gameState == EGameState::Running) {
     if (!dying) {
+      CFrameBenchmark::CPhaseScope phase(CFrameBenchmark::EPhase::Particles);
       CDecalManager::Update(dt, *this);
     }
-    UpdateSortedLists();
-    if (!dying) {
-      MovePlatforms(dt);
-      MoveActors(dt);
+    {
+      CFrameBenchmark::CPhaseScope phase(CFrameBenchmark::EPhase::MoveActors);
+      UpdateSortedLists();
+      if (!dying) {
+        MovePlatforms(dt);
+        MoveActors(dt);
+      }
     }
     ProcessPlayerInput();
-    if (x904_gameState != EGameState::SoftPaused) {
-      CGameCollision::Move(*this, *x84c_player, dt, nullptr);
-    }
-    UpdateSortedLists();
-    if (!dying) {
-      CrossTouchActors();
+    {
+      CFrameBenchmark::CPhaseScope phase(CFrameBenchmark::EPhase::Collision);
+      if (x904_gameState != EGameState::SoftPaused) {
+        CGameCollision::Move(*this, *x84c_player, dt, nullptr);
+      }
+      UpdateSortedLists();
+      if (!dying) {
+        CrossTouchActors();
+      }
     }
+    DeliverDeferredScriptMsgs();
   } else {
     ProcessPlayerInput();
   }
 
   if (!dying && x904_gameState == EGameState::Running) {
+    CFrameBenchmark::CPhaseScope phase(CFrameBenchmark::EPhase::Particles);
     x884_actorModelParticles->Update(dt, *this);
   }
 
-  if (x904_gameState == EGameState::Running || x904_gameState == EGameState::SoftPaused) {
-    Think(dt);
+  {
+    CFrameBenchmark::CPhaseScope phase(CFrameBenchmark::EPhase::Think);
+    if (x904_gameState == EGameState::Running || x904_gameState == EGameState::SoftPaused) {
+      Think(dt);
+    }
   }
+  DeliverDeferredScriptMsgs();
 
   if (x904_gameState != EGameState::SoftPaused) {
+    CFrameBenchmark::CPhaseScope phase(CFrameBenchmark::EPhase::Camera);
     x870_cameraManager->Update(dt, *this);
   }
 
-  while (xf76_lastRelay != kInvalidUniqueId) {
-    if (CEntity* ent = ObjectById(xf76_lastRelay)) {
-      ent->Think(dt, *this);
-    } else {
-      xf76_lastRelay = kInvalidUniqueId;
-      break;
+  {
+    CFrameBenchmark::CPhaseScope phase(CFrameBenchmark::EPhase::Think);
+    while (xf76_lastRelay != kInvalidUniqueId) {
+      if (CEntity* ent = ObjectById(xf76_lastRelay)) {
+        ent->Think(dt, *this);
+      } else {
+        xf76_lastRelay = kInvalidUniqueId;
+        break;
+      }
     }
-  }
 
-  if (x904_gameState != EGameState::Paused) {
-    PostUpdatePlayer(dt);
+    if (x904_gameState != EGameState::Paused) {
+      PostUpdatePlayer(dt);
+    }
   }
 
   if (xf84_ == xf80_hudMessageFrameCount) {
@@ -2247,10 +2269,14 @@ void CStateManager::Update(float dt) {
     UpdateEscapeSequenceTimer(dt);
   }
 
-  x850_world->Update(dt);
-  x88c_rumbleManager->Update(dt);
+  {
+    CFrameBenchmark::CPhaseScope phase(CFrameBenchmark::EPhase::World);
+    x850_world->Update(dt);
+    x88c_rumbleManager->Update(dt);
+  }
 
   if (!dying) {
+    CFrameBenchmark::CPhaseScope phase(CFrameBenchmark::EPhase::Particles);
     x880_envFxManager->Update(dt, *this);
   }
 
@@ -2267,13 +2293,22 @@ void CStateManager::Update(float dt) {
     xf94_27_inMapScreen = false;
   }
 
-  if (!m_warping) {
-    g_GameState->CurrentWorldState().SetAreaId(x8cc_nextAreaId);
-    x850_world->TravelToArea(x8cc_nextAreaId, *this, false);
-  }
+  {
+    CFrameBenchmark::CPhaseScope phase(CFrameBenchmark::EPhase::World);
+    if (!m_warping) {
+      g_GameState->CurrentWorldState().SetAreaId(x8cc_nextAreaId);
+      x850_world->TravelToArea(x8cc_nextAreaId, *this, false);
+    }
 
-  ClearGraveyard();
+    DeliverDeferredScriptMsgs();
+    ClearGraveyard();
+  }
   ++x8d8_updateFrameIdx;
+  CFrameBenchmark::EndFrame();
+
+  if (CInputRecorder::IsActive()) {
+    CInputRecorder::ProcessStateHash(HashSimulationState());
+  }
 }
 
 void CStateManager::UpdateGameState() {
@@ -2315,27 +2350,27 @@ void CStateManager::PreThinkObjects(float dt) {
   if (x84c_player->x9f4_deathTime > 0.f) {
     x84c_player->DoPreThink(dt, *this);
   } else if (x904_gameState == EGameState::SoftPaused) {
-    for (CEntity* ent : GetAllObjectList()) {
-      if (const TCastToPtr<CScriptEffect> effect = ent) {
-        effect->PreThink(dt, *this);
+    for (const auto& entry : GetAllObjectList().GetPackedEntries()) {
+      if (m_entityKinds[entry.id].m_scriptEffect) {
+        static_cast<CScriptEffect*>(entry.entity)->PreThink(dt, *this);
       }
     }
   } else {
-    for (CEntity* ent : GetAllObjectList()) {
-      if (ent != nullptr && !GetCameraObjectList().GetObjectById(ent->GetUniqueId())) {
-        ent->PreThink(dt, *this);
+    for (const auto& entry : GetAllObjectList().GetPackedEntries()) {
+      if (!IsCameraManaged(entry)) {
+        entry.entity->PreThink(dt, *this);
       }
     }
   }
 }
 
 void CStateManager::MovePlatforms(float dt) {
-  for (CEntity* ent : GetPlatformAndDoorObjectList()) {
-    if (ent == nullptr || !GetPlatformAndDoorObjectList().IsPlatform(*ent)) {
+  for (const auto& entry : GetPlatformAndDoorObjectList().GetPackedEntries()) {
+    if (!m_entityKinds[entry.id].m_platform) {
       continue;
     }
 
-    auto& plat = static_cast<CScriptPlatform&>(*ent);
+    auto& plat = static_cast<CScriptPlatform&>(*entry.entity);
     if (!plat.GetActive() || plat.GetMass() == 0.f) {
       continue;
     }
@@ -2344,9 +2379,25 @@ void CStateManager::MovePlatforms(float dt) {
   }
 }
 
+bool CStateManager::IsAiThinkSuspended(const CEntity& ai) const {
+  if (xf94_29_cinematicPause) {
+    return true;
+  }
+  if (ai.GetAreaIdAlways() == kInvalidAreaId) {
+    return false;
+  }
+  const CGameArea* area = x850_world->GetAreaAlways(ai.GetAreaIdAlways());
+  float occTime = 0.0f;
+  if (area->IsPostConstructed()) {
+    occTime = area->GetPostConstructed()->x10e4_occludedTime;
+  }
+  return occTime > 5.f;
+}
+
 void CStateManager::MoveActors(float dt) {
-  for (CEntity* ent : GetPhysicsActorObjectList()) {
-    if (ent == nullptr || !ent->GetActive()) {
+  for (const auto& entry : GetPhysicsActorObjectList().GetPackedEntries()) {
+    CEntity* ent = entry.entity;
+    if (!ent->GetActive()) {
       continue;
     }
 
@@ -2355,28 +2406,14 @@ void CStateManager::MoveActors(float dt) {
       continue;
     }
 
-    if (const TCastToPtr<CAi> ai = physActor) {
-      bool doThink = !xf94_29_cinematicPause;
-      if (doThink && ai->GetAreaIdAlways() != kInvalidAreaId) {
-        const CGameArea* area = x850_world->GetAreaAlways(ai->GetAreaIdAlways());
-        float occTime = 0.0f;
-        if (area->IsPostConstructed()) {
-          occTime = area->GetPostConstructed()->x10e4_occludedTime;
-        }
-        if (occTime > 5.f) {
-          doThink = false;
-        }
-      }
-      if (!doThink) {
-        SendScriptMsgAlways(ai->GetUniqueId(), kInvalidUniqueId, EScriptObjectMessage::SuspendedMove);
-        continue;
-      }
+    const SEntityKind kind = m_entityKinds[entry.id];
+    if (kind.m_ai && IsAiThinkSuspended(physActor)) {
+      SendScriptMsgAlways(physActor.GetUniqueId(), kInvalidUniqueId, EScriptObjectMessage::SuspendedMove);
+      continue;
     }
 
-    if (x84c_player.get() != ent) {
-      if (!GetPlatformAndDoorObjectList().IsPlatform(*ent)) {
-        CGameCollision::Move(*this, physActor, dt, nullptr);
-      }
+    if (x84c_player.get() != ent && !kind.m_platform) {
+      CGameCollision::Move(*this, physActor, dt, nullptr);
     }
   }
 }
@@ -2385,12 +2422,8 @@ void CStateManager::CrossTouchActors() {
   std::array<bool, kMaxEntities> visits{};
   EntityList nearList;
 
-  for (CEntity* ent : GetActorObjectList()) {
-    if (ent == nullptr) {
-      continue;
-    }
-
-    auto& actor = static_cast<CActor&>(*ent);
+  for (const auto& entry : GetActorObjectList().GetPackedEntries()) {
+    auto& actor = static_cast<CActor&>(*entry.entity);
     if (!actor.GetActive() || !actor.GetCallTouch()) {
       continue;
     }
@@ -2440,31 +2473,18 @@ void CStateManager::Think(float dt) {
   }
 
   if (x904_gameState == EGameState::SoftPaused) {
-    for (CEntity* ent : GetAllObjectList()) {
-      if (const TCastToPtr<CScriptEffect> effect = ent) {
-        effect->Think(dt, *this);
+    for (const auto& entry : GetAllObjectList().GetPackedEntries()) {
+      if (m_entityKinds[entry.id].m_scriptEffect) {
+        static_cast<CScriptEffect*>(entry.entity)->Think(dt, *this);
       }
     }
   } else {
-    for (CEntity* ent : GetAllObjectList()) {
-      if (const TCastToPtr<CAi> ai = ent) {
-        bool doThink = !xf94_29_cinematicPause;
-        if (doThink && ai->GetAreaIdAlways() != kInvalidAreaId) {
-          const CGameArea* area = x850_world->GetAreaAlways(ai->GetAreaIdAlways());
-          float occTime = 0.0f;
-          if (area->IsPostConstructed()) {
-            occTime = area->GetPostConstructed()->x10e4_occludedTime;
-          }
-          if (occTime > 5.f) {
-            doThink = false;
-          }
-        }
-        if (!doThink) {
-          continue;
-        }
+    for (const auto& entry : GetAllObjectList().GetPackedEntries()) {
+      if (m_entityKinds[entry.id].m_ai && IsAiThinkSuspended(*entry.entity)) {
+        continue;
       }
-      if (!GetCameraObjectList().GetObjectById(ent->GetUniqueId())) {
-        ent->Think(dt, *this);
+      if (!IsCameraManaged(entry)) {
+        entry.entity->Think(dt, *this);
       }
     }
   }
@@ -2487,6 +2507,28 @@ void CStateManager::ClearGraveyard() {
   x854_objectGraveyard.clear();
 }
 
+u64 CStateManager::HashSimulationState() const {
+  XXH64_state_t st;
+  XXH64_reset(&st, 0);
+  const auto hashFloat = [&](float f) { XXH64_update(&st, &f, sizeof(f)); };
+  for (const CEntity* ent : GetActorObjectList()) {
+    const CActor* act = static_cast<const CActor*>(ent);
+    const u16 uid = act->GetUniqueId().id;
+    XXH64_update(&st, &uid, sizeof(uid));
+    const zeus::CTransform& xf = act->GetTransform();
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        hashFloat(xf.basis[i][j]);
+      }
+      hashFloat(xf.origin[i]);
+    }
+    if (const CHealthInfo* hInfo = act->GetHealthInfo(*this)) {
+      hashFloat(hInfo->GetHP());
+    }
+  }
+  return XXH64_digest(&st);
+}
+
 void CStateManager::FrameBegin(s32 frameCount) { x8d4_inputFrameIdx = frameCount; }
 
 void CStateManager::InitializeState(CAssetId mlvlId, TAreaId aid, CAssetId mreaId) {
@@ -2605,14 +2647,7 @@ const CObjectList* CStateManager::GetObjectListById(EGameObjectList type) const
 void CStateManager::RemoveObject(TUniqueId uid) {
   if (CEntity* ent = GetAllObjectList().GetValidObjectById(uid)) {
     if (ent->GetEditorId() != kInvalidEditorId) {
-      const auto search = x890_scriptIdMap.equal_range(ent->GetEditorId());
-      for (auto it = search.first; it != search.second;) {
-        if (it->second == uid) {
-          it = x890_scriptIdMap.erase(it);
-          continue;
-        }
-        ++it;
-      }
+      x890_scriptIdMap.Erase(uid);
     }
     if (ent->GetAreaIdAlways() != kInvalidAreaId) {
       CGameArea* area = x850_world->GetArea(ent->GetAreaIdAlways());
@@ -2623,6 +2658,7 @@ void CStateManager::RemoveObject(TUniqueId uid) {
     if (const TCastToPtr<CActor> act = ent) {
       x874_sortedListManager->Remove(act.GetPtr());
     }
+    m_entityKinds[uid.Value()] = {};
   }
   for (auto& list : x808_objLists) {
     list->RemoveObject(uid);
@@ -2663,6 +2699,7 @@ void CStateManager::SetCurrentAreaId(TAreaId aid) {
   if (aid == kInvalidAreaId) {
     return;
   }
+  CMemoryTags::SetCurrentArea(x850_world->GetArea(aid)->GetAreaAssetId());
   if (x8c0_mapWorldInfo->IsAreaVisited(aid)) {
     return;
   }
@@ -2757,11 +2794,17 @@ std::optional<zeus::CAABox> CStateManager::CalculateObjectBounds(const CActor& a
 
 void CStateManager::AddObject(CEntity& ent) {
   if (ent.GetEditorId() != kInvalidEditorId) {
-    x890_scriptIdMap.insert(std::make_pair(ent.GetEditorId(), ent.GetUniqueId()));
+    x890_scriptIdMap.Insert(ent.GetEditorId(), ent.GetUniqueId());
   }
   for (auto& list : x808_objLists) {
     list->AddObject(ent);
   }
+  m_entityKinds[ent.GetUniqueId().Value()] = {
+      .m_ai = TCastToConstPtr<CAi>(ent).IsValid(),
+      .m_camera = TCastToConstPtr<CGameCamera>(ent).IsValid(),
+      .m_platform = TCastToConstPtr<CScriptPlatform>(ent).IsValid(),
+      .m_scriptEffect = TCastToConstPtr<CScriptEffect>(ent).IsValid(),
+  };
 
   if (ent.GetAreaIdAlways() == kInvalidAreaId && x84c_player && ent.GetUniqueId() != x84c_player->GetUniqueId()) {
     ent.x4_areaId = x84c_player->GetAreaIdAlways();
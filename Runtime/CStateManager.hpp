@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <list>
 #include <map>
 #include <memory>
@@ -11,6 +12,7 @@
 
 #include "Runtime/CBasics.hpp"
 #include "Runtime/CRandom16.hpp"
+#include "Runtime/CScriptIdMap.hpp"
 #include "Runtime/CSortedLists.hpp"
 #include "Runtime/CToken.hpp"
 #include "Runtime/rstl.hpp"
@@ -136,7 +138,7 @@ private:
   CActorModelParticles* x884_actorModelParticles = nullptr;
   CRumbleManager* x88c_rumbleManager = nullptr;
 
-  std::multimap<TEditorId, TUniqueId> x890_scriptIdMap;
+  CScriptIdMap x890_scriptIdMap;
   std::map<TEditorId, SScriptObjectStream> x8a4_loadedScriptObjects;
 
   std::shared_ptr<CPlayerState> x8b8_playerState;
@@ -218,6 +220,32 @@ private:
 
   bool m_logScripting = false;
   std::optional<hecl::CVarValueReference<bool>> m_logScriptingReference;
+
+  /* Messages queued with DeferScriptMsg, delivered in FIFO order at fixed points of Update */
+  struct SDeferredScriptMsg {
+    TUniqueId m_dest;
+    TUniqueId m_src;
+    EScriptObjectMessage m_msg;
+  };
+  static constexpr size_t kMaxDeferredScriptMsgs = 256;
+  std::array<SDeferredScriptMsg, kMaxDeferredScriptMsgs> m_deferredScriptMsgs;
+  size_t m_deferredScriptMsgHead = 0;
+  size_t m_deferredScriptMsgCount = 0;
+
+  /* Type tests made once in AddObject, so the update phases can walk the packed object lists
+   * without a TCastToPtr visit per entity */
+  struct SEntityKind {
+    bool m_ai : 1 = false;
+    bool m_camera : 1 = false;
+    bool m_platform : 1 = false;
+    bool m_scriptEffect : 1 = false;
+  };
+  std::array<SEntityKind, kMaxEntities> m_entityKinds{};
+  bool IsCameraManaged(const CObjectList::SPackedEntry& entry) const {
+    return m_entityKinds[entry.id].m_camera && !entry.entity->IsScriptingBlocked();
+  }
+  bool IsAiThinkSuspended(const CEntity& ai) const;
+
   void UpdateThermalVisor();
   static void RendererDrawCallback(void*, void*, int);
 
@@ -278,14 +306,18 @@ public:
   void SendScriptMsg(TUniqueId dest, TUniqueId src, EScriptObjectMessage msg);
   void SendScriptMsg(TUniqueId src, TEditorId dest, EScriptObjectMessage msg, EScriptObjectState state);
   void SendScriptMsgAlways(TUniqueId dest, TUniqueId src, EScriptObjectMessage);
+  /* Queues a message for delivery at the next drain point instead of dispatching it recursively.
+   * Only for messages whose sender does not depend on the receiver having handled it. */
+  void DeferScriptMsg(TUniqueId dest, TUniqueId src, EScriptObjectMessage msg);
+  void DeliverDeferredScriptMsgs();
   void FreeScriptObjects(TAreaId);
   void FreeScriptObject(TUniqueId);
   std::pair<const SScriptObjectStream*, TEditorId> GetBuildForScript(TEditorId) const;
   TEditorId GetEditorIdForUniqueId(TUniqueId) const;
   TUniqueId GetIdForScript(TEditorId) const;
-  std::pair<std::multimap<TEditorId, TUniqueId>::const_iterator, std::multimap<TEditorId, TUniqueId>::const_iterator>
-      GetIdListForScript(TEditorId) const;
-  std::multimap<TEditorId, TUniqueId>::const_iterator GetIdListEnd() const { return x890_scriptIdMap.cend(); }
+  std::pair<CScriptIdMap::const_iterator, CScriptIdMap::const_iterator> GetIdListForScript(TEditorId) const;
+  CScriptIdMap::const_iterator GetIdListEnd() const { return x890_scriptIdMap.end(); }
+  const CScriptIdMap& GetScriptIdMap() const { return x890_scriptIdMap; }
   void LoadScriptObjects(TAreaId, CInputStream& in, std::vector<TEditorId>& idsOut);
   void InitializeScriptObjects(const std::vector<TEditorId>& objIds);
   std::pair<TEditorId, TUniqueId> LoadScriptObject(TAreaId, EScriptObjectType, u32, CInputStream& in);
@@ -329,6 +361,7 @@ public:
   void PostUpdatePlayer(float dt);
   void ShowPausedHUDMemo(CAssetId strg, float time);
   void ClearGraveyard();
+  u64 HashSimulationState() const;
   void FrameBegin(s32 frameCount);
   void InitializeState(CAssetId mlvlId, TAreaId aid, CAssetId mreaId);
   void CreateStandardGameObjects();
@@ -3,27 +3,24 @@
 #include <chrono>
 #include <fmt/format.h>
 
+#include "Runtime/CProfiler.hpp"
+
 namespace metaforce {
 class CStopwatch {
   std::chrono::steady_clock::time_point m_start;
 
 public:
   CStopwatch() : m_start(std::chrono::steady_clock::now()) {}
+  /* Records the elapsed time as a profiler zone; name must be a string literal */
   double report(const char* name) const {
-    double t =
-        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count() /
-        1000000.0;
-    //#ifndef NDEBUG
-    //    fmt::print(FMT_STRING("{} {}\n"), name, t);
-    //#endif
-    return t;
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    CProfiler::AddZone(name, m_start, now);
+    return std::chrono::duration_cast<std::chrono::microseconds>(now - m_start).count() / 1000000.0;
   }
   double reportReset(const char* name) {
-    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    CProfiler::AddZone(name, m_start, now);
     double t = std::chrono::duration_cast<std::chrono::microseconds>(now - m_start).count() / 1000000.0;
-    //#ifndef NDEBUG
-    //    fmt::print(FMT_STRING("{} {}\n"), name, t);
-    //#endif
     m_start = now;
     return t;
   }
@@ -31,7 +31,7 @@ void CObjectReference::Unlock() {
 
 void CObjectReference::Lock() {
   ++x2_lockCount;
-  if (!x10_object && !x3_loading) {
+  if (!x10_object && !x3_loading && !xC_objectStore->TakeRetainedObject(x4_objTag, x10_object)) {
     IFactory& fac = xC_objectStore->GetFactory();
     fac.BuildAsync(x4_objTag, x14_params, &x10_object, this);
     x3_loading = !x10_object.operator bool();
@@ -46,12 +46,13 @@ void CObjectReference::CancelLoad() {
 }
 
 void CObjectReference::Unload() {
-  x10_object.reset();
+  if (!xC_objectStore || !xC_objectStore->RetainUnloadedObject(x4_objTag, x10_object))
+    x10_object.reset();
   x3_loading = false;
 }
 
 IObj* CObjectReference::GetObject() {
-  if (!x10_object) {
+  if (!x10_object && !xC_objectStore->TakeRetainedObject(x4_objTag, x10_object)) {
     IFactory& factory = xC_objectStore->GetFactory();
     x10_object = factory.Build(x4_objTag, x14_params, this);
   }
@@ -10,6 +10,7 @@
 
 namespace metaforce {
 class IObjectStore;
+enum class EMemoryTag : u8;
 
 /** Shared data-structure for CToken references, analogous to std::shared_ptr */
 class CObjectReference {
@@ -23,6 +24,9 @@ class CObjectReference {
   IObjectStore* xC_objectStore = nullptr;
   std::unique_ptr<IObj> x10_object;
   CVParamTransfer x14_params;
+  /* Bytes CSimplePool charged to m_memoryTag for this reference */
+  u32 m_memorySize = 0;
+  EMemoryTag m_memoryTag{};
 
   /** Mechanism by which CToken decrements 1st ref-count, indicating CToken invalidation or reset.
    *  Reaching 0 indicates the CToken should delete the CObjectReference */
@@ -73,6 +73,7 @@ public:
   float GetAverageVelocity() const { return x60_averageVelocity; }
   zeus::CQuaternion GetRotation(const CSegId& seg, const CCharAnimTime& time) const;
   zeus::CVector3f GetOffset(const CSegId& seg, const CCharAnimTime& time) const;
+  bool HasRotation(const CSegId& seg) const { return x20_rotationChannels[seg] != 0xff; }
   bool HasOffset(const CSegId& seg) const;
   const CCharAnimTime& GetDuration() const { return x0_duration; }
   const CSegId& GetRootBoneId() const { return x1c_rootBone; }
@@ -6,6 +6,7 @@
 #include "Runtime/Character/CFBStreamedAnimReader.hpp"
 #include "Runtime/Character/CInt32POINode.hpp"
 #include "Runtime/Character/CParticlePOINode.hpp"
+#include "Runtime/Character/CSegStatementCache.hpp"
 #include "Runtime/Character/CSoundPOINode.hpp"
 
 namespace metaforce {
@@ -308,12 +309,12 @@ SAdvancementResults CAnimSourceReader::VReverseView(const CCharAnimTime& dt) {
 std::unique_ptr<IAnimReader> CAnimSourceReader::VClone() const { return std::make_unique<CAnimSourceReader>(*this); }
 
 void CAnimSourceReader::VGetSegStatementSet(const CSegIdList& list, CSegStatementSet& setOut) const {
-  x54_source->GetSegStatementSet(list, setOut, xc_curTime);
+  CSegStatementCache::GetSegStatementSet(*x54_source, list, setOut, xc_curTime);
 }
 
 void CAnimSourceReader::VGetSegStatementSet(const CSegIdList& list, CSegStatementSet& setOut,
                                             const CCharAnimTime& time) const {
-  x54_source->GetSegStatementSet(list, setOut, time);
+  CSegStatementCache::GetSegStatementSet(*x54_source, list, setOut, time);
 }
 
 SAdvancementResults CAnimSourceReader::VAdvanceView(const CCharAnimTime& dt) {
@@ -0,0 +1,89 @@
+#include "Runtime/Character/CSegStatementCache.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#include "Runtime/Character/CAnimSource.hpp"
+#include "Runtime/Character/CCharAnimTime.hpp"
+#include "Runtime/Character/CSegIdList.hpp"
+#include "Runtime/Character/CSegStatementSet.hpp"
+
+namespace metaforce {
+
+std::array<CSegStatementCache::SEntry, CSegStatementCache::kTableSize> CSegStatementCache::x0_entries;
+u32 CSegStatementCache::x4_frame = 1;
+CSegStatementCache::SStats CSegStatementCache::x8_curStats;
+CSegStatementCache::SStats CSegStatementCache::x18_lastStats;
+
+size_t CSegStatementCache::Hash(const CAnimSource* source, const CSegIdList* list, float time) {
+  u32 timeBits;
+  std::memcpy(&timeBits, &time, sizeof(timeBits));
+  size_t h = reinterpret_cast<uintptr_t>(source) >> 4;
+  h ^= (reinterpret_cast<uintptr_t>(list) >> 4) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  h ^= timeBits + 0x9e3779b9 + (h << 6) + (h >> 2);
+  return h & (kTableSize - 1);
+}
+
+void CSegStatementCache::GetSegStatementSet(const CAnimSource& source, const CSegIdList& list,
+                                            CSegStatementSet& setOut, const CCharAnimTime& time) {
+  const float seconds = time.GetSeconds();
+  size_t idx = Hash(&source, &list, seconds);
+  for (;;) {
+    SEntry& entry = x0_entries[idx];
+    if (entry.x0_frame != x4_frame) {
+      break;
+    }
+    if (entry.x4_source == &source && entry.x8_list == &list && entry.xc_time == seconds) {
+      /* Replay exactly the channels CAnimSource would have written */
+      for (const auto& [seg, data] : entry.x10_segs) {
+        CAnimPerSegmentData& out = setOut[seg];
+        out.x0_rotation = data.x0_rotation;
+        if (data.x1c_hasOffset) {
+          out.x10_offset = data.x10_offset;
+          out.x1c_hasOffset = true;
+        }
+      }
+      ++x8_curStats.x0_hits;
+      return;
+    }
+    idx = (idx + 1) & (kTableSize - 1);
+  }
+
+  source.GetSegStatementSet(list, setOut, time);
+  ++x8_curStats.x4_misses;
+
+  if (x8_curStats.xc_entries >= kMaxEntries) {
+    ++x8_curStats.x8_rejected;
+    return;
+  }
+
+  SEntry& entry = x0_entries[idx];
+  entry.x0_frame = x4_frame;
+  entry.x4_source = &source;
+  entry.x8_list = &list;
+  entry.xc_time = seconds;
+  entry.x10_segs.clear();
+  for (const CSegId& id : list.GetList()) {
+    if (!source.HasRotation(id)) {
+      continue;
+    }
+    CAnimPerSegmentData data = setOut[id];
+    data.x1c_hasOffset = source.HasOffset(id);
+    entry.x10_segs.emplace_back(id, data);
+  }
+  ++x8_curStats.xc_entries;
+}
+
+void CSegStatementCache::NewFrame() {
+  x18_lastStats = x8_curStats;
+  x8_curStats = SStats{};
+  /* Entries are tagged with the frame they were written on; bumping the frame empties the table */
+  if (++x4_frame == 0) {
+    for (SEntry& entry : x0_entries) {
+      entry.x0_frame = 0;
+    }
+    x4_frame = 1;
+  }
+}
+
+} // namespace metaforce
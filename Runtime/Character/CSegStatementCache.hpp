@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "Runtime/GCNTypes.hpp"
+#include "Runtime/Character/CAnimPerSegmentData.hpp"
+#include "Runtime/Character/CSegId.hpp"
+
+namespace metaforce {
+class CAnimSource;
+class CCharAnimTime;
+class CSegIdList;
+class CSegStatementSet;
+
+/* Per-frame memoization of leaf CAnimSource evaluations.
+ * Actors sharing an ANCS and playing the same clip in lockstep (swarms, fish clouds)
+ * request identical (source, segment list, time) poses; those resolve once per frame. */
+class CSegStatementCache {
+public:
+  struct SStats {
+    u32 x0_hits = 0;
+    u32 x4_misses = 0;
+    u32 x8_rejected = 0;
+    u32 xc_entries = 0;
+  };
+
+private:
+  static constexpr size_t kTableSize = 512;
+  static constexpr size_t kMaxEntries = kTableSize * 3 / 4;
+
+  struct SEntry {
+    u32 x0_frame = 0;
+    const CAnimSource* x4_source = nullptr;
+    const CSegIdList* x8_list = nullptr;
+    float xc_time = 0.f;
+    std::vector<std::pair<CSegId, CAnimPerSegmentData>> x10_segs;
+  };
+
+  static std::array<SEntry, kTableSize> x0_entries;
+  static u32 x4_frame;
+  static SStats x8_curStats;
+  static SStats x18_lastStats;
+
+  static size_t Hash(const CAnimSource* source, const CSegIdList* list, float time);
+
+public:
+  static void GetSegStatementSet(const CAnimSource& source, const CSegIdList& list, CSegStatementSet& setOut,
+                                 const CCharAnimTime& time);
+
+  /* Invalidates all entries and latches the previous frame's statistics */
+  static void NewFrame();
+  static const SStats& GetLastFrameStats() { return x18_lastStats; }
+};
+
+} // namespace metaforce
@@ -505,7 +505,7 @@ void CAreaOctTree::SwapTreeNode(u8* ptr, Node::ETreeType type) {
 CAreaOctTree::CAreaOctTree(const zeus::CAABox& aabb, Node::ETreeType treeType, const u8* buf, const u8* treeBuf,
                            u32 matCount, const u32* materials, const u8* vertMats, const u8* edgeMats,
                            const u8* polyMats, u32 edgeCount, const CCollisionEdge* edges, u32 polyCount,
-                           const u16* polyEdges, u32 vertCount, const float* verts)
+                           const u16* polyEdges, u32 vertCount, const float* verts, bool swapBuffers)
 : x0_aabb(aabb)
 , x18_treeType(treeType)
 , x1c_buf(buf)
@@ -521,6 +521,9 @@ CAreaOctTree::CAreaOctTree(const zeus::CAABox& aabb, Node::ETreeType treeType, c
 , x44_polyEdges(polyEdges)
 , x48_vertCount(vertCount)
 , x4c_verts(verts) {
+  if (!swapBuffers)
+    return;
+
   SwapTreeNode(const_cast<u8*>(x20_treeBuf), treeType);
 
   for (u32 i = 0; i < matCount; ++i)
@@ -536,7 +539,7 @@ CAreaOctTree::CAreaOctTree(const zeus::CAABox& aabb, Node::ETreeType treeType, c
     const_cast<float*>(x4c_verts)[i] = hecl::SBig(x4c_verts[i]);
 }
 
-std::unique_ptr<CAreaOctTree> CAreaOctTree::MakeFromMemory(const u8* buf, unsigned int size) {
+std::unique_ptr<CAreaOctTree> CAreaOctTree::MakeFromMemory(const u8* buf, unsigned int size, bool nativeEndian) {
   athena::io::MemoryReader r(buf + 8, size - 8);
   r.readUint32Big();
   r.readUint32Big();
@@ -585,7 +588,7 @@ std::unique_ptr<CAreaOctTree> CAreaOctTree::MakeFromMemory(const u8* buf, unsign
 
   return std::make_unique<CAreaOctTree>(aabb, nodeType, reinterpret_cast<const u8*>(buf + 8), treeBuf, matCount, matBuf,
                                         vertMatsBuf, edgeMatsBuf, polyMatsBuf, edgeCount, edgeBuf, polyCount, polyBuf,
-                                        vertCount, vertBuf);
+                                        vertCount, vertBuf, !nativeEndian);
 }
 
 CCollisionSurface CAreaOctTree::GetMasterListTriangle(u16 idx) const {
@@ -93,7 +93,8 @@ public:
 public:
   CAreaOctTree(const zeus::CAABox& aabb, Node::ETreeType treeType, const u8* buf, const u8* treeBuf, u32 matCount,
                const u32* materials, const u8* vertMats, const u8* edgeMats, const u8* polyMats, u32 edgeCount,
-               const CCollisionEdge* edges, u32 polyCount, const u16* polyEdges, u32 vertCount, const float* verts);
+               const CCollisionEdge* edges, u32 polyCount, const u16* polyEdges, u32 vertCount, const float* verts,
+               bool swapBuffers = true);
 
   const zeus::CAABox& GetAABB() const { return x0_aabb; }
   Node GetRootNode() const { return Node(x20_treeBuf, x0_aabb, *this, x18_treeType); }
@@ -113,7 +114,8 @@ public:
   void GetTriangleVertexIndices(u16 idx, u16 indicesOut[3]) const;
   const u16* GetTriangleEdgeIndices(u16 idx) const { return &x44_polyEdges[idx * 3]; }
 
-  static std::unique_ptr<CAreaOctTree> MakeFromMemory(const u8* buf, unsigned int size);
+  /* nativeEndian skips byte-swapping for buffers that were already swapped, e.g. by CBlobCache */
+  static std::unique_ptr<CAreaOctTree> MakeFromMemory(const u8* buf, unsigned int size, bool nativeEndian = false);
 };
 
 } // namespace metaforce
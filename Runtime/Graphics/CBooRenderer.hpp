@@ -42,7 +42,7 @@ class Buckets;
 
 enum class EWorldShadowMode { None, WorldOnActorShadow, BallOnWorldShadow, BallOnWorldIds, MAX };
 
-class CBooRenderer final : public IRenderer {
+class CBooRenderer : public IRenderer {
   friend class CBooModel;
   friend class CGameArea;
   friend class CModel;
@@ -169,6 +169,8 @@ private:
   };
   std::vector<ModelInstance> m_instances;
   ModelInstance m_ballShadowInstance;
+  /* Uniform buffer bytes of m_instances charged to EMemoryTag::Models */
+  size_t m_instanceBytes = 0;
 
   boo::ObjToken<boo::IGraphicsBufferS> m_staticVbo;
   boo::ObjToken<boo::IGraphicsBufferS> m_staticIbo;
@@ -178,6 +180,7 @@ private:
   boo::ObjToken<boo::ITextureCubeR> m_lastDrawnReflectionCube;
 
   ModelInstance* PushNewModelInstance(int sharedLayoutBuf = -1, boo::IGraphicsDataFactory::Context* ctx = nullptr);
+  void ClearModelInstances();
   void DrawAlphaSurfaces(const CModelFlags& flags) const;
   void DrawNormalSurfaces(const CModelFlags& flags) const;
   void DrawSurfaces(const CModelFlags& flags) const;
@@ -1,5 +1,6 @@
 #include "Runtime/Graphics/CModel.hpp"
 
+#include "Runtime/CMemoryTags.hpp"
 #include "Runtime/CSimplePool.hpp"
 #include "Runtime/GameGlobalObjects.hpp"
 #include "Runtime/Character/CSkinRules.hpp"
@@ -142,6 +143,7 @@ void CBooModel::EnableShadowMaps(const boo::ObjToken<boo::ITexture>& map, const
 void CBooModel::DisableShadowMaps() { g_shadowMap = nullptr; }
 
 CBooModel::~CBooModel() {
+  CMemoryTags::Sub(EMemoryTag::Models, s64(sizeof(CBooModel) + m_instanceBytes));
   if (m_prev)
     m_prev->m_next = m_next;
   if (m_next)
@@ -165,6 +167,8 @@ CBooModel::CBooModel(TToken<CModel>& token, CModel* parent, std::vector<CBooSurf
 , x41_mask(renderMask)
 , m_staticVbo(vbo)
 , m_staticIbo(ibo) {
+  CMemoryTags::Add(EMemoryTag::Models, sizeof(CBooModel));
+
   if (!g_FirstModel)
     g_FirstModel = this;
   else {
@@ -292,6 +296,9 @@ CBooModel::ModelInstance* CBooModel::PushNewModelInstance(int sharedLayoutBuf,
     /* Allocate resident buffer */
     m_uniformDataSize = uniBufSize;
     newInst.m_uniformBuffer = ctx.newDynamicBuffer(boo::BufferUse::Uniform, uniBufSize, 1);
+    const size_t instBytes = uniBufSize + (sharedLayoutBuf >= 0 ? 0 : m_geomLayout->m_geomBufferSize);
+    m_instanceBytes += instBytes;
+    CMemoryTags::Add(EMemoryTag::Models, s64(instBytes));
 
     const std::array<boo::ObjToken<boo::IGraphicsBuffer>, 4> bufs{
         geomUniformBuf.get(),
@@ -442,6 +449,12 @@ void CBooModel::DisableAllLights() {
   }
 }
 
+void CBooModel::ClearModelInstances() {
+  m_instances.clear();
+  CMemoryTags::Sub(EMemoryTag::Models, s64(m_instanceBytes));
+  m_instanceBytes = 0;
+}
+
 void CBooModel::RemapMaterialData(SShader& shader) {
   if (!shader.m_geomLayout)
     return;
@@ -451,7 +464,7 @@ void CBooModel::RemapMaterialData(SShader& shader) {
   x1c_textures = shader.x0_textures;
   m_pipelines = &shader.m_shaders;
   x40_24_texturesLoaded = false;
-  m_instances.clear();
+  ClearModelInstances();
 }
 
 void CBooModel::RemapMaterialData(SShader& shader,
@@ -464,7 +477,7 @@ void CBooModel::RemapMaterialData(SShader& shader,
   x1c_textures = shader.x0_textures;
   m_pipelines = &pipelines;
   x40_24_texturesLoaded = false;
-  m_instances.clear();
+  ClearModelInstances();
 }
 
 bool CBooModel::TryLockTextures() {
@@ -498,7 +511,7 @@ bool CBooModel::TryLockTextures() {
 }
 
 void CBooModel::UnlockTextures() {
-  m_instances.clear();
+  ClearModelInstances();
 
   for (auto& tex : x1c_textures) {
     tex.second.Unlock();
@@ -990,13 +1003,13 @@ boo::ObjToken<boo::IGraphicsBufferD> CBooModel::UpdateUniformData(const CModelFl
        flags.m_extendedShader == EExtendedShader::LightingCubeReflectionWorldShadow) &&
       m_lastDrawnShadowMap != g_shadowMap) {
     m_lastDrawnShadowMap = g_shadowMap;
-    m_instances.clear();
+    ClearModelInstances();
   }
 
   /* Invalidate instances if new one-texture being drawn */
   if (flags.m_extendedShader == EExtendedShader::Disintegrate && m_lastDrawnOneTexture != g_disintegrateTexture) {
     m_lastDrawnOneTexture = g_disintegrateTexture;
-    m_instances.clear();
+    ClearModelInstances();
   }
 
   /* Invalidate instances if new reflection cube being drawn */
@@ -1005,7 +1018,7 @@ boo::ObjToken<boo::IGraphicsBufferD> CBooModel::UpdateUniformData(const CModelFl
        flags.m_extendedShader == EExtendedShader::LightingCubeReflectionWorldShadow) &&
       m_lastDrawnReflectionCube != g_reflectionCube) {
     m_lastDrawnReflectionCube = g_reflectionCube;
-    m_instances.clear();
+    ClearModelInstances();
   }
 
   const ModelInstance* inst;
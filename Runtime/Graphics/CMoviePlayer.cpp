@@ -1,14 +1,101 @@
 #include "Runtime/Graphics/CMoviePlayer.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
 #include "Runtime/Audio/g721.h"
 #include "Runtime/CDvdRequest.hpp"
+#include "Runtime/CProfiler.hpp"
 #include "Runtime/Graphics/CGraphics.hpp"
 
 #include <amuse/DSPCodec.hpp>
 #include <hecl/Pipeline.hpp>
+#include <logvisor/logvisor.hpp>
+#include <optick.h>
 #include <turbojpeg.h>
 
 namespace metaforce {
+namespace {
+logvisor::Module Log("metaforce::CMoviePlayer");
+
+/* Worker threads shared by all movie players. TurboJPEG handles are not thread-safe, so each worker owns one. */
+class CTHPDecodePool {
+  std::vector<std::thread> m_threads;
+  std::mutex m_lock;
+  std::condition_variable m_jobCV;
+  std::condition_variable m_doneCV;
+  std::deque<std::function<void(tjhandle)>> m_jobs;
+  bool m_running = false;
+
+  void WorkerProc() {
+    logvisor::RegisterThreadName("THPDecode");
+    OPTICK_THREAD("THPDecode");
+    CProfiler::SetThreadName("THPDecode");
+    tjhandle handle = tjInitDecompress();
+
+    std::unique_lock lk{m_lock};
+    while (true) {
+      m_jobCV.wait(lk, [this] { return !m_jobs.empty() || !m_running; });
+      /* Drain the queue before exiting so no player waits on a frame that never decodes */
+      if (m_jobs.empty()) {
+        break;
+      }
+      std::function<void(tjhandle)> job = std::move(m_jobs.front());
+      m_jobs.pop_front();
+      lk.unlock();
+      {
+        CProfiler::CZone zone("CMoviePlayer::DecodeFrame");
+        job(handle);
+      }
+      lk.lock();
+      m_doneCV.notify_all();
+    }
+
+    tjDestroy(handle);
+  }
+
+public:
+  ~CTHPDecodePool() { Stop(); }
+
+  u32 GetThreadCount() const { return u32(m_threads.size()); }
+
+  void Push(std::function<void(tjhandle)>&& job) {
+    std::unique_lock lk{m_lock};
+    if (!m_running) {
+      m_running = true;
+      const u32 threads = std::clamp(std::thread::hardware_concurrency(), 2u, 5u) - 1;
+      for (u32 i = 0; i < threads; ++i) {
+        m_threads.emplace_back([this] { WorkerProc(); });
+      }
+    }
+    m_jobs.push_back(std::move(job));
+    lk.unlock();
+    m_jobCV.notify_one();
+  }
+
+  void Wait(const std::atomic_bool& done) {
+    std::unique_lock lk{m_lock};
+    m_doneCV.wait(lk, [&done] { return done.load(); });
+  }
+
+  void Stop() {
+    std::unique_lock lk{m_lock};
+    m_running = false;
+    lk.unlock();
+    m_jobCV.notify_all();
+    for (std::thread& thread : m_threads) {
+      thread.join();
+    }
+    m_threads.clear();
+  }
+};
+CTHPDecodePool DecodePool;
+} // Anonymous namespace
 
 zeus::CMatrix4f g_PlatformMatrix;
 
@@ -28,7 +115,6 @@ static const u16 StaticVolumeLookup[] = {
 
 /* shared boo resources */
 static boo::ObjToken<boo::IShaderPipeline> YUVShaderPipeline;
-static tjhandle TjHandle = nullptr;
 
 /* RSF audio state */
 static const u8* StaticAudio = nullptr;
@@ -55,12 +141,11 @@ void CMoviePlayer::Initialize(boo::IGraphicsDataFactory* factory) {
     break;
   }
   YUVShaderPipeline = hecl::conv->convert(Shader_CMoviePlayerShader{});
-  TjHandle = tjInitDecompress();
 }
 
 void CMoviePlayer::Shutdown() {
+  DecodePool.Stop();
   YUVShaderPipeline.reset();
-  tjDestroy(TjHandle);
 }
 
 void CMoviePlayer::THPHeader::swapBig() {
@@ -146,39 +231,46 @@ u32 CMoviePlayer::THPAudioDecode(s16* buffer, const u8* audioFrame, bool stereo)
   return header.numSamples;
 }
 
-CMoviePlayer::CMoviePlayer(const char* path, float preLoadSeconds, bool loop, bool deinterlace)
-: CDvdFile(path), xec_preLoadSeconds(preLoadSeconds), xf4_24_loop(loop), m_deinterlace(deinterlace) {
-  /* Read THP header information */
+bool CMoviePlayer::ReadHeaders(CDvdFile& file, THPHeader& head, THPComponents& comps, THPVideoInfo& videoInfo,
+                               THPAudioInfo& audioInfo) {
   u8 buf[64];
-  SyncRead(buf, 64);
-  memmove(&x28_thpHead, buf, 48);
-  x28_thpHead.swapBig();
+  file.SyncRead(buf, 64);
+  memmove(&head, buf, 48);
+  head.swapBig();
 
-  u32 cur = x28_thpHead.componentDataOffset;
-  SyncSeekRead(buf, 32, ESeekOrigin::Begin, cur);
-  memmove(&x58_thpComponents, buf, 20);
+  u32 cur = head.componentDataOffset;
+  file.SyncSeekRead(buf, 32, ESeekOrigin::Begin, cur);
+  memmove(&comps, buf, 20);
   cur += 20;
-  x58_thpComponents.swapBig();
+  comps.swapBig();
 
-  for (u32 i = 0; i < x58_thpComponents.numComponents; ++i) {
-    switch (x58_thpComponents.comps[i]) {
+  bool hasAudio = false;
+  for (u32 i = 0; i < comps.numComponents; ++i) {
+    switch (comps.comps[i]) {
     case THPComponents::Type::Video:
-      SyncSeekRead(buf, 32, ESeekOrigin::Begin, cur);
-      memmove(&x6c_videoInfo, buf, 8);
+      file.SyncSeekRead(buf, 32, ESeekOrigin::Begin, cur);
+      memmove(&videoInfo, buf, 8);
       cur += 8;
-      x6c_videoInfo.swapBig();
+      videoInfo.swapBig();
       break;
     case THPComponents::Type::Audio:
-      SyncSeekRead(buf, 32, ESeekOrigin::Begin, cur);
-      memmove(&x74_audioInfo, buf, 12);
+      file.SyncSeekRead(buf, 32, ESeekOrigin::Begin, cur);
+      memmove(&audioInfo, buf, 12);
       cur += 12;
-      x74_audioInfo.swapBig();
-      xf4_25_hasAudio = true;
+      audioInfo.swapBig();
+      hasAudio = true;
       break;
     default:
       break;
     }
   }
+  return hasAudio;
+}
+
+CMoviePlayer::CMoviePlayer(const char* path, float preLoadSeconds, bool loop, bool deinterlace)
+: CDvdFile(path), xec_preLoadSeconds(preLoadSeconds), xf4_24_loop(loop), m_deinterlace(deinterlace) {
+  /* Read THP header information */
+  xf4_25_hasAudio = ReadHeaders(*this, x28_thpHead, x58_thpComponents, x6c_videoInfo, x74_audioInfo);
 
   /* Initial read state */
   xb4_nextReadOff = x28_thpHead.firstFrameOffset;
@@ -247,8 +339,12 @@ CMoviePlayer::CMoviePlayer(const char* path, float preLoadSeconds, bool loop, bo
     return true;
   } BooTrace);
 
-  /* Temporary planar YUV decode buffer, resulting planes copied to Boo */
-  m_yuvBuf.reset(new uint8_t[tjBufSizeYUV(x6c_videoInfo.width, x6c_videoInfo.height, TJ_420)]);
+  /* Planar YUV and audio decode buffers for the workers, resulting planes copied to Boo */
+  for (CTHPDecodeSlot& slot : m_decodeSlots) {
+    slot.yuvBuf.reset(new uint8_t[tjBufSizeYUV(x6c_videoInfo.width, x6c_videoInfo.height, TJ_420)]);
+    if (xf4_25_hasAudio)
+      slot.audioBuf.reset(new s16[x28_thpHead.maxAudioSamples * 2]);
+  }
 
   /* Schedule initial read */
   PostDVDReadRequestIfNeeded();
@@ -263,6 +359,8 @@ CMoviePlayer::CMoviePlayer(const char* path, float preLoadSeconds, bool loop, bo
   m_blockBuf->load(&m_viewVertBlock, sizeof(m_viewVertBlock));
 }
 
+CMoviePlayer::~CMoviePlayer() { DiscardPendingDecodes(); }
+
 void CMoviePlayer::SetStaticAudioVolume(int vol) {
   StaticVolumeAtten = StaticVolumeLookup[std::max(0, std::min(127, vol))];
 }
@@ -378,6 +476,7 @@ void CMoviePlayer::MixStaticAudio(s16* out, const s16* in, u32 samples) {
 }
 
 void CMoviePlayer::Rewind() {
+  DiscardPendingDecodes();
   if (x98_request) {
     x98_request->PostCancelRequest();
     x98_request.reset();
@@ -427,6 +526,8 @@ void CMoviePlayer::DrawFrame() {
 }
 
 void CMoviePlayer::Update(float dt) {
+  UploadDecodedFrames();
+
   if (xc0_curLoadFrame < xf0_preLoadFrames) {
     /* in buffering phase, ensure read data is stored for mem-cache access */
     if (x98_request && x98_request->IsComplete()) {
@@ -442,11 +543,12 @@ void CMoviePlayer::Update(float dt) {
       bool flag = false;
       if (xc4_requestFrameWrapped >= xa0_bufferQueue.size() && xc0_curLoadFrame >= xa0_bufferQueue.size())
         flag = true;
-      if (x98_request->IsComplete() && xd8_decodedTexCount < 2 && flag) {
-        DecodeFromRead(x90_requestBuf.get());
-        ReadCompleted();
+      if (x98_request->IsComplete() && CanQueueDecode() && flag) {
+        /* streamed frames are not kept in the mem-cache; the decode slot holds the buffer until it is done */
+        std::unique_ptr<uint8_t[]> frameData = ReadCompleted();
+        const uint8_t* data = frameData.get();
+        DecodeFromRead(data, std::move(frameData));
         PostDVDReadRequestIfNeeded();
-        ++xd8_decodedTexCount;
         ++xc4_requestFrameWrapped;
         if (xc4_requestFrameWrapped >= x28_thpHead.numFrames && xf4_24_loop)
           xc4_requestFrameWrapped = 0;
@@ -461,14 +563,13 @@ void CMoviePlayer::Update(float dt) {
   }
 
   /* decode frame directly from mem-cache if needed */
-  if (xd8_decodedTexCount < 2) {
+  if (CanQueueDecode()) {
     if (xe0_playMode == EPlayMode::Playing && xc4_requestFrameWrapped < xf0_preLoadFrames) {
       u32 minFrame = std::min(u32(xa0_bufferQueue.size()) - 1, xc4_requestFrameWrapped);
       if (minFrame == UINT32_MAX)
         return;
       std::unique_ptr<uint8_t[]>& frameData = xa0_bufferQueue[minFrame];
       DecodeFromRead(frameData.get());
-      ++xd8_decodedTexCount;
       ++xc4_requestFrameWrapped;
       if (xc4_requestFrameWrapped >= x28_thpHead.numFrames && xf4_24_loop)
         xc4_requestFrameWrapped = 0;
@@ -512,55 +613,24 @@ void CMoviePlayer::Update(float dt) {
   xdc_frameRem = rem;
 }
 
-void CMoviePlayer::DecodeFromRead(const void* data) {
+u32 CMoviePlayer::DecodeFrame(void* jpegHandle, const void* data, const THPHeader& head, const THPComponents& comps,
+                              bool stereo, u8* yuvOut, s16* audioOut) {
   const u8* inptr = (u8*)data;
-  CTHPTextureSet& tex = x80_textures[xcc_decodedTexSlot];
+  u32 audioSamples = 0;
 
   THPFrameHeader frameHeader = *static_cast<const THPFrameHeader*>(data);
   frameHeader.swapBig();
-  inptr += 8 + x58_thpComponents.numComponents * 4;
+  inptr += 8 + comps.numComponents * 4;
 
-  for (u32 i = 0; i < x58_thpComponents.numComponents; ++i) {
-    switch (x58_thpComponents.comps[i]) {
-    case THPComponents::Type::Video: {
-      tjDecompressToYUV(TjHandle, (u8*)inptr, frameHeader.imageSize, m_yuvBuf.get(), 0);
+  for (u32 i = 0; i < comps.numComponents; ++i) {
+    switch (comps.comps[i]) {
+    case THPComponents::Type::Video:
+      tjDecompressToYUV(jpegHandle, (u8*)inptr, frameHeader.imageSize, yuvOut, 0);
       inptr += frameHeader.imageSize;
-
-      uintptr_t planeSize = x6c_videoInfo.width * x6c_videoInfo.height;
-      uintptr_t planeSizeHalf = planeSize / 2;
-      uintptr_t planeSizeQuarter = planeSizeHalf / 2;
-
-      if (m_deinterlace) {
-        /* Deinterlace into 2 discrete 60-fps half-res textures */
-        u8* mappedData = (u8*)tex.Y[0]->map(planeSizeHalf);
-        for (unsigned y = 0; y < x6c_videoInfo.height / 2; ++y) {
-          memmove(mappedData + x6c_videoInfo.width * y, m_yuvBuf.get() + x6c_videoInfo.width * (y * 2),
-                  x6c_videoInfo.width);
-        }
-        tex.Y[0]->unmap();
-
-        mappedData = (u8*)tex.Y[1]->map(planeSizeHalf);
-        for (unsigned y = 0; y < x6c_videoInfo.height / 2; ++y) {
-          memmove(mappedData + x6c_videoInfo.width * y, m_yuvBuf.get() + x6c_videoInfo.width * (y * 2 + 1),
-                  x6c_videoInfo.width);
-        }
-        tex.Y[1]->unmap();
-
-        tex.U->load(m_yuvBuf.get() + planeSize, planeSizeQuarter);
-        tex.V->load(m_yuvBuf.get() + planeSize + planeSizeQuarter, planeSizeQuarter);
-      } else {
-        /* Direct planar load */
-        tex.Y[0]->load(m_yuvBuf.get(), planeSize);
-        tex.U->load(m_yuvBuf.get() + planeSize, planeSizeQuarter);
-        tex.V->load(m_yuvBuf.get() + planeSize + planeSizeQuarter, planeSizeQuarter);
-      }
-
       break;
-    }
     case THPComponents::Type::Audio:
-      memset(tex.audioBuf.get(), 0, x28_thpHead.maxAudioSamples * 4);
-      tex.audioSamples = THPAudioDecode(tex.audioBuf.get(), (u8*)inptr, x74_audioInfo.numChannels == 2);
-      tex.playedSamples = 0;
+      memset(audioOut, 0, head.maxAudioSamples * 4);
+      audioSamples = THPAudioDecode(audioOut, inptr, stereo);
       inptr += frameHeader.audioSize;
       break;
     default:
@@ -568,13 +638,97 @@ void CMoviePlayer::DecodeFromRead(const void* data) {
     }
   }
 
-  /* advance YUV producer-queue slot */
-  ++xcc_decodedTexSlot;
-  if (xcc_decodedTexSlot == x80_textures.size())
-    xcc_decodedTexSlot = 0;
+  return audioSamples;
+}
+
+void CMoviePlayer::DecodeFromRead(const void* data, std::unique_ptr<uint8_t[]> ownedFrame) {
+  CTHPDecodeSlot& slot = m_decodeSlots[(m_decodeHead + m_decodeCount) % kDecodeAhead];
+  slot.ownedFrame = std::move(ownedFrame);
+  slot.done.store(false);
+  ++m_decodeCount;
+
+  DecodePool.Push([this, data, &slot](tjhandle handle) {
+    slot.audioSamples = DecodeFrame(handle, data, x28_thpHead, x58_thpComponents, x74_audioInfo.numChannels == 2,
+                                    slot.yuvBuf.get(), slot.audioBuf.get());
+    slot.done.store(true, std::memory_order_release);
+  });
+}
+
+void CMoviePlayer::UploadDecodedFrames() {
+  while (m_decodeCount != 0 && xd8_decodedTexCount < 2) {
+    CTHPDecodeSlot& slot = m_decodeSlots[m_decodeHead];
+    if (!slot.done.load(std::memory_order_acquire))
+      return;
+
+    CTHPTextureSet& tex = x80_textures[xcc_decodedTexSlot];
+    const u8* yuv = slot.yuvBuf.get();
+    for (u32 i = 0; i < x58_thpComponents.numComponents; ++i) {
+      switch (x58_thpComponents.comps[i]) {
+      case THPComponents::Type::Video: {
+        uintptr_t planeSize = x6c_videoInfo.width * x6c_videoInfo.height;
+        uintptr_t planeSizeHalf = planeSize / 2;
+        uintptr_t planeSizeQuarter = planeSizeHalf / 2;
+
+        if (m_deinterlace) {
+          /* Deinterlace into 2 discrete 60-fps half-res textures */
+          u8* mappedData = (u8*)tex.Y[0]->map(planeSizeHalf);
+          for (unsigned y = 0; y < x6c_videoInfo.height / 2; ++y) {
+            memmove(mappedData + x6c_videoInfo.width * y, yuv + x6c_videoInfo.width * (y * 2), x6c_videoInfo.width);
+          }
+          tex.Y[0]->unmap();
+
+          mappedData = (u8*)tex.Y[1]->map(planeSizeHalf);
+          for (unsigned y = 0; y < x6c_videoInfo.height / 2; ++y) {
+            memmove(mappedData + x6c_videoInfo.width * y, yuv + x6c_videoInfo.width * (y * 2 + 1),
+                    x6c_videoInfo.width);
+          }
+          tex.Y[1]->unmap();
+
+          tex.U->load(yuv + planeSize, planeSizeQuarter);
+          tex.V->load(yuv + planeSize + planeSizeQuarter, planeSizeQuarter);
+        } else {
+          /* Direct planar load */
+          tex.Y[0]->load(yuv, planeSize);
+          tex.U->load(yuv + planeSize, planeSizeQuarter);
+          tex.V->load(yuv + planeSize + planeSizeQuarter, planeSizeQuarter);
+        }
+        break;
+      }
+      case THPComponents::Type::Audio:
+        /* audio travels with its video frame so the two stay in step */
+        std::swap(tex.audioBuf, slot.audioBuf);
+        tex.audioSamples = slot.audioSamples;
+        tex.playedSamples = 0;
+        break;
+      default:
+        break;
+      }
+    }
+    slot.ownedFrame.reset();
+
+    /* advance YUV producer-queue slot */
+    ++xcc_decodedTexSlot;
+    if (xcc_decodedTexSlot == x80_textures.size())
+      xcc_decodedTexSlot = 0;
+    ++xd8_decodedTexCount;
+
+    ++m_decodeHead;
+    if (m_decodeHead == kDecodeAhead)
+      m_decodeHead = 0;
+    --m_decodeCount;
+  }
+}
+
+void CMoviePlayer::DiscardPendingDecodes() {
+  for (CTHPDecodeSlot& slot : m_decodeSlots) {
+    DecodePool.Wait(slot.done);
+    slot.ownedFrame.reset();
+  }
+  m_decodeHead = 0;
+  m_decodeCount = 0;
 }
 
-void CMoviePlayer::ReadCompleted() {
+std::unique_ptr<uint8_t[]> CMoviePlayer::ReadCompleted() {
   std::unique_ptr<uint8_t[]> buffer = std::move(x90_requestBuf);
   x98_request.reset();
   const THPFrameHeader* frameHeader = reinterpret_cast<const THPFrameHeader*>(buffer.get());
@@ -604,6 +758,82 @@ void CMoviePlayer::ReadCompleted() {
     xb0_nextReadSize = xb8_readSizeWrapped;
     xc0_curLoadFrame = xf0_preLoadFrames;
   }
+
+  /* hand back buffers that were not cached */
+  return buffer;
+}
+
+void CMoviePlayer::RunDecodeBenchmark(std::string_view path) {
+  CDvdFile file(path);
+  if (!file) {
+    Log.report(logvisor::Error, FMT_STRING("Unable to open movie '{}' for decode benchmark"), path);
+    return;
+  }
+
+  THPHeader head{};
+  THPComponents comps{};
+  THPVideoInfo videoInfo{};
+  THPAudioInfo audioInfo{};
+  const bool hasAudio = ReadHeaders(file, head, comps, videoInfo, audioInfo);
+  const bool stereo = audioInfo.numChannels == 2;
+  if (head.numFrames == 0) {
+    return;
+  }
+
+  /* Read every frame up front so only decoding is timed */
+  std::vector<std::unique_ptr<uint8_t[]>> frames;
+  frames.reserve(head.numFrames);
+  u32 readOff = head.firstFrameOffset;
+  u32 readSize = head.firstFrameSize;
+  for (u32 i = 0; i < head.numFrames; ++i) {
+    std::unique_ptr<uint8_t[]>& frame = frames.emplace_back(new uint8_t[readSize]);
+    file.SyncSeekRead(frame.get(), readSize, ESeekOrigin::Begin, readOff);
+    readOff += readSize;
+    readSize = hecl::SBig(reinterpret_cast<const THPFrameHeader*>(frame.get())->nextSize);
+  }
+
+  const auto allocSlot = [&](CTHPDecodeSlot& slot) {
+    slot.yuvBuf.reset(new uint8_t[tjBufSizeYUV(videoInfo.width, videoInfo.height, TJ_420)]);
+    if (hasAudio)
+      slot.audioBuf.reset(new s16[head.maxAudioSamples * 2]);
+  };
+
+  CTHPDecodeSlot serialSlot;
+  allocSlot(serialSlot);
+  tjhandle handle = tjInitDecompress();
+  auto start = std::chrono::steady_clock::now();
+  for (const std::unique_ptr<uint8_t[]>& frame : frames) {
+    DecodeFrame(handle, frame.get(), head, comps, stereo, serialSlot.yuvBuf.get(), serialSlot.audioBuf.get());
+  }
+  const double serialSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  tjDestroy(handle);
+
+  /* Two slots per worker keeps every worker busy while finished slots are recycled in order */
+  const u32 slotCount = std::max(std::thread::hardware_concurrency(), 1u) * 2;
+  std::unique_ptr<CTHPDecodeSlot[]> slots(new CTHPDecodeSlot[slotCount]);
+  for (u32 i = 0; i < slotCount; ++i) {
+    allocSlot(slots[i]);
+  }
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < frames.size(); ++i) {
+    CTHPDecodeSlot& slot = slots[i % slotCount];
+    DecodePool.Wait(slot.done);
+    slot.done.store(false);
+    const uint8_t* data = frames[i].get();
+    DecodePool.Push([&slot, &head, &comps, data, stereo](tjhandle workerHandle) {
+      DecodeFrame(workerHandle, data, head, comps, stereo, slot.yuvBuf.get(), slot.audioBuf.get());
+      slot.done.store(true, std::memory_order_release);
+    });
+  }
+  for (u32 i = 0; i < slotCount; ++i) {
+    DecodePool.Wait(slots[i].done);
+  }
+  const double poolSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  Log.report(logvisor::Info,
+             FMT_STRING("Decoded '{}' ({}x{}, {} frames at {:.2f} fps{}): serial {:.1f} fps, {} workers {:.1f} fps"),
+             path, videoInfo.width, videoInfo.height, head.numFrames, head.fps, hasAudio ? ", with audio" : "",
+             head.numFrames / serialSec, DecodePool.GetThreadCount(), head.numFrames / poolSec);
 }
 
 void CMoviePlayer::PostDVDReadRequestIfNeeded() {
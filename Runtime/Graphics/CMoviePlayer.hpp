@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <string_view>
 #include <vector>
 
 #include "Runtime/CDvdFile.hpp"
@@ -81,6 +84,20 @@ private:
     boo::ObjToken<boo::IShaderDataBinding> binding[2];
   };
   std::vector<CTHPTextureSet> x80_textures;
+
+  /* Frames handed to the decode workers, uploaded in order once done and a texture set is free */
+  static constexpr u32 kDecodeAhead = 4;
+  struct CTHPDecodeSlot {
+    std::unique_ptr<uint8_t[]> ownedFrame;
+    std::unique_ptr<uint8_t[]> yuvBuf;
+    std::unique_ptr<s16[]> audioBuf;
+    u32 audioSamples = 0;
+    std::atomic_bool done{true};
+  };
+  std::array<CTHPDecodeSlot, kDecodeAhead> m_decodeSlots;
+  u32 m_decodeHead = 0;
+  u32 m_decodeCount = 0;
+
   std::unique_ptr<uint8_t[]> x90_requestBuf;
   std::shared_ptr<IDvdRequest> x98_request;
   std::vector<std::unique_ptr<uint8_t[]>> xa0_bufferQueue;
@@ -109,8 +126,6 @@ private:
   u32 xf8_ = 0;
   u32 xfc_fieldIndex = 0;
 
-  std::unique_ptr<uint8_t[]> m_yuvBuf;
-
   struct TexShaderVert {
     zeus::CVector3f m_pos;
     zeus::CVector2f m_uv;
@@ -137,12 +152,20 @@ private:
   TexShaderVert m_frame[4];
 
   static u32 THPAudioDecode(s16* buffer, const u8* audioFrame, bool stereo);
-  void DecodeFromRead(const void* data);
-  void ReadCompleted();
+  static bool ReadHeaders(CDvdFile& file, THPHeader& head, THPComponents& comps, THPVideoInfo& videoInfo,
+                          THPAudioInfo& audioInfo);
+  static u32 DecodeFrame(void* jpegHandle, const void* data, const THPHeader& head, const THPComponents& comps,
+                         bool stereo, u8* yuvOut, s16* audioOut);
+  bool CanQueueDecode() const { return m_decodeCount < kDecodeAhead; }
+  void DecodeFromRead(const void* data, std::unique_ptr<uint8_t[]> ownedFrame = {});
+  void UploadDecodedFrames();
+  void DiscardPendingDecodes();
+  std::unique_ptr<uint8_t[]> ReadCompleted();
   void PostDVDReadRequestIfNeeded();
 
 public:
   CMoviePlayer(const char* path, float preLoadSeconds, bool loop, bool deinterlace);
+  ~CMoviePlayer();
 
   static void DisableStaticAudio() { SetStaticAudio(nullptr, 0, 0, 0); }
   static void SetStaticAudioVolume(int vol);
@@ -169,6 +192,9 @@ public:
 
   static void Initialize(boo::IGraphicsDataFactory* factory);
   static void Shutdown();
+
+  /* Decodes every frame of a THP without uploading, serially and on the decode workers (--benchmark-movie) */
+  static void RunDecodeBenchmark(std::string_view path);
 };
 
 } // namespace metaforce
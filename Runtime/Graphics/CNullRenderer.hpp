@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Runtime/Graphics/CBooRenderer.hpp"
+
+namespace metaforce {
+
+/* Renderer for running without a graphics device (metaforce-benchmark). Everything that draws or queues
+ * work for drawing is dropped; static geometry registration, PVS and view matrices still go through
+ * CBooRenderer, so the simulation sees the same renderer state it does in a windowed run.
+ * Derives from CBooRenderer because g_Renderer is typed as one. */
+class CNullRenderer final : public CBooRenderer {
+public:
+  CNullRenderer(IObjectStore& store, IFactory& resFac) : CBooRenderer(store, resFac) {}
+
+  void DrawAreaGeometry(int, int, int) override {}
+  void DrawUnsortedGeometry(int, int, int, bool) override {}
+  void DrawSortedGeometry(int, int, int) override {}
+  void DrawStaticGeometry(int, int, int) override {}
+  void DrawModelFlat(const CModel&, const CModelFlags&, bool) override {}
+  void PostRenderFogs() override {}
+  void AddParticleGen(CParticleGen&) override {}
+  void AddParticleGen(CParticleGen&, const zeus::CVector3f&, const zeus::CAABox&) override {}
+  void AddPlaneObject(void*, const zeus::CAABox&, const zeus::CPlane&, int) override {}
+  void AddDrawable(void*, const zeus::CVector3f&, const zeus::CAABox&, int, EDrawableSorting) override {}
+  void SetViewport(int, int, int, int) override {}
+  void BeginScene() override {}
+  void EndScene() override {}
+  void DrawString(const char*, int, int) override {}
+  void CacheReflection(TReflectionCallback, void*, bool) override {}
+  void DrawSpaceWarp(const zeus::CVector3f&, float) override {}
+  void DrawThermalModel(const CModel&, const zeus::CColor&, const zeus::CColor&) override {}
+  void DrawXRayOutline(const zeus::CAABox&) override {}
+  void RenderFogVolume(const zeus::CColor&, const zeus::CAABox&, const TLockedToken<CModel>*,
+                       const CSkinnedModel*) override {}
+  void DoThermalBlendCold() override {}
+  void DoThermalBlendHot() override {}
+};
+
+} // namespace metaforce
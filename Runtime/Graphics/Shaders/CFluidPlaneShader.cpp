@@ -93,7 +93,7 @@ CFluidPlaneShader::Cache::GetOrBuildShader<SFluidPlaneShaderInfo>(const SFluidPl
   OPTICK_EVENT();
   u16 key = MakeCacheKey(info);
   auto& slot = CacheSlot(info, key);
-  if (slot.m_regular)
+  if (slot.m_regular || CGraphics::g_BooFactory == nullptr)
     return slot;
 
   slot.m_regular = hecl::conv->convert(Shader_CFluidPlaneShader{info, false});
@@ -108,7 +108,7 @@ CFluidPlaneShader::Cache::GetOrBuildShader<SFluidPlaneDoorShaderInfo>(const SFlu
   OPTICK_EVENT();
   u16 key = MakeCacheKey(info);
   auto& slot = CacheSlot(info, key);
-  if (slot.m_regular)
+  if (slot.m_regular || CGraphics::g_BooFactory == nullptr)
     return slot;
 
   slot.m_regular = hecl::conv->convert(Shader_CFluidPlaneDoorShader{info});
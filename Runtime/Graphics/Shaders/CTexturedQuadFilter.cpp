@@ -179,12 +179,12 @@ static boo::ObjToken<boo::IShaderPipeline> SelectAlphaPipeline(EFilterType type)
 }
 
 CTexturedQuadFilter::CTexturedQuadFilter(const boo::ObjToken<boo::ITexture>& tex) : m_booTex(tex) {
-  m_flipRect = CGraphics::g_BooFactory->platform() == boo::IGraphicsDataFactory::Platform::Vulkan;
+  m_flipRect = CGraphics::g_BooPlatform == boo::IGraphicsDataFactory::Platform::Vulkan;
 }
 
 CTexturedQuadFilter::CTexturedQuadFilter(EFilterType type, const boo::ObjToken<boo::ITexture>& tex, ZTest ztest)
 : m_booTex(tex), m_zTest(ztest) {
-  m_flipRect = CGraphics::g_BooFactory->platform() == boo::IGraphicsDataFactory::Platform::Vulkan;
+  m_flipRect = CGraphics::g_BooPlatform == boo::IGraphicsDataFactory::Platform::Vulkan;
   tex->setClampMode(boo::TextureClampMode::ClampToEdge);
   CGraphics::CommitResources([&](boo::IGraphicsDataFactory::Context& ctx) {
     m_vbo = ctx.newDynamicBuffer(boo::BufferUse::Vertex, 32, 16);
@@ -202,7 +202,7 @@ CTexturedQuadFilter::CTexturedQuadFilter(EFilterType type, const boo::ObjToken<b
 
 CTexturedQuadFilter::CTexturedQuadFilter(EFilterType type, TLockedToken<CTexture> tex, ZTest ztest)
 : CTexturedQuadFilter(type, (tex ? tex->GetBooTexture() : nullptr), ztest) {
-  m_flipRect = CGraphics::g_BooFactory->platform() == boo::IGraphicsDataFactory::Platform::Vulkan;
+  m_flipRect = CGraphics::g_BooPlatform == boo::IGraphicsDataFactory::Platform::Vulkan;
   m_tex = tex;
 }
 
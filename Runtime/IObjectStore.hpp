@@ -1,11 +1,13 @@
 #pragma once
 
+#include <memory>
 #include <string_view>
 
 namespace metaforce {
 class CToken;
 class CVParamTransfer;
 class IFactory;
+class IObj;
 struct SObjectTag;
 
 class IObjectStore {
@@ -20,6 +22,11 @@ public:
   virtual IFactory& GetFactory() const = 0;
   virtual void Flush() = 0;
   virtual void ObjectUnreferenced(const SObjectTag&) = 0;
+
+  /* Offers an object that is being unloaded to the store's residency cache; returns true if ownership was taken */
+  virtual bool RetainUnloadedObject(const SObjectTag&, std::unique_ptr<IObj>&) { return false; }
+  /* Moves a previously retained object into out; returns false if it must be built again */
+  virtual bool TakeRetainedObject(const SObjectTag&, std::unique_ptr<IObj>&) { return false; }
 };
 
 } // namespace metaforce
@@ -2,14 +2,21 @@
 
 #include "../version.h"
 #include "MP1/MP1.hpp"
+#include "Runtime/CMemoryTags.hpp"
+#include "Runtime/CResLoadStats.hpp"
+#include "Runtime/CScriptMsgStats.hpp"
 #include "Runtime/CStateManager.hpp"
 #include "Runtime/GameGlobalObjects.hpp"
+#include "Runtime/Character/CSegStatementCache.hpp"
 #include "Runtime/World/CPlayer.hpp"
 #include "Runtime/ImGuiEntitySupport.hpp"
 
 #include "ImGuiEngine.hpp"
 #include "magic_enum.hpp"
 
+#include <algorithm>
+#include <numeric>
+
 #include <zeus/CEulerAngles.hpp>
 
 namespace ImGui {
@@ -705,7 +712,8 @@ void ImGuiConsole::ShowAboutWindow(bool canClose, std::string_view errorString)
 
 void ImGuiConsole::ShowDebugOverlay() {
   if (!m_frameCounter && !m_frameRate && !m_inGameTime && !m_roomTimer && !m_playerInfo && !m_areaInfo &&
-      !m_worldInfo && !m_randomStats && !m_resourceStats) {
+      !m_worldInfo && !m_randomStats && !m_resourceStats && !m_animationStats &&
+      !m_scriptStats && !m_memoryStats) {
     return;
   }
   ImGuiIO& io = ImGui::GetIO();
@@ -861,6 +869,69 @@ void ImGuiConsole::ShowDebugOverlay() {
       hasPrevious = true;
 
       ImGuiStringViewText(fmt::format(FMT_STRING("Resource Objects: {}\n"), g_SimplePool->GetLiveObjects()));
+      const CSimplePool::SResidencyStats& residency = g_SimplePool->GetResidencyStats();
+      ImGuiStringViewText(fmt::format(FMT_STRING("Resident: {} ({:.1f}/{:.1f} MiB)\n"),
+                                      g_SimplePool->GetResidentObjects(),
+                                      double(g_SimplePool->GetResidentBytes()) / 1048576.0,
+                                      double(g_SimplePool->GetResidencyBudget()) / 1048576.0));
+      ImGuiStringViewText(fmt::format(FMT_STRING("Resident Hits: {}, Misses: {}, Evictions: {}\n"), residency.m_hits,
+                                      residency.m_misses, residency.m_evictions));
+      ImGuiStringViewText(fmt::format(FMT_STRING("Sync Builds: {}\n"), CResLoadStats::GetTotalSyncBuilds()));
+    }
+    if (m_animationStats) {
+      if (hasPrevious) {
+        ImGui::Separator();
+      }
+      hasPrevious = true;
+
+      const CSegStatementCache::SStats& stats = CSegStatementCache::GetLastFrameStats();
+      const u32 lookups = stats.x0_hits + stats.x4_misses;
+      const float hitRate = lookups != 0 ? float(stats.x0_hits) / float(lookups) * 100.f : 0.f;
+      ImGuiStringViewText(fmt::format(FMT_STRING("Pose Cache Hits: {}, Misses: {} ({:.1f}%)\n"
+                                                 "           Entries: {}, Rejected: {}\n"),
+                                      stats.x0_hits, stats.x4_misses, hitRate, stats.xc_entries, stats.x8_rejected));
+    }
+    if (m_scriptStats) {
+      if (hasPrevious) {
+        ImGui::Separator();
+      }
+      hasPrevious = true;
+
+      const CScriptMsgStats::SFrameStats& stats = CScriptMsgStats::GetLastFrameStats();
+      ImGuiStringViewText(fmt::format(FMT_STRING("Script Messages: {}, Deferred: {}, Max Depth: {}\n"), stats.m_total,
+                                      stats.m_deferred, stats.m_maxDepth));
+
+      std::array<size_t, CScriptMsgStats::kNumMessages> order;
+      std::iota(order.begin(), order.end(), 0);
+      const auto top = order.begin() + std::min<size_t>(8, order.size());
+      std::partial_sort(order.begin(), top, order.end(), [&](size_t a, size_t b) {
+        return stats.m_messages[a].m_count > stats.m_messages[b].m_count;
+      });
+      for (auto it = order.begin(); it != top && stats.m_messages[*it].m_count != 0; ++it) {
+        const CScriptMsgStats::SMessageStats& msg = stats.m_messages[*it];
+        ImGuiStringViewText(fmt::format(FMT_STRING("  {}: {} ({:.1f}us)\n"),
+                                        ScriptObjectMessageToStr(EScriptObjectMessage(*it)), msg.m_count,
+                                        msg.m_inclusiveUs));
+      }
+    }
+    if (m_memoryStats) {
+      if (hasPrevious) {
+        ImGui::Separator();
+      }
+      hasPrevious = true;
+
+      const CMemoryTags::SAreaPeak* areaPeak = CMemoryTags::GetCurrentAreaPeak();
+      for (size_t i = 0; i < CMemoryTags::kNumTags; ++i) {
+        const auto tag = EMemoryTag(i);
+        std::string line = fmt::format(FMT_STRING("{}: {:.0f} KiB, Peak: {:.0f} KiB"), CMemoryTags::GetTagName(tag),
+                                       double(CMemoryTags::GetLive(tag)) / 1024.0,
+                                       double(CMemoryTags::GetPeak(tag)) / 1024.0);
+        if (areaPeak != nullptr) {
+          line += fmt::format(FMT_STRING(", Area Peak: {:.0f} KiB"), double(areaPeak->m_peak[i]) / 1024.0);
+        }
+        line += '\n';
+        ImGuiStringViewText(line);
+      }
     }
     ShowCornerContextMenu(m_debugOverlayCorner, m_inputOverlayCorner);
   }
@@ -1065,6 +1136,7 @@ void ImGuiConsole::ShowAppMainMenuBar(bool canInspect) {
       ImGui::MenuItem("Items", nullptr, &m_showItemsWindow, canInspect && m_developer && m_cheats);
       ImGui::MenuItem("Layers", nullptr, &m_showLayersWindow, canInspect && m_developer);
       ImGui::MenuItem("Console Variables", nullptr, &m_showConsoleVariablesWindow);
+      ImGui::MenuItem("Profiler", nullptr, &m_showProfilerWindow);
       ImGui::EndMenu();
     }
     if (ImGui::BeginMenu("Debug")) {
@@ -1098,6 +1170,15 @@ void ImGuiConsole::ShowAppMainMenuBar(bool canInspect) {
       if (ImGui::MenuItem("Resource Stats", nullptr, &m_resourceStats)) {
         m_cvarCommons.m_debugOverlayShowResourceStats->fromBoolean(m_resourceStats);
       }
+      if (ImGui::MenuItem("Animation Stats", nullptr, &m_animationStats)) {
+        m_cvarCommons.m_debugOverlayShowAnimationStats->fromBoolean(m_animationStats);
+      }
+      if (ImGui::MenuItem("Script Stats", nullptr, &m_scriptStats)) {
+        m_cvarCommons.m_debugOverlayShowScriptStats->fromBoolean(m_scriptStats);
+      }
+      if (ImGui::MenuItem("Memory Stats", nullptr, &m_memoryStats)) {
+        m_cvarCommons.m_debugOverlayShowMemoryStats->fromBoolean(m_memoryStats);
+      }
       if (ImGui::MenuItem("Show Input", nullptr, &m_showInput)) {
         m_cvarCommons.m_debugOverlayShowInput->fromBoolean(m_showInput);
       }
@@ -1139,10 +1220,15 @@ void ImGuiConsole::PreUpdate() {
     m_cvarCommons.m_debugOverlayShowRandomStats->addListener([this](hecl::CVar* c) { m_randomStats = c->toBoolean(); });
     m_cvarCommons.m_debugOverlayShowResourceStats->addListener(
         [this](hecl::CVar* c) { m_resourceStats = c->toBoolean(); });
+    m_cvarCommons.m_debugOverlayShowAnimationStats->addListener(
+        [this](hecl::CVar* c) { m_animationStats = c->toBoolean(); });
+    m_cvarCommons.m_debugOverlayShowScriptStats->addListener([this](hecl::CVar* c) { m_scriptStats = c->toBoolean(); });
+    m_cvarCommons.m_debugOverlayShowMemoryStats->addListener([this](hecl::CVar* c) { m_memoryStats = c->toBoolean(); });
     m_cvarCommons.m_debugOverlayShowInput->addListener([this](hecl::CVar* c) { m_showInput = c->toBoolean(); });
     m_cvarMgr.findCVar("developer")->addListener([this](hecl::CVar* c) { m_developer = c->toBoolean(); });
     m_cvarMgr.findCVar("cheats")->addListener([this](hecl::CVar* c) { m_cheats = c->toBoolean(); });
   }
+  CScriptMsgStats::SetTimingEnabled(m_scriptStats);
   // We ned to make sure we have a valid CRandom16 at all times, so lets do that here
   if (g_StateManager != nullptr && g_StateManager->GetActiveRandom() == nullptr) {
     g_StateManager->SetActiveRandomToDefault();
@@ -1198,6 +1284,10 @@ void ImGuiConsole::PreUpdate() {
   if (m_showConsoleVariablesWindow) {
     ShowConsoleVariablesWindow();
   }
+  CProfiler::SetLiveView(m_showProfilerWindow);
+  if (m_showProfilerWindow) {
+    ShowProfilerWindow();
+  }
   ShowDebugOverlay();
   ShowInputViewer();
   ShowPlayerTransformEditor();
@@ -1519,6 +1609,43 @@ void ImGuiConsole::ShowLayersWindow() {
   ImGui::End();
 }
 
+void ImGuiConsole::ShowProfilerWindow() {
+  float initialWindowSize = 350.f * ImGui::GetIO().DisplayFramebufferScale.x;
+  ImGui::SetNextWindowSize(ImVec2{initialWindowSize, initialWindowSize}, ImGuiCond_FirstUseEver);
+
+  if (ImGui::Begin("Profiler", &m_showProfilerWindow)) {
+    if (ImGui::Button("Export Chrome Trace")) {
+      CProfiler::WriteChromeTrace("profile.json");
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Capture 300 Frames") && !CProfiler::IsCapturing()) {
+      CProfiler::StartCapture(300, "profile.json");
+    }
+
+    // Zones of the previous frame on this thread, children indented under their parents
+    CProfiler::GetLastFrameZones(m_profilerZones);
+    if (ImGui::BeginTable("Zones", 2,
+                          ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter |
+                              ImGuiTableFlags_BordersV | ImGuiTableFlags_ScrollY)) {
+      ImGui::TableSetupColumn("Zone", ImGuiTableColumnFlags_WidthStretch);
+      ImGui::TableSetupColumn("ms", ImGuiTableColumnFlags_WidthFixed);
+      ImGui::TableSetupScrollFreeze(0, 1);
+      ImGui::TableHeadersRow();
+      for (const CProfiler::SZone& zone : m_profilerZones) {
+        ImGui::TableNextRow();
+        if (ImGui::TableNextColumn()) {
+          ImGuiStringViewText(fmt::format(FMT_STRING("{:{}}{}"), "", zone.m_depth * 2, zone.m_name));
+        }
+        if (ImGui::TableNextColumn()) {
+          ImGuiStringViewText(fmt::format(FMT_STRING("{:.3f}"), double(zone.m_endNs - zone.m_beginNs) / 1000000.0));
+        }
+      }
+      ImGui::EndTable();
+    }
+  }
+  ImGui::End();
+}
+
 void ImGuiConsole::ShowMenuHint() {
   if (m_menuHintTime <= 0.f) {
     return;
@@ -2,8 +2,10 @@
 
 #include <set>
 #include <string_view>
+#include <vector>
 
 #include "RetroTypes.hpp"
+#include "Runtime/CProfiler.hpp"
 #include "Runtime/World/CActor.hpp"
 #include "Runtime/World/CEntity.hpp"
 #include "Runtime/ImGuiPlayerLoadouts.hpp"
@@ -60,6 +62,8 @@ private:
   bool m_showLayersWindow = false;
   bool m_showConsoleVariablesWindow = false;
   bool m_showPlayerTransformEditor = false;
+  bool m_showProfilerWindow = false;
+  std::vector<CProfiler::SZone> m_profilerZones;
   std::optional<zeus::CVector3f> m_savedLocation;
   std::optional<zeus::CEulerAngles> m_savedRotation;
 
@@ -85,6 +89,9 @@ private:
   bool m_layerInfo = m_cvarCommons.m_debugOverlayLayerInfo->toBoolean();
   bool m_randomStats = m_cvarCommons.m_debugOverlayShowRandomStats->toBoolean();
   bool m_resourceStats = m_cvarCommons.m_debugOverlayShowResourceStats->toBoolean();
+  bool m_animationStats = m_cvarCommons.m_debugOverlayShowAnimationStats->toBoolean();
+  bool m_scriptStats = m_cvarCommons.m_debugOverlayShowScriptStats->toBoolean();
+  bool m_memoryStats = m_cvarCommons.m_debugOverlayShowMemoryStats->toBoolean();
   bool m_showInput = m_cvarCommons.m_debugOverlayShowInput->toBoolean();
   bool m_developer = m_cvarMgr.findCVar("developer")->toBoolean();
   bool m_cheats = m_cvarMgr.findCVar("cheats")->toBoolean();
@@ -112,5 +119,6 @@ private:
   void SetOverlayWindowLocation(int corner) const;
   void ShowCornerContextMenu(int& corner, int avoidCorner) const;
   void ShowPlayerTransformEditor();
+  void ShowProfilerWindow();
 };
 } // namespace metaforce
@@ -2,6 +2,7 @@
 
 #include "Runtime/CArchitectureMessage.hpp"
 #include "Runtime/CArchitectureQueue.hpp"
+#include "Runtime/Input/CInputRecorder.hpp"
 
 namespace metaforce {
 
@@ -11,18 +12,42 @@ void CInputGenerator::Update(float dt, CArchitectureQueue& queue) {
     return;
   }
 
+  /* Gather raw device state; a replay substitutes its recorded state here */
+  CInputRecorder::SFrame frame;
+  frame.m_kbm = m_data;
+  std::array<EStatusChange, 4> changes{};
+  for (u32 i = 0; i < 4; ++i) {
+    bool connected;
+    changes[i] = m_dolphinCb.getStatusChange(i, connected);
+    if (connected) {
+      frame.m_connectedMask |= 1u << i;
+      frame.m_pads[i] = m_dolphinCb.getState(i);
+    }
+  }
+  if (CInputRecorder::ProcessFrame(frame)) {
+    m_data = frame.m_kbm;
+    for (u32 i = 0; i < 4; ++i) {
+      const bool connected = frame.m_connectedMask & (1u << i);
+      if (connected == bool(m_connectedMask & (1u << i))) {
+        changes[i] = EStatusChange::NoChange;
+      } else {
+        changes[i] = connected ? EStatusChange::Connected : EStatusChange::Disconnected;
+      }
+    }
+  }
+  m_connectedMask = frame.m_connectedMask;
+
   /* Keyboard/Mouse first */
   CFinalInput kbInput = getFinalInput(0, dt);
   bool kbUsed = false;
 
   /* Dolphin controllers next */
-  for (int i = 0; i < 4; ++i) {
-    bool connected;
-    EStatusChange change = m_dolphinCb.getStatusChange(i, connected);
-    if (change != EStatusChange::NoChange)
+  for (u32 i = 0; i < 4; ++i) {
+    const bool connected = frame.m_connectedMask & (1u << i);
+    if (changes[i] != EStatusChange::NoChange)
       queue.Push(MakeMsg::CreateControllerStatus(EArchMsgTarget::Game, i, connected));
     if (connected) {
-      CFinalInput input = m_dolphinCb.getFinalInput(i, dt, m_leftDiv, m_rightDiv);
+      CFinalInput input = m_dolphinCb.getFinalInput(i, dt, frame.m_pads[i], m_leftDiv, m_rightDiv);
       if (i == 0) /* Merge KB input with first controller */
       {
         input |= kbInput;
@@ -33,6 +33,7 @@ class CInputGenerator : public boo::DeviceFinder {
   }
 
   bool m_firstFrame = true;
+  u32 m_connectedMask = 0;
 
 public:
   CInputGenerator(float leftDiv, float rightDiv)
@@ -105,12 +106,17 @@ public:
     }
 
     std::array<CFinalInput, 4> m_lastUpdates;
-    const CFinalInput& getFinalInput(unsigned idx, float dt, float leftDiv, float rightDiv) {
+    boo::DolphinControllerState getState(unsigned idx) {
       /* Game thread */
       std::unique_lock lk{m_stateLock};
       boo::DolphinControllerState state = m_states[idx];
       lk.unlock();
       state.clamp(); /* PADClamp equivalent */
+      return state;
+    }
+    const CFinalInput& getFinalInput(unsigned idx, float dt, const boo::DolphinControllerState& state, float leftDiv,
+                                     float rightDiv) {
+      /* Game thread */
       m_lastUpdates[idx] = CFinalInput(idx, dt, state, m_lastUpdates[idx], leftDiv, rightDiv);
       return m_lastUpdates[idx];
     }
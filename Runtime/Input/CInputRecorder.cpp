@@ -0,0 +1,265 @@
+#include "Runtime/Input/CInputRecorder.hpp"
+
+#include <cstring>
+
+#include "Runtime/IOStreams.hpp"
+
+#include <athena/FileReader.hpp>
+#include <athena/FileWriter.hpp>
+#include <logvisor/logvisor.hpp>
+
+namespace metaforce {
+namespace {
+logvisor::Module Log("metaforce::CInputRecorder");
+
+constexpr std::array<u8, 4> kMagic{'M', 'F', 'I', 'R'};
+constexpr u32 kVersion = 1;
+
+enum class ERecordType : u8 { Input = 'I', Hash = 'H', End = 'E' };
+
+template <typename T>
+void PutBig(std::vector<u8>& out, T val) {
+  for (int i = int(sizeof(T)) - 1; i >= 0; --i) {
+    out.push_back(u8(val >> (i * 8)));
+  }
+}
+
+void PutFloat(std::vector<u8>& out, float val) {
+  u32 bits;
+  std::memcpy(&bits, &val, sizeof(bits));
+  PutBig(out, bits);
+}
+
+void PutDouble(std::vector<u8>& out, double val) {
+  u64 bits;
+  std::memcpy(&bits, &val, sizeof(bits));
+  PutBig(out, bits);
+}
+
+template <size_t N>
+void PutBits(std::vector<u8>& out, const std::array<bool, N>& bits) {
+  for (size_t i = 0; i < N; i += 8) {
+    u8 byte = 0;
+    for (size_t b = 0; b < 8 && i + b < N; ++b) {
+      byte |= u8(bits[i + b]) << b;
+    }
+    out.push_back(byte);
+  }
+}
+
+template <size_t N>
+void GetBits(CInputStream& in, std::array<bool, N>& bits) {
+  for (size_t i = 0; i < N; i += 8) {
+    const u8 byte = in.readUByte();
+    for (size_t b = 0; b < 8 && i + b < N; ++b) {
+      bits[i + b] = (byte >> b) & 1;
+    }
+  }
+}
+
+void PackFrame(const CInputRecorder::SFrame& frame, std::vector<u8>& out) {
+  const CKeyboardMouseControllerData& kbm = frame.m_kbm;
+  PutBits(out, kbm.m_charKeys);
+  PutBits(out, kbm.m_specialKeys);
+  PutBits(out, kbm.m_mouseButtons);
+  PutBig(out, u32(kbm.m_modMask));
+  for (size_t i = 0; i < 2; ++i) {
+    PutBig(out, u32(kbm.m_mouseCoord.pixel[i]));
+    PutBig(out, u32(kbm.m_mouseCoord.virtualPixel[i]));
+    PutFloat(out, kbm.m_mouseCoord.norm[i]);
+    PutDouble(out, kbm.m_accumScroll.delta[i]);
+  }
+  out.push_back(u8(kbm.m_accumScroll.isFine));
+  out.push_back(u8(kbm.m_accumScroll.isAccelerated));
+
+  out.push_back(u8(frame.m_connectedMask));
+  for (size_t i = 0; i < frame.m_pads.size(); ++i) {
+    if ((frame.m_connectedMask & (1u << i)) == 0) {
+      continue;
+    }
+    const boo::DolphinControllerState& pad = frame.m_pads[i];
+    for (size_t j = 0; j < 2; ++j) {
+      PutBig(out, u16(pad.m_leftStick[j]));
+      PutBig(out, u16(pad.m_rightStick[j]));
+      PutBig(out, u16(pad.m_analogTriggers[j]));
+    }
+    PutBig(out, u16(pad.m_btns));
+  }
+}
+
+CInputRecorder::SFrame UnpackFrame(CInputStream& in) {
+  CInputRecorder::SFrame frame;
+  CKeyboardMouseControllerData& kbm = frame.m_kbm;
+  GetBits(in, kbm.m_charKeys);
+  GetBits(in, kbm.m_specialKeys);
+  GetBits(in, kbm.m_mouseButtons);
+  kbm.m_modMask = boo::EModifierKey(in.readUint32Big());
+  for (size_t i = 0; i < 2; ++i) {
+    kbm.m_mouseCoord.pixel[i] = in.readInt32Big();
+    kbm.m_mouseCoord.virtualPixel[i] = in.readInt32Big();
+    kbm.m_mouseCoord.norm[i] = in.readFloatBig();
+    kbm.m_accumScroll.delta[i] = in.readDoubleBig();
+  }
+  kbm.m_accumScroll.isFine = in.readBool();
+  kbm.m_accumScroll.isAccelerated = in.readBool();
+
+  frame.m_connectedMask = in.readUByte();
+  for (size_t i = 0; i < frame.m_pads.size(); ++i) {
+    if ((frame.m_connectedMask & (1u << i)) == 0) {
+      continue;
+    }
+    boo::DolphinControllerState& pad = frame.m_pads[i];
+    for (size_t j = 0; j < 2; ++j) {
+      pad.m_leftStick[j] = in.readInt16Big();
+      pad.m_rightStick[j] = in.readInt16Big();
+      pad.m_analogTriggers[j] = in.readInt16Big();
+    }
+    pad.m_btns = in.readUint16Big();
+  }
+  return frame;
+}
+} // Anonymous namespace
+
+CInputRecorder::EMode CInputRecorder::m_mode = CInputRecorder::EMode::Off;
+u32 CInputRecorder::m_frameIdx = 0;
+u32 CInputRecorder::m_replayEndFrame = 0;
+std::unique_ptr<athena::io::FileWriter> CInputRecorder::m_writer;
+std::vector<u8> CInputRecorder::m_lastPacked;
+std::vector<std::pair<u32, CInputRecorder::SFrame>> CInputRecorder::m_replayFrames;
+std::vector<std::pair<u32, u64>> CInputRecorder::m_replayHashes;
+size_t CInputRecorder::m_replayFrameIt = 0;
+size_t CInputRecorder::m_replayHashIt = 0;
+CInputRecorder::SFrame CInputRecorder::m_replayState;
+bool CInputRecorder::m_diverged = false;
+
+bool CInputRecorder::StartRecording(std::string_view path) {
+  Stop();
+  m_writer = std::make_unique<athena::io::FileWriter>(path);
+  if (m_writer->hasError()) {
+    Log.report(logvisor::Error, FMT_STRING("Unable to open '{}' for recording input"), path);
+    m_writer.reset();
+    return false;
+  }
+  m_writer->writeUBytes(kMagic.data(), kMagic.size());
+  m_writer->writeUint32Big(kVersion);
+  m_lastPacked.clear();
+  m_frameIdx = 0;
+  m_mode = EMode::Record;
+  Log.report(logvisor::Info, FMT_STRING("Recording input to '{}'"), path);
+  return true;
+}
+
+bool CInputRecorder::StartReplay(std::string_view path) {
+  Stop();
+  athena::io::FileReader reader(path);
+  if (reader.hasError()) {
+    Log.report(logvisor::Error, FMT_STRING("Unable to open input recording '{}'"), path);
+    return false;
+  }
+  const u64 length = reader.length();
+  const auto data = reader.readUBytes(length);
+  CMemoryInStream in(data.get(), length);
+
+  std::array<u8, 4> magic{};
+  in.readUBytesToBuf(magic.data(), magic.size());
+  if (magic != kMagic || in.readUint32Big() != kVersion) {
+    Log.report(logvisor::Error, FMT_STRING("'{}' is not a supported input recording"), path);
+    return false;
+  }
+
+  m_replayFrames.clear();
+  m_replayHashes.clear();
+  m_replayEndFrame = 0;
+  while (in.position() < length) {
+    const auto type = ERecordType(in.readUByte());
+    const u32 frameIdx = in.readUint32Big();
+    m_replayEndFrame = frameIdx;
+    if (type == ERecordType::Input) {
+      m_replayFrames.emplace_back(frameIdx, UnpackFrame(in));
+    } else if (type == ERecordType::Hash) {
+      m_replayHashes.emplace_back(frameIdx, in.readUint64Big());
+    } else if (type == ERecordType::End) {
+      break;
+    } else {
+      Log.report(logvisor::Warning, FMT_STRING("Unknown record in '{}'; truncating replay at frame {}"), path,
+                 frameIdx);
+      break;
+    }
+  }
+
+  m_replayFrameIt = 0;
+  m_replayHashIt = 0;
+  m_replayState = {};
+  m_diverged = false;
+  m_frameIdx = 0;
+  m_mode = EMode::Replay;
+  Log.report(logvisor::Info, FMT_STRING("Replaying {} frames of input from '{}'"), m_replayEndFrame, path);
+  return true;
+}
+
+void CInputRecorder::Stop() {
+  if (m_writer) {
+    m_writer->writeUByte(u8(ERecordType::End));
+    m_writer->writeUint32Big(m_frameIdx);
+    m_writer.reset();
+  }
+  m_replayFrames = {};
+  m_replayHashes = {};
+  m_mode = EMode::Off;
+}
+
+bool CInputRecorder::ProcessFrame(SFrame& frame) {
+  switch (m_mode) {
+  case EMode::Off:
+    return false;
+  case EMode::Record: {
+    std::vector<u8> packed;
+    packed.reserve(m_lastPacked.size());
+    PackFrame(frame, packed);
+    if (packed != m_lastPacked) {
+      m_writer->writeUByte(u8(ERecordType::Input));
+      m_writer->writeUint32Big(m_frameIdx);
+      m_writer->writeUBytes(packed.data(), packed.size());
+      m_lastPacked = std::move(packed);
+    }
+    ++m_frameIdx;
+    return false;
+  }
+  case EMode::Replay:
+    if (m_frameIdx >= m_replayEndFrame) {
+      Log.report(logvisor::Info, FMT_STRING("Input replay finished at frame {}{}"), m_frameIdx,
+                 m_diverged ? " (diverged)" : "");
+      Stop();
+      return false;
+    }
+    while (m_replayFrameIt < m_replayFrames.size() && m_replayFrames[m_replayFrameIt].first <= m_frameIdx) {
+      m_replayState = m_replayFrames[m_replayFrameIt].second;
+      ++m_replayFrameIt;
+    }
+    frame = m_replayState;
+    ++m_frameIdx;
+    return true;
+  }
+  return false;
+}
+
+void CInputRecorder::ProcessStateHash(u64 hash) {
+  if (m_mode == EMode::Record) {
+    m_writer->writeUByte(u8(ERecordType::Hash));
+    m_writer->writeUint32Big(m_frameIdx);
+    m_writer->writeUint64Big(hash);
+    return;
+  }
+  if (m_mode != EMode::Replay || m_diverged || m_replayHashIt >= m_replayHashes.size()) {
+    return;
+  }
+  const auto& [expectedFrame, expectedHash] = m_replayHashes[m_replayHashIt++];
+  if (expectedFrame != m_frameIdx || expectedHash != hash) {
+    Log.report(logvisor::Warning,
+               FMT_STRING("Replay diverged at frame {}: expected state {:016X} at frame {}, got {:016X}"), m_frameIdx,
+               expectedHash, expectedFrame, hash);
+    m_diverged = true;
+  }
+}
+
+} // namespace metaforce
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Runtime/GCNTypes.hpp"
+#include "Runtime/Input/CKeyboardMouseController.hpp"
+
+#include <boo/inputdev/DolphinSmashAdapter.hpp>
+
+namespace athena::io {
+class FileWriter;
+}
+
+namespace metaforce {
+
+/* Records the raw controller and keyboard/mouse state fed to CInputGenerator and plays it back.
+ * Frames are only written when the state changes, tagged with their input frame index.
+ * A hash of the simulation state is stored alongside each frame so a replay reports the exact
+ * frame at which it diverges from the recording. */
+class CInputRecorder {
+public:
+  struct SFrame {
+    CKeyboardMouseControllerData m_kbm;
+    u32 m_connectedMask = 0;
+    std::array<boo::DolphinControllerState, 4> m_pads{};
+  };
+
+private:
+  enum class EMode { Off, Record, Replay };
+
+  static EMode m_mode;
+  static u32 m_frameIdx;
+  static u32 m_replayEndFrame;
+  static std::unique_ptr<athena::io::FileWriter> m_writer;
+  static std::vector<u8> m_lastPacked;
+  static std::vector<std::pair<u32, SFrame>> m_replayFrames;
+  static std::vector<std::pair<u32, u64>> m_replayHashes;
+  static size_t m_replayFrameIt;
+  static size_t m_replayHashIt;
+  static SFrame m_replayState;
+  static bool m_diverged;
+
+public:
+  static bool StartRecording(std::string_view path);
+  static bool StartReplay(std::string_view path);
+  static void Stop();
+
+  static bool IsRecording() { return m_mode == EMode::Record; }
+  static bool IsReplaying() { return m_mode == EMode::Replay; }
+  static bool IsActive() { return m_mode != EMode::Off; }
+  static u32 GetFrameIndex() { return m_frameIdx; }
+  /* Input frame at which the loaded replay ends */
+  static u32 GetReplayEndFrame() { return m_replayEndFrame; }
+
+  /* Called once per input poll; records the frame, or replaces it with the recorded one.
+   * Returns true if the frame was replaced. */
+  static bool ProcessFrame(SFrame& frame);
+
+  /* Called once per simulation update with the current state hash */
+  static void ProcessStateHash(u64 hash);
+};
+
+} // namespace metaforce
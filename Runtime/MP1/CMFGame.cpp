@@ -346,7 +346,7 @@ CIOWin::EMessageReturn CMFGameLoader::OnMessage(const CArchitectureMessage& msg,
 
     x1c_loadList.clear();
 
-    if (!CGraphics::g_BooFactory->areShadersReady())
+    if (CGraphics::g_BooFactory != nullptr && !CGraphics::g_BooFactory->areShadersReady())
       return EMessageReturn::Exit;
 
     wtMgr->StartTextFadeOut();
@@ -1,5 +1,6 @@
 #include "Runtime/MP1/MP1.hpp"
 
+#include <algorithm>
 #include <array>
 
 #include "NESEmulator/CNESShader.hpp"
@@ -26,10 +27,16 @@
 #include "Runtime/Graphics/Shaders/CWorldShadowShader.hpp"
 #include "Runtime/Graphics/Shaders/CXRayBlurFilter.hpp"
 
+#include "Runtime/CBlobCache.hpp"
 #include "Runtime/CDependencyGroup.hpp"
+#include "Runtime/CFrameBenchmark.hpp"
 #include "Runtime/CGameHintInfo.hpp"
+#include "Runtime/CMemoryTags.hpp"
+#include "Runtime/CProfiler.hpp"
+#include "Runtime/CResLoadStats.hpp"
 #include "Runtime/CWorldSaveGameInfo.hpp"
 #include "Runtime/CScannableObjectInfo.hpp"
+#include "Runtime/CScriptMsgStats.hpp"
 #include "Runtime/CStateManager.hpp"
 #include "Runtime/CStopwatch.hpp"
 #include "Runtime/CTextureCache.hpp"
@@ -44,6 +51,7 @@
 #include "Runtime/Character/CAnimCharacterSet.hpp"
 #include "Runtime/Character/CAnimPOIData.hpp"
 #include "Runtime/Character/CCharLayoutInfo.hpp"
+#include "Runtime/Character/CSegStatementCache.hpp"
 #include "Runtime/Character/CSkinRules.hpp"
 #include "Runtime/Collision/CCollidableOBBTreeGroup.hpp"
 #include "Runtime/Collision/CCollisionResponseData.hpp"
@@ -52,6 +60,7 @@
 #include "Runtime/GuiSys/CGuiFrame.hpp"
 #include "Runtime/GuiSys/CRasterFont.hpp"
 #include "Runtime/GuiSys/CStringTable.hpp"
+#include "Runtime/Input/CInputRecorder.hpp"
 #include "Runtime/MP1/CGBASupport.hpp"
 #include "Runtime/Particle/CDecalDataFactory.hpp"
 #include "Runtime/Particle/CParticleDataFactory.hpp"
@@ -59,6 +68,8 @@
 #include "Runtime/Particle/CParticleSwooshDataFactory.hpp"
 #include "Runtime/Particle/CProjectileWeaponDataFactory.hpp"
 #include "Runtime/Particle/CWeaponDescription.hpp"
+#include "Runtime/World/CBoidGrid.hpp"
+#include "Runtime/World/CFluidPlaneCPU.hpp"
 #include "Runtime/World/CPatterned.hpp"
 #include "Runtime/World/CPlayer.hpp"
 #include "Runtime/World/CStateMachine.hpp"
@@ -247,6 +258,10 @@ CMain::CMain(IFactory* resFactory, CSimplePool* resStore, boo::IGraphicsDataFact
 
 CMain::BooSetter::BooSetter(boo::IGraphicsDataFactory* factory, boo::IGraphicsCommandQueue* cmdQ,
                             const boo::ObjToken<boo::ITextureR>& spareTex) {
+  // Headless runs have no device; resource commits become no-ops and g_Renderer is a CNullRenderer
+  if (factory == nullptr) {
+    return;
+  }
   CGraphics::InitializeBoo(factory, cmdQ, spareTex);
   CParticleSwooshShaders::Initialize();
   CThermalColdFilter::Initialize();
@@ -410,13 +425,17 @@ void CMain::ResetGameState() {
 void CMain::InitializeSubsystems() {
   CBasics::Initialize();
   CModelShaders::Initialize();
-  CLineRenderer::Initialize();
+  if (CGraphics::g_BooFactory != nullptr) {
+    CLineRenderer::Initialize();
+  }
   CElementGen::Initialize();
   CAnimData::InitializeCache();
   CDecalManager::Initialize();
   CGBASupport::Initialize();
   CPatterned::Initialize();
-  CGraphics::g_BooFactory->waitUntilShadersReady();
+  if (CGraphics::g_BooFactory != nullptr) {
+    CGraphics::g_BooFactory->waitUntilShadersReady();
+  }
 }
 
 void CMain::MemoryCardInitializePump() {
@@ -771,6 +790,90 @@ void CMain::Init(const hecl::Runtime::FileStoreManager& storeMgr, hecl::CVarMana
       "Warp"sv, "Warps to a given area and world"sv, "[worldname] areaId"sv,
       [this](hecl::Console* console, const std::vector<std::string>& args) { Warp(console, args); },
       hecl::SConsoleCommand::ECommandFlags::Normal);
+  m_console->registerCommand(
+      "ProfilerCapture"sv, "Records profiler zones for a number of frames and writes them as a Chrome trace"sv,
+      "frames [path]"sv,
+      [](hecl::Console* console, const std::vector<std::string>& args) {
+        if (args.empty()) {
+          console->report(hecl::Console::Level::Info, FMT_STRING("Usage: ProfilerCapture frames [path]"));
+          return;
+        }
+        CProfiler::StartCapture(hecl::StrToUl(args[0].c_str(), nullptr, 0), args.size() > 1 ? args[1] : "");
+      },
+      hecl::SConsoleCommand::ECommandFlags::Developer);
+  m_console->registerCommand(
+      "ResourceStats"sv, "Prints per-type resource load times and sizes, writes them as CSV or clears them"sv,
+      "[csv path|reset]"sv,
+      [](hecl::Console* console, const std::vector<std::string>& args) {
+        if (args.size() >= 2 && args[0] == "csv") {
+          CResLoadStats::WriteCsv(args[1]);
+        } else if (!args.empty() && args[0] == "reset") {
+          CResLoadStats::Reset();
+        } else {
+          console->report(hecl::Console::Level::Info, FMT_STRING("{}"), CResLoadStats::Summarize());
+        }
+      },
+      hecl::SConsoleCommand::ECommandFlags::Developer);
+  m_console->registerCommand(
+      "ResourceCache"sv, "Prints residency cache usage and hit rate, sets its budget in MiB or clears its stats"sv,
+      "[budget MiB|reset]"sv,
+      [](hecl::Console* console, const std::vector<std::string>& args) {
+        if (args.size() >= 2 && args[0] == "budget") {
+          g_SimplePool->SetResidencyBudget(size_t(hecl::StrToUl(args[1].c_str(), nullptr, 0)) * 1024 * 1024);
+        } else if (!args.empty() && args[0] == "reset") {
+          g_SimplePool->ResetResidencyStats();
+        } else {
+          const CSimplePool::SResidencyStats& stats = g_SimplePool->GetResidencyStats();
+          console->report(hecl::Console::Level::Info,
+                          FMT_STRING("{} objects, {:.1f}/{:.1f} MiB resident; {} hits, {} misses, {} evictions"),
+                          g_SimplePool->GetResidentObjects(), double(g_SimplePool->GetResidentBytes()) / 1048576.0,
+                          double(g_SimplePool->GetResidencyBudget()) / 1048576.0, stats.m_hits, stats.m_misses,
+                          stats.m_evictions);
+        }
+      },
+      hecl::SConsoleCommand::ECommandFlags::Developer);
+  m_console->registerCommand(
+      "BlobCache"sv, "Prints blob cache hit rate and the time spent building cached and uncached objects"sv, ""sv,
+      [](hecl::Console* console, const std::vector<std::string>&) {
+        console->report(hecl::Console::Level::Info, FMT_STRING("{}"), CBlobCache::Summarize());
+      },
+      hecl::SConsoleCommand::ECommandFlags::Developer);
+  m_console->registerCommand(
+      "MemoryTags"sv, "Prints live and peak memory per subsystem tag and area, or sets the periodic log interval"sv,
+      "[log frames|reset]"sv,
+      [](hecl::Console* console, const std::vector<std::string>& args) {
+        if (args.size() >= 2 && args[0] == "log") {
+          CMemoryTags::SetLogInterval(hecl::StrToUl(args[1].c_str(), nullptr, 0));
+        } else if (!args.empty() && args[0] == "reset") {
+          CMemoryTags::ResetPeaks();
+        } else {
+          console->report(hecl::Console::Level::Info, FMT_STRING("{}"), CMemoryTags::Summarize());
+        }
+      },
+      hecl::SConsoleCommand::ECommandFlags::Developer);
+  m_console->registerCommand(
+      "StreamAudio"sv, "Prints streamed music callback durations, underruns and decode time, or clears them"sv,
+      "[reset]"sv,
+      [](hecl::Console* console, const std::vector<std::string>& args) {
+        if (!args.empty() && args[0] == "reset") {
+          CStreamAudioManager::ResetStats();
+        } else {
+          console->report(hecl::Console::Level::Info, FMT_STRING("{}"), CStreamAudioManager::Summarize());
+        }
+      },
+      hecl::SConsoleCommand::ECommandFlags::Developer);
+  m_console->registerCommand(
+      "SfxStats"sv, "Prints sound effects submitted, culled and played and voice commands batched, or clears them"sv,
+      "[reset]"sv,
+      [](hecl::Console* console, const std::vector<std::string>& args) {
+        if (!args.empty() && args[0] == "reset") {
+          CSfxManager::ResetStats();
+        } else {
+          console->report(hecl::Console::Level::Info, FMT_STRING("{}"), CSfxManager::Summarize());
+        }
+      },
+      hecl::SConsoleCommand::ECommandFlags::Developer);
+  CProfiler::SetThreadName("Main");
 
   bool loadedVersion = false;
   if (CDvdFile::FileExists("version.yaml")) {
@@ -805,7 +908,7 @@ void CMain::Init(const hecl::Runtime::FileStoreManager& storeMgr, hecl::CVarMana
     MainLog.report(logvisor::Level::Fatal, FMT_STRING("Unable to load version info"));
   }
 
-  const auto& args = boo::APP->getArgs();
+  const auto& args = boo::APP != nullptr ? boo::APP->getArgs() : m_headlessArgs;
   for (auto it = args.begin(); it != args.end(); ++it) {
     if (*it == "--warp" && args.end() - it >= 3) {
       const char* worldIdxStr = (*(it + 1)).c_str();
@@ -852,11 +955,51 @@ void CMain::Init(const hecl::Runtime::FileStoreManager& storeMgr, hecl::CVarMana
     }
   }
 
+  for (auto it = args.begin(); it != args.end(); ++it) {
+    if (*it == "--benchmark-frames" && args.end() - it >= 2) {
+      const u32 frameCount = hecl::StrToUl((*(it + 1)).c_str(), nullptr, 0);
+      std::string_view outPath;
+      const auto outIt = std::find(args.begin(), args.end(), "--benchmark-out");
+      if (args.end() - outIt >= 2) {
+        outPath = *(outIt + 1);
+      }
+      if (frameCount != 0) {
+        CFrameBenchmark::Start(frameCount, outPath);
+      }
+    } else if (*it == "--profile-frames" && args.end() - it >= 2) {
+      std::string_view outPath;
+      const auto outIt = std::find(args.begin(), args.end(), "--profile-out");
+      if (args.end() - outIt >= 2) {
+        outPath = *(outIt + 1);
+      }
+      CProfiler::StartCapture(hecl::StrToUl((*(it + 1)).c_str(), nullptr, 0), outPath);
+    } else if (*it == "--blob-cache") {
+      CBlobCache::Enable(fmt::format(FMT_STRING("{}/blobcache"), storeMgr.getStoreRoot()));
+    } else if (*it == "--resource-budget" && args.end() - it >= 2) {
+      g_SimplePool->SetResidencyBudget(size_t(hecl::StrToUl((*(it + 1)).c_str(), nullptr, 0)) * 1024 * 1024);
+    } else if (*it == "--memory-log-frames" && args.end() - it >= 2) {
+      CMemoryTags::SetLogInterval(hecl::StrToUl((*(it + 1)).c_str(), nullptr, 0));
+    } else if (*it == "--benchmark-object-lists" && args.end() - it >= 2) {
+      CFrameBenchmark::RunObjectListBenchmark(hecl::StrToUl((*(it + 1)).c_str(), nullptr, 0));
+    } else if (*it == "--benchmark-movie" && args.end() - it >= 2) {
+      CMoviePlayer::RunDecodeBenchmark(*(it + 1));
+    } else if (*it == "--benchmark-fluid" && args.end() - it >= 2) {
+      CFluidPlaneCPU::RunTessellationBenchmark(hecl::StrToUl((*(it + 1)).c_str(), nullptr, 0));
+    } else if (*it == "--benchmark-boids" && args.end() - it >= 2) {
+      CBoidGrid::RunNeighborBenchmark(hecl::StrToUl((*(it + 1)).c_str(), nullptr, 0));
+    } else if (*it == "--record-input" && args.end() - it >= 2) {
+      CInputRecorder::StartRecording(*(it + 1));
+    } else if (*it == "--replay-input" && args.end() - it >= 2) {
+      CInputRecorder::StartReplay(*(it + 1));
+    }
+  }
+
   FillInAssetIDs();
   x164_archSupport = std::make_unique<CGameArchitectureSupport>(*this, voiceEngine, backend);
   g_archSupport = x164_archSupport.get();
   x164_archSupport->PreloadAudio();
-  std::srand(static_cast<u32>(std::time(nullptr)));
+  // Recorded sessions need the HUD's libc random calls to repeat as well
+  std::srand(CInputRecorder::IsActive() ? 0 : static_cast<u32>(std::time(nullptr)));
   // g_TweakManager->ReadFromMemoryCard("AudioTweaks");
 }
 
@@ -897,6 +1040,10 @@ void CMain::WarmupShaders() {
 
 bool CMain::Proc(float dt) {
   CRandom16::ResetNumNextCalls();
+  CSegStatementCache::NewFrame();
+  CScriptMsgStats::NewFrame();
+  CProfiler::NewFrame();
+  CMemoryTags::NewFrame();
   // Warmup cycle overrides update
   if (m_warmupTags.size())
     return false;
@@ -923,6 +1070,10 @@ bool CMain::Proc(float dt) {
     x160_24_finished = true;
   }
 
+  if (CFrameBenchmark::IsFinished()) {
+    x160_24_finished = true;
+  }
+
   Discord_RunCallbacks();
 
   return x160_24_finished;
@@ -974,9 +1125,11 @@ void CMain::ShutdownSubsystems() {
 }
 
 void CMain::Shutdown() {
+  CInputRecorder::Stop();
   m_console->unregisterCommand("Give");
   x128_globalObjects->m_gameResFactory->UnloadPersistentResources();
   x164_archSupport.reset();
+  g_SimplePool->SetResidencyBudget(0);
   ShutdownSubsystems();
   CParticleSwooshShaders::Shutdown();
   CThermalColdFilter::Shutdown();
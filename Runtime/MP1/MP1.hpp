@@ -22,6 +22,7 @@
 #include "Runtime/Particle/CDecalManager.hpp"
 #include "Runtime/Particle/CGenDescription.hpp"
 #include "Runtime/Graphics/CBooRenderer.hpp"
+#include "Runtime/Graphics/CNullRenderer.hpp"
 #include "Runtime/Audio/CAudioSys.hpp"
 #include "Runtime/Input/CInputGenerator.hpp"
 #include "Runtime/GuiSys/CGuiSys.hpp"
@@ -76,7 +77,11 @@ class CGameGlobalObjects {
   }
   void AddPaksAndFactories();
   static IRenderer* AllocateRenderer(IObjectStore& store, IFactory& resFactory) {
-    g_Renderer = new CBooRenderer(store, resFactory);
+    if (CGraphics::g_BooFactory == nullptr) {
+      g_Renderer = new CNullRenderer(store, resFactory);
+    } else {
+      g_Renderer = new CBooRenderer(store, resFactory);
+    }
     return g_Renderer;
   }
 
@@ -245,6 +250,7 @@ private:
   std::unique_ptr<CGameArchitectureSupport> x164_archSupport;
 
   boo::IWindow* m_mainWindow = nullptr;
+  std::vector<std::string> m_headlessArgs;
   hecl::CVarManager* m_cvarMgr = nullptr;
   std::unique_ptr<hecl::CVarCommons> m_cvarCommons;
   std::unique_ptr<hecl::Console> m_console;
@@ -274,6 +280,8 @@ public:
   void StreamNewGameState(CBitStreamReader&, u32 idx);
   void RefreshGameState();
   void CheckTweakManagerDebugOptions() {}
+  /* Command line read by Init when there is no boo application (metaforce-benchmark) */
+  void SetHeadlessArgs(std::vector<std::string> args) { m_headlessArgs = std::move(args); }
   void SetMFGameBuilt(bool b) { x160_25_mfGameBuilt = b; }
   void SetScreenFading(bool b) { x160_26_screenFading = b; }
   bool GetScreenFading() const { return x160_26_screenFading; }
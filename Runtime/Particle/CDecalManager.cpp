@@ -32,7 +32,9 @@ void CDecalManager::Initialize() {
   m_LastDecalCreatedAssetId = -1;
 
   /* Compile shaders */
-  CDecalShaders::Initialize();
+  if (CGraphics::g_BooFactory != nullptr) {
+    CDecalShaders::Initialize();
+  }
 }
 
 void CDecalManager::Reinitialize() {
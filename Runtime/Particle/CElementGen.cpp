@@ -1,5 +1,8 @@
 #include "Runtime/Particle/CElementGen.hpp"
 
+#include "Runtime/CFrameBenchmark.hpp"
+#include "Runtime/CMemoryTags.hpp"
+#include "Runtime/CProfiler.hpp"
 #include "Runtime/GameGlobalObjects.hpp"
 #include "Runtime/Character/CActorLights.hpp"
 #include "Runtime/Graphics/CBooRenderer.hpp"
@@ -48,7 +51,9 @@ void CElementGen::Initialize() {
   g_ParticleSystemInitialized = true;
 
   /* Compile shaders */
-  CElementGenShaders::Initialize();
+  if (CGraphics::g_BooFactory != nullptr) {
+    CElementGenShaders::Initialize();
+  }
 }
 
 void CElementGen::Shutdown() { CElementGenShaders::Shutdown(); }
@@ -166,6 +171,7 @@ CElementGen::CElementGen(TToken<CGenDescription> gen, EModelOrientationType orie
   }
   if (x2c_orientType == EModelOrientationType::One)
     x50_parentMatrices.resize(x90_MAXP);
+  UpdateTrackedBytes();
 
   x26c_31_LINE = desc->x44_24_x30_24_LINE;
   x26d_24_FXLL = desc->x44_25_x30_25_FXLL;
@@ -229,9 +235,23 @@ CElementGen::CElementGen(TToken<CGenDescription> gen, EModelOrientationType orie
 CElementGen::~CElementGen() {
   --g_ParticleSystemAliveCount;
   g_ParticleAliveCount -= x30_particles.size();
+  CMemoryTags::Sub(EMemoryTag::Particles, s64(m_trackedBytes));
+}
+
+void CElementGen::UpdateTrackedBytes() {
+  const size_t bytes = x30_particles.capacity() * sizeof(CParticle) +
+                       x50_parentMatrices.capacity() * sizeof(zeus::CMatrix3f) +
+                       x60_advValues.capacity() * sizeof(std::array<float, 8>);
+  if (bytes != m_trackedBytes) {
+    CMemoryTags::Add(EMemoryTag::Particles, s64(bytes) - s64(m_trackedBytes));
+    m_trackedBytes = bytes;
+  }
 }
 
 bool CElementGen::Update(double t) {
+  CProfiler::CZone zone("CElementGen::Update");
+  CFrameBenchmark::CPhaseTimer phaseTimer(CFrameBenchmark::EPhase::Particles);
+  CMemoryTags::CScope memoryScope(EMemoryTag::Particles);
   s32 oldMax = x90_MAXP;
   s32 oldMBSP = x270_MBSP;
   CParticleGlobals::SParticleSystem* prevSystem = CParticleGlobals::instance()->m_currentParticleSystem;
@@ -521,6 +541,7 @@ void CElementGen::CreateNewParticles(int count) {
   if (x26d_28_enableADV && x60_advValues.size() < count + x30_particles.size()) {
     x60_advValues.resize(std::min(int(x60_advValues.size() * 2), x90_MAXP));
   }
+  UpdateTrackedBytes();
 
   CParticleGlobals::instance()->m_particleAccessParameters = nullptr;
 
@@ -56,6 +56,7 @@ private:
   std::vector<u32> x40;
   std::vector<zeus::CMatrix3f> x50_parentMatrices;
   std::vector<std::array<float, 8>> x60_advValues;
+  size_t m_trackedBytes = 0;
 
   int x70_internalStartFrame = 0;
   int x74_curFrame = 0;
@@ -168,6 +169,8 @@ public:
   bool UpdateVelocitySource(size_t idx, s32 particleFrame, CParticle& particle);
   void UpdateExistingParticles();
   void CreateNewParticles(int count);
+  /* Charges particle buffer growth to EMemoryTag::Particles */
+  void UpdateTrackedBytes();
   void UpdatePSTranslationAndOrientation();
   void UpdateChildParticleSystems(double dt);
   std::unique_ptr<CParticleGen> ConstructChildParticleSystem(const TToken<CGenDescription>& desc) const;
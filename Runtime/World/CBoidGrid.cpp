@@ -0,0 +1,334 @@
+#include "Runtime/World/CBoidGrid.hpp"
+
+#if __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+
+#include <hecl/ParallelFor.hpp>
+
+#include "Runtime/CRandom16.hpp"
+#include "Runtime/World/CBoidNeighborhood.hpp"
+
+#include <logvisor/logvisor.hpp>
+
+namespace metaforce {
+static logvisor::Module Log("metaforce::CBoidGrid");
+
+namespace {
+/* Visits the cells within radius of pos (at least one pitch each way) in x, y, z loop order, stopping when
+ * func returns false. The float stepping is the original CFishCloud partition walk, kept as-is so the same
+ * cells are visited. */
+template <typename CellFunc>
+void ForEachNearbyCell(const zeus::CAABox& aabb, const zeus::CVector3f& pitch, const zeus::CVector3f& ooPitch,
+                       int dim, const zeus::CVector3f& pos, float radius, CellFunc&& func) {
+  const float x = std::max(radius * ooPitch.x(), float(pitch.x()));
+  const float y = std::max(radius * ooPitch.y(), float(pitch.y()));
+  const float z = std::max(radius * ooPitch.z(), float(pitch.z()));
+  const float nx = 0.01f - x;
+  const float ny = 0.01f - y;
+  const float nz = 0.01f - z;
+  const int cellCount = dim * dim * dim;
+
+  for (float lnx = nx; lnx < x; lnx += pitch.x()) {
+    const float cx = lnx + pos.x();
+    if (cx < aabb.min.x()) {
+      continue;
+    }
+    if (cx >= aabb.max.x()) {
+      break;
+    }
+    for (float lny = ny; lny < y; lny += pitch.y()) {
+      const float cy = lny + pos.y();
+      if (cy < aabb.min.y()) {
+        continue;
+      }
+      if (cy >= aabb.max.y()) {
+        break;
+      }
+      for (float lnz = nz; lnz < z; lnz += pitch.z()) {
+        const float cz = lnz + pos.z();
+        if (cz < aabb.min.z()) {
+          continue;
+        }
+        if (cz >= aabb.max.z()) {
+          break;
+        }
+        const zeus::CVector3f ints = (zeus::CVector3f(cx, cy, cz) - aabb.min) * ooPitch;
+        const int idx = int(ints.x()) + int(ints.y()) * dim + int(ints.z()) * dim * dim;
+        if (idx >= 0 && idx < cellCount && !func(idx)) {
+          return;
+        }
+      }
+    }
+  }
+}
+} // anonymous namespace
+
+void CBoidGrid::Reset(const zeus::CAABox& box, const zeus::CVector3f& pitch, const zeus::CVector3f& ooPitch, int dim,
+                      size_t boidCount) {
+  m_box = box;
+  m_pitch = pitch;
+  m_ooPitch = ooPitch;
+  m_dim = dim;
+  m_boidCells.assign(boidCount, -1);
+  m_boidPositions.resize(boidCount);
+}
+
+void CBoidGrid::Insert(u32 index, const zeus::CVector3f& pos) {
+  const int idx = GetCellIndex(pos);
+  if (idx < 0 || idx >= GetCellCount()) {
+    return;
+  }
+  m_boidCells[index] = idx;
+  m_boidPositions[index] = pos;
+}
+
+void CBoidGrid::Finish() {
+  const int cellCount = GetCellCount();
+  m_cellStart.assign(size_t(cellCount) + 1, 0);
+  for (const int cell : m_boidCells) {
+    if (cell >= 0) {
+      ++m_cellStart[cell + 1];
+    }
+  }
+  for (int i = 0; i < cellCount; ++i) {
+    m_cellStart[i + 1] += m_cellStart[i];
+  }
+
+  const u32 total = m_cellStart[cellCount];
+  m_indices.resize(total);
+  m_x.resize(total);
+  m_y.resize(total);
+  m_z.resize(total);
+  m_cellFill.assign(m_cellStart.begin(), m_cellStart.end() - 1);
+  for (size_t i = m_boidCells.size(); i-- > 0;) {
+    const int cell = m_boidCells[i];
+    if (cell < 0) {
+      continue;
+    }
+    const u32 slot = m_cellFill[cell]++;
+    m_indices[slot] = u32(i);
+    m_x[slot] = m_boidPositions[i].x();
+    m_y[slot] = m_boidPositions[i].y();
+    m_z[slot] = m_boidPositions[i].z();
+  }
+}
+
+u32 CBoidGrid::GatherFromCell(int cell, const zeus::CVector3f& pos, float radiusSq, SNeighbor* out, u32 count,
+                              u32 capacity) const {
+  u32 i = m_cellStart[cell];
+  const u32 end = m_cellStart[cell + 1];
+  /* Distances are (dx*dx + dy*dy) + dz*dz with no fused multiply-adds, the same sum CVector3f::magSquared forms */
+#if __SSE2__
+  const __m128 px = _mm_set1_ps(pos.x());
+  const __m128 py = _mm_set1_ps(pos.y());
+  const __m128 pz = _mm_set1_ps(pos.z());
+  const __m128 rSq = _mm_set1_ps(radiusSq);
+  const __m128 zero = _mm_setzero_ps();
+  for (; i < end; i += 4) {
+    const u32 lanes = std::min(end - i, 4u);
+    __m128 xs, ys, zs;
+    if (lanes == 4) {
+      xs = _mm_loadu_ps(&m_x[i]);
+      ys = _mm_loadu_ps(&m_y[i]);
+      zs = _mm_loadu_ps(&m_z[i]);
+    } else {
+      alignas(16) float tx[4] = {};
+      alignas(16) float ty[4] = {};
+      alignas(16) float tz[4] = {};
+      std::copy_n(&m_x[i], lanes, tx);
+      std::copy_n(&m_y[i], lanes, ty);
+      std::copy_n(&m_z[i], lanes, tz);
+      xs = _mm_load_ps(tx);
+      ys = _mm_load_ps(ty);
+      zs = _mm_load_ps(tz);
+    }
+    const __m128 dx = _mm_sub_ps(xs, px);
+    const __m128 dy = _mm_sub_ps(ys, py);
+    const __m128 dz = _mm_sub_ps(zs, pz);
+    const __m128 distSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+    const int mask = _mm_movemask_ps(_mm_and_ps(_mm_cmpneq_ps(distSq, zero), _mm_cmplt_ps(distSq, rSq))) &
+                     ((1 << lanes) - 1);
+    if (mask == 0) {
+      continue;
+    }
+    alignas(16) float dists[4];
+    _mm_store_ps(dists, distSq);
+    for (u32 lane = 0; lane < lanes; ++lane) {
+      if (mask & (1 << lane)) {
+        out[count++] = {m_indices[i + lane], dists[lane]};
+        if (count == capacity) {
+          return count;
+        }
+      }
+    }
+  }
+#else
+  for (; i < end; ++i) {
+    const float dx = m_x[i] - pos.x();
+    const float dy = m_y[i] - pos.y();
+    const float dz = m_z[i] - pos.z();
+    const float distSq = (dx * dx + dy * dy) + dz * dz;
+    if (distSq != 0.f && distSq < radiusSq) {
+      out[count++] = {m_indices[i], distSq};
+      if (count == capacity) {
+        return count;
+      }
+    }
+  }
+#endif
+  return count;
+}
+
+u32 CBoidGrid::GatherOwnCell(const zeus::CVector3f& pos, float radius, SNeighbor* out, u32 capacity) const {
+  const int idx = GetCellIndex(pos);
+  if (idx < 0 || idx >= GetCellCount() || capacity == 0) {
+    return 0;
+  }
+  return GatherFromCell(idx, pos, radius * radius, out, 0, capacity);
+}
+
+u32 CBoidGrid::GatherNearby(const zeus::CVector3f& pos, float radius, SNeighbor* out, u32 capacity) const {
+  const float radiusSq = radius * radius;
+  u32 count = 0;
+  if (capacity == 0) {
+    return 0;
+  }
+  ForEachNearbyCell(m_box, m_pitch, m_ooPitch, m_dim, pos, radius, [&](int idx) {
+    count = GatherFromCell(idx, pos, radiusSq, out, count, capacity);
+    return count < capacity;
+  });
+  return count;
+}
+
+void CBoidGrid::RunNeighborBenchmark(u32 boidCount) {
+  if (boidCount == 0) {
+    return;
+  }
+
+  /* CFishCloud's setup: a 7x7x7 partition and a 25-neighbor cap. 10k boids average ~12 neighbors in this box. */
+  constexpr int dim = 7;
+  constexpr u32 capacity = 25;
+  constexpr u32 frames = 20;
+  constexpr float radius = 3.f;
+  const zeus::CAABox box({-20.f, -20.f, -20.f}, {20.f, 20.f, 20.f});
+  const zeus::CVector3f pitch = (box.max - box.min) / float(dim);
+  const zeus::CVector3f ooPitch = 1.f / pitch;
+
+  struct SListBoid {
+    zeus::CVector3f m_pos;
+    zeus::CVector3f m_vel;
+    SListBoid* m_next = nullptr;
+  };
+  std::vector<SListBoid> boids(boidCount);
+  CRandom16 random(0xB01D);
+  const zeus::CVector3f extent = box.max - box.min;
+  for (SListBoid& b : boids) {
+    const float px = random.Float();
+    const float py = random.Float();
+    const float pz = random.Float();
+    b.m_pos = zeus::CVector3f(px, py, pz) * extent + box.min;
+    const float vx = random.Float();
+    const float vy = random.Float();
+    const float vz = random.Float();
+    b.m_vel = zeus::CVector3f(vx, vy, vz) - zeus::CVector3f(0.5f);
+  }
+
+  /* Reference: prepend-built linked lists walked boid by boid, as CFishCloud did before the grid */
+  std::vector<CBoidNeighborhood> listResults(boidCount, CBoidNeighborhood(capacity));
+  std::vector<SListBoid*> lists(size_t(dim * dim * dim));
+  const auto listStart = std::chrono::steady_clock::now();
+  for (u32 f = 0; f < frames; ++f) {
+    std::fill(lists.begin(), lists.end(), nullptr);
+    for (SListBoid& b : boids) {
+      const zeus::CVector3f idxs = (b.m_pos - box.min) * ooPitch;
+      const int idx = int(idxs.x()) + int(idxs.y()) * dim + int(idxs.z()) * dim * dim;
+      if (idx >= 0 && idx < dim * dim * dim) {
+        b.m_next = lists[idx];
+        lists[idx] = &b;
+      }
+    }
+    for (u32 i = 0; i < boidCount; ++i) {
+      const zeus::CVector3f& pos = boids[i].m_pos;
+      CBoidNeighborhood& neighborhood = listResults[i] = CBoidNeighborhood(capacity);
+      ForEachNearbyCell(box, pitch, ooPitch, dim, pos, radius, [&](int idx) {
+        for (const SListBoid* b = lists[idx]; b != nullptr; b = b->m_next) {
+          const float distSq = (b->m_pos - pos).magSquared();
+          if (distSq != 0.f && distSq < radius * radius) {
+            neighborhood.Add(b->m_pos, distSq, b->m_vel);
+            if (neighborhood.IsFull()) {
+              return false;
+            }
+          }
+        }
+        return true;
+      });
+    }
+  }
+  const double listMs =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - listStart).count() / frames;
+
+  CBoidGrid grid;
+  std::vector<u32> counts(boidCount);
+  std::vector<SNeighbor> neighbors(size_t(boidCount) * capacity);
+  constexpr u32 batchSize = 64;
+  const auto runGrid = [&](bool helpers) {
+    hecl::SetParallelForHelpers(helpers);
+    const auto start = std::chrono::steady_clock::now();
+    for (u32 f = 0; f < frames; ++f) {
+      grid.Reset(box, pitch, ooPitch, dim, boidCount);
+      for (u32 i = 0; i < boidCount; ++i) {
+        grid.Insert(i, boids[i].m_pos);
+      }
+      grid.Finish();
+      hecl::ParallelFor((boidCount + batchSize - 1) / batchSize, [&](size_t batch) {
+        const u32 last = std::min(boidCount, u32(batch + 1) * batchSize);
+        for (u32 i = u32(batch) * batchSize; i < last; ++i) {
+          counts[i] = grid.GatherNearby(boids[i].m_pos, radius, &neighbors[size_t(i) * capacity], capacity);
+        }
+      });
+    }
+    hecl::SetParallelForHelpers(true);
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+  };
+
+  const double serialMs = runGrid(false);
+  const hecl::ParallelForStats before = hecl::GetParallelForStats();
+  const double pooledMs = runGrid(true);
+  const hecl::ParallelForStats after = hecl::GetParallelForStats();
+
+  /* The grid must pick the same neighbors in the same order; rebuild each neighborhood and compare */
+  u32 mismatches = 0;
+  size_t neighborTotal = 0;
+  for (u32 i = 0; i < boidCount; ++i) {
+    CBoidNeighborhood neighborhood(capacity);
+    for (u32 n = 0; n < counts[i]; ++n) {
+      const SNeighbor& neighbor = neighbors[size_t(i) * capacity + n];
+      neighborhood.Add(boids[neighbor.m_index].m_pos, neighbor.m_distSq, boids[neighbor.m_index].m_vel);
+    }
+    const CBoidNeighborhood& ref = listResults[i];
+    neighborTotal += neighborhood.GetCount();
+    if (neighborhood.GetCount() != ref.GetCount() ||
+        (!ref.IsEmpty() && (neighborhood.GetNearestPosition() != ref.GetNearestPosition() ||
+                            neighborhood.GetAveragePosition() != ref.GetAveragePosition() ||
+                            neighborhood.GetAverageHeading() != ref.GetAverageHeading()))) {
+      ++mismatches;
+    }
+  }
+  if (mismatches != 0) {
+    Log.report(logvisor::Error, FMT_STRING("Boid grid disagrees with the partition lists for {} of {} boids"),
+               mismatches, boidCount);
+  }
+
+  Log.report(logvisor::Info,
+             FMT_STRING("Boid neighbors, {} boids ({:.1f} neighbors each): lists {:.3f} ms, grid serial {:.3f} ms "
+                        "({:.2f}x), grid pooled {:.3f} ms ({:.2f}x) per frame, {} of {} batches on helpers"),
+             boidCount, double(neighborTotal) / boidCount, listMs, serialMs, serialMs > 0.0 ? listMs / serialMs : 0.0,
+             pooledMs, pooledMs > 0.0 ? listMs / pooledMs : 0.0, after.helperItems - before.helperItems,
+             after.items - before.items);
+}
+
+} // namespace metaforce
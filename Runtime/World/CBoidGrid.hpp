@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Runtime/GCNTypes.hpp"
+
+#include <zeus/CAABox.hpp>
+#include <zeus/CVector3f.hpp>
+
+namespace metaforce {
+
+/* Uniform partition grid over a flock, rebuilt once per frame into flat per-cell position arrays.
+ * Each cell lists its boids in descending index order, matching the old prepend-built linked lists,
+ * so capped neighbor queries select the same boids in the same order. Queries are const and may
+ * run concurrently once Finish() has been called. */
+class CBoidGrid {
+public:
+  struct SNeighbor {
+    u32 m_index;
+    float m_distSq;
+  };
+
+private:
+  zeus::CAABox m_box;
+  zeus::CVector3f m_pitch;
+  zeus::CVector3f m_ooPitch;
+  int m_dim = 0;
+  std::vector<int> m_boidCells;
+  std::vector<zeus::CVector3f> m_boidPositions;
+  std::vector<u32> m_cellStart;
+  std::vector<u32> m_cellFill;
+  std::vector<u32> m_indices;
+  std::vector<float> m_x;
+  std::vector<float> m_y;
+  std::vector<float> m_z;
+
+  u32 GatherFromCell(int cell, const zeus::CVector3f& pos, float radiusSq, SNeighbor* out, u32 count,
+                     u32 capacity) const;
+
+public:
+  /* Starts a rebuild over boids [0, boidCount); boids not inserted are left out of every cell */
+  void Reset(const zeus::CAABox& box, const zeus::CVector3f& pitch, const zeus::CVector3f& ooPitch, int dim,
+             size_t boidCount);
+  void Insert(u32 index, const zeus::CVector3f& pos);
+  void Finish();
+
+  /* Raw cell index of pos; may be out of range */
+  int GetCellIndex(const zeus::CVector3f& pos) const {
+    const zeus::CVector3f ints = (pos - m_box.min) * m_ooPitch;
+    return int(ints.x()) + int(ints.y()) * m_dim + int(ints.z()) * m_dim * m_dim;
+  }
+  int GetCellCount() const { return m_dim * m_dim * m_dim; }
+
+  /* Neighbors with 0 < distSq < radius^2, up to capacity. GatherOwnCell only scans the cell containing pos,
+   * GatherNearby walks every cell the radius spans (at least one pitch each way). */
+  u32 GatherOwnCell(const zeus::CVector3f& pos, float radius, SNeighbor* out, u32 capacity) const;
+  u32 GatherNearby(const zeus::CVector3f& pos, float radius, SNeighbor* out, u32 capacity) const;
+
+  /* Times neighbor gathering for boidCount boids against the linked-list partition walk it replaces */
+  static void RunNeighborBenchmark(u32 boidCount);
+};
+
+} // namespace metaforce
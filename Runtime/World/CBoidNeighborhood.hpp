@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cfloat>
+
+#include "Runtime/GCNTypes.hpp"
+
+#include <zeus/CVector3f.hpp>
+
+namespace metaforce {
+
+/* Running sums of everything the flocking rules need from a boid's neighbors.
+ * Accumulated in one pass over the neighbors, so separation, cohesion and alignment
+ * share it instead of each rescanning a near list. */
+class CBoidNeighborhood {
+  zeus::CVector3f x0_nearestPos;
+  float xc_nearestDistSq = FLT_MAX;
+  zeus::CVector3f x10_posSum;
+  zeus::CVector3f x1c_headingSum;
+  u32 x28_count = 0;
+  u32 x2c_capacity;
+
+public:
+  explicit CBoidNeighborhood(u32 capacity) : x2c_capacity(capacity) {}
+
+  void Add(const zeus::CVector3f& pos, float distSq, const zeus::CVector3f& heading) {
+    if (distSq < xc_nearestDistSq) {
+      xc_nearestDistSq = distSq;
+      x0_nearestPos = pos;
+    }
+    x10_posSum += pos;
+    x1c_headingSum += heading;
+    ++x28_count;
+  }
+
+  bool IsFull() const { return x28_count >= x2c_capacity; }
+  bool IsEmpty() const { return x28_count == 0; }
+  u32 GetCount() const { return x28_count; }
+  const zeus::CVector3f& GetNearestPosition() const { return x0_nearestPos; }
+  zeus::CVector3f GetAveragePosition() const { return x10_posSum / float(x28_count); }
+  zeus::CVector3f GetAverageHeading() const { return x1c_headingSum / float(x28_count); }
+};
+
+} // namespace metaforce
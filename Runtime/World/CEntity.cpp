@@ -1,5 +1,7 @@
 #include "Runtime/World/CEntity.hpp"
 
+#include <algorithm>
+
 #include "Runtime/CStateManager.hpp"
 
 namespace metaforce {
@@ -43,9 +45,79 @@ void CEntity::AcceptScriptMsg(EScriptObjectMessage msg, TUniqueId objId, CStateM
 }
 
 void CEntity::SendScriptMsgs(EScriptObjectState state, CStateManager& stateMgr, EScriptObjectMessage skipMsg) {
-  for (const SConnection& conn : x20_conns) {
+  for (size_t i = 0; i < x20_conns.size(); ++i) {
+    const SConnection& conn = x20_conns[i];
     if (conn.x0_state == state && conn.x4_msg != skipMsg) {
-      stateMgr.SendScriptMsg(x8_uid, conn.x8_objId, conn.x4_msg, state);
+      SendConnectionMsg(i, stateMgr);
+    }
+  }
+}
+
+CEntity::SResolvedConnection& CEntity::ResolveConnectionTargets(size_t connIdx, const CStateManager& stateMgr) {
+  // Connection lists can be edited after construction; drop everything if the shape changed
+  if (m_resolvedConns.size() != x20_conns.size()) {
+    m_resolvedConns.assign(x20_conns.size(), {});
+    m_resolvedConnTargets.clear();
+  }
+
+  const TEditorId objId = x20_conns[connIdx].x8_objId;
+  SResolvedConnection& resolved = m_resolvedConns[connIdx];
+  const u32 stamp = stateMgr.GetScriptIdMap().GetKeyStamp(objId);
+  if (resolved.m_objId == objId && resolved.m_stamp == stamp) {
+    return resolved;
+  }
+
+  rstl::reserved_vector<TUniqueId, kMaxResolvedTargets + 1> targets;
+  const auto search = stateMgr.GetIdListForScript(objId);
+  for (auto it = search.first; it != search.second && targets.size() <= kMaxResolvedTargets; ++it) {
+    targets.push_back(it->second);
+  }
+
+  // Reuse this connection's range when the new targets fit, otherwise append a fresh one
+  const auto count = u16(targets.size());
+  if (resolved.m_objId != objId || count > resolved.m_capacity) {
+    resolved.m_begin = u16(m_resolvedConnTargets.size());
+    resolved.m_capacity = count;
+    m_resolvedConnTargets.resize(m_resolvedConnTargets.size() + count);
+  }
+  std::copy(targets.begin(), targets.end(), m_resolvedConnTargets.begin() + resolved.m_begin);
+  resolved.m_objId = objId;
+  resolved.m_stamp = stamp;
+  resolved.m_count = count;
+  return resolved;
+}
+
+void CEntity::SendConnectionMsg(size_t connIdx, CStateManager& stateMgr) {
+  const SConnection& conn = x20_conns[connIdx];
+  const SResolvedConnection& resolved = ResolveConnectionTargets(connIdx, stateMgr);
+  if (resolved.m_count > kMaxResolvedTargets) {
+    stateMgr.SendScriptMsg(x8_uid, conn.x8_objId, conn.x4_msg, conn.x0_state);
+    return;
+  }
+
+  // Receivers may send messages of their own that re-resolve this entity, so work from a copy
+  rstl::reserved_vector<TUniqueId, kMaxResolvedTargets> targets;
+  for (u16 i = 0; i < resolved.m_count; ++i) {
+    targets.push_back(m_resolvedConnTargets[resolved.m_begin + i]);
+  }
+  const CScriptIdMap& idMap = stateMgr.GetScriptIdMap();
+  const u32 stamp = resolved.m_stamp;
+  for (const TUniqueId target : targets) {
+    // Targets are indexed by uid slot; never follow a slot that now holds a different object
+    CEntity* dest = stateMgr.ObjectById(target);
+    if (dest != nullptr && dest->GetUniqueId() != target) {
+      dest = nullptr;
+    }
+    stateMgr.SendScriptMsg(dest, x8_uid, conn.x4_msg);
+    if (idMap.GetKeyStamp(conn.x8_objId) != stamp) {
+      // This editor ID gained or lost targets; continue from the target's live position as a map iterator would
+      auto it = idMap.Locate(target);
+      if (it != idMap.end()) {
+        for (++it; it != idMap.end(); ++it) {
+          stateMgr.SendScriptMsg(stateMgr.ObjectById(it->second), x8_uid, conn.x4_msg);
+        }
+      }
+      return;
     }
   }
 }
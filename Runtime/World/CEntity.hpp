@@ -47,6 +47,23 @@ protected:
   bool m_debugHovered = false;
   const std::set<SConnection>* m_incomingConnections = nullptr;
 
+private:
+  /* Targets of x20_conns[i] resolved against the script ID map, valid while the stamp of the
+   * connection's editor ID matches */
+  struct SResolvedConnection {
+    TEditorId m_objId = kInvalidEditorId;
+    u32 m_stamp = UINT32_MAX;
+    u16 m_begin = 0;
+    u16 m_count = 0;
+    u16 m_capacity = 0;
+  };
+  static constexpr size_t kMaxResolvedTargets = 32;
+  std::vector<SResolvedConnection> m_resolvedConns;
+  std::vector<TUniqueId> m_resolvedConnTargets;
+
+  SResolvedConnection& ResolveConnectionTargets(size_t connIdx, const CStateManager& stateMgr);
+  void SendConnectionMsg(size_t connIdx, CStateManager& stateMgr);
+
 public:
   static const std::vector<SConnection> NullConnectionList;
   virtual ~CEntity() = default;
@@ -1,5 +1,7 @@
 #include "Runtime/World/CFishCloud.hpp"
 
+#include <hecl/ParallelFor.hpp>
+
 #include "Runtime/CSimplePool.hpp"
 #include "Runtime/CStateManager.hpp"
 #include "Runtime/GameGlobalObjects.hpp"
@@ -91,17 +93,16 @@ void CFishCloud::UpdateParticles(float dt) {
 }
 
 void CFishCloud::UpdatePartitionList() {
-  xf8_boidPartitionLists.clear();
-  xf8_boidPartitionLists.resize(xf8_boidPartitionLists.capacity());
-  const auto aabb = GetBoundingBox();
-  for (auto& b : xe8_boids) {
-    const zeus::CVector3f idxs = (b.x0_pos - aabb.min) * x244_ooPartitionPitch;
-    const int idx = int(idxs.x()) + int(idxs.y()) * 7 + int(idxs.z()) * 49;
-    if (idx >= 0 && idx < 343) {
-      b.x1c_next = xf8_boidPartitionLists[idx];
-      xf8_boidPartitionLists[idx] = &b;
+  m_boidGrid.Reset(GetBoundingBox(), x238_partitionPitch, x244_ooPartitionPitch, 7, xe8_boids.size());
+  u32 idx = 0;
+  for (const auto& b : xe8_boids) {
+    /* Inactive boids never pass a neighbor query, so they stay out of the grid */
+    if (b.x20_active) {
+      m_boidGrid.Insert(idx, b.x0_pos);
     }
+    ++idx;
   }
+  m_boidGrid.Finish();
 }
 
 bool CFishCloud::PointInBox(const zeus::CAABox& aabb, const zeus::CVector3f& point) const {
@@ -145,91 +146,35 @@ zeus::CPlane CFishCloud::FindClosestPlane(const zeus::CAABox& aabb, const zeus::
   }
 }
 
-CFishCloud::CBoid* CFishCloud::GetListAt(const zeus::CVector3f& pos) {
-  const zeus::CAABox aabb = GetBoundingBox();
-  const zeus::CVector3f ints = (pos - aabb.min) * x244_ooPartitionPitch;
-  const int idx = int(ints.x()) + int(ints.y()) * 7 + int(ints.z()) * 49;
-
-  if (idx < 0 || idx >= 343) {
-    return nullptr;
-  }
-
-  return xf8_boidPartitionLists[idx];
-}
-
-void CFishCloud::BuildBoidNearList(const zeus::CVector3f& pos, float radius,
-                                   rstl::reserved_vector<CBoid*, 25>& nearList) {
-  const float radiusSq = radius * radius;
-  CBoid* b = GetListAt(pos);
-
-  while (b != nullptr && nearList.size() < 25) {
-    if (b->x20_active) {
-      const float distSq = (b->GetTranslation() - pos).magSquared();
-      if (distSq != 0.f && distSq < radiusSq) {
-        nearList.push_back(b);
-      }
-    }
-    b = b->x1c_next;
-  }
-}
-
-void CFishCloud::BuildBoidNearPartitionList(const zeus::CVector3f& pos, float radius,
-                                            rstl::reserved_vector<CBoid*, 25>& nearList) {
-  const float radiusSq = radius * radius;
-  const zeus::CAABox aabb = GetBoundingBox();
-  const float x = std::max(radius * x244_ooPartitionPitch.x(), float(x238_partitionPitch.x()));
-  const float y = std::max(radius * x244_ooPartitionPitch.y(), float(x238_partitionPitch.y()));
-  const float z = std::max(radius * x244_ooPartitionPitch.z(), float(x238_partitionPitch.z()));
-  const float nx = 0.01f - x;
-  const float ny = 0.01f - y;
-  const float nz = 0.01f - z;
-
-  for (float lnx = nx; lnx < x; lnx += x238_partitionPitch.x()) {
-    const float cx = lnx + pos.x();
-    if (cx < aabb.min.x()) {
-      continue;
-    }
-    if (cx >= aabb.max.x()) {
-      break;
-    }
-    for (float lny = ny; lny < y; lny += x238_partitionPitch.y()) {
-      const float cy = lny + pos.y();
-      if (cy < aabb.min.y()) {
+void CFishCloud::GatherBoidNeighbors() {
+  /* Positions stay put until every boid has steered, so this frame's neighbor queries run up front on the
+   * helper pool. Steering then adds each boid's neighbors in the original order with live headings. */
+  constexpr u32 batchSize = 64;
+  const u32 boidCount = u32(xe8_boids.size());
+  m_nearCounts.assign(boidCount, 0);
+  m_nearNeighbors.resize(size_t(boidCount) * kMaxNeighbors);
+  hecl::ParallelFor((boidCount + batchSize - 1) / batchSize, [&](size_t batch) {
+    const u32 last = std::min(boidCount, u32(batch + 1) * batchSize);
+    for (u32 i = u32(batch) * batchSize; i < last; ++i) {
+      const CBoid& b = xe8_boids[i];
+      if (!b.x20_active || (i & x11c_updateMask) != (x118_thinkCounter & x11c_updateMask)) {
         continue;
       }
-      if (cy >= aabb.max.y()) {
-        break;
-      }
-      for (float lnz = nz; lnz < z; lnz += x238_partitionPitch.z()) {
-        const float cz = lnz + pos.z();
-        if (cz < aabb.min.z()) {
-          continue;
-        }
-        if (cz >= aabb.max.z()) {
-          break;
-        }
-        const zeus::CVector3f ints = (zeus::CVector3f(cx, cy, cz) - aabb.min) * x244_ooPartitionPitch;
-        const int idx = int(ints.x()) + int(ints.y()) * 7 + int(ints.z()) * 49;
-        if (idx < 0) {
-          continue;
-        }
-        if (idx < 343) {
-          CBoid* boid = xf8_boidPartitionLists[idx];
-          while (boid != nullptr) {
-            if (boid->x20_active) {
-              const float distSq = (boid->x0_pos - pos).magSquared();
-              if (distSq != 0.f && distSq < radiusSq) {
-                nearList.push_back(boid);
-                if (nearList.size() == 25) {
-                  return;
-                }
-              }
-            }
-            boid = boid->x1c_next;
-          }
-        }
+      CBoidGrid::SNeighbor* out = &m_nearNeighbors[size_t(i) * kMaxNeighbors];
+      if (x250_31_updateWithoutPartitions) {
+        m_nearCounts[i] = m_boidGrid.GatherOwnCell(b.x0_pos, x138_separationRadius, out, kMaxNeighbors);
+      } else {
+        m_nearCounts[i] = m_boidGrid.GatherNearby(b.x0_pos, x138_separationRadius, out, kMaxNeighbors);
       }
     }
+  });
+}
+
+void CFishCloud::BuildBoidNeighborhood(u32 idx, CBoidNeighborhood& neighborhood) const {
+  const CBoidGrid::SNeighbor* neighbors = &m_nearNeighbors[size_t(idx) * kMaxNeighbors];
+  for (u32 i = 0; i < m_nearCounts[idx]; ++i) {
+    const CBoid& other = xe8_boids[neighbors[i].m_index];
+    neighborhood.Add(other.x0_pos, neighbors[i].m_distSq, other.xc_vel);
   }
 }
 
@@ -256,22 +201,12 @@ void CFishCloud::PlaceBoid(CStateManager& mgr, CBoid& boid, const zeus::CAABox&
   }
 }
 
-void CFishCloud::ApplySeparation(CBoid& boid, const rstl::reserved_vector<CBoid*, 25>& nearList) const {
-  if (nearList.empty()) {
+void CFishCloud::ApplySeparation(CBoid& boid, const CBoidNeighborhood& neighborhood) const {
+  if (neighborhood.IsEmpty()) {
     return;
   }
 
-  float minDist = FLT_MAX;
-  zeus::CVector3f pos;
-  for (const CBoid* b : nearList) {
-    const float dist = (boid.GetTranslation() - b->GetTranslation()).magSquared();
-    if (dist < minDist) {
-      minDist = dist;
-      pos = b->GetTranslation();
-    }
-  }
-
-  ApplySeparation(boid, pos, x138_separationRadius, x144_separationMagnitude);
+  ApplySeparation(boid, neighborhood.GetNearestPosition(), x138_separationRadius, x144_separationMagnitude);
 }
 
 void CFishCloud::ApplySeparation(CBoid& boid, const zeus::CVector3f& separateFrom, float separationRadius,
@@ -290,18 +225,12 @@ void CFishCloud::ApplySeparation(CBoid& boid, const zeus::CVector3f& separateFro
   boid.xc_vel += (1.f - deltaDistSq / capDeltaDistSq) * delta.normalized() * separationMagnitude;
 }
 
-void CFishCloud::ApplyCohesion(CBoid& boid, const rstl::reserved_vector<CBoid*, 25>& nearList) const {
-  if (nearList.empty()) {
+void CFishCloud::ApplyCohesion(CBoid& boid, const CBoidNeighborhood& neighborhood) const {
+  if (neighborhood.IsEmpty()) {
     return;
   }
 
-  zeus::CVector3f avg;
-  for (const CBoid* b : nearList) {
-    avg += b->GetTranslation();
-  }
-
-  avg = avg / float(nearList.size());
-  ApplyCohesion(boid, avg, x138_separationRadius, x13c_cohesionMagnitude);
+  ApplyCohesion(boid, neighborhood.GetAveragePosition(), x138_separationRadius, x13c_cohesionMagnitude);
 }
 
 void CFishCloud::ApplyCohesion(CBoid& boid, const zeus::CVector3f& cohesionFrom, float cohesionRadius,
@@ -316,17 +245,12 @@ void CFishCloud::ApplyCohesion(CBoid& boid, const zeus::CVector3f& cohesionFrom,
   boid.xc_vel += ((distSq > capDistSq) ? 1.f : distSq / capDistSq) * delta.normalized() * cohesionMagnitude;
 }
 
-void CFishCloud::ApplyAlignment(CBoid& boid, const rstl::reserved_vector<CBoid*, 25>& nearList) const {
-  if (nearList.empty()) {
+void CFishCloud::ApplyAlignment(CBoid& boid, const CBoidNeighborhood& neighborhood) const {
+  if (neighborhood.IsEmpty()) {
     return;
   }
 
-  zeus::CVector3f avg;
-  for (const CBoid* b : nearList) {
-    avg += b->xc_vel;
-  }
-
-  avg = avg / float(nearList.size());
+  const zeus::CVector3f avg = neighborhood.GetAverageHeading();
   boid.xc_vel += zeus::CVector3f::getAngleDiff(boid.xc_vel, avg) / M_PIF * (avg * x140_alignmentWeight);
 }
 
@@ -409,31 +333,28 @@ void CFishCloud::Think(float dt, CStateManager& mgr) {
 
     UpdateParticles(dt);
     UpdatePartitionList();
+    GatherBoidNeighbors();
 
     const zeus::CAABox aabb = GetBoundingBox();
     int idx = 0;
     for (auto& b : xe8_boids) {
       if (b.x20_active && (idx & x11c_updateMask) == (x118_thinkCounter & x11c_updateMask)) {
-        rstl::reserved_vector<CBoid*, 25> nearList;
-        if (x250_31_updateWithoutPartitions) {
-          BuildBoidNearList(b.x0_pos, x138_separationRadius, nearList);
-        } else {
-          BuildBoidNearPartitionList(b.x0_pos, x138_separationRadius, nearList);
-        }
+        CBoidNeighborhood neighborhood(kMaxNeighbors);
+        BuildBoidNeighborhood(u32(idx), neighborhood);
 
         for (int i = 0; i < 5; ++i) {
           switch (i) {
           case 1:
-            ApplySeparation(b, nearList);
+            ApplySeparation(b, neighborhood);
             break;
           case 2:
             if (!x250_24_randomMovement || mgr.GetActiveRandom()->Float() > x12c_randomMovementTimer) {
-              ApplyCohesion(b, nearList);
+              ApplyCohesion(b, neighborhood);
             }
             break;
           case 3:
             if (!x250_24_randomMovement || mgr.GetActiveRandom()->Float() > x12c_randomMovementTimer) {
-              ApplyAlignment(b, nearList);
+              ApplyAlignment(b, neighborhood);
             }
             break;
           case 4:
@@ -506,7 +427,10 @@ void CFishCloud::Think(float dt, CStateManager& mgr) {
   }
 }
 
-void CFishCloud::CreatePartitionList() { xf8_boidPartitionLists.reserve(343); }
+void CFishCloud::CreatePartitionList() {
+  m_nearCounts.reserve(xe8_boids.size());
+  m_nearNeighbors.reserve(xe8_boids.size() * kMaxNeighbors);
+}
 
 void CFishCloud::AllocateSkinnedModels(CStateManager& mgr, CModelData::EWhichModel which) {
   int idx = 0;
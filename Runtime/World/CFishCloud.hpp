@@ -6,6 +6,8 @@
 #include "Runtime/rstl.hpp"
 #include "Runtime/Particle/CElementGen.hpp"
 #include "Runtime/World/CActor.hpp"
+#include "Runtime/World/CBoidGrid.hpp"
+#include "Runtime/World/CBoidNeighborhood.hpp"
 
 #include <zeus/CVector3f.hpp>
 
@@ -17,7 +19,6 @@ class CFishCloud : public CActor {
     zeus::CVector3f x0_pos;
     zeus::CVector3f xc_vel;
     float x18_scale;
-    CBoid* x1c_next = nullptr;
     bool x20_active = true;
 
   public:
@@ -51,7 +52,11 @@ class CFishCloud : public CActor {
     }
   };
   std::vector<CBoid> xe8_boids;
-  std::vector<CBoid*> xf8_boidPartitionLists;
+  static constexpr u32 kMaxNeighbors = 25;
+  CBoidGrid m_boidGrid;
+  /* Per-boid neighbors gathered ahead of steering, kMaxNeighbors slots per boid */
+  std::vector<u32> m_nearCounts;
+  std::vector<CBoidGrid::SNeighbor> m_nearNeighbors;
   std::vector<CModifierSource> x108_modifierSources;
   u32 x118_thinkCounter = 0;
   u32 x11c_updateMask;
@@ -99,18 +104,16 @@ class CFishCloud : public CActor {
   void UpdatePartitionList();
   bool PointInBox(const zeus::CAABox& aabb, const zeus::CVector3f& point) const;
   zeus::CPlane FindClosestPlane(const zeus::CAABox& aabb, const zeus::CVector3f& point) const;
-  CBoid* GetListAt(const zeus::CVector3f& pos);
-  void BuildBoidNearList(const zeus::CVector3f& pos, float radius, rstl::reserved_vector<CBoid*, 25>& nearList);
-  void BuildBoidNearPartitionList(const zeus::CVector3f& pos, float radius,
-                                  rstl::reserved_vector<CBoid*, 25>& nearList);
+  void GatherBoidNeighbors();
+  void BuildBoidNeighborhood(u32 idx, CBoidNeighborhood& neighborhood) const;
   void PlaceBoid(CStateManager& mgr, CBoid& boid, const zeus::CAABox& aabb) const;
-  void ApplySeparation(CBoid& boid, const rstl::reserved_vector<CBoid*, 25>& nearList) const;
+  void ApplySeparation(CBoid& boid, const CBoidNeighborhood& neighborhood) const;
   void ApplySeparation(CBoid& boid, const zeus::CVector3f& separateFrom, float separationRadius,
                        float separationMagnitude) const;
-  void ApplyCohesion(CBoid& boid, const rstl::reserved_vector<CBoid*, 25>& nearList) const;
+  void ApplyCohesion(CBoid& boid, const CBoidNeighborhood& neighborhood) const;
   void ApplyCohesion(CBoid& boid, const zeus::CVector3f& cohesionFrom, float cohesionRadius,
                      float cohesionMagnitude) const;
-  void ApplyAlignment(CBoid& boid, const rstl::reserved_vector<CBoid*, 25>& nearList) const;
+  void ApplyAlignment(CBoid& boid, const CBoidNeighborhood& neighborhood) const;
   void ApplyAttraction(CBoid& boid, const zeus::CVector3f& attractTo, float attractionRadius,
                        float attractionMagnitude) const;
   void ApplyRepulsion(CBoid& boid, const zeus::CVector3f& attractTo, float repulsionRadius,
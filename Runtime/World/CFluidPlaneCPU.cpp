@@ -1,5 +1,14 @@
 #include "Runtime/World/CFluidPlaneCPU.hpp"
 
+#if __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <chrono>
+
+#include <hecl/ParallelFor.hpp>
+
+#include "Runtime/CRandom16.hpp"
 #include "Runtime/CSimplePool.hpp"
 #include "Runtime/CStateManager.hpp"
 #include "Runtime/GameGlobalObjects.hpp"
@@ -10,7 +19,11 @@
 
 #include "TCastTo.hpp" // Generated file, do not modify include path
 
+#include <logvisor/logvisor.hpp>
+
 namespace metaforce {
+static logvisor::Module Log("metaforce::CFluidPlaneCPU");
+
 constexpr u32 kTableSize = 2048;
 
 CFluidPlaneCPU::CTurbulence::CTurbulence(float speed, float distance, float freqMax, float freqMin, float phaseMax,
@@ -307,16 +320,40 @@ bool CFluidPlaneCPU::PrepareRipple(const CRipple& ripple, const CFluidPlaneRende
   return !(rippleOut.x14_gfromX > rippleOut.x18_gtoX || rippleOut.x1c_gfromY > rippleOut.x20_gtoY);
 }
 
-void CFluidPlaneCPU::ApplyTurbulence(float t, Heights& heights, const Flags& flags, const SineTable& sineWave,
-                                     const CFluidPlaneRender::SPatchInfo& info,
-                                     const zeus::CVector3f& areaCenter) const {
+void CFluidPlaneCPU::ComputeTurbulenceDistances(const CFluidPlaneRender::SPatchInfo& info,
+                                                const zeus::CVector3f& areaCenter,
+                                                TurbulenceDistances& distances) const {
+  const float ooDistance = GetOOTurbulenceDistance();
+
+  // Every row walks the same X positions; square them once per patch
+  std::array<float, std::tuple_size_v<TurbulenceDistances::value_type>> curXSq;
+  float curX = info.x4_localMin.x() - info.x18_rippleResolution - areaCenter.x();
+  for (float& xSq : curXSq) {
+    xSq = curX * curX;
+    curX += info.x18_rippleResolution;
+  }
+
+  float curY = info.x4_localMin.y() - info.x18_rippleResolution - areaCenter.y();
+  for (auto& row : distances) {
+    const float curYSq = curY * curY;
+    for (size_t j = 0; j < row.size(); ++j) {
+      float distFac = curXSq[j] + curYSq;
+      if (distFac != 0.f)
+        distFac = std::sqrt(distFac);
+      row[j] = ooDistance * distFac;
+    }
+    curY += info.x18_rippleResolution;
+  }
+}
+
+void CFluidPlaneCPU::ApplyTurbulence(float t, Heights& heights, const TurbulenceDistances& distances,
+                                     const CFluidPlaneRender::SPatchInfo& info) const {
   if (!HasTurbulence()) {
     memset(&heights, 0, sizeof(heights));
     return;
   }
 
   float scaledT = t * GetOOTurbulenceSpeed();
-  float curY = info.x4_localMin.y() - info.x18_rippleResolution - areaCenter.y();
   int xDivs = (info.x0_xSubdivs + CFluidPlaneRender::numSubdivisionsInTile - 4) /
                   CFluidPlaneRender::numSubdivisionsInTile * CFluidPlaneRender::numSubdivisionsInTile +
               2;
@@ -324,16 +361,10 @@ void CFluidPlaneCPU::ApplyTurbulence(float t, Heights& heights, const Flags& fla
                   CFluidPlaneRender::numSubdivisionsInTile * CFluidPlaneRender::numSubdivisionsInTile +
               2;
   for (int i = 0; i <= yDivs; ++i) {
-    float curYSq = curY * curY;
-    float curX = info.x4_localMin.x() - info.x18_rippleResolution - areaCenter.x();
-    for (int j = 0; j <= xDivs; ++j) {
-      float distFac = curX * curX + curYSq;
-      if (distFac != 0.f)
-        distFac = std::sqrt(distFac);
-      heights[i][j].height = GetTurbulenceHeight(GetOOTurbulenceDistance() * distFac + scaledT);
-      curX += info.x18_rippleResolution;
-    }
-    curY += info.x18_rippleResolution;
+    auto& row = heights[i];
+    const auto& distRow = distances[i];
+    for (int j = 0; j <= xDivs; ++j)
+      row[j].height = GetTurbulenceHeight(distRow[j] + scaledT);
   }
 }
 
@@ -503,6 +534,84 @@ void CFluidPlaneCPU::ApplyRipples(const rstl::reserved_vector<CFluidPlaneRender:
     flags[CFluidPlaneRender::numTilesInHField + 1][i + 1] |= 2;
 }
 
+/* Normal and wavecap intensity of one sample from its four neighbours */
+static void UpdateSampleNormal(CFluidPlane::Heights& heights, int k, int l, float normalScale, float nz,
+                               float wavecapScale) {
+  CFluidPlaneRender::SHFieldSample& sample = heights[k][l];
+  const CFluidPlaneRender::SHFieldSample& up = heights[k + 1][l];
+  const CFluidPlaneRender::SHFieldSample& down = heights[k - 1][l];
+  const CFluidPlaneRender::SHFieldSample& right = heights[k][l + 1];
+  const CFluidPlaneRender::SHFieldSample& left = heights[k][l - 1];
+  float nx = (right.height - left.height) * normalScale;
+  float ny = (up.height - down.height) * normalScale;
+  float normalizer = ny * ny + nx * nx + nz * nz;
+  if (normalizer != 0.f)
+    normalizer = std::sqrt(normalizer);
+  normalizer = 63.f / normalizer;
+  sample.nx = s8(nx * normalizer);
+  sample.ny = s8(ny * normalizer);
+  sample.nz = s8(nz * normalizer);
+  if (sample.height > 0.f)
+    sample.wavecapIntensity = u8(std::min(255, int(wavecapScale * sample.height)));
+  else
+    sample.wavecapIntensity = 0;
+}
+
+#if __SSE2__
+static_assert(sizeof(CFluidPlaneRender::SHFieldSample) == 8, "Row normals expect {height, nx, ny, nz, wavecap}");
+
+/* Heights of four consecutive samples */
+static __m128 LoadHeights(const CFluidPlaneRender::SHFieldSample* samples) {
+  const __m128 lo = _mm_loadu_ps(reinterpret_cast<const float*>(samples));
+  const __m128 hi = _mm_loadu_ps(reinterpret_cast<const float*>(samples + 2));
+  return _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+}
+#endif
+
+/* UpdateSampleNormal over samples [from, to) of row k; four at a time with SSE2, matching the scalar
+ * result bit for bit (sqrt and divide are correctly rounded, conversions truncate) */
+static void UpdateRowNormals(CFluidPlane::Heights& heights, int k, int from, int to, float normalScale, float nz,
+                             float wavecapScale) {
+  int l = from;
+#if __SSE2__
+  CFluidPlaneRender::SHFieldSample* row = heights[k].data();
+  const CFluidPlaneRender::SHFieldSample* up = heights[k + 1].data();
+  const CFluidPlaneRender::SHFieldSample* down = heights[k - 1].data();
+  const __m128 scale4 = _mm_set1_ps(normalScale);
+  const __m128 nz4 = _mm_set1_ps(nz);
+  const __m128 nzSq4 = _mm_set1_ps(nz * nz);
+  const __m128 wavecapScale4 = _mm_set1_ps(wavecapScale);
+  const __m128i byteMask = _mm_set1_epi32(0xff);
+  /* Copy this row's heights out first; loading neighbours back from just-stored samples stalls store forwarding */
+  std::array<float, std::tuple_size_v<CFluidPlane::Heights::value_type>> rowHeights;
+  for (int i = from - 1; i <= to; ++i)
+    rowHeights[i] = row[i].height;
+  for (; l + 4 <= to; l += 4) {
+    const __m128 height = _mm_loadu_ps(&rowHeights[l]);
+    const __m128 nx = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&rowHeights[l + 1]), _mm_loadu_ps(&rowHeights[l - 1])),
+                                 scale4);
+    const __m128 ny = _mm_mul_ps(_mm_sub_ps(LoadHeights(up + l), LoadHeights(down + l)), scale4);
+    const __m128 normalizer = _mm_div_ps(
+        _mm_set1_ps(63.f),
+        _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ny, ny), _mm_mul_ps(nx, nx)), nzSq4)));
+    const __m128i outNx = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(nx, normalizer)), byteMask);
+    const __m128i outNy = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(ny, normalizer)), byteMask);
+    const __m128i outNz = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(nz4, normalizer)), byteMask);
+    const __m128 wavecap = _mm_min_ps(_mm_mul_ps(wavecapScale4, height), _mm_set1_ps(255.f));
+    const __m128i outWavecap = _mm_and_si128(_mm_cvttps_epi32(wavecap),
+                                             _mm_castps_si128(_mm_cmpgt_ps(height, _mm_setzero_ps())));
+    const __m128i packed =
+        _mm_or_si128(_mm_or_si128(outNx, _mm_slli_epi32(outNy, 8)),
+                     _mm_or_si128(_mm_slli_epi32(outNz, 16), _mm_slli_epi32(outWavecap, 24)));
+    auto* out = reinterpret_cast<float*>(row + l);
+    _mm_storeu_ps(out, _mm_unpacklo_ps(height, _mm_castsi128_ps(packed)));
+    _mm_storeu_ps(out + 4, _mm_unpackhi_ps(height, _mm_castsi128_ps(packed)));
+  }
+#endif
+  for (; l < to; ++l)
+    UpdateSampleNormal(heights, k, l, normalScale, nz, wavecapScale);
+}
+
 void CFluidPlaneCPU::UpdatePatchNoNormals(Heights& heights, const Flags& flags,
                                           const CFluidPlaneRender::SPatchInfo& info) {
   for (int i = 1; i <= (info.x1_ySubdivs + CFluidPlaneRender::numSubdivisionsInTile - 2) /
@@ -566,6 +675,7 @@ void CFluidPlaneCPU::UpdatePatchWithNormals(Heights& heights, const Flags& flags
                                             const CFluidPlaneRender::SPatchInfo& info) {
   float normalScale = -(2.f * info.x18_rippleResolution);
   float nz = 0.25f * 2.f * info.x18_rippleResolution;
+  float wavecapScale = info.x38_wavecapIntensityScale;
   int curGridY = info.x2e_tileY * info.x2a_gridDimX - 1 + info.x28_tileX;
   for (int i = 1; i <= (info.x1_ySubdivs + CFluidPlaneRender::numSubdivisionsInTile - 2) /
                            CFluidPlaneRender::numSubdivisionsInTile;
@@ -580,119 +690,25 @@ void CFluidPlaneCPU::UpdatePatchWithNormals(Heights& heights, const Flags& flags
       int x3c = std::min(r12, info.x0_xSubdivs + 1);
       r12 -= CFluidPlaneRender::numSubdivisionsInTile;
       if ((flags[i][j] & 0x1f) == 0x1f) {
-        for (int k = r9; k < x38; ++k) {
-          for (int l = r12; l < x3c; ++l) {
-            CFluidPlaneRender::SHFieldSample& sample = heights[k][l];
-            CFluidPlaneRender::SHFieldSample& up = heights[k + 1][l];
-            CFluidPlaneRender::SHFieldSample& down = heights[k - 1][l];
-            CFluidPlaneRender::SHFieldSample& right = heights[k][l + 1];
-            CFluidPlaneRender::SHFieldSample& left = heights[k][l - 1];
-            float nx = (right.height - left.height) * normalScale;
-            float ny = (up.height - down.height) * normalScale;
-            float normalizer = ny * ny + nx * nx + nz * nz;
-            if (normalizer != 0.f)
-              normalizer = std::sqrt(normalizer);
-            normalizer = 63.f / normalizer;
-            sample.nx = s8(nx * normalizer);
-            sample.ny = s8(ny * normalizer);
-            sample.nz = s8(nz * normalizer);
-            if (sample.height > 0.f)
-              sample.wavecapIntensity = u8(std::min(255, int(info.x38_wavecapIntensityScale * sample.height)));
-            else
-              sample.wavecapIntensity = 0;
-          }
-        }
+        for (int k = r9; k < x38; ++k)
+          UpdateRowNormals(heights, k, r12, x3c, normalScale, nz, wavecapScale);
       } else {
         if (!info.x30_gridFlags || info.x30_gridFlags[curGridY + j]) {
           if (i > 0 && i < CFluidPlaneRender::numTilesInHField + 1 && j > 0 &&
               j < CFluidPlaneRender::numTilesInHField + 1) {
             int halfSubdivs = CFluidPlaneRender::numSubdivisionsInTile / 2;
-            int k = halfSubdivs + r9;
-            int l = halfSubdivs + r12;
-            CFluidPlaneRender::SHFieldSample& sample = heights[k][l];
-            CFluidPlaneRender::SHFieldSample& up = heights[k + 1][l];
-            CFluidPlaneRender::SHFieldSample& down = heights[k - 1][l];
-            CFluidPlaneRender::SHFieldSample& right = heights[k][l + 1];
-            CFluidPlaneRender::SHFieldSample& left = heights[k][l - 1];
-            float nx = (right.height - left.height) * normalScale;
-            float ny = (up.height - down.height) * normalScale;
-            float normalizer = ny * ny + nx * nx + nz * nz;
-            if (normalizer != 0.f)
-              normalizer = std::sqrt(normalizer);
-            normalizer = 63.f / normalizer;
-            sample.nx = s8(nx * normalizer);
-            sample.ny = s8(ny * normalizer);
-            sample.nz = s8(nz * normalizer);
-            if (sample.height > 0.f)
-              sample.wavecapIntensity = u8(std::min(255, int(info.x38_wavecapIntensityScale * sample.height)));
-            else
-              sample.wavecapIntensity = 0;
+            UpdateSampleNormal(heights, halfSubdivs + r9, halfSubdivs + r12, normalScale, nz, wavecapScale);
           }
         }
 
         if (j != 0 && i != 0) {
           if ((flags[i][j] & 2) != 0 || (flags[i - 1][j] & 1) != 0 || (flags[i][j] & 4) != 0 ||
               (flags[i][j - 1] & 8) != 0) {
-            for (int l = r12; l < x3c; ++l) {
-              CFluidPlaneRender::SHFieldSample& sample = heights[r9][l];
-              CFluidPlaneRender::SHFieldSample& up = heights[r9 + 1][l];
-              CFluidPlaneRender::SHFieldSample& down = heights[r9 - 1][l];
-              CFluidPlaneRender::SHFieldSample& right = heights[r9][l + 1];
-              CFluidPlaneRender::SHFieldSample& left = heights[r9][l - 1];
-              float nx = (right.height - left.height) * normalScale;
-              float ny = (up.height - down.height) * normalScale;
-              float normalizer = ny * ny + nx * nx + nz * nz;
-              if (normalizer != 0.f)
-                normalizer = std::sqrt(normalizer);
-              normalizer = 63.f / normalizer;
-              sample.nx = s8(nx * normalizer);
-              sample.ny = s8(ny * normalizer);
-              sample.nz = s8(nz * normalizer);
-              if (sample.height > 0.f)
-                sample.wavecapIntensity = u8(std::min(255, int(info.x38_wavecapIntensityScale * sample.height)));
-              else
-                sample.wavecapIntensity = 0;
-            }
-
-            for (int k = r9; k < x38; ++k) {
-              CFluidPlaneRender::SHFieldSample& sample = heights[k][r12];
-              CFluidPlaneRender::SHFieldSample& up = heights[k + 1][r12];
-              CFluidPlaneRender::SHFieldSample& down = heights[k - 1][r12];
-              CFluidPlaneRender::SHFieldSample& right = heights[k][r12 + 1];
-              CFluidPlaneRender::SHFieldSample& left = heights[k][r12 - 1];
-              float nx = (right.height - left.height) * normalScale;
-              float ny = (up.height - down.height) * normalScale;
-              float normalizer = ny * ny + nx * nx + nz * nz;
-              if (normalizer != 0.f)
-                normalizer = std::sqrt(normalizer);
-              normalizer = 63.f / normalizer;
-              sample.nx = s8(nx * normalizer);
-              sample.ny = s8(ny * normalizer);
-              sample.nz = s8(nz * normalizer);
-              if (sample.height > 0.f)
-                sample.wavecapIntensity = u8(std::min(255, int(info.x38_wavecapIntensityScale * sample.height)));
-              else
-                sample.wavecapIntensity = 0;
-            }
+            UpdateRowNormals(heights, r9, r12, x3c, normalScale, nz, wavecapScale);
+            for (int k = r9; k < x38; ++k)
+              UpdateSampleNormal(heights, k, r12, normalScale, nz, wavecapScale);
           } else {
-            CFluidPlaneRender::SHFieldSample& sample = heights[r9][r12];
-            CFluidPlaneRender::SHFieldSample& up = heights[r9 + 1][r12];
-            CFluidPlaneRender::SHFieldSample& down = heights[r9 - 1][r12];
-            CFluidPlaneRender::SHFieldSample& right = heights[r9][r12 + 1];
-            CFluidPlaneRender::SHFieldSample& left = heights[r9][r12 - 1];
-            float nx = (right.height - left.height) * normalScale;
-            float ny = (up.height - down.height) * normalScale;
-            float normalizer = ny * ny + nx * nx + nz * nz;
-            if (normalizer != 0.f)
-              normalizer = std::sqrt(normalizer);
-            normalizer = 63.f / normalizer;
-            sample.nx = s8(nx * normalizer);
-            sample.ny = s8(ny * normalizer);
-            sample.nz = s8(nz * normalizer);
-            if (sample.height > 0.f)
-              sample.wavecapIntensity = u8(std::min(255, int(info.x38_wavecapIntensityScale * sample.height)));
-            else
-              sample.wavecapIntensity = 0;
+            UpdateSampleNormal(heights, r9, r12, normalScale, nz, wavecapScale);
           }
         }
       }
@@ -700,9 +716,9 @@ void CFluidPlaneCPU::UpdatePatchWithNormals(Heights& heights, const Flags& flags
   }
 }
 
-bool CFluidPlaneCPU::UpdatePatch(float time, const CFluidPlaneRender::SPatchInfo& info, Heights& heights, Flags& flags,
-                                 const zeus::CVector3f& areaCenter, const std::optional<CRippleManager>& rippleManager,
-                                 int fromX, int toX, int fromY, int toY) const {
+bool CFluidPlaneCPU::UpdatePatch(float time, const CFluidPlaneRender::SPatchInfo& info, SPatchCacheEntry& patch,
+                                 const std::optional<CRippleManager>& rippleManager, int fromX, int toX, int fromY,
+                                 int toY) const {
   rstl::reserved_vector<CFluidPlaneRender::SRippleInfo, 32> rippleInfos;
   if (rippleManager) {
     for (const CRipple& ripple : rippleManager->GetRipples()) {
@@ -717,25 +733,79 @@ bool CFluidPlaneCPU::UpdatePatch(float time, const CFluidPlaneRender::SPatchInfo
   if (rippleInfos.empty())
     return true;
 
-  ApplyTurbulence(time, heights, flags, sGlobalSineWave, info, areaCenter);
-  ApplyRipples(rippleInfos, heights, flags, sGlobalSineWave, info);
+  if (!patch.m_turbulenceValid && HasTurbulence()) {
+    ComputeTurbulenceDistances(info, patch.m_areaCenter, patch.m_turbulenceDist);
+    patch.m_turbulenceValid = true;
+  }
+  ApplyTurbulence(time, patch.m_heights, patch.m_turbulenceDist, info);
+  ApplyRipples(rippleInfos, patch.m_heights, patch.m_flags, sGlobalSineWave, info);
 
   /* No further action necessary if using tessellation shaders */
   if (m_tessellation)
     return false;
 
   if (info.x37_normalMode == CFluidPlaneRender::NormalMode::NoNormals)
-    UpdatePatchNoNormals(heights, flags, info);
+    UpdatePatchNoNormals(patch.m_heights, patch.m_flags, info);
   else
-    UpdatePatchWithNormals(heights, flags, info);
+    UpdatePatchWithNormals(patch.m_heights, patch.m_flags, info);
 
   return false;
 }
 
-// Used to be part of locked cache
-// These are too big for stack allocation
-static CFluidPlane::Heights lc_heights{};
-static CFluidPlane::Flags lc_flags{};
+CFluidPlaneCPU::SPatchCacheEntry& CFluidPlaneCPU::GetPatchCacheEntry(int patchX, int patchY,
+                                                                     const CFluidPlaneRender::SPatchInfo& info,
+                                                                     const zeus::CVector3f& areaCenter) {
+  std::unique_ptr<SPatchCacheEntry>& entry = m_patchCache[u32(patchX) | u32(patchY) << 16];
+  if (!entry)
+    entry = std::make_unique<SPatchCacheEntry>();
+  if (entry->m_localMin != info.x4_localMin || entry->m_areaCenter != areaCenter ||
+      entry->m_rippleResolution != info.x18_rippleResolution) {
+    entry->m_localMin = info.x4_localMin;
+    entry->m_areaCenter = areaCenter;
+    entry->m_rippleResolution = info.x18_rippleResolution;
+    entry->m_turbulenceValid = false;
+  }
+  entry->m_lastUsedFrame = m_patchCacheFrame;
+  return *entry;
+}
+
+void CFluidPlaneCPU::QueuePatch(int patchX, int patchY, const CFluidPlaneRender::SPatchInfo& info,
+                                const zeus::CVector3f& areaCenter, u8 renderFlags) {
+  int fromX = info.x28_tileX != 0 ? (2 - CFluidPlaneRender::numSubdivisionsInTile) : 0;
+  int toX;
+  if (info.x28_tileX != info.x2a_gridDimX - 1)
+    toX = info.x0_xSubdivs + (CFluidPlaneRender::numSubdivisionsInTile - 2);
+  else
+    toX = info.x0_xSubdivs;
+
+  int fromY = info.x2e_tileY != 0 ? (2 - CFluidPlaneRender::numSubdivisionsInTile) : 0;
+  int toY;
+  if (info.x2e_tileY != info.x2c_gridDimY - 1)
+    toY = info.x1_ySubdivs + (CFluidPlaneRender::numSubdivisionsInTile - 2);
+  else
+    toY = info.x1_ySubdivs;
+
+  m_visiblePatches.push_back(
+      {info, &GetPatchCacheEntry(patchX, patchY, info, areaCenter), fromX, toX, fromY, toY, renderFlags});
+}
+
+void CFluidPlaneCPU::UpdateQueuedPatches(float time, const std::optional<CRippleManager>& rippleManager) {
+  /* Patches only share read-only state; RenderPatch consumes them afterwards in queue order */
+  hecl::ParallelFor(m_visiblePatches.size(), [&](size_t i) {
+    SVisiblePatch& visible = m_visiblePatches[i];
+    visible.m_patch->m_noRipples = UpdatePatch(time, visible.m_info, *visible.m_patch, rippleManager,
+                                               visible.m_fromX, visible.m_toX, visible.m_fromY, visible.m_toY);
+  });
+}
+
+void CFluidPlaneCPU::PrunePatchCache() {
+  for (auto it = m_patchCache.begin(); it != m_patchCache.end();) {
+    if (m_patchCacheFrame - it->second->m_lastUsedFrame > kPatchCacheMaxAge)
+      it = m_patchCache.erase(it);
+    else
+      ++it;
+  }
+}
 
 void CFluidPlaneCPU::Render(const CStateManager& mgr, float alpha, const zeus::CAABox& aabb, const zeus::CTransform& xf,
                             const zeus::CTransform& areaXf, bool noNormals, const zeus::CFrustum& frustum,
@@ -820,6 +890,9 @@ void CFluidPlaneCPU::Render(const CStateManager& mgr, float alpha, const zeus::C
     m_shader->prepareDraw(setupInfo);
   }
 
+  ++m_patchCacheFrame;
+  m_visiblePatches.clear();
+
   u32 tileY = 0;
   float curY = aabb.min.y();
   for (int i = 0; curY < aabb.max.y() && i < patchDimY; ++i) {
@@ -841,23 +914,7 @@ void CFluidPlaneCPU::Render(const CStateManager& mgr, float alpha, const zeus::C
                                              normalMode, redShift, greenShift, blueShift, tileX, gridDimX, gridDimY,
                                              tileY, gridFlags);
 
-          int fromX = tileX != 0 ? (2 - CFluidPlaneRender::numSubdivisionsInTile) : 0;
-          int toX;
-          if (tileX != gridDimX - 1)
-            toX = info.x0_xSubdivs + (CFluidPlaneRender::numSubdivisionsInTile - 2);
-          else
-            toX = info.x0_xSubdivs;
-
-          int fromY = tileY != 0 ? (2 - CFluidPlaneRender::numSubdivisionsInTile) : 0;
-          int toY;
-          if (tileY != gridDimY - 1)
-            toY = info.x1_ySubdivs + (CFluidPlaneRender::numSubdivisionsInTile - 2);
-          else
-            toY = info.x1_ySubdivs;
-
-          bool noRipples = UpdatePatch(mgr.GetFluidPlaneManager()->GetUVT(), info, lc_heights, lc_flags, areaCenter,
-                                       rippleManager, fromX, toX, fromY, toY);
-          RenderPatch(info, lc_heights, lc_flags, noRipples, renderFlags == 1, m_verts, m_pVerts);
+          QueuePatch(j, i, info, areaCenter, renderFlags);
         }
       }
       curX += ripplePitch.x();
@@ -867,8 +924,102 @@ void CFluidPlaneCPU::Render(const CStateManager& mgr, float alpha, const zeus::C
     tileY += CFluidPlaneRender::numTilesInHField;
   }
 
+  UpdateQueuedPatches(mgr.GetFluidPlaneManager()->GetUVT(), rippleManager);
+  for (const SVisiblePatch& visible : m_visiblePatches) {
+    const SPatchCacheEntry& patch = *visible.m_patch;
+    RenderPatch(visible.m_info, patch.m_heights, patch.m_flags, patch.m_noRipples, visible.m_renderFlags == 1, m_verts,
+                m_pVerts);
+  }
+  PrunePatchCache();
+
   m_shader->loadVerts(m_verts, m_pVerts);
   m_shader->doneDrawing();
 }
 
+void CFluidPlaneCPU::RunTessellationBenchmark(u32 frames) {
+  if (frames == 0) {
+    return;
+  }
+  InitializeSineWave();
+
+  /* 320x320 units of 4-unit tiles at 8 subdivisions: 16x16 patches of 40x40 samples */
+  constexpr float planeSize = 320.f;
+  constexpr u32 rippleCount = 32;
+  CFluidPlaneCPU plane({}, {}, {}, {}, {}, {}, {}, 1.f, 4.f, 8, EFluidType::NormalWater, 1.f, zeus::skUp, 1.f,
+                       CFluidUVMotion(10.f, 0.f), 20.f, 100.f, 1.f, 3.f, 0.f, 90.f, 0.5f, 0.25f, 0.f, 1.f, 0.5f, 1.f,
+                       1.f, 0);
+  CFluidPlaneRender::numSubdivisionsInTile = plane.x104_tileSubdivisions;
+  CFluidPlaneRender::numTilesInHField = std::min(7, 42 / CFluidPlaneRender::numSubdivisionsInTile);
+  CFluidPlaneRender::numSubdivisionsInHField =
+      CFluidPlaneRender::numTilesInHField * CFluidPlaneRender::numSubdivisionsInTile;
+  const float rippleRes = plane.x108_rippleResolution;
+  const float patchPitch = rippleRes * CFluidPlaneRender::numSubdivisionsInHField;
+  const u32 gridDim = u32(planeSize / plane.x100_tileSize);
+  const zeus::CVector3f areaCenter(0.5f * planeSize, 0.5f * planeSize, 0.f);
+
+  size_t ripplingPatches = 0;
+  const auto runFrames = [&](bool helpers) {
+    CRandom16 random(0xABBA);
+    plane.m_patchCache.clear();
+    std::optional<CRippleManager> ripples(std::in_place, int(rippleCount), 1.f);
+    const auto spawnRipple = [&](CRipple& ripple, kUniqueIdType id) {
+      const zeus::CVector3f center(random.Float() * planeSize, random.Float() * planeSize, 0.f);
+      ripple = CRipple(TUniqueId(id, 0), center, 0.5f);
+      ripple.SetTime(random.Float() * ripple.GetTimeFalloff());
+    };
+    for (u32 r = 0; r < rippleCount; ++r) {
+      spawnRipple(ripples->GetRipples()[r], kUniqueIdType(r));
+    }
+
+    hecl::SetParallelForHelpers(helpers);
+    std::chrono::steady_clock::duration elapsed{};
+    for (u32 f = 0; f < frames; ++f) {
+      ++plane.m_patchCacheFrame;
+      plane.m_visiblePatches.clear();
+      u32 tileY = 0;
+      for (int i = 0; float(i) * patchPitch < planeSize; ++i, tileY += CFluidPlaneRender::numTilesInHField) {
+        u32 tileX = 0;
+        for (int j = 0; float(j) * patchPitch < planeSize; ++j, tileX += CFluidPlaneRender::numTilesInHField) {
+          const zeus::CVector3f localMin(float(j) * patchPitch, float(i) * patchPitch, 0.f);
+          const zeus::CVector3f localMax(std::min(localMin.x() + patchPitch, planeSize),
+                                         std::min(localMin.y() + patchPitch, planeSize), 0.f);
+          const CFluidPlaneRender::SPatchInfo info(
+              localMin, localMax, zeus::skZero3f, rippleRes, plane.x100_tileSize, 255.f,
+              CFluidPlaneRender::numSubdivisionsInHField, CFluidPlaneRender::NormalMode::Normals, 0, 0, 0, tileX,
+              gridDim, gridDim, tileY, nullptr);
+          plane.QueuePatch(j, i, info, areaCenter, 1);
+        }
+      }
+
+      const auto start = std::chrono::steady_clock::now();
+      plane.UpdateQueuedPatches(float(f) / 60.f, ripples);
+      elapsed += std::chrono::steady_clock::now() - start;
+      for (const SVisiblePatch& visible : plane.m_visiblePatches) {
+        ripplingPatches += !visible.m_patch->m_noRipples;
+      }
+
+      ripples->Update(1.f / 60.f);
+      for (CRipple& ripple : ripples->GetRipples()) {
+        if (ripple.GetTime() >= ripple.GetTimeFalloff()) {
+          spawnRipple(ripple, ripple.GetUniqueId().id);
+          ripple.SetTime(0.f);
+        }
+      }
+    }
+    hecl::SetParallelForHelpers(true);
+    return std::chrono::duration<double, std::milli>(elapsed).count() / frames;
+  };
+
+  const double serialMs = runFrames(false);
+  const hecl::ParallelForStats before = hecl::GetParallelForStats();
+  const double pooledMs = runFrames(true);
+  const hecl::ParallelForStats after = hecl::GetParallelForStats();
+  Log.report(logvisor::Info,
+             FMT_STRING("Fluid tessellation, {} patches with {} ripples: serial {:.3f} ms, pooled {:.3f} ms per frame "
+                        "({:.2f}x, {:.1f} rippling patches per frame, {} of {} patches on helpers)"),
+             plane.m_visiblePatches.size(), rippleCount, serialMs, pooledMs,
+             pooledMs > 0.0 ? serialMs / pooledMs : 0.0, double(ripplingPatches) / (2 * frames),
+             after.helperItems - before.helperItems, after.items - before.items);
+}
+
 } // namespace metaforce
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "Runtime/GCNTypes.hpp"
 #include "Runtime/World/CFluidPlane.hpp"
@@ -63,22 +66,63 @@ protected:
   u32 m_maxVertCount;
   bool m_tessellation = false;
 
+  using TurbulenceDistances = std::array<std::array<float, std::tuple_size_v<Heights::value_type>>,
+                                         std::tuple_size_v<Heights>>;
+
+  /* Tessellation buffers of one patch, kept across renders. The turbulence distance of each sample only
+   * depends on where the patch sits, so it is computed once per placement and each frame only adds the
+   * turbulence phase before the table lookup. */
+  struct SPatchCacheEntry {
+    zeus::CVector2f m_localMin;
+    zeus::CVector3f m_areaCenter;
+    float m_rippleResolution = 0.f;
+    bool m_turbulenceValid = false;
+    bool m_noRipples = true;
+    u32 m_lastUsedFrame = 0;
+    Heights m_heights;
+    Flags m_flags{};
+    TurbulenceDistances m_turbulenceDist;
+  };
+  /* Entries for patches that left the view are dropped after this many renders */
+  static constexpr u32 kPatchCacheMaxAge = 60;
+  std::unordered_map<u32, std::unique_ptr<SPatchCacheEntry>> m_patchCache;
+  u32 m_patchCacheFrame = 0;
+
+  struct SVisiblePatch {
+    CFluidPlaneRender::SPatchInfo m_info;
+    SPatchCacheEntry* m_patch;
+    int m_fromX;
+    int m_toX;
+    int m_fromY;
+    int m_toY;
+    u8 m_renderFlags;
+  };
+  std::vector<SVisiblePatch> m_visiblePatches;
+
+  SPatchCacheEntry& GetPatchCacheEntry(int patchX, int patchY, const CFluidPlaneRender::SPatchInfo& info,
+                                       const zeus::CVector3f& areaCenter);
+  void QueuePatch(int patchX, int patchY, const CFluidPlaneRender::SPatchInfo& info,
+                  const zeus::CVector3f& areaCenter, u8 renderFlags);
+  void UpdateQueuedPatches(float time, const std::optional<CRippleManager>& rippleManager);
+  void PrunePatchCache();
+
   bool m_cachedDoubleLightmapBlend = false;
   bool m_cachedAdditive = false;
 
   static bool PrepareRipple(const CRipple& ripple, const CFluidPlaneRender::SPatchInfo& info,
                             CFluidPlaneRender::SRippleInfo& rippleOut);
-  void ApplyTurbulence(float t, Heights& heights, const Flags& flags, const SineTable& sineWave,
-                       const CFluidPlaneRender::SPatchInfo& info, const zeus::CVector3f& areaCenter) const;
+  void ComputeTurbulenceDistances(const CFluidPlaneRender::SPatchInfo& info, const zeus::CVector3f& areaCenter,
+                                  TurbulenceDistances& distances) const;
+  void ApplyTurbulence(float t, Heights& heights, const TurbulenceDistances& distances,
+                       const CFluidPlaneRender::SPatchInfo& info) const;
   void ApplyRipple(const CFluidPlaneRender::SRippleInfo& rippleInfo, Heights& heights, Flags& flags,
                    const SineTable& sineWave, const CFluidPlaneRender::SPatchInfo& info) const;
   void ApplyRipples(const rstl::reserved_vector<CFluidPlaneRender::SRippleInfo, 32>& rippleInfos, Heights& heights,
                     Flags& flags, const SineTable& sineWave, const CFluidPlaneRender::SPatchInfo& info) const;
   static void UpdatePatchNoNormals(Heights& heights, const Flags& flags, const CFluidPlaneRender::SPatchInfo& info);
   static void UpdatePatchWithNormals(Heights& heights, const Flags& flags, const CFluidPlaneRender::SPatchInfo& info);
-  bool UpdatePatch(float time, const CFluidPlaneRender::SPatchInfo& info, Heights& heights, Flags& flags,
-                   const zeus::CVector3f& areaCenter, const std::optional<CRippleManager>& rippleManager, int fromX,
-                   int toX, int fromY, int toY) const;
+  bool UpdatePatch(float time, const CFluidPlaneRender::SPatchInfo& info, SPatchCacheEntry& patch,
+                   const std::optional<CRippleManager>& rippleManager, int fromX, int toX, int fromY, int toY) const;
 
 public:
   CFluidPlaneCPU(CAssetId texPattern1, CAssetId texPattern2, CAssetId texColor, CAssetId bumpMap, CAssetId envMap,
@@ -119,6 +163,10 @@ public:
   float GetOOTurbulenceDistance() const { return x120_turbulence.GetOODistance(); }
   float GetOOTurbulenceSpeed() const { return x120_turbulence.GetOOSpeed(); }
   bool HasTurbulence() const { return x120_turbulence.HasTurbulence(); }
+
+  /* Tessellates a large turbulent plane with 32 live ripples, serially and on the shared helper pool
+   * (--benchmark-fluid N) */
+  static void RunTessellationBenchmark(u32 frames);
 };
 
 } // namespace metaforce
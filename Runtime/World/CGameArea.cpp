@@ -3,7 +3,10 @@
 #include <array>
 #include <cstring>
 
+#include "Runtime/CBlobCache.hpp"
 #include "Runtime/CGameState.hpp"
+#include "Runtime/CMemoryTags.hpp"
+#include "Runtime/CProfiler.hpp"
 #include "Runtime/CSimplePool.hpp"
 #include "Runtime/CStateManager.hpp"
 #include "Runtime/GameGlobalObjects.hpp"
@@ -433,6 +436,7 @@ CGameArea::~CGameArea() {
     RemoveStaticGeometry();
   else
     while (!Invalidate(nullptr)) {}
+  KillmAreaData();
 }
 
 bool CGameArea::IsFinishedOccluding() const {
@@ -685,8 +689,11 @@ bool CGameArea::StartStreamingMainArea() {
   if (xf0_24_postConstructed)
     return false;
 
+  CProfiler::CZone zone("CGameArea::StartStreamingMainArea");
+
   switch (xf4_phase) {
   case EPhase::LoadHeader: {
+    m_streamStartTime = std::chrono::steady_clock::now();
     x110_mreaSecBufs.reserve(3);
     AllocNewAreaData(0, 96);
     x12c_postConstructed = std::make_unique<CPostConstructed>();
@@ -759,6 +766,7 @@ u32 CGameArea::GetNumPartSizes() const {
 
 void CGameArea::AllocNewAreaData(int offset, int size) {
   x110_mreaSecBufs.emplace_back(std::unique_ptr<u8[]>(new u8[size]), size);
+  CMemoryTags::Add(EMemoryTag::World, size);
   xf8_loadTransactions.push_back(g_ResFactory->LoadResourcePartAsync(SObjectTag{FOURCC('MREA'), x84_mrea}, offset, size,
                                                                      x110_mreaSecBufs.back().first.get()));
 }
@@ -806,6 +814,9 @@ bool CGameArea::Invalidate(CStateManager* mgr) {
 }
 
 void CGameArea::KillmAreaData() {
+  for (const auto& buf : x110_mreaSecBufs) {
+    CMemoryTags::Sub(EMemoryTag::World, buf.second);
+  }
   m_resolvedBufs.clear();
   x110_mreaSecBufs.clear();
 }
@@ -825,6 +836,8 @@ void CGameArea::StartStreamIn(CStateManager& mgr) {
     return;
 
   OPTICK_EVENT();
+  CProfiler::CZone zone("CGameArea::StartStreamIn");
+  CMemoryTags::CScope memoryScope(EMemoryTag::World);
   VerifyTokenList(mgr);
 
   if (!xf0_26_tokensReady) {
@@ -852,6 +865,8 @@ void CGameArea::Validate(CStateManager& mgr) {
   if (xf0_24_postConstructed)
     return;
 
+  CProfiler::CZone zone("CGameArea::Validate");
+
   while (StartStreamingMainArea()) {}
 
   for (auto& req : xf8_loadTransactions)
@@ -895,6 +910,8 @@ void CGameArea::Validate(CStateManager& mgr) {
 }
 
 void CGameArea::LoadScriptObjects(CStateManager& mgr) {
+  CProfiler::CZone zone("CGameArea::LoadScriptObjects");
+  CMemoryTags::CScope memoryScope(EMemoryTag::World);
   CScriptLayerManager& layerState = *mgr.WorldLayerState();
   u32 layerCount = layerState.GetAreaLayerCount(x4_selfIdx);
   std::vector<TEditorId> objIds;
@@ -915,6 +932,8 @@ std::pair<const u8*, u32> CGameArea::GetLayerScriptBuffer(int layer) const {
 }
 
 void CGameArea::PostConstructArea() {
+  CProfiler::CZone zone("CGameArea::PostConstructArea");
+  CMemoryTags::CScope memoryScope(EMemoryTag::World);
   SMREAHeader header = VerifyHeader();
 
   auto secIt = m_resolvedBufs.begin() + 2;
@@ -944,10 +963,30 @@ void CGameArea::PostConstructArea() {
   ++secIt;
 
   /* Collision section */
-  std::unique_ptr<CAreaOctTree> collision = CAreaOctTree::MakeFromMemory(secIt->first, secIt->second);
-  if (collision) {
-    x12c_postConstructed->x0_collision = std::move(collision);
-    x12c_postConstructed->x8_collisionSize = secIt->second;
+  {
+    const auto buildStart = std::chrono::steady_clock::now();
+    const u8* collisionBuf = secIt->first;
+    /* Hashed before MakeFromMemory byte-swaps the section in place */
+    const std::optional<CBlobCache::SKey> collisionKey =
+        CBlobCache::MakeKey(FOURCC('COLL'), x84_mrea, secIt->first, secIt->second);
+    if (collisionKey) {
+      x12c_postConstructed->m_collisionBlob = CBlobCache::Map(*collisionKey, secIt->second);
+      if (x12c_postConstructed->m_collisionBlob) {
+        collisionBuf = x12c_postConstructed->m_collisionBlob->GetData();
+      }
+    }
+    const bool cached = x12c_postConstructed->m_collisionBlob != nullptr;
+    std::unique_ptr<CAreaOctTree> collision = CAreaOctTree::MakeFromMemory(collisionBuf, secIt->second, cached);
+    if (collisionKey) {
+      if (collision && !cached) {
+        CBlobCache::Store(*collisionKey, collisionBuf, secIt->second);
+      }
+      CBlobCache::AddBuildTime(FOURCC('COLL'), cached, std::chrono::steady_clock::now() - buildStart);
+    }
+    if (collision) {
+      x12c_postConstructed->x0_collision = std::move(collision);
+      x12c_postConstructed->x8_collisionSize = secIt->second;
+    }
   }
   ++secIt;
 
@@ -1013,6 +1052,10 @@ void CGameArea::PostConstructArea() {
   if (!x12c_postConstructed->x1108_25_modelsConstructed)
     FillInStaticGeometry();
 
+  Log.report(logvisor::Info, FMT_STRING("Area 0x{} loaded in {:.1f} ms (blob cache {})"), x84_mrea,
+             std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_streamStartTime).count(),
+             CBlobCache::IsEnabled() ? "on" : "off");
+
   xf0_24_postConstructed = true;
 
   /* Resolve layer pointers */
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 
+#include "Runtime/CBlobCache.hpp"
 #include "Runtime/CObjectList.hpp"
 #include "Runtime/CToken.hpp"
 #include "Runtime/RetroTypes.hpp"
@@ -196,6 +198,8 @@ public:
   };
 
   struct CPostConstructed {
+    /* metaforce addition: cached native collision data, must outlive x0_collision */
+    std::unique_ptr<CBlobCache::CBlob> m_collisionBlob;
     std::unique_ptr<CAreaOctTree> x0_collision;
     u32 x8_collisionSize = 0;
     std::optional<CAreaRenderOctTree> xc_octTree;
@@ -255,6 +259,7 @@ public:
 private:
   std::vector<std::pair<std::unique_ptr<u8[]>, int>> x110_mreaSecBufs;
   std::vector<std::pair<const u8*, int>> m_resolvedBufs;
+  std::chrono::steady_clock::time_point m_streamStartTime;
   u32 x124_secCount = 0;
   u32 x128_mreaDataOffset = 0;
   std::unique_ptr<CPostConstructed> x12c_postConstructed;
@@ -380,7 +380,7 @@ CScriptDoor::EDoorOpenCondition CScriptDoor::GetDoorOpenCondition(CStateManager&
     }
   }
 
-  if (!CGraphics::g_BooFactory->areShadersReady()) {
+  if (CGraphics::g_BooFactory != nullptr && !CGraphics::g_BooFactory->areShadersReady()) {
     return EDoorOpenCondition::Loading;
   }
 
@@ -140,7 +140,9 @@ void CScriptPickupGenerator::GeneratePickup(CStateManager& mgr, TEditorId templa
     newPickup->SetGenerated();
   }
 
-  mgr.SendScriptMsg(newObj, GetUniqueId(), EScriptObjectMessage::Activate);
+  /* Nothing here depends on the pickup having activated; hand it to the next drain point rather than
+   * dispatching from inside whatever handler is generating the drop */
+  mgr.DeferScriptMsg(p.second, GetUniqueId(), EScriptObjectMessage::Activate);
 }
 
 void CScriptPickupGenerator::AcceptScriptMsg(EScriptObjectMessage msg, TUniqueId sender, CStateManager& stateMgr) {
@@ -70,7 +70,7 @@ CScriptWater::CScriptWater(
   x2cc_gridCellCount = (x2c4_gridDimX + 1) * (x2c8_gridDimY + 1);
 
   uint32_t maxPatchSize;
-  if (CGraphics::g_BooFactory->isTessellationSupported(maxPatchSize)) {
+  if (CGraphics::g_BooFactory != nullptr && CGraphics::g_BooFactory->isTessellationSupported(maxPatchSize)) {
     x1b4_fluidPlane = std::make_unique<CFluidPlaneGPU>(
         patternMap1, patternMap2, colorMap, bumpMap, envMap, envBumpMap, lightmapId, unitsPerLightmapTexel, tileSize,
         tileSubdivisions * 2, fluidType, x2bc_alpha, bumpLightDir, bumpScale, uvMot, turbSpeed, turbDistance,
@@ -350,8 +350,7 @@ void CWallCrawlerSwarm::SetExplodeTimers(const zeus::CVector3f& pos, float radiu
 }
 
 CWallCrawlerSwarm::CBoid* CWallCrawlerSwarm::GetListAt(const zeus::CVector3f& pos) {
-  const zeus::CAABox aabb = GetBoundingBox();
-  const zeus::CVector3f ints = (pos - aabb.min) / ((aabb.max - aabb.min) / 5.f);
+  const zeus::CVector3f ints = (pos - m_partitionBox.min) / m_partitionPitch;
   const int idx = int(ints.x()) + int(ints.y()) * 5 + int(ints.z()) * 25;
   if (idx < 0 || idx >= 125) {
     return x360_outlierBoidList;
@@ -359,35 +358,25 @@ CWallCrawlerSwarm::CBoid* CWallCrawlerSwarm::GetListAt(const zeus::CVector3f& po
   return x168_partitionedBoidLists[idx];
 }
 
-void CWallCrawlerSwarm::BuildBoidNearList(const CBoid& boid, float radius,
-                                          rstl::reserved_vector<CBoid*, 50>& nearList) {
+void CWallCrawlerSwarm::BuildBoidNeighborhood(const CBoid& boid, float radius, CBoidNeighborhood& neighborhood) {
   CBoid* b = GetListAt(boid.GetTranslation());
-  while (b && nearList.size() < 50) {
+  while (b && !neighborhood.IsFull()) {
     const float distSq = (b->GetTranslation() - boid.GetTranslation()).magSquared();
     if (distSq != 0.f && distSq < radius) {
-      nearList.push_back(b);
+      neighborhood.Add(b->GetTranslation(), distSq, b->GetTransform().basis[1]);
     }
     b = b->x44_next;
   }
 }
 
-void CWallCrawlerSwarm::ApplySeparation(const CBoid& boid, const rstl::reserved_vector<CBoid*, 50>& nearList,
+void CWallCrawlerSwarm::ApplySeparation(const CBoid& boid, const CBoidNeighborhood& neighborhood,
                                         zeus::CVector3f& aheadVec) const {
-  if (nearList.empty()) {
+  if (neighborhood.IsEmpty()) {
     return;
   }
 
-  float minDist = FLT_MAX;
-  zeus::CVector3f pos;
-  for (const CBoid* b : nearList) {
-    const float dist = (boid.GetTranslation() - b->GetTranslation()).magSquared();
-    if (dist != 0.f && dist < minDist) {
-      minDist = dist;
-      pos = b->GetTranslation();
-    }
-  }
-
-  ApplySeparation(boid, pos, x13c_separationRadius, x148_separationMagnitude, aheadVec);
+  ApplySeparation(boid, neighborhood.GetNearestPosition(), x13c_separationRadius, x148_separationMagnitude,
+                  aheadVec);
 }
 
 void CWallCrawlerSwarm::ApplySeparation(const CBoid& boid, const zeus::CVector3f& separateFrom, float separationRadius,
@@ -439,19 +428,13 @@ void CWallCrawlerSwarm::MoveToWayPoint(CBoid& boid, CStateManager& mgr, zeus::CV
   }
 }
 
-void CWallCrawlerSwarm::ApplyCohesion(const CBoid& boid, const rstl::reserved_vector<CBoid*, 50>& nearList,
+void CWallCrawlerSwarm::ApplyCohesion(const CBoid& boid, const CBoidNeighborhood& neighborhood,
                                       zeus::CVector3f& aheadVec) const {
-  if (nearList.empty()) {
+  if (neighborhood.IsEmpty()) {
     return;
   }
 
-  zeus::CVector3f avg;
-  for (const CBoid* b : nearList) {
-    avg += b->GetTranslation();
-  }
-
-  avg = avg / float(nearList.size());
-  ApplyCohesion(boid, avg, x13c_separationRadius, x140_cohesionMagnitude, aheadVec);
+  ApplyCohesion(boid, neighborhood.GetAveragePosition(), x13c_separationRadius, x140_cohesionMagnitude, aheadVec);
 }
 
 void CWallCrawlerSwarm::ApplyCohesion(const CBoid& boid, const zeus::CVector3f& cohesionFrom, float cohesionRadius,
@@ -466,18 +449,13 @@ void CWallCrawlerSwarm::ApplyCohesion(const CBoid& boid, const zeus::CVector3f&
   aheadVec += ((distSq > capDistSq) ? 1.f : distSq / capDistSq) * delta.normalized() * cohesionMagnitude;
 }
 
-void CWallCrawlerSwarm::ApplyAlignment(const CBoid& boid, const rstl::reserved_vector<CBoid*, 50>& nearList,
+void CWallCrawlerSwarm::ApplyAlignment(const CBoid& boid, const CBoidNeighborhood& neighborhood,
                                        zeus::CVector3f& aheadVec) const {
-  if (nearList.empty()) {
+  if (neighborhood.IsEmpty()) {
     return;
   }
 
-  zeus::CVector3f avg;
-  for (const CBoid* b : nearList) {
-    avg += b->GetTransform().basis[1];
-  }
-
-  avg = avg / float(nearList.size());
+  const zeus::CVector3f avg = neighborhood.GetAverageHeading();
   aheadVec += zeus::CVector3f::getAngleDiff(boid.GetTransform().basis[1], avg) / M_PIF * (avg * x144_alignmentWeight);
 }
 
@@ -564,8 +542,8 @@ void CWallCrawlerSwarm::UpdateBoid(const CAreaCollisionCache& ccache, CStateMana
                              .multiplyIgnoreTranslation(boid.GetTransform());
       boid.x7c_framesNotOnSurface += 1;
     }
-    rstl::reserved_vector<CBoid*, 50> nearList;
-    BuildBoidNearList(boid, x13c_separationRadius, nearList);
+    CBoidNeighborhood neighborhood(50);
+    BuildBoidNeighborhood(boid, x13c_separationRadius, neighborhood);
     zeus::CVector3f aheadVec = boid.GetTransform().basis[1] * 0.3f;
     for (int r26 = 0; r26 < 8; ++r26) {
       switch (r26) {
@@ -577,16 +555,16 @@ void CWallCrawlerSwarm::UpdateBoid(const CAreaCollisionCache& ccache, CStateMana
         }
         break;
       case 4:
-        ApplySeparation(boid, nearList, aheadVec);
+        ApplySeparation(boid, neighborhood, aheadVec);
         break;
       case 5:
         MoveToWayPoint(boid, mgr, aheadVec);
         break;
       case 6:
-        ApplyCohesion(boid, nearList, aheadVec);
+        ApplyCohesion(boid, neighborhood, aheadVec);
         break;
       case 7:
-        ApplyAlignment(boid, nearList, aheadVec);
+        ApplyAlignment(boid, neighborhood, aheadVec);
         break;
       case 3:
         ApplyAttraction(boid, mgr.GetPlayer().GetTranslation(), x154_attractionRadius, x150_attractionMagnitude,
@@ -676,11 +654,12 @@ void CWallCrawlerSwarm::UpdatePartition() {
   x168_partitionedBoidLists.resize(125);
   x360_outlierBoidList = nullptr;
 
-  const zeus::CAABox aabb = GetBoundingBox();
-  const zeus::CVector3f vec = (aabb.max - aabb.min) / 5.f;
+  /* Cache the partition space; GetListAt is queried once per updated boid */
+  m_partitionBox = GetBoundingBox();
+  m_partitionPitch = (m_partitionBox.max - m_partitionBox.min) / 5.f;
   for (auto& b : x108_boids) {
     if (b.GetActive()) {
-      const zeus::CVector3f divVec = (b.GetTranslation() - aabb.min) / vec;
+      const zeus::CVector3f divVec = (b.GetTranslation() - m_partitionBox.min) / m_partitionPitch;
       const int xIdx = int(divVec.x());
       const int yIdx = int(divVec.y());
       const int zIdx = int(divVec.z());
@@ -9,6 +9,7 @@
 #include "Runtime/Collision/CCollisionSurface.hpp"
 #include "Runtime/Particle/CElementGen.hpp"
 #include "Runtime/World/CActor.hpp"
+#include "Runtime/World/CBoidNeighborhood.hpp"
 #include "Runtime/World/CDamageInfo.hpp"
 #include "Runtime/World/CDamageVulnerability.hpp"
 
@@ -82,6 +83,8 @@ private:
   float x160_animPlaybackSpeed;
   float x164_waypointGoalRadius = 3.f;
   rstl::reserved_vector<CBoid*, 125> x168_partitionedBoidLists;
+  zeus::CAABox m_partitionBox = zeus::skNullBox;
+  zeus::CVector3f m_partitionPitch;
   CBoid* x360_outlierBoidList = nullptr;
   float x364_boidGenRate;
   float x368_boidGenCooldownTimer = 0.f;
@@ -136,19 +139,16 @@ private:
   void ExplodeBoid(CBoid& boid, CStateManager& mgr);
   void SetExplodeTimers(const zeus::CVector3f& pos, float radius, float minTime, float maxTime);
   CBoid* GetListAt(const zeus::CVector3f& pos);
-  void BuildBoidNearList(const CBoid& boid, float radius, rstl::reserved_vector<CBoid*, 50>& nearList);
-  void ApplySeparation(const CBoid& boid, const rstl::reserved_vector<CBoid*, 50>& nearList,
-                       zeus::CVector3f& aheadVec) const;
+  void BuildBoidNeighborhood(const CBoid& boid, float radius, CBoidNeighborhood& neighborhood);
+  void ApplySeparation(const CBoid& boid, const CBoidNeighborhood& neighborhood, zeus::CVector3f& aheadVec) const;
   void ApplySeparation(const CBoid& boid, const zeus::CVector3f& separateFrom, float separationRadius,
                        float separationMagnitude, zeus::CVector3f& aheadVec) const;
   void ScatterScarabBoid(CBoid& boid, CStateManager& mgr) const;
   void MoveToWayPoint(CBoid& boid, CStateManager& mgr, zeus::CVector3f& aheadVec) const;
-  void ApplyCohesion(const CBoid& boid, const rstl::reserved_vector<CBoid*, 50>& nearList,
-                     zeus::CVector3f& aheadVec) const;
+  void ApplyCohesion(const CBoid& boid, const CBoidNeighborhood& neighborhood, zeus::CVector3f& aheadVec) const;
   void ApplyCohesion(const CBoid& boid, const zeus::CVector3f& cohesionFrom, float cohesionRadius,
                      float cohesionMagnitude, zeus::CVector3f& aheadVec) const;
-  void ApplyAlignment(const CBoid& boid, const rstl::reserved_vector<CBoid*, 50>& nearList,
-                      zeus::CVector3f& aheadVec) const;
+  void ApplyAlignment(const CBoid& boid, const CBoidNeighborhood& neighborhood, zeus::CVector3f& aheadVec) const;
   void ApplyAttraction(const CBoid& boid, const zeus::CVector3f& attractTo, float attractionRadius,
                        float attractionMagnitude, zeus::CVector3f& aheadVec) const;
   void UpdateBoid(const CAreaCollisionCache& ccache, CStateManager& mgr, float dt, CBoid& boid);
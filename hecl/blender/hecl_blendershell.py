@@ -1,9 +1,24 @@
-import bpy, sys, os, re, struct, traceback
+import bpy, sys, os, re, struct, time, traceback
 
 ARGS_PATTERN = re.compile(r'''(?:"([^"]+)"|'([^']+)'|(\S+))''')
 
+# Output is framed and buffered until the next read; large flushes go through the shared-memory ring
+FRAME_INLINE = 0
+FRAME_RING = 1
+RING_HEADER_SIZE = 64
+RING_MIN_FRAME = 65536
+FLUSH_THRESHOLD = 1048576
+_outbuf = bytearray()
+ring = None
+ring_head = 0
+
 # Background mode seems to require quit() in some 2.80 builds
 def _quitblender():
+    if _outbuf:
+        try:
+            flushpipe()
+        except OSError:
+            pass
     bpy.ops.wm.quit_blender()
     quit()
 
@@ -32,22 +47,76 @@ else:
 
 err_path += "/hecl_%016X.derp" % os.getpid()
 
+# Shared-memory ring given as <fd or mapping name>:<size>
+if len(args) >= 5 and args[4] != 'NOSHM':
+    import mmap
+    ring_id, ring_size = args[4].rsplit(':', 1)
+    if sys.platform == "win32":
+        ring = mmap.mmap(-1, int(ring_size), tagname=ring_id)
+    else:
+        ring = mmap.mmap(int(ring_id), int(ring_size))
+
+def _writeall(data):
+    view = memoryview(data)
+    while len(view):
+        view = view[os.write(writefd, view):]
+    view.release()
+
+def flushpipe():
+    global ring_head
+    if not _outbuf:
+        return
+    if ring is not None and len(_outbuf) >= RING_MIN_FRAME:
+        capacity = len(ring) - RING_HEADER_SIZE
+        with memoryview(_outbuf) as data:
+            off = 0
+            while off < len(data):
+                chunk = data[off:off + capacity // 2]
+                chunk_len = len(chunk)
+                # Payloads never straddle the end of the ring
+                pos = ring_head
+                if pos % capacity + chunk_len > capacity:
+                    pos += capacity - pos % capacity
+                while pos + chunk_len - struct.unpack_from('Q', ring, 0)[0] > capacity:
+                    time.sleep(0.0001)
+                start = RING_HEADER_SIZE + pos % capacity
+                ring[start:start + chunk_len] = chunk
+                chunk.release()
+                _writeall(struct.pack('IIQ', chunk_len, FRAME_RING, pos))
+                ring_head = pos + chunk_len
+                off += chunk_len
+    else:
+        _writeall(struct.pack('IIQ', len(_outbuf), FRAME_INLINE, 0))
+        _writeall(_outbuf)
+    _outbuf.clear()
+
+def readpipebuf(read_len):
+    flushpipe()
+    read_bytes = b''
+    while len(read_bytes) < read_len:
+        chunk = os.read(readfd, read_len - len(read_bytes))
+        if not chunk:
+            print('HECL connection lost or desynchronized')
+            _quitblender()
+        read_bytes += chunk
+    return read_bytes
+
 def readpipestr():
-    read_bytes = os.read(readfd, 4)
-    if len(read_bytes) != 4:
-        print('HECL connection lost or desynchronized')
-        _quitblender()
-    read_len = struct.unpack('I', read_bytes)[0]
-    return os.read(readfd, read_len)
+    read_len = struct.unpack('I', readpipebuf(4))[0]
+    return readpipebuf(read_len)
 
 def writepipestr(linebytes):
     #print('LINE', linebytes)
-    os.write(writefd, struct.pack('I', len(linebytes)))
-    os.write(writefd, linebytes)
+    _outbuf.extend(struct.pack('I', len(linebytes)))
+    _outbuf.extend(linebytes)
+    if len(_outbuf) >= FLUSH_THRESHOLD:
+        flushpipe()
 
 def writepipebuf(linebytes):
     #print('BUF', linebytes)
-    os.write(writefd, linebytes)
+    _outbuf.extend(linebytes)
+    if len(_outbuf) >= FLUSH_THRESHOLD:
+        flushpipe()
 
 def quitblender():
     writepipestr(b'QUITTING')
@@ -132,7 +201,7 @@ def exec_compbuf(compbuf, globals):
 def animin_loop(globals):
     writepipestr(b'ANIMREADY')
     while True:
-        crv_type = struct.unpack('b', os.read(readfd, 1))
+        crv_type = struct.unpack('b', readpipebuf(1))
         if crv_type[0] < 0:
             writepipestr(b'ANIMDONE')
             return
@@ -143,22 +212,16 @@ def animin_loop(globals):
         elif crv_type[0] == 2:
             crvs = globals['scaleCurves']
 
-        key_info = struct.unpack('ii', os.read(readfd, 8))
+        key_info = struct.unpack('ii', readpipebuf(8))
         crv = crvs[key_info[0]]
         crv.keyframe_points.add(count=key_info[1])
 
-        if crv_type[0] == 1:
-            for k in range(key_info[1]):
-                key_data = struct.unpack('if', os.read(readfd, 8))
-                pt = crv.keyframe_points[k]
-                pt.interpolation = 'LINEAR'
-                pt.co = (key_data[0], key_data[1])
-        else:
-            for k in range(key_info[1]):
-                key_data = struct.unpack('if', os.read(readfd, 8))
-                pt = crv.keyframe_points[k]
-                pt.interpolation = 'LINEAR'
-                pt.co = (key_data[0], key_data[1])
+        # Each curve's keys arrive together
+        key_bytes = readpipebuf(8 * key_info[1]) if key_info[1] else b''
+        for k, key_data in enumerate(struct.iter_unpack('if', key_bytes)):
+            pt = crv.keyframe_points[k]
+            pt.interpolation = 'LINEAR'
+            pt.co = (key_data[0], key_data[1])
 
 def writelight(obj):
     wmtx = obj.matrix_world
@@ -591,4 +654,8 @@ except Exception:
     fout = open(err_path, 'w')
     traceback.print_exc(file=fout)
     fout.close()
+    try:
+        flushpipe()
+    except OSError:
+        pass
     raise
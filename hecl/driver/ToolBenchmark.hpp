@@ -0,0 +1,278 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ToolBase.hpp"
+#include "hecl/Blender/Token.hpp"
+#include "hecl/ClientProcess.hpp"
+#include "hecl/CookMetrics.hpp"
+#include "hecl/ParallelFor.hpp"
+
+class ToolBenchmark final : public ToolBase {
+  std::vector<hecl::ProjectPath> m_selectedItems;
+  std::unique_ptr<hecl::Database::Project> m_fallbackProj;
+  hecl::Database::Project* m_useProj;
+  const hecl::Database::DataSpecEntry* m_spec = nullptr;
+  int m_iterations = 3;
+  /* Round-trip the project's textures instead of cooking the selected files */
+  bool m_textures = false;
+
+  struct Timing {
+    double serialMs = 0.0;
+    double pooledMs = 0.0;
+    size_t helperItems = 0;
+    size_t items = 0;
+    /* Stage metrics reported by the cookers, summed over iterations */
+    std::vector<hecl::CookMetric> serialMetrics;
+    std::vector<hecl::CookMetric> pooledMetrics;
+  };
+
+  static void MergeMetrics(std::vector<hecl::CookMetric>& dst, std::vector<hecl::CookMetric>&& src) {
+    for (hecl::CookMetric& metric : src) {
+      auto it = std::find_if(dst.begin(), dst.end(), [&](const hecl::CookMetric& m) { return m.name == metric.name; });
+      if (it == dst.end()) {
+        dst.push_back(std::move(metric));
+      } else {
+        it->sum += metric.sum;
+        it->samples += metric.samples;
+      }
+    }
+  }
+
+  static double MetricSum(const std::vector<hecl::CookMetric>& metrics, std::string_view name) {
+    auto it = std::find_if(metrics.begin(), metrics.end(), [&](const hecl::CookMetric& m) { return m.name == name; });
+    return it != metrics.end() ? it->sum : 0.0;
+  }
+
+  /* Cooks into a scratch path next to the real cooked output so the cook database is left alone */
+  static bool CookOnce(hecl::Database::IDataSpec& spec, const hecl::ProjectPath& path,
+                       const hecl::ProjectPath& scratch, hecl::blender::Token& btok, double& msOut) {
+    const auto start = std::chrono::steady_clock::now();
+    const bool ret = spec.doCook(path, scratch, false, btok, [](const char*) {});
+    msOut += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return ret;
+  }
+
+public:
+  explicit ToolBenchmark(const ToolPassInfo& info) : ToolBase(info), m_useProj(info.project) {
+    for (const std::string& arg : info.args) {
+      if (arg.empty())
+        continue;
+      else if (arg.size() >= 14 && !arg.compare(0, 13, "--iterations=")) {
+        m_iterations = std::max(1, int(hecl::StrToUl(arg.c_str() + 13, nullptr, 0)));
+        continue;
+      } else if (arg == "--textures") {
+        m_textures = true;
+        continue;
+      } else if (arg.size() >= 8 && !arg.compare(0, 7, "--spec=")) {
+        std::string specName(arg.begin() + 7, arg.end());
+        for (const hecl::Database::DataSpecEntry* spec : hecl::Database::DATA_SPEC_REGISTRY) {
+          if (!hecl::StrCaseCmp(spec->m_name.data(), specName.c_str())) {
+            m_spec = spec;
+            break;
+          }
+        }
+        if (!m_spec)
+          LogModule.report(logvisor::Fatal, FMT_STRING("unable to find data spec '{}'"), specName);
+        continue;
+      } else if (arg.size() >= 2 && arg[0] == '-' && arg[1] == '-')
+        continue;
+
+      std::string subPath;
+      hecl::ProjectRootPath root = hecl::SearchForProject(MakePathArgAbsolute(arg, info.cwd), subPath);
+      if (root) {
+        if (!m_fallbackProj) {
+          m_fallbackProj.reset(new hecl::Database::Project(root));
+          m_useProj = m_fallbackProj.get();
+        } else if (m_fallbackProj->getProjectRootPath() != root)
+          LogModule.report(logvisor::Fatal,
+                           FMT_STRING("hecl benchmark can only process multiple items in the same project; "
+                                      "'{}' and '{}' are different projects"),
+                           m_fallbackProj->getProjectRootPath().getAbsolutePath(), root.getAbsolutePath());
+        m_selectedItems.emplace_back(*m_useProj, subPath);
+      }
+    }
+    if (!m_useProj)
+      LogModule.report(logvisor::Fatal, FMT_STRING("hecl benchmark must be ran within a project directory or "
+                                                   "provided a path within a project"));
+    if (m_selectedItems.empty()) {
+      if (!m_textures) {
+        LogModule.report(logvisor::Error, FMT_STRING("hecl benchmark requires one or more files to cook"));
+        return;
+      }
+      m_selectedItems.push_back(m_useProj->getProjectWorkingPath());
+    }
+
+    if (!m_spec) {
+      for (const auto& projectSpec : m_useProj->getDataSpecs()) {
+        if (projectSpec.active && projectSpec.spec.m_factory) {
+          m_spec = &projectSpec.spec;
+          break;
+        }
+      }
+    }
+    if (!m_spec) {
+      LogModule.report(logvisor::Error, FMT_STRING("no active data spec to benchmark; pass --spec=<spec>"));
+      return;
+    }
+    m_good = true;
+  }
+
+  static void Help(HelpOutput& help) {
+    help.secHead("NAME");
+    help.beginWrap();
+    help.wrap("hecl-benchmark - Time cooks with and without the shared helper pool\n");
+    help.endWrap();
+
+    help.secHead("SYNOPSIS");
+    help.beginWrap();
+    help.wrap("hecl benchmark [--iterations=<n>] [--spec=<spec>] <file>...\n");
+    help.wrap("hecl benchmark --textures [--iterations=<n>] [--spec=<spec>] [<dir>...]\n");
+    help.endWrap();
+
+    help.secHead("DESCRIPTION");
+    help.beginWrap();
+    help.wrap(
+        "Cooks each file on a single thread, then again with the shared helper pool lending idle "
+        "cores to data-parallel stages (texture encoding, mip filtering, collision and octree "
+        "builds). Reports the wall time of each, the speedup, source throughput and any stage "
+        "metrics the cookers record (e.g. octree build times). Output goes to a scratch file; the "
+        "cook database is not touched. Verbose mode (-v) prints per-iteration timings.\n\n"
+        "With --textures, every texture under the given directories (the whole project by default) is "
+        "encoded to its native format and decoded back, and the encode and decode throughput is "
+        "reported per native format.\n");
+    help.endWrap();
+
+    help.secHead("OPTIONS");
+    help.optionHead("<file>...", "input file(s)");
+    help.beginWrap();
+    help.wrap("Working files to cook (e.g. .png textures, area .blend files).\n");
+    help.endWrap();
+    help.optionHead("--textures", "texture round trip");
+    help.beginWrap();
+    help.wrap("Time texture encoding and decoding per native format instead of whole cooks.\n");
+    help.endWrap();
+    help.optionHead("--iterations=<n>", "repeat count");
+    help.beginWrap();
+    help.wrap("Number of timed cooks per file and mode. Defaults to 3.\n");
+    help.endWrap();
+    help.optionHead("--spec=<spec>", "data specification");
+    help.beginWrap();
+    help.wrap("DataSpec to cook with. Defaults to the project's first active spec.\n");
+    help.endWrap();
+  }
+
+  std::string_view toolName() const override { return "benchmark"sv; }
+
+  int runTextures(hecl::Database::IDataSpec& spec) {
+    std::vector<hecl::Database::IDataSpec::TextureBenchmark> formats;
+    for (const hecl::ProjectPath& path : m_selectedItems) {
+      if (!spec.benchmarkTextures(path, m_iterations, formats)) {
+        LogModule.report(logvisor::Error, FMT_STRING("{} has no texture pipeline to benchmark"), m_spec->m_name);
+        return 1;
+      }
+    }
+
+    /* MB/s are against native (cooked) bytes for both directions */
+    const auto mbps = [](size_t bytes, double ms) { return ms > 0.0 ? bytes / (ms * 1000.0) : 0.0; };
+    hecl::Database::IDataSpec::TextureBenchmark total;
+    for (const hecl::Database::IDataSpec::TextureBenchmark& bench : formats) {
+      fmt::print(FMT_STRING("{:>7}: {:5} textures, {:8.2f} MB, encode {:9.2f} ms ({:7.1f} MB/s), "
+                            "decode {:9.2f} ms ({:7.1f} MB/s)\n"),
+                 bench.format, bench.textures, bench.nativeBytes / 1000000.0, bench.encodeMs,
+                 mbps(bench.nativeBytes, bench.encodeMs), bench.decodeMs, mbps(bench.nativeBytes, bench.decodeMs));
+      total.textures += bench.textures;
+      total.nativeBytes += bench.nativeBytes;
+      total.encodeMs += bench.encodeMs;
+      total.decodeMs += bench.decodeMs;
+    }
+    fmt::print(FMT_STRING("  total: {:5} textures, {:8.2f} MB, encode {:9.2f} ms ({:7.1f} MB/s), "
+                          "decode {:9.2f} ms ({:7.1f} MB/s) on {} threads\n"),
+               total.textures, total.nativeBytes / 1000000.0, total.encodeMs, mbps(total.nativeBytes, total.encodeMs),
+               total.decodeMs, mbps(total.nativeBytes, total.decodeMs), hecl::GetCPUCount());
+    return 0;
+  }
+
+  int run() override {
+    std::unique_ptr<hecl::Database::IDataSpec> spec =
+        m_spec->m_factory(*m_useProj, hecl::Database::DataSpecTool::Cook);
+    spec->setThreadProject();
+    if (m_textures)
+      return runTextures(*spec);
+    hecl::blender::Token btok;
+    hecl::SetCookMetricsEnabled(true);
+
+    Timing total;
+    size_t totalBytes = 0;
+    for (const hecl::ProjectPath& path : m_selectedItems) {
+      if (!path.isFile() || !spec->canCook(path, btok)) {
+        LogModule.report(logvisor::Warning, FMT_STRING("skipping '{}'; not cookable by {}"), path.getRelativePath(),
+                         m_spec->m_name);
+        continue;
+      }
+      const hecl::Database::DataSpecEntry* specEnt = spec->overrideDataSpec(path, spec->getDataSpecEntry());
+      if (!specEnt)
+        continue;
+      const hecl::ProjectPath scratch = path.getCookedPath(*specEnt).getWithExtension(".bench", true);
+      scratch.makeDirChain(false);
+
+      hecl::Sstat st;
+      const size_t bytes = hecl::Stat(path.getAbsolutePath().data(), &st) ? 0 : size_t(st.st_size);
+
+      /* Warm caches and any Blender connection before timing */
+      double warmMs = 0.0;
+      if (!CookOnce(*spec, path, scratch, btok, warmMs)) {
+        LogModule.report(logvisor::Error, FMT_STRING("unable to cook '{}'"), path.getRelativePath());
+        continue;
+      }
+      hecl::TakeCookMetrics();
+
+      Timing timing;
+      for (int i = 0; i < m_iterations; ++i) {
+        hecl::SetParallelForHelpers(false);
+        const double serialPrev = timing.serialMs;
+        CookOnce(*spec, path, scratch, btok, timing.serialMs);
+        MergeMetrics(timing.serialMetrics, hecl::TakeCookMetrics());
+        hecl::SetParallelForHelpers(true);
+        const hecl::ParallelForStats before = hecl::GetParallelForStats();
+        const double pooledPrev = timing.pooledMs;
+        CookOnce(*spec, path, scratch, btok, timing.pooledMs);
+        const hecl::ParallelForStats after = hecl::GetParallelForStats();
+        MergeMetrics(timing.pooledMetrics, hecl::TakeCookMetrics());
+        timing.items += after.items - before.items;
+        timing.helperItems += after.helperItems - before.helperItems;
+        if (m_info.verbosityLevel)
+          fmt::print(FMT_STRING("  {} #{}: serial {:.2f} ms, pooled {:.2f} ms\n"), path.getRelativePath(), i,
+                     timing.serialMs - serialPrev, timing.pooledMs - pooledPrev);
+      }
+      hecl::Unlink(scratch.getAbsolutePath().data());
+
+      const double serialMs = timing.serialMs / m_iterations;
+      const double pooledMs = timing.pooledMs / m_iterations;
+      fmt::print(FMT_STRING("{}: serial {:.2f} ms, pooled {:.2f} ms ({:.2f}x, {:.1f} MB/s), "
+                            "{} of {} parallel items on helpers\n"),
+                 path.getRelativePath(), serialMs, pooledMs, pooledMs > 0.0 ? serialMs / pooledMs : 0.0,
+                 pooledMs > 0.0 ? bytes / (pooledMs * 1000.0) : 0.0, timing.helperItems, timing.items);
+      for (const hecl::CookMetric& metric : timing.serialMetrics)
+        fmt::print(FMT_STRING("  {}: serial {:.2f}, pooled {:.2f} per cook\n"), metric.name,
+                   metric.sum / m_iterations, MetricSum(timing.pooledMetrics, metric.name) / m_iterations);
+      total.serialMs += serialMs;
+      total.pooledMs += pooledMs;
+      total.items += timing.items;
+      total.helperItems += timing.helperItems;
+      totalBytes += bytes;
+    }
+
+    if (total.pooledMs > 0.0)
+      fmt::print(FMT_STRING("total: serial {:.2f} ms, pooled {:.2f} ms ({:.2f}x, {:.1f} MB/s) on {} threads\n"),
+                 total.serialMs, total.pooledMs, total.serialMs / total.pooledMs,
+                 totalBytes / (total.pooledMs * 1000.0), hecl::GetCPUCount());
+    hecl::SetCookMetricsEnabled(false);
+    return 0;
+  }
+};
@@ -3,6 +3,7 @@
 #include "ToolBase.hpp"
 #include <cstdio>
 #include "hecl/ClientProcess.hpp"
+#include "hecl/CookDatabase.hpp"
 
 class ToolCook final : public ToolBase {
   std::vector<hecl::ProjectPath> m_selectedItems;
@@ -29,6 +30,9 @@ public:
         else if (arg == "--fast") {
           m_fast = true;
           continue;
+        } else if (arg.size() >= 16 && !arg.compare(0, 15, "--blender-jobs=")) {
+          hecl::BlenderCookLimit = int(hecl::StrToUl(arg.c_str() + 15, nullptr, 0));
+          continue;
         } else if (arg.size() >= 8 && !arg.compare(0, 7, "--spec=")) {
           std::string specName(arg.begin() + 7, arg.end());
           for (const hecl::Database::DataSpecEntry* spec : hecl::Database::DATA_SPEC_REGISTRY) {
@@ -80,7 +84,7 @@ public:
 
     help.secHead("SYNOPSIS");
     help.beginWrap();
-    help.wrap("hecl cook [-rf] [--fast] [--spec=<spec>] [<pathspec>...]\n");
+    help.wrap("hecl cook [-rf] [--fast] [--blender-jobs=<n>] [--spec=<spec>] [<pathspec>...]\n");
     help.endWrap();
 
     help.secHead("DESCRIPTION");
@@ -98,12 +102,11 @@ public:
     help.wrap(" files return any linked ");
     help.wrapBold(".png");
     help.wrap(" images). If the dependent files are unable to be found, the cook process aborts.\n\n");
-    help.wrapBold("- Modtime Comparison: ");
+    help.wrapBold("- Hash Comparison: ");
     help.wrap(
-        "Files that have previously finished a cook pass are inspected for their time of "
-        "last modification. If the file hasn't changed since its previous cook-pass, the "
-        "process is skipped. If the file has been moved or deleted, the object is automatically "
-        "removed from the project database.\n\n");
+        "Files that have previously finished a cook pass are compared by content hash, along with "
+        "every file their cook read. If none of them has changed since the previous cook-pass, the "
+        "process is skipped. The reason for each recook is written to .hecl/cooked/cook-report.txt.\n\n");
     help.wrapBold("- Cook: ");
     help.wrap(
         "A type-specific procedure compiles the file's contents into an efficient format "
@@ -136,6 +139,12 @@ public:
     help.beginWrap();
     help.wrap("Performs draft-optimization cooking for supported data types.\n");
     help.endWrap();
+    help.optionHead("--blender-jobs=<n>", "blender concurrency");
+    help.beginWrap();
+    help.wrap(
+        "Limits how many Blender-backed cooks run at once; remaining workers keep cooking other data "
+        "types. Defaults to one per worker.\n");
+    help.endWrap();
 
     help.optionHead("--spec=<spec>", "data specification");
     help.beginWrap();
@@ -159,6 +168,7 @@ public:
     for (const hecl::ProjectPath& path : m_selectedItems)
       m_useProj->cookPath(path, printer, m_recursive, m_info.force, m_fast, m_spec, &cp);
     cp.waitUntilComplete();
+    m_useProj->getCookDatabase().flush();
     return 0;
   }
 
@@ -60,6 +60,8 @@ public:
       helpFunc = ToolCook::Help;
     else if (toolName == "package" || toolName == "pack")
       helpFunc = ToolPackage::Help;
+    else if (toolName == "benchmark")
+      helpFunc = ToolBenchmark::Help;
     else if (toolName == "help")
       helpFunc = ToolHelp::Help;
     else {
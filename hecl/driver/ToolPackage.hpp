@@ -4,6 +4,7 @@
 #include <string>
 #include "ToolBase.hpp"
 #include <cstdio>
+#include "hecl/CookDatabase.hpp"
 
 class ToolPackage final : public ToolBase {
   std::vector<hecl::ProjectPath> m_selectedItems;
@@ -176,6 +177,7 @@ public:
           LogModule.report(logvisor::Error, FMT_STRING("Unable to package {}"), path.getAbsolutePath());
       }
       cp.waitUntilComplete();
+      m_useProj->getCookDatabase().flush();
     }
 
     return 0;
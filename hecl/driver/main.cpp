@@ -14,6 +14,7 @@
 #include <signal.h>
 #include <regex>
 #include <list>
+#include "hecl/CookDatabase.hpp"
 #include "hecl/Database.hpp"
 #include "hecl/Blender/Connection.hpp"
 #include "hecl/Runtime.hpp"
@@ -29,6 +30,7 @@ logvisor::Module LogModule("hecl::Driver");
 #include "ToolCook.hpp"
 #include "ToolPackage.hpp"
 #include "ToolImage.hpp"
+#include "ToolBenchmark.hpp"
 #include "ToolInstallAddon.hpp"
 #include "ToolHelp.hpp"
 
@@ -250,6 +252,10 @@ static std::unique_ptr<ToolBase> MakeSelectedTool(std::string toolName, ToolPass
   }
 #endif
 
+  if (toolNameLower == "benchmark") {
+    return std::make_unique<ToolBenchmark>(info);
+  }
+
   if (toolNameLower == "installaddon") {
     return std::make_unique<ToolInstallAddon>(info);
   }
@@ -308,6 +314,7 @@ int main(int argc, char** argv) {
   logvisor::RegisterStandardExceptions();
   logvisor::RegisterConsoleLogger();
   atSetExceptionHandler(AthenaExc);
+  hecl::Database::CookDatabase::SetToolVersion(METAFORCE_WC_DESCRIBE);
 
 #if SENTRY_ENABLED
   hecl::Runtime::FileStoreManager fileMgr{"sentry-native-hecl"};
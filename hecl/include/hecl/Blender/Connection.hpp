@@ -60,6 +60,7 @@ enum class ANIMCurveType { Rotate, Translate, Scale };
 
 class ANIMOutStream {
   Connection* m_parent;
+  std::vector<uint8_t> m_curveBuf;
   unsigned m_curCount = 0;
   unsigned m_totalCount = 0;
   bool m_inCurve = false;
@@ -729,6 +730,20 @@ class Connection {
 #endif
   std::array<int, 2> m_readpipe{};
   std::array<int, 2> m_writepipe{};
+  /* Blender sends framed output; bulk frames are placed in a shared-memory ring instead of the pipe */
+#if _WIN32
+  HANDLE m_shmHandle = nullptr;
+#else
+  int m_shmFd = -1;
+#endif
+  uint8_t* m_shmBase = nullptr;
+  std::size_t m_shmSize = 0;
+  std::vector<uint8_t> m_frameBuf;
+  const uint8_t* m_frameData = nullptr;
+  std::size_t m_frameLen = 0;
+  std::size_t m_framePos = 0;
+  uint64_t m_frameRingEnd = 0;
+  bool m_frameInRing = false;
   BlendType m_loadedType = BlendType::None;
   bool m_loadedRigged = false;
   ProjectPath m_loadedBlend;
@@ -737,6 +752,12 @@ class Connection {
   uint32_t _writeStr(const char* str, uint32_t len, int wpipe);
   uint32_t _writeStr(const char* str, uint32_t len) { return _writeStr(str, len, m_writepipe[1]); }
   uint32_t _writeStr(std::string_view view) { return _writeStr(view.data(), view.size()); }
+  std::string _openSharedRing();
+  void _closeSharedRing();
+  void _resetInput();
+  bool _nextFrame();
+  void _releaseFrame();
+  bool _readInput(void* buf, std::size_t len);
   std::size_t _readBuf(void* buf, std::size_t len);
   std::size_t _writeBuf(const void* buf, std::size_t len);
   std::string _readStdString() {
@@ -831,6 +852,14 @@ public:
   bool getRigged() const { return m_loadedRigged; }
   bool openBlend(const ProjectPath& path, bool force = false);
   bool saveBlend();
+
+  /** openBlend calls across all connections, split by whether the loaded scene could be reused */
+  struct OpenStats {
+    uint64_t reused = 0;
+    uint64_t loaded = 0;
+    double loadMs = 0.0;
+  };
+  static OpenStats GetOpenStats();
   void deleteBlend();
 
   PyOutStream beginPythonOut(bool deleteOnError = false) {
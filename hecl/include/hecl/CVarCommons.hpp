@@ -38,6 +38,9 @@ struct CVarCommons {
   CVar* m_debugOverlayShowInGameTime = nullptr;
   CVar* m_debugOverlayShowResourceStats = nullptr;
   CVar* m_debugOverlayShowRandomStats = nullptr;
+  CVar* m_debugOverlayShowAnimationStats = nullptr;
+  CVar* m_debugOverlayShowScriptStats = nullptr;
+  CVar* m_debugOverlayShowMemoryStats = nullptr;
   CVar* m_debugOverlayShowRoomTimer = nullptr;
   CVar* m_debugOverlayShowInput = nullptr;
   CVar* m_debugToolDrawAiPath = nullptr;
@@ -1,27 +1,32 @@
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
+#include <deque>
 #include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <unordered_map>
 
 #include "hecl/Blender/Token.hpp"
+#include "hecl/Database.hpp"
 #include "hecl/hecl.hpp"
 
 #include <boo/ThreadLocalPtr.hpp>
 
-namespace hecl::Database {
-class IDataSpec;
-}
-
 namespace hecl {
 class MultiProgressPrinter;
 
 extern int CpuCountOverride;
+/* Maximum number of Blender-backed transactions running at once; 0 allows one per worker */
+extern int BlenderCookLimit;
 void SetCpuCountOverride(int argc, char** argv);
+/* CpuCountOverride if set, otherwise the number of online processors */
+int GetCPUCount();
 
 class ClientProcess {
   std::mutex m_mutex;
@@ -37,6 +42,12 @@ public:
     ClientProcess& m_parent;
     enum class Type { Buffer, Cook, Lambda } m_type;
     bool m_complete = false;
+    /* Scheduling hints: transactions with the longest expected duration run first */
+    Database::Project::Cost m_cost = Database::Project::Cost::Light;
+    bool m_usesBlender = false;
+    double m_expectedMs = 0.0;
+    /* Blend the transaction opens, if known; routed to the worker that last loaded it */
+    std::string m_blendKey;
     virtual void run(blender::Token& btok) = 0;
     Transaction(ClientProcess& parent, Type tp) : m_parent(parent), m_type(tp) {}
   };
@@ -67,10 +78,19 @@ public:
   };
 
 private:
-  std::list<std::shared_ptr<Transaction>> m_pendingQueue;
   std::list<std::shared_ptr<Transaction>> m_completedQueue;
+  size_t m_pendingCount = 0;
   int m_inProgress = 0;
+  int m_blenderInProgress = 0;
+  int m_blenderLimit = 1;
   bool m_running = true;
+  std::chrono::steady_clock::time_point m_batchStart;
+  double m_batchBusyMs = 0.0;
+  uint64_t m_batchReusedOpens = 0;
+  uint64_t m_batchLoadedOpens = 0;
+  double m_batchLoadMs = 0.0;
+  /* Worker index each blend was last assigned to */
+  std::unordered_map<std::string, int> m_blendAffinity;
 
   struct Worker {
     ClientProcess& m_proc;
@@ -78,12 +98,19 @@ private:
     std::thread m_thr;
     blender::Token m_blendTok;
     bool m_didInit = false;
+    /* Sorted by descending expected duration; guarded by m_proc.m_mutex */
+    std::deque<std::shared_ptr<Transaction>> m_queue;
+    double m_queuedMs = 0.0;
+    std::string m_residentBlend;
     Worker(ClientProcess& proc, int idx);
     void proc();
   };
   std::vector<Worker> m_workers;
   static ThreadLocalPtr<ClientProcess::Worker> ThreadWorker;
 
+  void enqueue(std::shared_ptr<Transaction> trans);
+  std::shared_ptr<Transaction> takeTransaction(Worker& worker);
+
 public:
   ClientProcess(const MultiProgressPrinter* progPrinter = nullptr);
   ~ClientProcess() { shutdown(); }
@@ -96,7 +123,7 @@ public:
   void swapCompletedQueue(std::list<std::shared_ptr<Transaction>>& queue);
   void waitUntilComplete();
   void shutdown();
-  bool isBusy() const { return m_pendingQueue.size() || m_inProgress; }
+  bool isBusy() const { return m_pendingCount || m_inProgress; }
 
   static int GetThreadWorkerIdx() {
     Worker* w = ThreadWorker.get();
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "hecl/hecl.hpp"
+
+namespace hecl::Database {
+
+/**
+ * @brief Persistent record of the inputs behind each cooked object
+ *
+ * Entries are keyed by cooked path and hold the content hash of the source, the tool version that
+ * cooked it and the content hashes of every other source file the cook read. An object is recooked
+ * only when one of these differs, so checking out an older branch does not invalidate untouched
+ * assets the way modification times do. File hashes are cached against size and modtime, and the
+ * duration of each cook is kept to schedule the next one.
+ */
+class CookDatabase {
+public:
+  /**
+   * @brief Collects the source files read by the cook running on the constructing thread
+   */
+  class DependencyScope {
+    friend class CookDatabase;
+    DependencyScope* m_prev;
+    std::vector<std::string> m_deps;
+
+  public:
+    DependencyScope();
+    ~DependencyScope();
+    DependencyScope(const DependencyScope&) = delete;
+    DependencyScope& operator=(const DependencyScope&) = delete;
+  };
+
+private:
+  struct FileHash {
+    uint64_t size;
+    int64_t modtime;
+    uint64_t hash;
+  };
+  struct Dependency {
+    std::string path;
+    uint64_t hash;
+  };
+  struct Entry {
+    std::string toolVersion;
+    uint64_t inputHash;
+    std::vector<Dependency> deps;
+  };
+
+  ProjectPath m_dbPath;
+  ProjectPath m_reportPath;
+  std::mutex m_lock;
+  bool m_loaded = false;
+  bool m_dirty = false;
+  std::unordered_map<std::string, Entry> m_entries;
+  std::unordered_map<std::string, FileHash> m_fileHashes;
+  std::unordered_map<std::string, double> m_cookTimes;
+  std::vector<std::string> m_report;
+  size_t m_upToDate = 0;
+
+  static std::string s_toolVersion;
+
+  void load();
+  static std::string MakeTimingKey(const ProjectPath& path);
+  uint64_t hashFile(const ProjectPath& file);
+  uint64_t hashSource(const ProjectPath& path);
+  uint64_t hashDependency(const ProjectPath& root, const std::string& dep);
+  static uint64_t HashListing(const ProjectPath& dir);
+
+public:
+  explicit CookDatabase(const ProjectPath& cookedRoot);
+
+  /** Entries cooked by a different version are recooked */
+  static void SetToolVersion(std::string_view version);
+
+  /** Adds path to the dependencies of the cook running on this thread, if any */
+  static void RecordDependency(const ProjectPath& path);
+
+  /** Like RecordDependency, but only the names in dir (files and subdirectories) are tracked, not their contents */
+  static void RecordDirectoryListing(const ProjectPath& dir);
+
+  /** Removes a previous cook of cooked so a cook that bails out cannot leave it looking current */
+  static void DiscardOutput(const ProjectPath& cooked);
+
+  /**
+   * @brief Decide whether cooked must be rebuilt from path
+   * @return Empty if cooked is current, otherwise the reason it must be recooked
+   */
+  std::string checkCook(const ProjectPath& path, const ProjectPath& cooked, bool force);
+
+  /** Record a completed cook along with the dependencies collected by deps and its duration */
+  void recordCook(const ProjectPath& path, const ProjectPath& cooked, const DependencyScope& deps, double cookMs);
+
+  /** Duration of the last cook of path in milliseconds, or 0 if it has never been cooked */
+  double getCookTime(const ProjectPath& path);
+
+  /** Write the database and the recook report if anything changed */
+  void flush();
+};
+
+} // namespace hecl::Database
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hecl {
+
+/* Named measurements cookers report for `hecl benchmark`. Recording is a no-op until enabled, so cook
+ * stages can report unconditionally. */
+struct CookMetric {
+  std::string name;
+  double sum = 0.0;
+  size_t samples = 0;
+};
+
+void SetCookMetricsEnabled(bool enable);
+bool CookMetricsEnabled();
+void AddCookMetric(std::string_view name, double value);
+/* Returns metrics accumulated since the last call, in first-recorded order */
+std::vector<CookMetric> TakeCookMetrics();
+
+/* Records the wall time of a scope in milliseconds */
+class CookMetricTimer {
+  std::string_view m_name;
+  std::chrono::steady_clock::time_point m_start;
+  bool m_active;
+
+public:
+  explicit CookMetricTimer(std::string_view name)
+  : m_name(name), m_start(std::chrono::steady_clock::now()), m_active(CookMetricsEnabled()) {}
+  ~CookMetricTimer() {
+    if (m_active)
+      AddCookMetric(m_name,
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count());
+  }
+  CookMetricTimer(const CookMetricTimer&) = delete;
+  CookMetricTimer& operator=(const CookMetricTimer&) = delete;
+};
+
+} // namespace hecl
@@ -17,6 +17,7 @@ namespace hecl {
 class ClientProcess;
 
 namespace Database {
+class CookDatabase;
 class Project;
 
 extern logvisor::Module LogModule;
@@ -99,9 +100,12 @@ public:
                                                 const DataSpecEntry* oldEntry) const {
     return oldEntry;
   }
-  virtual void doCook([[maybe_unused]] const ProjectPath& path, [[maybe_unused]] const ProjectPath& cookedPath,
+  /* Returns false if the cook bailed out without writing cookedPath */
+  virtual bool doCook([[maybe_unused]] const ProjectPath& path, [[maybe_unused]] const ProjectPath& cookedPath,
                       [[maybe_unused]] bool fast, [[maybe_unused]] blender::Token& btok,
-                      [[maybe_unused]] FCookProgress progress) {}
+                      [[maybe_unused]] FCookProgress progress) {
+    return false;
+  }
 
   virtual bool canPackage([[maybe_unused]] const ProjectPath& path) {
     return false;
@@ -113,6 +117,24 @@ public:
 
   virtual void interruptCook() {}
 
+  /**
+   * @brief Texture round-trip timings for one native texture format
+   */
+  struct TextureBenchmark {
+    std::string format;
+    size_t textures = 0;
+    size_t nativeBytes = 0;
+    double encodeMs = 0.0;
+    double decodeMs = 0.0;
+  };
+
+  /* Encodes every working texture under root to the native format and decodes it back, averaging
+   * each over iterations; returns false if the spec has no texture pipeline */
+  virtual bool benchmarkTextures([[maybe_unused]] const ProjectPath& root, [[maybe_unused]] int iterations,
+                                 [[maybe_unused]] std::vector<TextureBenchmark>& out) {
+    return false;
+  }
+
   const DataSpecEntry* getDataSpecEntry() const { return m_specEntry; }
 };
 
@@ -238,10 +260,12 @@ private:
   std::unordered_map<uint64_t, ProjectPath> m_bridgePathCache;
   std::vector<std::unique_ptr<IDataSpec>> m_cookSpecs;
   std::unique_ptr<IDataSpec> m_lastPackageSpec;
+  std::unique_ptr<CookDatabase> m_cookDatabase;
   bool m_valid = false;
 
 public:
   Project(const ProjectRootPath& rootPath);
+  ~Project();
   explicit operator bool() const { return m_valid; }
 
   /**
@@ -271,7 +295,8 @@ public:
   /**
    * @brief A rough description of how 'expensive' a given cook operation is
    *
-   * This is used to provide pretty colors during the cook operation
+   * ClientProcess runs transactions with higher expected costs first when no cook timings
+   * have been recorded for them yet
    */
   enum class Cost { None, Light, Medium, Heavy };
 
@@ -428,6 +453,12 @@ public:
    */
   PackageDepsgraph buildPackageDepsgraph(const ProjectPath& path);
 
+  /**
+   * @brief Content-hash record of cooked objects, consulted before each cook
+   * @return Cook database stored in the cooked root
+   */
+  CookDatabase& getCookDatabase() { return *m_cookDatabase; }
+
   /** Add ProjectPath to bridge cache */
   void addBridgePathToCache(uint64_t id, const ProjectPath& path);
 
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace hecl {
+
+/* Counters for the shared helper pool, for benchmarking */
+struct ParallelForStats {
+  size_t jobs = 0;
+  size_t items = 0;
+  size_t helperItems = 0;
+};
+ParallelForStats GetParallelForStats();
+
+/* Disabling helpers runs every ParallelFor on its calling thread (serial baselines for benchmarks) */
+void SetParallelForHelpers(bool enable);
+
+/* Marks the calling thread as running CPU-bound work (ClientProcess transactions do this). The shared
+ * helper pool only lends threads while fewer than GetCPUCount() threads are busy, so fanned-out work
+ * fills cores left idle by the workers rather than oversubscribing them. */
+class ParallelBusyScope {
+  bool m_wasBusy;
+
+public:
+  ParallelBusyScope();
+  ~ParallelBusyScope();
+  ParallelBusyScope(const ParallelBusyScope&) = delete;
+  ParallelBusyScope& operator=(const ParallelBusyScope&) = delete;
+};
+
+void ParallelForImpl(size_t count, void (*func)(void*, size_t), void* ctx, void (*callerFunc)(void*) = nullptr,
+                     void* callerCtx = nullptr);
+
+/* Runs func(0..count-1) on the calling thread plus any idle threads of the shared helper pool, and
+ * returns once every index has run. Safe to nest; the caller always works through its own job. */
+template <typename Func>
+void ParallelFor(size_t count, Func&& func) {
+  if (count <= 1) {
+    if (count)
+      func(size_t(0));
+    return;
+  }
+  ParallelForImpl(
+      count, [](void* ctx, size_t i) { (*static_cast<std::remove_reference_t<Func>*>(ctx))(i); },
+      const_cast<void*>(static_cast<const void*>(&func)));
+}
+
+/* Like ParallelFor, but the calling thread first runs callerFunc (work that must stay on this thread)
+ * while helpers start on the indices, then joins them */
+template <typename CallerFunc, typename Func>
+void ParallelForAlongside(CallerFunc&& callerFunc, size_t count, Func&& func) {
+  if (!count) {
+    callerFunc();
+    return;
+  }
+  ParallelForImpl(
+      count, [](void* ctx, size_t i) { (*static_cast<std::remove_reference_t<Func>*>(ctx))(i); },
+      const_cast<void*>(static_cast<const void*>(&func)),
+      [](void* ctx) { (*static_cast<std::remove_reference_t<CallerFunc>*>(ctx))(); },
+      const_cast<void*>(static_cast<const void*>(&callerFunc)));
+}
+
+} // namespace hecl
@@ -16,6 +16,7 @@
 #include "hecl/Blender/Connection.hpp"
 #include "hecl/Blender/FindBlender.hpp"
 #include "hecl/Blender/Token.hpp"
+#include "hecl/CookDatabase.hpp"
 #include "hecl/Database.hpp"
 #include "hecl/hecl.hpp"
 #include "hecl/SteamFinder.hpp"
@@ -28,6 +29,8 @@
 #include <io.h>
 #include <fcntl.h>
 #else
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/wait.h>
 #endif
 
@@ -119,11 +122,170 @@ static std::size_t BoundedStrLen(const char* buf, std::size_t maxLen) {
   return ret;
 }
 
+static bool ReadFull(int fd, void* buf, std::size_t size) {
+  auto* cBuf = static_cast<uint8_t*>(buf);
+  while (size != 0) {
+    const int ret = Read(fd, cBuf, size);
+    if (ret <= 0)
+      return false;
+    cBuf += ret;
+    size -= ret;
+  }
+  return true;
+}
+
+/* Everything blender sends is framed; Ring payloads are found in the shared-memory ring at ringPos */
+struct FrameHeader {
+  uint32_t len;
+  uint32_t kind;
+  uint64_t ringPos;
+};
+static_assert(sizeof(FrameHeader) == 16, "Must match the 'IIQ' header packed by hecl_blendershell.py");
+
+enum class FrameKind : uint32_t { Inline, Ring };
+
+/* The ring starts with the consumed position, which blender waits on before reusing space */
+constexpr std::size_t RingHeaderSize = 64;
+constexpr std::size_t RingSize = 32 * 1024 * 1024;
+
+template <typename T>
+static void AppendValue(std::vector<uint8_t>& buf, const T& val) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(&val);
+  buf.insert(buf.end(), bytes, bytes + sizeof(T));
+}
+
+#ifndef _WIN32
+/* Reports launch failures from the forked child in the framing blender would use */
+static void WriteInlineStr(int fd, std::string_view str) {
+  const uint32_t strLen = uint32_t(str.size());
+  const FrameHeader header{uint32_t(sizeof(strLen) + strLen), uint32_t(FrameKind::Inline), 0};
+  Write(fd, &header, sizeof(header));
+  Write(fd, &strLen, sizeof(strLen));
+  Write(fd, str.data(), str.size());
+}
+#endif
+
+std::string Connection::_openSharedRing() {
+#if _WIN32
+  static std::atomic_uint RingCounter(0);
+  const std::string name = fmt::format(FMT_STRING("hecl_ring_{}_{}"), GetCurrentProcessId(), RingCounter++);
+  const nowide::wstackstring wname(name);
+  m_shmHandle = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, DWORD(RingSize), wname.get());
+  if (m_shmHandle != nullptr)
+    m_shmBase = static_cast<uint8_t*>(MapViewOfFile(m_shmHandle, FILE_MAP_ALL_ACCESS, 0, 0, RingSize));
+  std::string spec = name;
+#else
+#ifdef __linux__
+  m_shmFd = memfd_create("hecl_ring", 0);
+#else
+  static std::atomic_uint RingCounter(0);
+  const std::string name = fmt::format(FMT_STRING("/hecl_ring_{}_{}"), getpid(), RingCounter++);
+  m_shmFd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (m_shmFd >= 0)
+    shm_unlink(name.c_str());
+#endif
+  if (m_shmFd >= 0 && ftruncate(m_shmFd, RingSize) == 0) {
+    void* mapping = mmap(nullptr, RingSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_shmFd, 0);
+    if (mapping != MAP_FAILED)
+      m_shmBase = static_cast<uint8_t*>(mapping);
+  }
+  std::string spec = fmt::format(FMT_STRING("{}"), m_shmFd);
+#endif
+
+  if (m_shmBase == nullptr) {
+    BlenderLog.report(logvisor::Warning, FMT_STRING("Unable to map shared-memory ring; bulk data will use the pipe"));
+    _closeSharedRing();
+    return "NOSHM";
+  }
+  m_shmSize = RingSize;
+  return fmt::format(FMT_STRING("{}:{}"), spec, RingSize);
+}
+
+void Connection::_closeSharedRing() {
+#if _WIN32
+  if (m_shmBase != nullptr)
+    UnmapViewOfFile(m_shmBase);
+  if (m_shmHandle != nullptr)
+    CloseHandle(m_shmHandle);
+  m_shmHandle = nullptr;
+#else
+  if (m_shmBase != nullptr)
+    munmap(m_shmBase, RingSize);
+  if (m_shmFd >= 0)
+    close(m_shmFd);
+  m_shmFd = -1;
+#endif
+  m_shmBase = nullptr;
+  m_shmSize = 0;
+}
+
+void Connection::_resetInput() {
+  m_frameInRing = false;
+  _releaseFrame();
+  if (m_shmBase != nullptr)
+    *reinterpret_cast<volatile uint64_t*>(m_shmBase) = 0;
+}
+
+bool Connection::_nextFrame() {
+  FrameHeader header;
+  if (!ReadFull(m_readpipe[0], &header, sizeof(header)))
+    return false;
+
+  if (header.kind == uint32_t(FrameKind::Ring)) {
+    const std::size_t capacity = m_shmSize - RingHeaderSize;
+    if (m_shmBase == nullptr || header.ringPos % capacity + header.len > capacity) {
+      BlenderLog.report(logvisor::Error, FMT_STRING("Invalid ring frame [{}+{}]"), header.ringPos, header.len);
+      return false;
+    }
+    m_frameData = m_shmBase + RingHeaderSize + header.ringPos % capacity;
+    m_frameRingEnd = header.ringPos + header.len;
+    m_frameInRing = true;
+  } else {
+    m_frameBuf.resize(header.len);
+    if (!ReadFull(m_readpipe[0], m_frameBuf.data(), header.len))
+      return false;
+    m_frameData = m_frameBuf.data();
+  }
+
+  m_frameLen = header.len;
+  m_framePos = 0;
+  return true;
+}
+
+void Connection::_releaseFrame() {
+  if (m_frameInRing) {
+    /* Payload reads must complete before blender sees the space as free */
+    std::atomic_thread_fence(std::memory_order_release);
+    *reinterpret_cast<volatile uint64_t*>(m_shmBase) = m_frameRingEnd;
+    m_frameInRing = false;
+  }
+  m_frameData = nullptr;
+  m_frameLen = 0;
+  m_framePos = 0;
+}
+
+bool Connection::_readInput(void* buf, std::size_t len) {
+  auto* cBuf = static_cast<uint8_t*>(buf);
+  while (len != 0) {
+    if (m_framePos == m_frameLen && !_nextFrame())
+      return false;
+
+    const std::size_t copyLen = std::min(len, m_frameLen - m_framePos);
+    std::memcpy(cBuf, m_frameData + m_framePos, copyLen);
+    m_framePos += copyLen;
+    cBuf += copyLen;
+    len -= copyLen;
+
+    if (m_framePos == m_frameLen)
+      _releaseFrame();
+  }
+  return true;
+}
+
 uint32_t Connection::_readStr(char* buf, uint32_t bufSz) {
   uint32_t readLen;
-  int ret = Read(m_readpipe[0], &readLen, sizeof(readLen));
-  if (ret < 4) {
-    BlenderLog.report(logvisor::Error, FMT_STRING("Pipe error {} {}"), ret, strerror(errno));
+  if (!_readInput(&readLen, sizeof(readLen))) {
+    BlenderLog.report(logvisor::Error, FMT_STRING("Pipe error {}"), strerror(errno));
     _blenderDied();
     return 0;
   }
@@ -134,8 +296,7 @@ uint32_t Connection::_readStr(char* buf, uint32_t bufSz) {
     return 0;
   }
 
-  ret = Read(m_readpipe[0], buf, readLen);
-  if (ret < 0) {
+  if (!_readInput(buf, readLen)) {
     BlenderLog.report(logvisor::Fatal, FMT_STRING("{}"), strerror(errno));
     return 0;
   }
@@ -173,34 +334,20 @@ uint32_t Connection::_writeStr(const char* buf, uint32_t len, int wpipe) {
 }
 
 std::size_t Connection::_readBuf(void* buf, std::size_t len) {
-  const auto error = [this] {
+  if (!_readInput(buf, len)) {
     _blenderDied();
-    return 0U;
-  };
-
-  auto* cBuf = static_cast<uint8_t*>(buf);
-  std::size_t readLen = 0;
-
-  do {
-    const int ret = Read(m_readpipe[0], cBuf, len);
-    if (ret < 0) {
-      return error();
-    }
+    return 0;
+  }
 
-    constexpr std::string_view exception_str{"EXCEPTION"};
-    const std::size_t readStrLen = BoundedStrLen(static_cast<char*>(buf), len);
-    if (readStrLen >= exception_str.size()) {
-      if (exception_str.compare(0, exception_str.size(), std::string_view(static_cast<char*>(buf), readStrLen)) == 0) {
-        _blenderDied();
-      }
+  constexpr std::string_view exception_str{"EXCEPTION"};
+  const std::size_t readStrLen = BoundedStrLen(static_cast<char*>(buf), len);
+  if (readStrLen >= exception_str.size()) {
+    if (exception_str.compare(0, exception_str.size(), std::string_view(static_cast<char*>(buf), readStrLen)) == 0) {
+      _blenderDied();
     }
+  }
 
-    readLen += ret;
-    cBuf += ret;
-    len -= ret;
-  } while (len != 0);
-
-  return readLen;
+  return len;
 }
 
 std::size_t Connection::_writeBuf(const void* buf, std::size_t len) {
@@ -301,6 +448,8 @@ Connection::Connection(int verbosityLevel) {
     InstallAddon(blenderAddonPath.c_str());
   }
 
+  const std::string ringSpec = _openSharedRing();
+
   int installAttempt = 0;
   while (true) {
     /* Construct communication pipes */
@@ -333,6 +482,7 @@ Connection::Connection(int verbosityLevel) {
     pipe(m_readpipe.data());
     pipe(m_writepipe.data());
 #endif
+    _resetInput();
 
     int blenderMajor = 0;
     int blenderMinor = 0;
@@ -342,8 +492,9 @@ Connection::Connection(int verbosityLevel) {
     }
 
 #if _WIN32
-    std::string cmdLine = fmt::format(FMT_STRING(" --background -P \"{}\" -- {} {} {} \"{}\""), blenderShellPath,
-                                      uintptr_t(writehandle), uintptr_t(readhandle), verbosityLevel, blenderAddonPath);
+    std::string cmdLine =
+        fmt::format(FMT_STRING(" --background -P \"{}\" -- {} {} {} \"{}\" {}"), blenderShellPath,
+                    uintptr_t(writehandle), uintptr_t(readhandle), verbosityLevel, blenderAddonPath, ringSpec);
 
     STARTUPINFO sinfo = {sizeof(STARTUPINFO)};
     HANDLE nulHandle = CreateFileW(L"nul", GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, &sattrs, OPEN_EXISTING,
@@ -407,12 +558,14 @@ Connection::Connection(int verbosityLevel) {
     pid_t pid = fork();
     if (!pid) {
       /* Close all file descriptors besides those this blender instance uses */
-      int upper_fd = std::max(m_writepipe[0], m_readpipe[1]);
+      int upper_fd = std::max({m_writepipe[0], m_readpipe[1], m_shmFd});
       for (int i = 3; i < upper_fd; ++i) {
-        if (i != m_writepipe[0] && i != m_readpipe[1])
+        if (i != m_writepipe[0] && i != m_readpipe[1] && i != m_shmFd)
           close(i);
       }
       closefrom(upper_fd + 1);
+      if (m_shmFd >= 0)
+        fcntl(m_shmFd, F_SETFD, 0);
 
       if (verbosityLevel == 0) {
         int devNull = open("/dev/null", O_WRONLY);
@@ -428,16 +581,16 @@ Connection::Connection(int verbosityLevel) {
 
       if (blenderBin) {
         execlp(blenderBin->c_str(), blenderBin->c_str(), "--background", "-P", blenderShellPath.c_str(), "--",
-               readfds.c_str(), writefds.c_str(), vLevel.c_str(), blenderAddonPath.c_str(), nullptr);
+               readfds.c_str(), writefds.c_str(), vLevel.c_str(), blenderAddonPath.c_str(), ringSpec.c_str(), nullptr);
         if (errno != ENOENT) {
           errbuf = fmt::format(FMT_STRING("NOLAUNCH {}"), strerror(errno));
-          _writeStr(errbuf.c_str(), errbuf.size(), m_readpipe[1]);
+          WriteInlineStr(m_readpipe[1], errbuf);
           exit(1);
         }
       }
 
       /* Unable to find blender */
-      _writeStr("NOBLENDER", 9, m_readpipe[1]);
+      WriteInlineStr(m_readpipe[1], "NOBLENDER"sv);
       exit(1);
     }
     close(m_writepipe[0]);
@@ -501,7 +654,10 @@ Connection::Connection(int verbosityLevel) {
 #endif
 }
 
-Connection::~Connection() { _closePipe(); }
+Connection::~Connection() {
+  _closePipe();
+  _closeSharedRing();
+}
 
 void Vector2f::read(Connection& conn) { conn._readBuf(&val, 8); }
 void Vector3f::read(Connection& conn) { conn._readBuf(&val, 12); }
@@ -583,16 +739,35 @@ bool Connection::createBlend(const ProjectPath& path, BlendType type) {
   return false;
 }
 
+static std::mutex OpenStatsLock;
+static Connection::OpenStats OpenStatsTotal;
+
+Connection::OpenStats Connection::GetOpenStats() {
+  std::lock_guard lk{OpenStatsLock};
+  return OpenStatsTotal;
+}
+
 bool Connection::openBlend(const ProjectPath& path, bool force) {
   if (m_lock) {
     BlenderLog.report(logvisor::Fatal,
                       FMT_STRING("BlenderConnection::openBlend() musn't be called with stream active"));
     return false;
   }
-  if (!force && path == m_loadedBlend)
+  Database::CookDatabase::RecordDependency(path);
+  if (!force && path == m_loadedBlend) {
+    std::lock_guard lk{OpenStatsLock};
+    ++OpenStatsTotal.reused;
     return true;
+  }
+  const auto start = std::chrono::steady_clock::now();
   _writeStr(fmt::format(FMT_STRING("OPEN \"{}\""), path.getAbsolutePath()));
   if (_isFinished()) {
+    {
+      std::lock_guard lk{OpenStatsLock};
+      ++OpenStatsTotal.loaded;
+      OpenStatsTotal.loadMs +=
+          std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
     m_loadedBlend = path;
     _writeStr("GETTYPE");
     std::string typeStr = _readStdString();
@@ -790,8 +965,8 @@ ANIMOutStream::ANIMOutStream(Connection* parent) : m_parent(parent) {
 }
 
 ANIMOutStream::~ANIMOutStream() {
-  char tp = -1;
-  m_parent->_writeBuf(&tp, 1);
+  AppendValue(m_curveBuf, int8_t(-1));
+  m_parent->_writeBuf(m_curveBuf.data(), m_curveBuf.size());
   m_parent->_checkAnimDone("unable to close ANIMOutStream"sv);
 }
 
@@ -800,13 +975,9 @@ void ANIMOutStream::changeCurve(CurveType type, unsigned crvIdx, unsigned keyCou
     BlenderLog.report(logvisor::Fatal, FMT_STRING("incomplete ANIMOutStream for change"));
   m_curCount = 0;
   m_totalCount = keyCount;
-  char tp = char(type);
-  m_parent->_writeBuf(&tp, 1);
-  struct {
-    uint32_t ci;
-    uint32_t kc;
-  } info = {uint32_t(crvIdx), uint32_t(keyCount)};
-  m_parent->_writeBuf(reinterpret_cast<const char*>(&info), 8);
+  AppendValue(m_curveBuf, int8_t(type));
+  AppendValue(m_curveBuf, uint32_t(crvIdx));
+  AppendValue(m_curveBuf, uint32_t(keyCount));
   m_inCurve = true;
 }
 
@@ -814,12 +985,13 @@ void ANIMOutStream::write(unsigned frame, float val) {
   if (!m_inCurve)
     BlenderLog.report(logvisor::Fatal, FMT_STRING("changeCurve not called before write"));
   if (m_curCount < m_totalCount) {
-    struct {
-      uint32_t frm;
-      float val;
-    } key = {uint32_t(frame), val};
-    m_parent->_writeBuf(reinterpret_cast<const char*>(&key), 8);
-    ++m_curCount;
+    AppendValue(m_curveBuf, uint32_t(frame));
+    AppendValue(m_curveBuf, val);
+    /* Each curve goes out in a single write */
+    if (++m_curCount == m_totalCount) {
+      m_parent->_writeBuf(m_curveBuf.data(), m_curveBuf.size());
+      m_curveBuf.clear();
+    }
   } else
     BlenderLog.report(logvisor::Fatal, FMT_STRING("ANIMOutStream keyCount overflow"));
 }
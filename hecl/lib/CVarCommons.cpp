@@ -59,6 +59,15 @@ CVarCommons::CVarCommons(CVarManager& manager) : m_mgr(manager) {
   m_debugOverlayShowRandomStats = m_mgr.findOrMakeCVar(
       "debugOverlay.showRandomStats", "Displays the current number of random calls per frame"sv, false,
       hecl::CVar::EFlags::Game | hecl::CVar::EFlags::Archive | hecl::CVar::EFlags::ReadOnly);
+  m_debugOverlayShowAnimationStats = m_mgr.findOrMakeCVar(
+      "debugOverlay.showAnimationStats"sv, "Displays the per-frame animation pose cache hit/miss counts"sv, false,
+      hecl::CVar::EFlags::Game | hecl::CVar::EFlags::Archive | hecl::CVar::EFlags::ReadOnly);
+  m_debugOverlayShowScriptStats = m_mgr.findOrMakeCVar(
+      "debugOverlay.showScriptStats"sv, "Displays the per-frame script message counts and costs by message type"sv,
+      false, hecl::CVar::EFlags::Game | hecl::CVar::EFlags::Archive | hecl::CVar::EFlags::ReadOnly);
+  m_debugOverlayShowMemoryStats = m_mgr.findOrMakeCVar(
+      "debugOverlay.showMemoryStats"sv, "Displays live and peak memory per subsystem and for the current area"sv,
+      false, hecl::CVar::EFlags::Game | hecl::CVar::EFlags::Archive | hecl::CVar::EFlags::ReadOnly);
   m_debugOverlayShowInput =
       m_mgr.findOrMakeCVar("debugOverlay.showInput"sv, "Displays user input"sv, false,
                            hecl::CVar::EFlags::Game | hecl::CVar::EFlags::Archive | hecl::CVar::EFlags::ReadOnly);
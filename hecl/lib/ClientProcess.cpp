@@ -1,10 +1,13 @@
 #include "hecl/ClientProcess.hpp"
 
 #include <algorithm>
+#include <chrono>
 
 #include "hecl/Blender/Connection.hpp"
+#include "hecl/CookDatabase.hpp"
 #include "hecl/Database.hpp"
 #include "hecl/MultiProgressPrinter.hpp"
+#include "hecl/ParallelFor.hpp"
 
 #include <athena/FileReader.hpp>
 #include <boo/IApplication.hpp>
@@ -25,6 +28,7 @@ static logvisor::Module CP_Log("hecl::ClientProcess");
 ThreadLocalPtr<ClientProcess::Worker> ClientProcess::ThreadWorker;
 
 int CpuCountOverride = 0;
+int BlenderCookLimit = 0;
 
 void SetCpuCountOverride(int argc, char** argv) {
   bool threadArg = false;
@@ -45,7 +49,7 @@ void SetCpuCountOverride(int argc, char** argv) {
   }
 }
 
-static int GetCPUCount() {
+int GetCPUCount() {
   if (CpuCountOverride > 0) {
     return CpuCountOverride;
   }
@@ -74,6 +78,34 @@ void ClientProcess::BufferTransaction::run(blender::Token& btok) {
   m_complete = true;
 }
 
+/* Fallback durations until a cook has been timed */
+static double DefaultExpectedMs(Database::Project::Cost cost) {
+  switch (cost) {
+  case Database::Project::Cost::None:
+    return 0.0;
+  case Database::Project::Cost::Light:
+    return 50.0;
+  case Database::Project::Cost::Medium:
+    return 500.0;
+  case Database::Project::Cost::Heavy:
+  default:
+    return 5000.0;
+  }
+}
+
+static Database::Project::Cost EstimateCookCost(const ProjectPath& path, bool& usesBlender, std::string& blendKey) {
+  const ProjectPath asBlend =
+      path.getPathType() == ProjectPath::Type::Glob ? path.getWithExtension(".blend", true) : path;
+  usesBlender = hecl::IsPathBlend(asBlend);
+  if (usesBlender) {
+    blendKey = asBlend.getRelativePath();
+    return Database::Project::Cost::Heavy;
+  }
+  if (hecl::IsPathPNG(path))
+    return Database::Project::Cost::Medium;
+  return Database::Project::Cost::Light;
+}
+
 void ClientProcess::CookTransaction::run(blender::Token& btok) {
   m_dataSpec->setThreadProject();
   m_returnResult = m_parent.syncCook(m_path, m_dataSpec, btok, m_force, m_fast);
@@ -104,13 +136,27 @@ void ClientProcess::Worker::proc() {
       m_proc.m_initCv.notify_one();
       m_didInit = true;
     }
-    while (m_proc.m_running && m_proc.m_pendingQueue.size()) {
-      std::shared_ptr<Transaction> trans = std::move(m_proc.m_pendingQueue.front());
+    while (m_proc.m_running) {
+      std::shared_ptr<Transaction> trans = m_proc.takeTransaction(*this);
+      if (!trans)
+        break;
       ++m_proc.m_inProgress;
-      m_proc.m_pendingQueue.pop_front();
+      if (trans->m_usesBlender)
+        ++m_proc.m_blenderInProgress;
       lk.unlock();
-      trans->run(m_blendTok);
+      const auto start = std::chrono::steady_clock::now();
+      {
+        ParallelBusyScope busy;
+        trans->run(m_blendTok);
+      }
+      const double runMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
       lk.lock();
+      m_proc.m_batchBusyMs += runMs;
+      if (trans->m_usesBlender) {
+        --m_proc.m_blenderInProgress;
+        /* Workers may be idling on the Blender limit */
+        m_proc.m_cv.notify_all();
+      }
       m_proc.m_completedQueue.push_back(std::move(trans));
       --m_proc.m_inProgress;
     }
@@ -123,12 +169,104 @@ void ClientProcess::Worker::proc() {
   m_blendTok.shutdown();
 }
 
+void ClientProcess::enqueue(std::shared_ptr<Transaction> trans) {
+  if (!isBusy()) {
+    m_batchStart = std::chrono::steady_clock::now();
+    m_batchBusyMs = 0.0;
+    const blender::Connection::OpenStats openStats = blender::Connection::GetOpenStats();
+    m_batchReusedOpens = openStats.reused;
+    m_batchLoadedOpens = openStats.loaded;
+    m_batchLoadMs = openStats.loadMs;
+  }
+
+  /* Nested transactions stay with the submitting worker, blends go where they were last loaded and
+   * others go to the least-loaded queue */
+  Worker* target = ThreadWorker.get();
+  if (target == nullptr || &target->m_proc != this) {
+    target = nullptr;
+    if (!trans->m_blendKey.empty()) {
+      const auto search = m_blendAffinity.find(trans->m_blendKey);
+      if (search != m_blendAffinity.cend())
+        target = &m_workers[search->second];
+    }
+    if (target == nullptr) {
+      target = &m_workers.front();
+      for (Worker& worker : m_workers)
+        if (worker.m_queuedMs < target->m_queuedMs)
+          target = &worker;
+    }
+  }
+  if (!trans->m_blendKey.empty())
+    m_blendAffinity[trans->m_blendKey] = target->m_idx;
+
+  const auto pos = std::find_if(target->m_queue.cbegin(), target->m_queue.cend(),
+                                [&](const auto& other) { return other->m_expectedMs < trans->m_expectedMs; });
+  target->m_queuedMs += trans->m_expectedMs;
+  target->m_queue.insert(pos, std::move(trans));
+  ++m_pendingCount;
+  m_cv.notify_all();
+}
+
+std::shared_ptr<ClientProcess::Transaction> ClientProcess::takeTransaction(Worker& worker) {
+  const bool blenderFull = m_blenderInProgress >= m_blenderLimit;
+  const auto take = [&](Worker& victim, std::deque<std::shared_ptr<Transaction>>::iterator it) {
+    std::shared_ptr<Transaction> trans = std::move(*it);
+    victim.m_queue.erase(it);
+    victim.m_queuedMs = victim.m_queue.empty() ? 0.0 : victim.m_queuedMs - trans->m_expectedMs;
+    --m_pendingCount;
+    if (!trans->m_blendKey.empty()) {
+      m_blendAffinity[trans->m_blendKey] = worker.m_idx;
+      worker.m_residentBlend = trans->m_blendKey;
+    }
+    return trans;
+  };
+  const auto takeFrom = [&](Worker& victim, bool keepAffine) -> std::shared_ptr<Transaction> {
+    for (auto it = victim.m_queue.begin(); it != victim.m_queue.end(); ++it) {
+      if (blenderFull && (*it)->m_usesBlender)
+        continue;
+      if (keepAffine && !(*it)->m_blendKey.empty()) {
+        const auto search = m_blendAffinity.find((*it)->m_blendKey);
+        if (search != m_blendAffinity.cend() && search->second == victim.m_idx)
+          continue;
+      }
+      return take(victim, it);
+    }
+    return {};
+  };
+
+  /* Reuse the scene already loaded in this worker's Blender before anything else */
+  if (!blenderFull && !worker.m_residentBlend.empty()) {
+    const auto it = std::find_if(worker.m_queue.begin(), worker.m_queue.end(),
+                                 [&](const auto& trans) { return trans->m_blendKey == worker.m_residentBlend; });
+    if (it != worker.m_queue.end())
+      return take(worker, it);
+  }
+  if (auto trans = takeFrom(worker, false))
+    return trans;
+
+  /* Steal the longest runnable transaction, preferring the most loaded queues and work that
+   * does not pull a blend away from the worker that has it loaded */
+  std::vector<Worker*> victims;
+  victims.reserve(m_workers.size());
+  for (Worker& other : m_workers)
+    if (&other != &worker && !other.m_queue.empty())
+      victims.push_back(&other);
+  std::sort(victims.begin(), victims.end(),
+            [](const Worker* a, const Worker* b) { return a->m_queuedMs > b->m_queuedMs; });
+  for (const bool keepAffine : {true, false})
+    for (Worker* victim : victims)
+      if (auto trans = takeFrom(*victim, keepAffine))
+        return trans;
+  return {};
+}
+
 ClientProcess::ClientProcess(const MultiProgressPrinter* progPrinter) : m_progPrinter(progPrinter) {
 #if HECL_MULTIPROCESSOR
   const int cpuCount = GetCPUCount();
 #else
   constexpr int cpuCount = 1;
 #endif
+  m_blenderLimit = BlenderCookLimit > 0 ? std::min(BlenderCookLimit, cpuCount) : cpuCount;
   m_workers.reserve(cpuCount);
   for (int i = 0; i < cpuCount; ++i) {
     std::unique_lock lk{m_mutex};
@@ -142,18 +280,21 @@ std::shared_ptr<const ClientProcess::BufferTransaction> ClientProcess::addBuffer
                                                                                             size_t offset) {
   std::unique_lock lk{m_mutex};
   auto ret = std::make_shared<BufferTransaction>(*this, path, target, maxLen, offset);
-  m_pendingQueue.emplace_back(ret);
-  m_cv.notify_one();
+  ret->m_expectedMs = DefaultExpectedMs(ret->m_cost);
+  enqueue(ret);
   return ret;
 }
 
 std::shared_ptr<const ClientProcess::CookTransaction> ClientProcess::addCookTransaction(const hecl::ProjectPath& path,
                                                                                         bool force, bool fast,
                                                                                         Database::IDataSpec* spec) {
-  std::unique_lock lk{m_mutex};
   auto ret = std::make_shared<CookTransaction>(*this, path, force, fast, spec);
-  m_pendingQueue.emplace_back(ret);
-  m_cv.notify_one();
+  ret->m_cost = EstimateCookCost(path, ret->m_usesBlender, ret->m_blendKey);
+  ret->m_expectedMs = path.getProject().getCookDatabase().getCookTime(path);
+  if (ret->m_expectedMs <= 0.0)
+    ret->m_expectedMs = DefaultExpectedMs(ret->m_cost);
+  std::unique_lock lk{m_mutex};
+  enqueue(ret);
   ++m_addedCooks;
   m_progPrinter->setMainFactor(m_completedCooks / float(m_addedCooks));
   return ret;
@@ -163,8 +304,11 @@ std::shared_ptr<const ClientProcess::LambdaTransaction>
 ClientProcess::addLambdaTransaction(std::function<void(blender::Token&)>&& func) {
   std::unique_lock lk{m_mutex};
   auto ret = std::make_shared<LambdaTransaction>(*this, std::move(func));
-  m_pendingQueue.emplace_back(ret);
-  m_cv.notify_one();
+  /* Lambdas are handed a Blender token and may be arbitrarily long */
+  ret->m_cost = Database::Project::Cost::Heavy;
+  ret->m_usesBlender = true;
+  ret->m_expectedMs = DefaultExpectedMs(ret->m_cost);
+  enqueue(ret);
   return ret;
 }
 
@@ -177,22 +321,31 @@ bool ClientProcess::syncCook(const hecl::ProjectPath& path, Database::IDataSpec*
       if (fast)
         cooked = cooked.getWithExtension(".fast");
       cooked.makeDirChain(false);
-      if (force || cooked.getPathType() == ProjectPath::Type::None || path.getModtime() > cooked.getModtime()) {
+      Database::CookDatabase& cookDb = path.getProject().getCookDatabase();
+      const std::string reason = cookDb.checkCook(path, cooked, force);
+      if (!reason.empty()) {
         if (m_progPrinter) {
           std::string str;
           if (path.getAuxInfo().empty())
-            str = fmt::format(FMT_STRING("Cooking {}"), path.getRelativePath());
+            str = fmt::format(FMT_STRING("Cooking {} ({})"), path.getRelativePath(), reason);
           else
-            str = fmt::format(FMT_STRING("Cooking {}|{}"), path.getRelativePath(), path.getAuxInfo());
+            str = fmt::format(FMT_STRING("Cooking {}|{} ({})"), path.getRelativePath(), path.getAuxInfo(), reason);
           m_progPrinter->print(str, std::nullopt, -1.f, hecl::ClientProcess::GetThreadWorkerIdx());
           m_progPrinter->flush();
         } else {
           if (path.getAuxInfo().empty())
-            LogModule.report(logvisor::Info, FMT_STRING("Cooking {}"), path.getRelativePath());
+            LogModule.report(logvisor::Info, FMT_STRING("Cooking {} ({})"), path.getRelativePath(), reason);
           else
-            LogModule.report(logvisor::Info, FMT_STRING("Cooking {}|{}"), path.getRelativePath(), path.getAuxInfo());
+            LogModule.report(logvisor::Info, FMT_STRING("Cooking {}|{} ({})"), path.getRelativePath(),
+                             path.getAuxInfo(), reason);
         }
-        spec->doCook(path, cooked, false, btok, [](const char*) {});
+        Database::CookDatabase::DependencyScope deps;
+        Database::CookDatabase::DiscardOutput(cooked);
+        const auto start = std::chrono::steady_clock::now();
+        if (spec->doCook(path, cooked, false, btok, [](const char*) {}))
+          cookDb.recordCook(
+              path, cooked, deps,
+              std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
         if (m_progPrinter) {
           std::string str;
           if (path.getAuxInfo().empty())
@@ -216,15 +369,38 @@ void ClientProcess::swapCompletedQueue(std::list<std::shared_ptr<Transaction>>&
 
 void ClientProcess::waitUntilComplete() {
   std::unique_lock lk{m_mutex};
+  if (!isBusy())
+    return;
   while (isBusy())
     m_waitCv.wait(lk);
+  const double wallMs =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_batchStart).count();
+  if (wallMs > 0.0)
+    CP_Log.report(logvisor::Info, FMT_STRING("{} cooks finished in {:.1f} s wall clock; {} workers {:.0f}% busy"),
+                  m_completedCooks, wallMs / 1000.0, m_workers.size(),
+                  100.0 * m_batchBusyMs / (wallMs * double(m_workers.size())));
+
+  const blender::Connection::OpenStats openStats = blender::Connection::GetOpenStats();
+  const uint64_t reused = openStats.reused - m_batchReusedOpens;
+  const uint64_t loaded = openStats.loaded - m_batchLoadedOpens;
+  const double loadMs = openStats.loadMs - m_batchLoadMs;
+  if (reused + loaded != 0)
+    CP_Log.report(logvisor::Info,
+                  FMT_STRING("Blender reused a loaded scene for {} of {} opens ({:.0f}%), saving ~{:.1f} s"), reused,
+                  reused + loaded, 100.0 * double(reused) / double(reused + loaded),
+                  loaded != 0 ? double(reused) * loadMs / double(loaded) / 1000.0 : 0.0);
 }
 
 void ClientProcess::shutdown() {
   if (!m_running)
     return;
   std::unique_lock lk{m_mutex};
-  m_pendingQueue.clear();
+  for (Worker& worker : m_workers) {
+    worker.m_queue.clear();
+    worker.m_queuedMs = 0.0;
+  }
+  m_blendAffinity.clear();
+  m_pendingCount = 0;
   m_running = false;
   m_cv.notify_all();
   lk.unlock();
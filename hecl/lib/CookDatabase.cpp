@@ -0,0 +1,339 @@
+#include "hecl/CookDatabase.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#include "hecl/Database.hpp"
+
+#include <fmt/format.h>
+#include <logvisor/logvisor.hpp>
+
+namespace hecl::Database {
+namespace {
+logvisor::Module Log("hecl::CookDatabase");
+
+constexpr uint32_t CookDatabaseVersion = 2;
+constexpr size_t HashChunkSize = 65536;
+
+thread_local CookDatabase::DependencyScope* CurrentScope = nullptr;
+
+/* Splits off the next space-delimited field; the final field of a line may contain spaces */
+std::string_view NextField(std::string_view& line) {
+  const size_t pos = line.find(' ');
+  const std::string_view field = line.substr(0, pos);
+  line = pos == std::string_view::npos ? std::string_view{} : line.substr(pos + 1);
+  return field;
+}
+
+uint64_t ParseHex(std::string_view str) { return std::strtoull(std::string(str).c_str(), nullptr, 16); }
+uint64_t ParseDec(std::string_view str) { return std::strtoull(std::string(str).c_str(), nullptr, 10); }
+} // Anonymous namespace
+
+std::string CookDatabase::s_toolVersion = "unversioned";
+
+CookDatabase::DependencyScope::DependencyScope() : m_prev(CurrentScope) { CurrentScope = this; }
+
+CookDatabase::DependencyScope::~DependencyScope() { CurrentScope = m_prev; }
+
+CookDatabase::CookDatabase(const ProjectPath& cookedRoot)
+: m_dbPath(cookedRoot, "cookdb"), m_reportPath(cookedRoot, "cook-report.txt") {}
+
+void CookDatabase::SetToolVersion(std::string_view version) {
+  s_toolVersion = version.empty() ? "unversioned" : version;
+  std::replace(s_toolVersion.begin(), s_toolVersion.end(), ' ', '_');
+}
+
+void CookDatabase::RecordDependency(const ProjectPath& path) {
+  if (CurrentScope == nullptr)
+    return;
+  std::string relPath(path.getRelativePath());
+  if (std::find(CurrentScope->m_deps.cbegin(), CurrentScope->m_deps.cend(), relPath) == CurrentScope->m_deps.cend())
+    CurrentScope->m_deps.push_back(std::move(relPath));
+}
+
+void CookDatabase::RecordDirectoryListing(const ProjectPath& dir) {
+  if (CurrentScope == nullptr)
+    return;
+  /* The trailing separator marks a listing dependency in the database */
+  std::string relPath = fmt::format(FMT_STRING("{}/"), dir.getRelativePath());
+  if (std::find(CurrentScope->m_deps.cbegin(), CurrentScope->m_deps.cend(), relPath) == CurrentScope->m_deps.cend())
+    CurrentScope->m_deps.push_back(std::move(relPath));
+}
+
+void CookDatabase::DiscardOutput(const ProjectPath& cooked) {
+  if (cooked.getPathType() == ProjectPath::Type::File)
+    hecl::Unlink(cooked.getAbsolutePath().data());
+}
+
+void CookDatabase::load() {
+  if (m_loaded)
+    return;
+  m_loaded = true;
+
+  std::string data;
+  {
+    const auto fp = hecl::FopenUnique(m_dbPath.getAbsolutePath().data(), "rb");
+    if (!fp)
+      return;
+    char buf[4096];
+    size_t rd;
+    while ((rd = std::fread(buf, 1, sizeof(buf), fp.get())) > 0)
+      data.append(buf, rd);
+  }
+
+  std::string_view remaining(data);
+  Entry* curEntry = nullptr;
+  bool first = true;
+  while (!remaining.empty()) {
+    const size_t eol = remaining.find('\n');
+    std::string_view line = remaining.substr(0, eol);
+    remaining = eol == std::string_view::npos ? std::string_view{} : remaining.substr(eol + 1);
+
+    if (first) {
+      first = false;
+      if (line != fmt::format(FMT_STRING("HECLCOOKDB {}"), CookDatabaseVersion)) {
+        Log.report(logvisor::Info, FMT_STRING("discarding incompatible cook database {}"), m_dbPath.getRelativePath());
+        return;
+      }
+      continue;
+    }
+
+    const std::string_view tag = NextField(line);
+    if (tag == "F") {
+      FileHash fh;
+      fh.hash = ParseHex(NextField(line));
+      fh.size = ParseDec(NextField(line));
+      fh.modtime = int64_t(ParseDec(NextField(line)));
+      m_fileHashes[std::string(line)] = fh;
+    } else if (tag == "E") {
+      Entry entry;
+      entry.inputHash = ParseHex(NextField(line));
+      entry.toolVersion = NextField(line);
+      curEntry = &(m_entries[std::string(line)] = std::move(entry));
+    } else if (tag == "T") {
+      const double cookMs = std::strtod(std::string(NextField(line)).c_str(), nullptr);
+      m_cookTimes[std::string(line)] = cookMs;
+    } else if (tag == "D" && curEntry != nullptr) {
+      const uint64_t hash = ParseHex(NextField(line));
+      curEntry->deps.push_back({std::string(line), hash});
+    }
+  }
+}
+
+std::string CookDatabase::MakeTimingKey(const ProjectPath& path) {
+  if (path.getAuxInfo().empty())
+    return std::string(path.getRelativePath());
+  return fmt::format(FMT_STRING("{}|{}"), path.getRelativePath(), path.getAuxInfo());
+}
+
+uint64_t CookDatabase::hashFile(const ProjectPath& file) {
+  Sstat theStat;
+  if (hecl::Stat(file.getAbsolutePath().data(), &theStat) || !S_ISREG(theStat.st_mode))
+    return 0;
+
+  std::string relPath(file.getRelativePath());
+  {
+    std::lock_guard lk{m_lock};
+    load();
+    const auto search = m_fileHashes.find(relPath);
+    if (search != m_fileHashes.cend() && search->second.size == uint64_t(theStat.st_size) &&
+        search->second.modtime == int64_t(theStat.st_mtime))
+      return search->second.hash;
+  }
+
+  const auto fp = hecl::FopenUnique(file.getAbsolutePath().data(), "rb");
+  if (!fp)
+    return 0;
+  XXH64_state_t state;
+  XXH64_reset(&state, 0);
+  const std::unique_ptr<uint8_t[]> buf(new uint8_t[HashChunkSize]);
+  size_t rd;
+  while ((rd = std::fread(buf.get(), 1, HashChunkSize, fp.get())) > 0)
+    XXH64_update(&state, buf.get(), rd);
+  const uint64_t hash = XXH64_digest(&state);
+
+  std::lock_guard lk{m_lock};
+  m_fileHashes[std::move(relPath)] = {uint64_t(theStat.st_size), int64_t(theStat.st_mtime), hash};
+  m_dirty = true;
+  return hash;
+}
+
+uint64_t CookDatabase::HashListing(const ProjectPath& dir) {
+  if (dir.getPathType() != ProjectPath::Type::Directory)
+    return 0;
+  /* Sorted with directories first; a subdirectory and a file of the same name hash differently */
+  XXH64_state_t state;
+  XXH64_reset(&state, 0);
+  hecl::DirectoryEnumerator de(dir.getAbsolutePath(), hecl::DirectoryEnumerator::Mode::DirsThenFilesSorted, false,
+                               false, true);
+  for (const hecl::DirectoryEnumerator::Entry& ent : de) {
+    const char type = ent.m_isDir ? 'D' : 'F';
+    XXH64_update(&state, &type, 1);
+    XXH64_update(&state, ent.m_name.data(), ent.m_name.size() + 1);
+  }
+  return XXH64_digest(&state);
+}
+
+uint64_t CookDatabase::hashDependency(const ProjectPath& root, const std::string& dep) {
+  if (!dep.empty() && dep.back() == '/')
+    return HashListing(ProjectPath(root.getProject(), std::string_view(dep).substr(0, dep.size() - 1)));
+  return hashSource(ProjectPath(root.getProject(), dep));
+}
+
+uint64_t CookDatabase::hashSource(const ProjectPath& path) {
+  /* Same file set getModtime considers */
+  std::vector<ProjectPath> files;
+  uint64_t listingHash = 0;
+  switch (path.getPathType()) {
+  case ProjectPath::Type::Glob:
+    path.getGlobResults(files);
+    break;
+  case ProjectPath::Type::File:
+    files.emplace_back(path.getProject(), path.getRelativePath());
+    break;
+  case ProjectPath::Type::Directory: {
+    /* Subdirectories are not descended into, but adding, removing or renaming one still changes the hash */
+    listingHash = HashListing(path);
+    hecl::DirectoryEnumerator de(path.getAbsolutePath(), hecl::DirectoryEnumerator::Mode::DirsThenFilesSorted, false,
+                                 false, true);
+    for (const hecl::DirectoryEnumerator::Entry& ent : de)
+      if (!ent.m_isDir)
+        files.emplace_back(path, ent.m_name);
+    break;
+  }
+  default:
+    return 0;
+  }
+  std::sort(files.begin(), files.end(),
+            [](const ProjectPath& a, const ProjectPath& b) { return a.getRelativePath() < b.getRelativePath(); });
+
+  XXH64_state_t state;
+  XXH64_reset(&state, listingHash);
+  for (const ProjectPath& file : files) {
+    const std::string_view relPath = file.getRelativePath();
+    const uint64_t fileHash = hashFile(file);
+    XXH64_update(&state, relPath.data(), relPath.size());
+    XXH64_update(&state, &fileHash, sizeof(fileHash));
+  }
+  return XXH64_digest(&state);
+}
+
+std::string CookDatabase::checkCook(const ProjectPath& path, const ProjectPath& cooked, bool force) {
+  std::string reason;
+  if (force) {
+    reason = "forced";
+  } else if (cooked.getPathType() == ProjectPath::Type::None) {
+    reason = "no cooked output";
+  } else {
+    Entry entry;
+    bool found = false;
+    {
+      std::lock_guard lk{m_lock};
+      load();
+      const auto search = m_entries.find(std::string(cooked.getRelativePath()));
+      if (search != m_entries.cend()) {
+        entry = search->second;
+        found = true;
+      }
+    }
+    if (!found) {
+      reason = "not in cook database";
+    } else if (entry.toolVersion != s_toolVersion) {
+      reason = fmt::format(FMT_STRING("cooked by {}"), entry.toolVersion);
+    } else if (hashSource(path) != entry.inputHash) {
+      reason = "source changed";
+    } else {
+      for (const Dependency& dep : entry.deps) {
+        if (hashDependency(path, dep.path) != dep.hash) {
+          reason = fmt::format(FMT_STRING("dependency {} changed"), dep.path);
+          break;
+        }
+      }
+    }
+  }
+
+  std::lock_guard lk{m_lock};
+  if (reason.empty()) {
+    ++m_upToDate;
+  } else if (path.getAuxInfo().empty()) {
+    m_report.push_back(fmt::format(FMT_STRING("{}: {}"), path.getRelativePath(), reason));
+  } else {
+    m_report.push_back(fmt::format(FMT_STRING("{}|{}: {}"), path.getRelativePath(), path.getAuxInfo(), reason));
+  }
+  return reason;
+}
+
+void CookDatabase::recordCook(const ProjectPath& path, const ProjectPath& cooked, const DependencyScope& deps,
+                              double cookMs) {
+  /* Stale output is discarded before cooking, so nothing written means the cook failed; leave it to be retried */
+  if (cooked.getPathType() == ProjectPath::Type::None)
+    return;
+
+  Entry entry;
+  entry.toolVersion = s_toolVersion;
+  entry.inputHash = hashSource(path);
+  const std::string_view selfPath = path.getRelativePath();
+  for (const std::string& dep : deps.m_deps)
+    if (dep != selfPath)
+      entry.deps.push_back({dep, hashDependency(path, dep)});
+
+  std::lock_guard lk{m_lock};
+  load();
+  m_entries[std::string(cooked.getRelativePath())] = std::move(entry);
+  m_cookTimes[MakeTimingKey(path)] = cookMs;
+  m_dirty = true;
+}
+
+double CookDatabase::getCookTime(const ProjectPath& path) {
+  std::lock_guard lk{m_lock};
+  load();
+  const auto search = m_cookTimes.find(MakeTimingKey(path));
+  return search != m_cookTimes.cend() ? search->second : 0.0;
+}
+
+void CookDatabase::flush() {
+  std::lock_guard lk{m_lock};
+  if (!m_report.empty()) {
+    std::sort(m_report.begin(), m_report.end());
+    if (const auto fp = hecl::FopenUnique(m_reportPath.getAbsolutePath().data(), "wb")) {
+      for (const std::string& line : m_report)
+        fmt::print(fp.get(), FMT_STRING("{}\n"), line);
+    }
+    Log.report(logvisor::Info, FMT_STRING("{} objects recooked, {} up to date; reasons written to {}"),
+               m_report.size(), m_upToDate, m_reportPath.getRelativePath());
+  }
+  m_report.clear();
+  m_upToDate = 0;
+
+  if (!m_dirty)
+    return;
+  const std::string tmpPath = std::string(m_dbPath.getAbsolutePath()) + ".tmp";
+  {
+    const auto fp = hecl::FopenUnique(tmpPath.c_str(), "wb");
+    if (!fp) {
+      Log.report(logvisor::Warning, FMT_STRING("unable to open '{}' for writing"), tmpPath);
+      return;
+    }
+    fmt::print(fp.get(), FMT_STRING("HECLCOOKDB {}\n"), CookDatabaseVersion);
+    for (const auto& [relPath, fh] : m_fileHashes)
+      fmt::print(fp.get(), FMT_STRING("F {:016x} {} {} {}\n"), fh.hash, fh.size, fh.modtime, relPath);
+    for (const auto& [key, cookMs] : m_cookTimes)
+      fmt::print(fp.get(), FMT_STRING("T {:.1f} {}\n"), cookMs, key);
+    for (const auto& [cookedPath, entry] : m_entries) {
+      fmt::print(fp.get(), FMT_STRING("E {:016x} {} {}\n"), entry.inputHash, entry.toolVersion, cookedPath);
+      for (const Dependency& dep : entry.deps)
+        fmt::print(fp.get(), FMT_STRING("D {:016x} {}\n"), dep.hash, dep.path);
+    }
+  }
+  if (hecl::Rename(tmpPath.c_str(), m_dbPath.getAbsolutePath().data()) != 0) {
+    Log.report(logvisor::Warning, FMT_STRING("unable to replace '{}'"), m_dbPath.getAbsolutePath());
+    hecl::Unlink(tmpPath.c_str());
+    return;
+  }
+  m_dirty = false;
+}
+
+} // namespace hecl::Database
@@ -0,0 +1,34 @@
+#include "hecl/CookMetrics.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+namespace hecl {
+
+static std::atomic_bool MetricsEnabled{false};
+static std::mutex MetricsMutex;
+static std::vector<CookMetric> Metrics;
+
+void SetCookMetricsEnabled(bool enable) { MetricsEnabled = enable; }
+
+bool CookMetricsEnabled() { return MetricsEnabled; }
+
+void AddCookMetric(std::string_view name, double value) {
+  if (!MetricsEnabled)
+    return;
+  std::unique_lock lk{MetricsMutex};
+  auto it = std::find_if(Metrics.begin(), Metrics.end(), [&](const CookMetric& m) { return m.name == name; });
+  if (it == Metrics.end())
+    it = Metrics.insert(Metrics.end(), CookMetric{std::string(name)});
+  it->sum += value;
+  ++it->samples;
+}
+
+std::vector<CookMetric> TakeCookMetrics() {
+  std::unique_lock lk{MetricsMutex};
+  return std::exchange(Metrics, {});
+}
+
+} // namespace hecl
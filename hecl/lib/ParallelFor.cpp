@@ -0,0 +1,183 @@
+#include "hecl/ParallelFor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hecl/ClientProcess.hpp"
+
+#include <logvisor/logvisor.hpp>
+
+namespace hecl {
+namespace {
+
+struct ParallelJob {
+  void (*m_func)(void*, size_t);
+  void* m_ctx;
+  size_t m_count;
+  std::atomic_size_t m_next{0};
+  std::atomic_size_t m_done{0};
+  /* Helpers currently holding a pointer to this job; guarded by the pool mutex */
+  int m_helpers = 0;
+};
+
+thread_local bool t_busy = false;
+
+class HelperPool {
+  std::mutex m_mutex;
+  std::condition_variable m_workCv;
+  std::condition_variable m_doneCv;
+  std::deque<ParallelJob*> m_jobs;
+  std::vector<std::thread> m_threads;
+  int m_capacity = 0;
+  int m_busy = 0;
+  bool m_running = true;
+  bool m_helpersEnabled = true;
+  ParallelForStats m_stats;
+
+  bool canHelp() const { return m_helpersEnabled && !m_jobs.empty() && m_busy < m_capacity; }
+
+  /* Claims and runs indices until the job is exhausted; returns the number run */
+  static size_t runItems(ParallelJob& job) {
+    size_t ran = 0;
+    for (size_t i = job.m_next++; i < job.m_count; i = job.m_next++) {
+      job.m_func(job.m_ctx, i);
+      ++ran;
+    }
+    return ran;
+  }
+
+  void helperProc(int idx) {
+    std::string thrName = fmt::format(FMT_STRING("HECL Helper {}"), idx);
+    logvisor::RegisterThreadName(thrName.c_str());
+
+    std::unique_lock lk{m_mutex};
+    while (m_running) {
+      m_workCv.wait(lk, [this]() { return !m_running || canHelp(); });
+      if (!m_running)
+        break;
+      ParallelJob* job = m_jobs.front();
+      if (job->m_next >= job->m_count) {
+        m_jobs.pop_front();
+        continue;
+      }
+      ++job->m_helpers;
+      ++m_busy;
+      lk.unlock();
+      t_busy = true;
+      const size_t ran = runItems(*job);
+      t_busy = false;
+      lk.lock();
+      --m_busy;
+      m_stats.helperItems += ran;
+      job->m_done += ran;
+      if (--job->m_helpers == 0)
+        m_doneCv.notify_all();
+    }
+  }
+
+public:
+  ~HelperPool() {
+    {
+      std::unique_lock lk{m_mutex};
+      m_running = false;
+    }
+    m_workCv.notify_all();
+    for (std::thread& thr : m_threads)
+      thr.join();
+  }
+
+  void setBusy(bool busy) {
+    {
+      std::unique_lock lk{m_mutex};
+      m_busy += busy ? 1 : -1;
+    }
+    if (!busy)
+      m_workCv.notify_one();
+  }
+
+  void run(ParallelJob& job, void (*callerFunc)(void*), void* callerCtx) {
+    {
+      std::unique_lock lk{m_mutex};
+      if (m_threads.empty()) {
+        m_capacity = std::max(1, GetCPUCount());
+        for (int i = 1; i < m_capacity; ++i)
+          m_threads.emplace_back(&HelperPool::helperProc, this, i);
+      }
+      ++m_stats.jobs;
+      m_stats.items += job.m_count;
+      m_jobs.push_back(&job);
+    }
+    m_workCv.notify_all();
+
+    if (callerFunc)
+      callerFunc(callerCtx);
+    const size_t ran = runItems(job);
+
+    std::unique_lock lk{m_mutex};
+    if (auto it = std::find(m_jobs.begin(), m_jobs.end(), &job); it != m_jobs.end())
+      m_jobs.erase(it);
+    if (job.m_done.fetch_add(ran) + ran == job.m_count && job.m_helpers == 0)
+      return;
+
+    /* Hand our core to the pool while helpers finish the indices they claimed */
+    if (t_busy) {
+      --m_busy;
+      m_workCv.notify_one();
+    }
+    m_doneCv.wait(lk, [&]() { return job.m_done == job.m_count && job.m_helpers == 0; });
+    if (t_busy)
+      ++m_busy;
+  }
+
+  void setHelpersEnabled(bool enable) {
+    {
+      std::unique_lock lk{m_mutex};
+      m_helpersEnabled = enable;
+    }
+    m_workCv.notify_all();
+  }
+
+  ParallelForStats stats() {
+    std::unique_lock lk{m_mutex};
+    return m_stats;
+  }
+};
+
+HelperPool& GetHelperPool() {
+  static HelperPool pool;
+  return pool;
+}
+
+} // namespace
+
+ParallelForStats GetParallelForStats() { return GetHelperPool().stats(); }
+
+void SetParallelForHelpers(bool enable) { GetHelperPool().setHelpersEnabled(enable); }
+
+ParallelBusyScope::ParallelBusyScope() : m_wasBusy(t_busy) {
+  if (!m_wasBusy) {
+    t_busy = true;
+    GetHelperPool().setBusy(true);
+  }
+}
+
+ParallelBusyScope::~ParallelBusyScope() {
+  if (!m_wasBusy) {
+    t_busy = false;
+    GetHelperPool().setBusy(false);
+  }
+}
+
+void ParallelForImpl(size_t count, void (*func)(void*, size_t), void* ctx, void (*callerFunc)(void*),
+                     void* callerCtx) {
+  ParallelJob job{func, ctx, count};
+  GetHelperPool().run(job, callerFunc, callerCtx);
+}
+
+} // namespace hecl
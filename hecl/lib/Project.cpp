@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cerrno>
+#include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <string>
@@ -13,6 +14,7 @@
 #endif
 
 #include "hecl/ClientProcess.hpp"
+#include "hecl/CookDatabase.hpp"
 #include "hecl/Database.hpp"
 #include "hecl/Blender/Connection.hpp"
 #include "hecl/MultiProgressPrinter.hpp"
@@ -166,6 +168,7 @@ Project::Project(const ProjectRootPath& rootPath)
 , m_workRoot(*this, "")
 , m_dotPath(m_workRoot, ".hecl")
 , m_cookedRoot(m_dotPath, "cooked")
+, m_cookDatabase(std::make_unique<CookDatabase>(m_cookedRoot))
 , m_specs(*this, "specs")
 , m_paths(*this, "paths")
 , m_groups(*this, "groups") {
@@ -212,6 +215,8 @@ Project::Project(const ProjectRootPath& rootPath)
   m_valid = true;
 }
 
+Project::~Project() { m_cookDatabase->flush(); }
+
 const ProjectPath& Project::getProjectCookedPath(const DataSpecEntry& spec) const {
   for (const ProjectDataSpec& sp : m_compiledSpecs)
     if (&sp.spec == &spec)
@@ -336,10 +341,17 @@ static void VisitFile(const ProjectPath& path, bool force, bool fast,
         ProjectPath cooked = path.getCookedPath(*override);
         if (fast)
           cooked = cooked.getWithExtension(".fast");
-        if (force || cooked.getPathType() == ProjectPath::Type::None || path.getModtime() > cooked.getModtime()) {
+        CookDatabase& cookDb = path.getProject().getCookDatabase();
+        if (!cookDb.checkCook(path, cooked, force).empty()) {
           progress.reportFile(override);
-          spec->doCook(path, cooked, fast, hecl::blender::SharedBlenderToken,
-                       [&](const char* extra) { progress.reportFile(override, extra); });
+          CookDatabase::DependencyScope deps;
+          CookDatabase::DiscardOutput(cooked);
+          const auto start = std::chrono::steady_clock::now();
+          if (spec->doCook(path, cooked, fast, hecl::blender::SharedBlenderToken,
+                           [&](const char* extra) { progress.reportFile(override, extra); }))
+            cookDb.recordCook(
+                path, cooked, deps,
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
         }
       }
     }
@@ -430,6 +442,8 @@ bool Project::cookPath(const ProjectPath& path, const hecl::MultiProgressPrinter
     break;
   }
 
+  if (!cp)
+    m_cookDatabase->flush();
   return true;
 }
 
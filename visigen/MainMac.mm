@@ -122,6 +122,14 @@ int main(int argc, char** argv)
     logvisor::RegisterConsoleLogger();
     atSetExceptionHandler(AthenaExc);
     VISIRenderer renderer(argc, argv);
+
+    /* The software renderer needs no window or GL context */
+    if (renderer.IsSoftware())
+    {
+        renderer.Run(nullptr);
+        return renderer.ReturnVal();
+    }
+
     int instIdx = -1;
     if (argc > 3)
         instIdx = atoi(argv[3]);
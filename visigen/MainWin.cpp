@@ -55,6 +55,12 @@ int main(int argc, char** argv) {
   VISIRenderer renderer(argc, argv);
   s_Renderer = &renderer;
 
+  /* The software renderer needs no window or GL context */
+  if (renderer.IsSoftware()) {
+    renderer.Run(nullptr);
+    return renderer.ReturnVal();
+  }
+
   int instIdx = -1;
   if (argc > 3)
     instIdx = atoi(argv[3]);
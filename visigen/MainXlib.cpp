@@ -88,6 +88,12 @@ int main(int argc, char** argv) {
   atSetExceptionHandler(AthenaExc);
   VISIRenderer renderer(argc, argv);
 
+  /* The software renderer needs no display or GL context */
+  if (renderer.IsSoftware()) {
+    renderer.Run(nullptr);
+    return renderer.ReturnVal();
+  }
+
   if (!XInitThreads()) {
     Log.report(logvisor::Error, FMT_STRING("X doesn't support multithreading"));
     return 1;
@@ -1,6 +1,12 @@
 #include "VISIBuilder.hpp"
 #include "logvisor/logvisor.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <thread>
+
 #ifndef _WIN32
 #include <unistd.h>
 #include <signal.h>
@@ -15,17 +21,24 @@ VISIBuilder::PVSRenderCache::PVSRenderCache(VISIRenderer& renderer) : m_renderer
 
 static std::unique_ptr<VISIRenderer::RGBA8[]> RGBABuf(new VISIRenderer::RGBA8[256 * 256 * 6]);
 
-const VISIBuilder::Leaf& VISIBuilder::PVSRenderCache::GetLeaf(const zeus::CVector3f& vec) {
-  auto search = m_cache.find(vec);
-  if (search != m_cache.cend()) {
-    // Log.report(logvisor::Info, FMT_STRING("Cache hit"));
-    return *search->second;
+static thread_local VISIRasterizer Rasterizer;
+
+std::unique_ptr<VISIBuilder::Leaf> VISIBuilder::PVSRenderCache::RenderLeaf(const zeus::CVector3f& vec) {
+  std::unique_ptr<Leaf> leafOut = std::make_unique<Leaf>();
+  auto setBitLambda = [&](int idx) { leafOut->setBit(idx); };
+  auto setLightLambda = [&](int idx, EPVSVisSetState state) {
+    if (state != EPVSVisSetState::EndOfTree)
+      leafOut->setLightEnum(m_lightMetaBit + idx * 2, state);
+  };
+
+  if (m_renderer.IsSoftware()) {
+    m_renderer.RenderPVSSoftware(Rasterizer, vec, setBitLambda, setLightLambda);
+    return leafOut;
   }
 
   // Log.report(logvisor::Info, FMT_STRING("Rendering"));
   bool needsTransparent = false;
   m_renderer.RenderPVSOpaque(RGBABuf.get(), vec, needsTransparent);
-  std::unique_ptr<Leaf> leafOut = std::make_unique<Leaf>();
   for (unsigned i = 0; i < 768 * 512; ++i) {
     const VISIRenderer::RGBA8& pixel = RGBABuf[i];
     uint32_t id = (pixel.b << 16) | (pixel.g << 8) | pixel.r;
@@ -33,18 +46,105 @@ const VISIBuilder::Leaf& VISIBuilder::PVSRenderCache::GetLeaf(const zeus::CVecto
       leafOut->setBit(id - 1);
   }
 
-  auto setBitLambda = [&](int idx) { leafOut->setBit(idx); };
-  auto setLightLambda = [&](int idx, EPVSVisSetState state) {
-    if (state != EPVSVisSetState::EndOfTree)
-      leafOut->setLightEnum(m_lightMetaBit + idx * 2, state);
-  };
   if (needsTransparent)
     m_renderer.RenderPVSTransparent(setBitLambda, vec);
   m_renderer.RenderPVSEntitiesAndLights(setBitLambda, setLightLambda, vec);
+  if (m_renderer.IsVerifying())
+    VerifyLeaf(vec, *leafOut);
+  return leafOut;
+}
 
+void VISIBuilder::PVSRenderCache::VerifyLeaf(const zeus::CVector3f& vec, const Leaf& glLeaf) {
+  Leaf swLeaf;
+  m_renderer.RenderPVSSoftware(
+      Rasterizer, vec, [&](int idx) { swLeaf.setBit(idx); },
+      [&](int idx, EPVSVisSetState state) {
+        if (state != EPVSVisSetState::EndOfTree)
+          swLeaf.setLightEnum(m_lightMetaBit + idx * 2, state);
+      });
+
+  size_t missed = 0;
+  size_t extra = 0;
+  for (size_t i = 0; i < std::max(glLeaf.bits.size(), swLeaf.bits.size()); ++i) {
+    const uint8_t glByte = i < glLeaf.bits.size() ? glLeaf.bits[i] : 0;
+    const uint8_t swByte = i < swLeaf.bits.size() ? swLeaf.bits[i] : 0;
+    missed += std::bitset<8>(glByte & ~swByte).count();
+    extra += std::bitset<8>(swByte & ~glByte).count();
+  }
+  ++m_verifyLeaves;
+  if (missed != 0 || extra != 0)
+    ++m_verifyMismatchedLeaves;
+  m_verifyMissedBits += missed;
+  m_verifyExtraBits += extra;
+}
+
+const VISIBuilder::Leaf& VISIBuilder::PVSRenderCache::GetLeaf(const zeus::CVector3f& vec) {
+  static const Leaf EmptyLeaf;
+  if (m_recording) {
+    m_pending.insert(vec);
+    return EmptyLeaf;
+  }
+
+  {
+    std::lock_guard lk(m_cacheLock);
+    auto search = m_cache.find(vec);
+    if (search != m_cache.cend()) {
+      // Log.report(logvisor::Info, FMT_STRING("Cache hit"));
+      return *search->second;
+    }
+  }
+
+  std::unique_ptr<Leaf> leafOut = RenderLeaf(vec);
+  std::lock_guard lk(m_cacheLock);
   return *m_cache.emplace(std::make_pair(vec, std::move(leafOut))).first->second;
 }
 
+void VISIBuilder::PVSRenderCache::RenderPending(FPercent updatePercent, const std::function<bool()>& terminate) {
+  std::vector<zeus::CVector3f> points;
+  points.reserve(m_pending.size());
+  for (const zeus::CVector3f& point : m_pending) {
+    if (m_cache.find(point) == m_cache.cend())
+      points.push_back(point);
+  }
+  m_pending.clear();
+  m_cache.reserve(m_cache.size() + points.size());
+
+  const auto startTime = std::chrono::steady_clock::now();
+  const size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+  std::atomic_size_t next{0};
+  std::atomic_size_t done{0};
+  std::atomic_bool stop{false};
+  auto workerProc = [&]() {
+    for (size_t i = next++; i < points.size() && !stop; i = next++) {
+      std::unique_ptr<Leaf> leaf = RenderLeaf(points[i]);
+      {
+        std::lock_guard lk(m_cacheLock);
+        m_cache.emplace(points[i], std::move(leaf));
+      }
+      ++done;
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(threadCount);
+  for (size_t i = 0; i < threadCount; ++i)
+    workers.emplace_back(workerProc);
+
+  // Leaves land in the cache in any order; the octree is built from it serially afterwards
+  while (done < points.size() && !stop) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if (terminate())
+      stop = true;
+    if (updatePercent && !points.empty())
+      updatePercent(float(done.load()) / float(points.size()));
+  }
+  for (std::thread& worker : workers)
+    worker.join();
+
+  const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+  Log.report(logvisor::Info, FMT_STRING("Rendered {} sample points in {:.2f} s ({:.1f} points/s, {} threads)"),
+             done.load(), secs, secs > 0.0 ? done.load() / secs : 0.0, threadCount);
+}
+
 void VISIBuilder::Progress::report(int divisions) {
   m_prog += 1.f / divisions;
   // printf(" %g%%        \r", m_prog * 100.f);
@@ -263,7 +363,8 @@ std::vector<uint8_t> VISIBuilder::build(const zeus::CAABox& fullAabb, size_t mod
   size_t featureCount = modelCount + entities.size();
   renderCache.m_lightMetaBit = featureCount;
 
-  Progress prog(updatePercent);
+  const bool software = renderCache.m_renderer.IsSoftware();
+  Progress prog(software ? nullptr : updatePercent);
 #ifndef _WIN32
   auto terminate = [this, parentPid]() {
     return renderCache.m_renderer.m_terminate || (parentPid ? kill(parentPid, 0) : false);
@@ -276,6 +377,20 @@ std::vector<uint8_t> VISIBuilder::build(const zeus::CAABox& fullAabb, size_t mod
     return renderCache.m_renderer.m_terminate || (parentPid ? exitCode != STILL_ACTIVE : false);
   };
 #endif
+  if (software) {
+    // The octree's sample points depend only on its bounds, so gather them all up front and
+    // render them across every core; the real build below then only hits the cache
+    renderCache.m_recording = true;
+    Node scratchRoot;
+    Progress scratchProg(nullptr);
+    scratchRoot.buildChildren(0, 1, fullAabb, renderCache, scratchProg, terminate);
+    for (const VISIRenderer::Light& l : lights)
+      renderCache.GetLeaf(l.point);
+    renderCache.m_recording = false;
+    renderCache.RenderPending(updatePercent, terminate);
+    if (terminate())
+      return {};
+  }
   rootNode.buildChildren(0, 1, fullAabb, renderCache, prog, terminate);
   if (terminate())
     return {};
@@ -322,6 +437,13 @@ std::vector<uint8_t> VISIBuilder::build(const zeus::CAABox& fullAabb, size_t mod
 
   w.seekAlign32();
 
+  if (renderCache.m_renderer.IsVerifying()) {
+    Log.report(renderCache.m_verifyMissedBits != 0 ? logvisor::Warning : logvisor::Info,
+               FMT_STRING("Software rasterizer differs from GL at {} of {} sample points: {} bits missed, {} extra"),
+               renderCache.m_verifyMismatchedLeaves, renderCache.m_verifyLeaves, renderCache.m_verifyMissedBits,
+               renderCache.m_verifyExtraBits);
+  }
+
   // Log.report(logvisor::Info, FMT_STRING("Finished!"));
   return dataOut;
 }
@@ -4,7 +4,10 @@
 #include "zeus/CAABox.hpp"
 #include "xxhash/xxhash.h"
 #include "athena/MemoryWriter.hpp"
+#include <functional>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 #ifdef _WIN32
 using ProcessType = HANDLE;
@@ -74,11 +77,25 @@ struct VISIBuilder {
     friend struct VISIBuilder;
     VISIRenderer& m_renderer;
     std::unordered_map<zeus::CVector3f, std::unique_ptr<Leaf>> m_cache;
+    std::mutex m_cacheLock;
     size_t m_lightMetaBit;
+    /* While set, GetLeaf only collects sample points for RenderPending */
+    bool m_recording = false;
+    std::unordered_set<zeus::CVector3f> m_pending;
+    /* Verify mode tallies; bits GL set that the software leaf lacks make the software path unsafe */
+    size_t m_verifyLeaves = 0;
+    size_t m_verifyMismatchedLeaves = 0;
+    size_t m_verifyMissedBits = 0;
+    size_t m_verifyExtraBits = 0;
+
+    std::unique_ptr<Leaf> RenderLeaf(const zeus::CVector3f& vec);
+    void VerifyLeaf(const zeus::CVector3f& vec, const Leaf& glLeaf);
 
   public:
     PVSRenderCache(VISIRenderer& renderer);
     const Leaf& GetLeaf(const zeus::CVector3f& vec);
+    /* Renders every collected sample point across all cores (software renderer only) */
+    void RenderPending(FPercent updatePercent, const std::function<bool()>& terminate);
   } renderCache;
 
   class Progress {
@@ -0,0 +1,261 @@
+#include "VISIRasterizer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+
+#include "zeus/CVector4f.hpp"
+
+namespace {
+constexpr uint32_t PrimitiveRestart = 0xffffffff;
+/* GL implementations snap window coordinates to at least 8 subpixel bits */
+constexpr float SubpixelSteps = 256.f;
+/* Half the width of a test fragment: the pixel itself plus one pixel of dilation */
+constexpr float TestHalfExtent = 1.5f;
+
+struct ScreenVert {
+  float x, y, z;
+};
+
+/* Edge function in y-up window space, written as A * x + B * y + C so rows evaluate independently */
+struct Edge {
+  float a, b, c;
+  bool topLeft;
+
+  Edge(const ScreenVert& v0, const ScreenVert& v1) {
+    a = -(v1.y - v0.y);
+    b = v1.x - v0.x;
+    c = (v1.y - v0.y) * v0.x - (v1.x - v0.x) * v0.y;
+    /* CCW triangles: left edges run downward, top edges run leftward */
+    topLeft = v1.y < v0.y || (v1.y == v0.y && v1.x < v0.x);
+  }
+
+  bool inside(float e) const { return e > 0.f || (e == 0.f && topLeft); }
+  /* Largest value the edge function takes over a square of half-width h around the sample */
+  float dilation(float h) const { return (std::fabs(a) + std::fabs(b)) * h; }
+};
+} // Anonymous namespace
+
+VISIRasterizer::VISIRasterizer()
+: m_depth(FaceSize * FaceSize), m_testDepth(FaceSize * FaceSize), m_ids(FaceSize * FaceSize) {}
+
+void VISIRasterizer::clear() {
+  std::fill(m_depth.begin(), m_depth.end(), 1.f);
+  std::fill(m_ids.begin(), m_ids.end(), 0);
+}
+
+void VISIRasterizer::finishOccluders() {
+  /* Separable 3x3 max: a test fragment is only rejected if every neighbouring occluder pixel rejects it,
+   * which absorbs GL and this rasterizer disagreeing about occluder edge pixels */
+  for (int y = 0; y < FaceSize; ++y) {
+    const float* src = &m_depth[y * FaceSize];
+    float* dst = &m_testDepth[y * FaceSize];
+    for (int x = 0; x < FaceSize; ++x) {
+      const float left = src[std::max(x - 1, 0)];
+      const float right = src[std::min(x + 1, FaceSize - 1)];
+      dst[x] = std::max({left, src[x], right});
+    }
+  }
+  std::array<float, FaceSize> above;
+  for (int y = 0; y < FaceSize; ++y) {
+    float* row = &m_testDepth[y * FaceSize];
+    const float* below = &m_testDepth[std::min(y + 1, FaceSize - 1) * FaceSize];
+    for (int x = 0; x < FaceSize; ++x) {
+      const float cur = row[x];
+      row[x] = std::max({y > 0 ? above[x] : cur, cur, below[x]});
+      above[x] = cur;
+    }
+  }
+}
+
+VISIRasterizer::ClipVert VISIRasterizer::transform(const zeus::CVector3f& pos) const {
+  const zeus::CVector4f clip = m_xf * zeus::CVector4f(pos);
+  return {clip.x(), clip.y(), clip.z(), clip.w()};
+}
+
+template <bool Write>
+bool VISIRasterizer::rasterizeTriangle(const ClipVert& a, const ClipVert& b, const ClipVert& c, uint32_t id) {
+  const auto toScreen = [](const ClipVert& v) {
+    const float invW = 1.f / v.w;
+    const float x = (v.x * invW * 0.5f + 0.5f) * FaceSize;
+    const float y = (v.y * invW * 0.5f + 0.5f) * FaceSize;
+    return ScreenVert{std::round(x * SubpixelSteps) / SubpixelSteps, std::round(y * SubpixelSteps) / SubpixelSteps,
+                      v.z * invW * 0.5f + 0.5f};
+  };
+  ScreenVert v0 = toScreen(a);
+  ScreenVert v1 = toScreen(b);
+  ScreenVert v2 = toScreen(c);
+
+  float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+  if constexpr (Write) {
+    /* Cull back faces and degenerates */
+    if (!(area > 0.f))
+      return false;
+  } else {
+    /* Tests see both windings; only degenerates are dropped */
+    if (area < 0.f) {
+      std::swap(v1, v2);
+      area = -area;
+    }
+    if (!(area > 0.f))
+      return false;
+  }
+
+  const float pad = Write ? 0.f : TestHalfExtent - 0.5f;
+  const float maxCoord = float(FaceSize - 1);
+  const int minX = int(std::clamp(std::floor(std::min({v0.x, v1.x, v2.x}) - pad), 0.f, maxCoord));
+  const int maxX = int(std::clamp(std::ceil(std::max({v0.x, v1.x, v2.x}) + pad), 0.f, maxCoord));
+  const int minY = int(std::clamp(std::floor(std::min({v0.y, v1.y, v2.y}) - pad), 0.f, maxCoord));
+  const int maxY = int(std::clamp(std::ceil(std::max({v0.y, v1.y, v2.y}) + pad), 0.f, maxCoord));
+
+  const Edge e12(v1, v2);
+  const Edge e20(v2, v0);
+  const Edge e01(v0, v1);
+  const float invArea = 1.f / area;
+
+  /* Tests take the nearest depth anywhere in their dilated fragment, bounded by the nearest vertex */
+  const float bias12 = Write ? 0.f : e12.dilation(TestHalfExtent);
+  const float bias20 = Write ? 0.f : e20.dilation(TestHalfExtent);
+  const float bias01 = Write ? 0.f : e01.dilation(TestHalfExtent);
+  const float dzdx = (e12.a * v0.z + e20.a * v1.z + e01.a * v2.z) * invArea;
+  const float dzdy = (e12.b * v0.z + e20.b * v1.z + e01.b * v2.z) * invArea;
+  const float zBias = Write ? 0.f : (std::fabs(dzdx) + std::fabs(dzdy)) * TestHalfExtent;
+  const float zFloor = Write ? 0.f : std::min({v0.z, v1.z, v2.z});
+  const std::vector<float>& depth = Write ? m_depth : m_testDepth;
+  bool passed = false;
+
+  for (int py = minY; py <= maxY; ++py) {
+    const float fy = py + 0.5f;
+    const float row12 = e12.b * fy + e12.c + bias12;
+    const float row20 = e20.b * fy + e20.c + bias20;
+    const float row01 = e01.b * fy + e01.c + bias01;
+    const float* depthRow = &depth[py * FaceSize];
+    uint32_t* idRow = &m_ids[py * FaceSize];
+    for (int px = minX; px <= maxX; ++px) {
+      const float fx = px + 0.5f;
+      const float w0 = e12.a * fx + row12;
+      const float w1 = e20.a * fx + row20;
+      const float w2 = e01.a * fx + row01;
+      if constexpr (Write) {
+        if (!e12.inside(w0) || !e20.inside(w1) || !e01.inside(w2))
+          continue;
+      } else {
+        if (w0 < 0.f || w1 < 0.f || w2 < 0.f)
+          continue;
+      }
+
+      /* Window-space depth is affine in screen space; fragments past the far plane are clipped.
+       * The dilation biases are removed again since they are not part of the barycentrics. */
+      float z = ((w0 - bias12) * v0.z + (w1 - bias20) * v1.z + (w2 - bias01) * v2.z) * invArea;
+      if constexpr (!Write)
+        z = std::max(z - zBias, zFloor);
+      if (z > 1.f || z > depthRow[px])
+        continue;
+
+      if constexpr (Write) {
+        m_depth[py * FaceSize + px] = z;
+        idRow[px] = id;
+        passed = true;
+      } else {
+        return true;
+      }
+    }
+  }
+  return passed;
+}
+
+template <bool Write>
+bool VISIRasterizer::clipAndRasterize(const ClipVert& a, const ClipVert& b, const ClipVert& c, uint32_t id) {
+  /* Clip against the near plane (z >= -w); the projection keeps w positive on the visible side */
+  const ClipVert* in[3] = {&a, &b, &c};
+  float dist[3];
+  int insideCount = 0;
+  for (int i = 0; i < 3; ++i) {
+    dist[i] = in[i]->z + in[i]->w;
+    if (dist[i] >= 0.f)
+      ++insideCount;
+  }
+  if (insideCount == 3)
+    return rasterizeTriangle<Write>(a, b, c, id);
+  if (insideCount == 0)
+    return false;
+
+  ClipVert poly[4];
+  int polyCount = 0;
+  for (int i = 0; i < 3; ++i) {
+    const int next = (i + 1) % 3;
+    if (dist[i] >= 0.f)
+      poly[polyCount++] = *in[i];
+    if ((dist[i] >= 0.f) != (dist[next] >= 0.f)) {
+      const float t = dist[i] / (dist[i] - dist[next]);
+      const ClipVert& p0 = *in[i];
+      const ClipVert& p1 = *in[next];
+      poly[polyCount++] = {p0.x + (p1.x - p0.x) * t, p0.y + (p1.y - p0.y) * t, p0.z + (p1.z - p0.z) * t,
+                           p0.w + (p1.w - p0.w) * t};
+    }
+  }
+
+  bool passed = false;
+  for (int i = 1; i + 1 < polyCount; ++i) {
+    passed |= rasterizeTriangle<Write>(poly[0], poly[i], poly[i + 1], id);
+    if (!Write && passed)
+      return true;
+  }
+  return passed;
+}
+
+template <bool Write>
+bool VISIRasterizer::drawPrimitives(const uint32_t* idxs, size_t count, bool strip, uint32_t id) {
+  bool passed = false;
+  if (strip) {
+    size_t stripStart = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (idxs[i] == PrimitiveRestart) {
+        stripStart = i + 1;
+        continue;
+      }
+      if (i - stripStart < 2)
+        continue;
+      /* Odd strip triangles are wound in reverse */
+      uint32_t i0 = idxs[i - 2];
+      uint32_t i1 = idxs[i - 1];
+      if ((i - stripStart) & 1)
+        std::swap(i0, i1);
+      passed |= clipAndRasterize<Write>(m_clipVerts[i0], m_clipVerts[i1], m_clipVerts[idxs[i]], id);
+      if (!Write && passed)
+        return true;
+    }
+  } else {
+    for (size_t i = 0; i + 2 < count; i += 3) {
+      passed |= clipAndRasterize<Write>(m_clipVerts[idxs[i]], m_clipVerts[idxs[i + 1]], m_clipVerts[idxs[i + 2]], id);
+      if (!Write && passed)
+        return true;
+    }
+  }
+  return passed;
+}
+
+void VISIRasterizer::drawElements(const uint32_t* idxs, size_t count, bool strip, uint32_t id) {
+  drawPrimitives<true>(idxs, count, strip, id);
+}
+
+bool VISIRasterizer::testElements(const uint32_t* idxs, size_t count, bool strip) {
+  return drawPrimitives<false>(idxs, count, strip, 0);
+}
+
+bool VISIRasterizer::testPoint(const zeus::CVector3f& point) const {
+  const ClipVert v = transform(point);
+  if (v.w <= 0.f || v.x < -v.w || v.x > v.w || v.y < -v.w || v.y > v.w || v.z < -v.w || v.z > v.w)
+    return false;
+  const float invW = 1.f / v.w;
+  const int px = std::min(int((v.x * invW * 0.5f + 0.5f) * FaceSize), FaceSize - 1);
+  const int py = std::min(int((v.y * invW * 0.5f + 0.5f) * FaceSize), FaceSize - 1);
+  const float z = v.z * invW * 0.5f + 0.5f;
+  /* The one-pixel point is dilated to its 3x3 neighbourhood */
+  for (int y = std::max(py - 1, 0); y <= std::min(py + 1, FaceSize - 1); ++y)
+    for (int x = std::max(px - 1, 0); x <= std::min(px + 1, FaceSize - 1); ++x)
+      if (z <= m_testDepth[y * FaceSize + x])
+        return true;
+  return false;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "zeus/CMatrix4f.hpp"
+#include "zeus/CVector3f.hpp"
+
+/* CPU depth/ID-buffer rasterizer for one 256x256 cube face. Draws mirror the GL path's state:
+ * back-face culling with CCW front faces, 8-bit subpixel snapping, top-left fill rule, LEQUAL depth test,
+ * near-plane clipping, strips with primitive restart.
+ * Tests are conservative instead, so they never miss a fragment GL would have passed: no culling,
+ * coverage dilated by one pixel with the depth interpolated to its nearest point, and depth compared
+ * against the occluders eroded by one pixel. Each thread needs its own instance. */
+class VISIRasterizer {
+public:
+  static constexpr int FaceSize = 256;
+
+private:
+  struct ClipVert {
+    float x, y, z, w;
+  };
+
+  std::vector<float> m_depth;
+  /* m_depth max-filtered over 3x3 pixels by finishOccluders() */
+  std::vector<float> m_testDepth;
+  std::vector<uint32_t> m_ids;
+  std::vector<ClipVert> m_clipVerts;
+  zeus::CMatrix4f m_xf;
+
+  ClipVert transform(const zeus::CVector3f& pos) const;
+  template <bool Write>
+  bool rasterizeTriangle(const ClipVert& a, const ClipVert& b, const ClipVert& c, uint32_t id);
+  template <bool Write>
+  bool clipAndRasterize(const ClipVert& a, const ClipVert& b, const ClipVert& c, uint32_t id);
+  template <bool Write>
+  bool drawPrimitives(const uint32_t* idxs, size_t count, bool strip, uint32_t id);
+
+public:
+  VISIRasterizer();
+
+  /* Depth to 1.0, IDs to 0 */
+  void clear();
+  void setTransform(const zeus::CMatrix4f& xf) { m_xf = xf; }
+
+  template <typename Vert>
+  void setVertices(const std::vector<Vert>& verts) {
+    m_clipVerts.resize(verts.size());
+    for (size_t i = 0; i < verts.size(); ++i)
+      m_clipVerts[i] = transform(verts[i].pos);
+  }
+
+  /* Depth-tested draw writing depth and id */
+  void drawElements(const uint32_t* idxs, size_t count, bool strip, uint32_t id);
+  /* Call once all occluders are drawn and before any tests */
+  void finishOccluders();
+  /* Conservative depth test without writes; true if any fragment may pass */
+  bool testElements(const uint32_t* idxs, size_t count, bool strip);
+  bool testPoint(const zeus::CVector3f& point) const;
+
+  const std::vector<uint32_t>& ids() const { return m_ids; }
+};
@@ -5,6 +5,9 @@
 #include "zeus/CFrustum.hpp"
 #include "logvisor/logvisor.hpp"
 
+#include <cstdlib>
+#include <cstring>
+
 static logvisor::Module Log("visigen");
 
 static const char* VS =
@@ -409,25 +412,114 @@ void VISIRenderer::RenderPVSEntitiesAndLights(const std::function<void(int)>& pa
   }
 }
 
+void VISIRenderer::RenderPVSSoftware(VISIRasterizer& rast, const zeus::CVector3f& pos,
+                                     const std::function<void(int)>& passFunc,
+                                     const std::function<void(int, EPVSVisSetState)>& lightPassFunc) const {
+  std::vector<bool> modelVisible(m_models.size());
+
+  for (int j = 0; j < 6; ++j) {
+    zeus::CMatrix4f mv = LookMATs[j] * zeus::CTransform::Translate(-pos).toMatrix4f();
+    rast.setTransform(g_Proj * mv);
+    rast.clear();
+
+    zeus::CFrustum frustum;
+    frustum.updatePlanes(mv, g_Proj);
+
+    // Non-transparents write their model index + 1, matching ColorForIndex
+    uint32_t id = 1;
+    for (const Model& model : m_models) {
+      if (frustum.aabbFrustumTest(model.aabb)) {
+        rast.setVertices(model.verts);
+        for (const Model::Surface& surf : model.surfaces) {
+          if (!surf.transparent)
+            rast.drawElements(model.idxs.data() + surf.first, surf.count, model.topology == GL_TRIANGLE_STRIP, id);
+        }
+      }
+      ++id;
+    }
+    for (const uint32_t pixelId : rast.ids()) {
+      if (pixelId != 0)
+        modelVisible[pixelId - 1] = true;
+    }
+    rast.finishOccluders();
+
+    // Models that won no pixel may still have won one under GL's edge rules
+    for (size_t i = 0; i < m_models.size(); ++i) {
+      const Model& model = m_models[i];
+      if (modelVisible[i] || !frustum.aabbFrustumTest(model.aabb))
+        continue;
+      rast.setVertices(model.verts);
+      for (const Model::Surface& surf : model.surfaces) {
+        if (!surf.transparent &&
+            rast.testElements(model.idxs.data() + surf.first, surf.count, model.topology == GL_TRIANGLE_STRIP)) {
+          modelVisible[i] = true;
+          break;
+        }
+      }
+    }
+
+    int idx = m_models.size();
+    for (const Entity& ent : m_entities) {
+      if (frustum.aabbFrustumTest(ent.aabb)) {
+        rast.setVertices(AABBToVerts(ent.aabb, ColorForIndex(idx)));
+        if (rast.testElements(AABBIdxs, 20, true))
+          passFunc(idx);
+      }
+      ++idx;
+    }
+
+    int lightIdx = 0;
+    for (const Light& light : m_lights) {
+      if (frustum.pointFrustumTest(light.point)) {
+        EPVSVisSetState state =
+            m_totalAABB.pointInside(light.point) ? EPVSVisSetState::EndOfTree : EPVSVisSetState::OutOfBounds;
+        if (rast.testPoint(light.point) && state == EPVSVisSetState::EndOfTree)
+          state = EPVSVisSetState::NodeFound;
+        lightPassFunc(lightIdx, state);
+      }
+      ++lightIdx;
+    }
+  }
+
+  for (size_t i = 0; i < modelVisible.size(); ++i) {
+    if (modelVisible[i])
+      passFunc(int(i));
+  }
+}
+
+EVISIRasterMode VISIRenderer::RasterModeRequested() {
+  const char* env = std::getenv("VISIGEN_SOFTWARE");
+  if (env == nullptr || *env == '\0' || std::strcmp(env, "0") == 0)
+    return EVISIRasterMode::GL;
+  if (std::strcmp(env, "verify") == 0)
+    return EVISIRasterMode::Verify;
+  return EVISIRasterMode::Software;
+}
+
 void VISIRenderer::Run(FPercent updatePercent) {
   m_updatePercent = updatePercent;
   CalculateProjMatrix();
 
-  if (glewInit() != GLEW_OK) {
-    Log.report(logvisor::Error, FMT_STRING("unable to init glew"));
-    m_return = 1;
-    return;
-  }
+  if (IsSoftware()) {
+    Log.report(logvisor::Warning,
+               FMT_STRING("Using the experimental software rasterizer; check it with VISIGEN_SOFTWARE=verify"));
+  } else {
+    if (glewInit() != GLEW_OK) {
+      Log.report(logvisor::Error, FMT_STRING("unable to init glew"));
+      m_return = 1;
+      return;
+    }
 
-  if (!GLEW_ARB_occlusion_query2) {
-    Log.report(logvisor::Error, FMT_STRING("GL_ARB_occlusion_query2 extension not present"));
-    m_return = 1;
-    return;
-  }
+    if (!GLEW_ARB_occlusion_query2) {
+      Log.report(logvisor::Error, FMT_STRING("GL_ARB_occlusion_query2 extension not present"));
+      m_return = 1;
+      return;
+    }
 
-  if (!SetupShaders()) {
-    m_return = 1;
-    return;
+    if (!SetupShaders()) {
+      m_return = 1;
+      return;
+    }
   }
 
   if (m_argc < 3) {
@@ -501,7 +593,7 @@ void VISIRenderer::Run(FPercent updatePercent) {
     }
   }
 
-  if (!SetupVertexBuffersAndFormats()) {
+  if (!IsSoftware() && !SetupVertexBuffersAndFormats()) {
     m_return = 1;
     return;
   }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "boo/graphicsdev/glew.h"
+#include "VISIRasterizer.hpp"
 #include "zeus/CColor.hpp"
 #include "zeus/CMatrix4f.hpp"
 #include "zeus/CAABox.hpp"
@@ -9,12 +10,17 @@ typedef void (*FPercent)(float);
 
 enum class EPVSVisSetState { EndOfTree, NodeFound, OutOfBounds };
 
+/* VISIGEN_SOFTWARE=1 selects Software, VISIGEN_SOFTWARE=verify selects Verify; GL is the default */
+enum class EVISIRasterMode { GL, Software, Verify };
+
 class VISIRenderer {
   friend struct VISIBuilder;
 
   int m_argc;
   char** m_argv;
   int m_return = 0;
+  /* Software rasterizes on the CPU instead of through GL; Verify renders with GL and diffs the CPU result */
+  EVISIRasterMode m_rasterMode;
 
   zeus::CAABox m_totalAABB;
 
@@ -81,7 +87,10 @@ public:
     uint8_t a;
   };
 
-  VISIRenderer(int argc, char** argv) : m_argc(argc), m_argv(argv) {}
+  VISIRenderer(int argc, char** argv) : m_argc(argc), m_argv(argv), m_rasterMode(RasterModeRequested()) {}
+  static EVISIRasterMode RasterModeRequested();
+  bool IsSoftware() const { return m_rasterMode == EVISIRasterMode::Software; }
+  bool IsVerifying() const { return m_rasterMode == EVISIRasterMode::Verify; }
   void Run(FPercent updatePercent);
   void Terminate();
   void RenderPVSOpaque(RGBA8* bufOut, const zeus::CVector3f& pos, bool& needTransparent);
@@ -89,5 +98,8 @@ public:
   void RenderPVSEntitiesAndLights(const std::function<void(int)>& passFunc,
                                   const std::function<void(int, EPVSVisSetState)>& lightPassFunc,
                                   const zeus::CVector3f& pos);
+  /* Opaque, entity and light passes on the CPU; thread-safe given a rasterizer per thread */
+  void RenderPVSSoftware(VISIRasterizer& rast, const zeus::CVector3f& pos, const std::function<void(int)>& passFunc,
+                         const std::function<void(int, EPVSVisSetState)>& lightPassFunc) const;
   int ReturnVal() const { return m_return; }
 };